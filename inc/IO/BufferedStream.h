@@ -0,0 +1,77 @@
+//
+//  BufferedStream.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef BufferedStream_h
+#define BufferedStream_h
+
+#include "IO/Stream.h"
+
+namespace IO {
+    // Buffers the reads and writes of another stream, so the small primitives do not cost a call of it each.
+    // The writes are coalesced until the buffer is full or flushed, the reads fill the buffer ahead.
+    // The stream is not owned, it must be alive until this one is deleted.
+    // A write fails while read-ahead bytes are unread, if the stream can not seek to give them back.
+    class BufferedStream : public Stream {
+    public:
+        using Stream::seek;
+
+        explicit BufferedStream(Stream *stream, size_t bufferSize = DefaultBufferSize);
+
+        BufferedStream(const BufferedStream &) = delete;
+
+        ~BufferedStream() override;
+
+        BufferedStream &operator=(const BufferedStream &) = delete;
+
+        ssize_t write(const uint8_t *array, off_t offset, size_t count) override;
+
+        ssize_t read(uint8_t *array, off_t offset, size_t count) override;
+
+        off_t position() const override;
+
+        size_t length() const override;
+
+        off_t seek(off_t offset, SeekOrigin origin) override;
+
+        bool canWrite() const override;
+
+        bool canRead() const override;
+
+        bool canSeek() const override;
+
+        // Writes the buffered bytes to the stream, then flushes it.
+        void flush() override;
+
+        void close() override;
+
+        Stream *stream() const;
+
+        size_t bufferSize() const;
+
+    public:
+        static const size_t DefaultBufferSize = 64 * 1024;
+
+    private:
+        bool flushWrite();
+
+        // Gives the unread bytes back to the stream by seeking it,
+        // returns false and keeps them if the stream can not seek.
+        bool discardRead();
+
+    private:
+        Stream *_stream;
+        uint8_t *_buffer;
+        size_t _bufferSize;
+
+        size_t _writeCount;     // bytes written to the buffer, not to the stream.
+        size_t _readPosition;   // the unread bytes are [_readPosition, _readCount).
+        size_t _readCount;
+    };
+}
+
+#endif // BufferedStream_h
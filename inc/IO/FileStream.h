@@ -84,6 +84,9 @@ namespace IO {
 
         void setLength(size_t length);
 
+        // Hints the system that the file is read sequentially, so it reads ahead more.
+        bool setSequential(bool sequential = true);
+
         int fd() const;
 
         const String &fileName() const;
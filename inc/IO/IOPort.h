@@ -30,6 +30,8 @@ namespace IO {
 
         size_t available() override;
 
+        bool waitAvailable(uint32_t timeout) override;
+
         bool useReceiveTimeout() const override;
 
         ssize_t send(const uint8_t *buffer, off_t offset, size_t count) override;
@@ -44,6 +46,13 @@ namespace IO {
 
         bool isOpen() const;
 
+    protected:
+        size_t availableInner() override;
+
+        ssize_t receiveInner(uint8_t *buffer, off_t offset, size_t count) override;
+
+        bool waitAvailableInner(uint32_t timeout) override;
+
     protected:
 #ifdef WIN32
         typedef void* Handle;
@@ -152,6 +152,40 @@ namespace IO {
 
         int64_t readBCDInt64();
 
+        // The bulk primitives, the values are byte swapped as a whole and written by one call.
+        // The reads return the number of the values read.
+        bool writeInt16s(const int16_t *values, size_t count, bool bigEndian = true);
+
+        size_t readInt16s(int16_t *values, size_t count, bool bigEndian = true);
+
+        bool writeUInt16s(const uint16_t *values, size_t count, bool bigEndian = true);
+
+        size_t readUInt16s(uint16_t *values, size_t count, bool bigEndian = true);
+
+        bool writeInt32s(const int32_t *values, size_t count, bool bigEndian = true);
+
+        size_t readInt32s(int32_t *values, size_t count, bool bigEndian = true);
+
+        bool writeUInt32s(const uint32_t *values, size_t count, bool bigEndian = true);
+
+        size_t readUInt32s(uint32_t *values, size_t count, bool bigEndian = true);
+
+        bool writeInt64s(const int64_t *values, size_t count, bool bigEndian = true);
+
+        size_t readInt64s(int64_t *values, size_t count, bool bigEndian = true);
+
+        bool writeUInt64s(const uint64_t *values, size_t count, bool bigEndian = true);
+
+        size_t readUInt64s(uint64_t *values, size_t count, bool bigEndian = true);
+
+        bool writeFloats(const float *values, size_t count, bool bigEndian = true);
+
+        size_t readFloats(float *values, size_t count, bool bigEndian = true);
+
+        bool writeDoubles(const double *values, size_t count, bool bigEndian = true);
+
+        size_t readDoubles(double *values, size_t count, bool bigEndian = true);
+
         const Version &version() const;
 
         void setVersion(const Version &version);
@@ -186,6 +220,11 @@ namespace IO {
 
         Stream(const Stream &stream);
 
+    private:
+        bool writeSpan(const void *values, size_t count, size_t size, bool bigEndian);
+
+        size_t readSpan(void *values, size_t count, size_t size, bool bigEndian);
+
     private:
         Version _version;
 
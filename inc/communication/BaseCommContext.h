@@ -215,6 +215,7 @@ namespace Communication {
         String file_name;
         uint32_t packetCount;
         String path;    // use by local db, it is not necessary to use in communications.
+        ByteArray hashedmd5;    // hashed while the packets are saved in order, empty if they are not.
 
         FileHeader();
 
@@ -232,6 +233,8 @@ namespace Communication {
 
         bool checkmd5(const String &filename) const;
 
+        bool matchmd5(const ByteArray &md5) const;
+
         String md5Str() const;
 
         static bool parseMd5Str(const String &file_md5, uint8_t md5[MD5_COUNT]);
@@ -23,6 +23,7 @@
 #include "diag/Stopwatch.h"
 #include "driver/instructions/Instruction.h"
 #include "system/Math.h"
+#include "crypto/Md5Provider.h"
 #include "BaseCommContext.h"
 
 using namespace Data;
@@ -506,20 +507,29 @@ namespace Communication
         static FileInstructionEntry* instance();
         
     protected:
-        bool saveFile(const FileHeader* header, const FileDatas* fds);
-        bool saveFile(const FileHeader* header, const FileData* fd);
-        bool saveFileInner(const FileHeader* header, const FileDatas* fds);
-        bool saveFileInner(const FileHeader* header, const FileData* fd);
+        bool saveFile(FileHeader* header, const FileDatas* fds);
+        bool saveFile(FileHeader* header, const FileData* fd);
+        bool saveFileInner(FileHeader* header, const FileDatas* fds);
+        bool saveFileInner(FileHeader* header, const FileData* fd);
         
         bool readFile(Stream* stream, const FileHeader* header, uint32_t packetNo, uint32_t packetLength) const;
         
     protected:
         static uint32_t calcPacketCount(FileHeader* header, uint32_t packetLength);
         
+    private:
+        // Hashes the packets saved in order, the md5 is set to header at the last one.
+        void hashPacket(FileHeader* header, const FileData* fd);
+        
     private:
         FileHeader _header;
         FileDatas _fds;
         
+        Mutex _hashMutex;
+        Crypto::HashContext _hash;
+        String _hashFileName;       // empty if the packets are not in order.
+        uint32_t _hashPacketNo;     // the next packet to be hashed.
+        
     private:
         static FileInstructionEntry* _instance;
     };
@@ -568,6 +568,7 @@ namespace Communication {
                         context->setPacketNo(i);
                         rcontext = dynamic_cast<C *>(_instructionPool->executeInstructionSync(id));
                         if (isSendSuccessfully(id->name(), rcontext)) {
+                            header->hashedmd5 = rcontext->header()->hashedmd5;
                             delete id;
 
                             if (entry != nullptr && entry->callback != nullptr) {
@@ -590,8 +591,10 @@ namespace Communication {
 
                     // check MD5.
                     if (packetCount > 0) {
-                        result = header->checkmd5(header->tempFullFileName()) ?
-                                 DownloadFileResult::Succeed : DownloadFileResult::MD5Failed;
+                        // the packets are hashed while they are saved, the file is read again if they are not in order.
+                        bool matched = !header->hashedmd5.isEmpty() ? header->matchmd5(header->hashedmd5) :
+                                       header->checkmd5(header->tempFullFileName());
+                        result = matched ? DownloadFileResult::Succeed : DownloadFileResult::MD5Failed;
                         if (result == DownloadFileResult::Succeed) {
                             String tempFileName = header->fullFileName();
                             if (File::move(header->tempFullFileName(), tempFileName)) {
@@ -9,14 +9,28 @@
 #ifndef ConfigService_h
 #define ConfigService_h
 
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include "data/String.h"
 #include "yml/YmlNode.h"
 #include "system/ServiceFactory.h"
+#include "system/Delegate.h"
+#include "configuration/ConfigSnapshot.h"
 
 using namespace Yml;
 using namespace System;
 
 namespace Config {
+    class ConfigChangedEventArgs : public EventArgs {
+    public:
+        ConfigChangedEventArgs(const ConfigSnapshot *snapshot, const StringArray &keys);
+
+    public:
+        const ConfigSnapshot *snapshot;
+        StringArray keys;       // added, removed or changed.
+    };
+
     class IConfigService : public IService {
     public:
         virtual const YmlNode::Properties &properties() const = 0;
@@ -25,6 +39,17 @@ namespace Config {
 
         virtual bool setProperty(const String &key, const String &value) = 0;
 
+        // The current snapshot of the properties, nullptr if they are read from properties().
+        // A replaced snapshot is still readable for a grace period, do not keep it longer,
+        // e.g. read the values of it at once, never hold it across a blocking call, a wait or a sleep.
+        virtual const ConfigSnapshot *snapshot() const;
+
+        // Resolves the key once, the handle reads the value in O(1) from the current snapshot later.
+        virtual ConfigHandle getHandle(const String &key);
+
+        // Invoked with ConfigChangedEventArgs after a new snapshot is published, nullptr if not supported.
+        virtual Delegates *changedDelegates();
+
         bool contains(const String &key) const;
 
         void printProperties() const;
@@ -55,6 +80,30 @@ namespace Config {
 
         bool getProperty(const String &key, double &value) const;
 
+        bool getProperty(const ConfigHandle &handle, String &value) const;
+
+        bool getProperty(const ConfigHandle &handle, bool &value) const;
+
+        bool getProperty(const ConfigHandle &handle, uint8_t &value) const;
+
+        bool getProperty(const ConfigHandle &handle, char &value) const;
+
+        bool getProperty(const ConfigHandle &handle, int16_t &value) const;
+
+        bool getProperty(const ConfigHandle &handle, uint16_t &value) const;
+
+        bool getProperty(const ConfigHandle &handle, int32_t &value) const;
+
+        bool getProperty(const ConfigHandle &handle, uint32_t &value) const;
+
+        bool getProperty(const ConfigHandle &handle, int64_t &value) const;
+
+        bool getProperty(const ConfigHandle &handle, uint64_t &value) const;
+
+        bool getProperty(const ConfigHandle &handle, float &value) const;
+
+        bool getProperty(const ConfigHandle &handle, double &value) const;
+
         template<class T>
         bool getProperty(const String &key, T &value) const {
             String str;
@@ -113,9 +162,27 @@ namespace Config {
 
         bool setProperty(const String &key, const String &value) override;
 
+        const ConfigSnapshot *snapshot() const override;
+
+        ConfigHandle getHandle(const String &key) override;
+
+        Delegates *changedDelegates() override;
+
     private:
         bool updateConfigFile(const YmlNode::Properties &properties) final;
 
+        // Compiles the properties to a new snapshot, the readers of the old one are not blocked.
+        void publish();
+
+        // Keeps the replaced snapshot for the grace period and deletes the expired ones, locked by _snapshotMutex.
+        void retire(const ConfigSnapshot *snapshot);
+
+        // Replaces the current snapshot with nullptr, it is retired, not deleted, it may be still read.
+        void retireSnapshot();
+
+        // Deletes all the snapshots, no reader is left, e.g. in the destructor.
+        void clearSnapshots();
+
         String fileName() const;
 
         String profileName() const;
@@ -153,8 +220,22 @@ namespace Config {
 
         StringMap _systemVariables;
 
+        struct Retired {
+            const ConfigSnapshot *snapshot;
+            uint64_t tick;
+        };
+
+        std::atomic<const ConfigSnapshot *> _snapshot;
+        // the replaced snapshots may be still read, they are deleted after RetiredTimeout.
+        std::vector<Retired> _retired;
+        uint64_t _version;
+        ConfigSnapshot::Indexes _indexes;
+        std::mutex _snapshotMutex;
+        Delegates _changedDelegates;
+
     private:
         static const ByteArray Sm4Key;
+        static const uint64_t RetiredTimeout = 10 * 1000;     // ms.
     };
 }
 
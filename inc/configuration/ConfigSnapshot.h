@@ -0,0 +1,152 @@
+//
+//  ConfigSnapshot.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef ConfigSnapshot_h
+#define ConfigSnapshot_h
+
+#include <vector>
+#include "data/String.h"
+#include "data/StringArray.h"
+#include "data/HashDictionary.h"
+#include "yml/YmlNode.h"
+
+using namespace Data;
+using namespace Yml;
+
+namespace Config {
+    class ConfigSnapshot;
+
+    // A key resolved once, it reads the value of any snapshot by the index, or by the key if it has no index.
+    class ConfigHandle {
+    public:
+        ConfigHandle();
+
+        ConfigHandle(const String &key, size_t index);
+
+        ConfigHandle(const ConfigHandle &other) = default;
+
+        ConfigHandle &operator=(const ConfigHandle &other) = default;
+
+        bool isEmpty() const;
+
+        const String &key() const;
+
+        size_t index() const;
+
+    public:
+        static const size_t NoIndex = SIZE_MAX;
+
+    private:
+        String _key;
+        size_t _index;
+    };
+
+    // The immutable properties, the values are parsed to all the types once, so the reads do not parse them again.
+    // The indexes of the keys are shared by all the snapshots of a service, a handle reads any of them.
+    class ConfigSnapshot {
+    public:
+        typedef HashDictionary<String, size_t, NullMutex> Indexes;
+
+        // The new keys of the properties are added to the indexes, the values equal to the base are not parsed again.
+        ConfigSnapshot(const YmlNode::Properties &properties, Indexes &indexes, uint64_t version = 0,
+                       const ConfigSnapshot *base = nullptr);
+
+        ConfigSnapshot(const ConfigSnapshot &) = delete;
+
+        ConfigSnapshot &operator=(const ConfigSnapshot &) = delete;
+
+        uint64_t version() const;
+
+        size_t count() const;
+
+        bool contains(const String &key) const;
+
+        // The handle of a key in this snapshot, or empty.
+        ConfigHandle getHandle(const String &key) const;
+
+        // The keys added, removed or changed from the other one.
+        void getChangedKeys(const ConfigSnapshot *other, StringArray &keys) const;
+
+        bool getValue(const String &key, String &value) const;
+
+        bool getValue(const ConfigHandle &handle, String &value) const;
+
+        bool getValue(const ConfigHandle &handle, bool &value) const;
+
+        bool getValue(const ConfigHandle &handle, uint8_t &value) const;
+
+        bool getValue(const ConfigHandle &handle, char &value) const;
+
+        bool getValue(const ConfigHandle &handle, int16_t &value) const;
+
+        bool getValue(const ConfigHandle &handle, uint16_t &value) const;
+
+        bool getValue(const ConfigHandle &handle, int32_t &value) const;
+
+        bool getValue(const ConfigHandle &handle, uint32_t &value) const;
+
+        bool getValue(const ConfigHandle &handle, int64_t &value) const;
+
+        bool getValue(const ConfigHandle &handle, uint64_t &value) const;
+
+        bool getValue(const ConfigHandle &handle, float &value) const;
+
+        bool getValue(const ConfigHandle &handle, double &value) const;
+
+        template<class T>
+        bool getValue(const String &key, T &value) const {
+            return getValue(getHandle(key), value);
+        }
+
+    private:
+        enum Type : uint16_t {
+            TypeText = 0x0001,
+            TypeBool = 0x0002,
+            TypeByte = 0x0004,
+            TypeChar = 0x0008,
+            TypeInt16 = 0x0010,
+            TypeUInt16 = 0x0020,
+            TypeInt32 = 0x0040,
+            TypeUInt32 = 0x0080,
+            TypeInt64 = 0x0100,
+            TypeUInt64 = 0x0200,
+            TypeFloat = 0x0400,
+            TypeDouble = 0x0800
+        };
+
+        struct Value {
+            String text;
+            uint16_t types;     // the types parsed successfully, 0 if the key is not in this snapshot.
+            bool boolValue;
+            uint8_t byteValue;
+            char charValue;
+            int16_t int16Value;
+            uint16_t uint16Value;
+            int32_t int32Value;
+            uint32_t uint32Value;
+            int64_t int64Value;
+            uint64_t uint64Value;
+            float floatValue;
+            double doubleValue;
+
+            Value();
+
+            void parse(const String &str);
+        };
+
+        const Value *find(const ConfigHandle &handle, Type type) const;
+
+    private:
+        Indexes _indexes;
+        std::vector<Value> _values;
+        size_t _count;
+        uint64_t _version;
+    };
+}
+
+#endif // ConfigSnapshot_h
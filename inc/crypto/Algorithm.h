@@ -11,6 +11,7 @@
 
 #include "data/Vector.h"
 #include "data/ByteArray.h"
+#include "data/StringArray.h"
 #include <openssl/ec.h>
 #include <openssl/evp.h>
 
@@ -22,7 +23,8 @@ namespace Crypto {
         ECB = 1,
         OFB = 2,
         CFB = 3,
-        CTR = 4
+        CTR = 4,
+        GCM = 5
     };
 
     enum PaddingMode {
@@ -53,6 +55,8 @@ namespace Crypto {
         }
     };
 
+    class CipherContext;
+
     class SymmetricAlgorithm {
     public:
         // The key size, in bits
@@ -64,6 +68,7 @@ namespace Crypto {
         virtual int feedbackSize() const;
 
     public:
+        // The messages of GCM are encrypted with a random nonce each, it precedes the cipher text and the tag.
         bool encrypt(const ByteArray &data, ByteArray &output);
 
         bool decrypt(const ByteArray &data, ByteArray &output);
@@ -124,6 +129,14 @@ namespace Crypto {
 
         void generateIV();
 
+    private:
+        // The IV precedes the cipher text in output if withIV.
+        bool encrypt(const ByteArray &key, const ByteArray &iv, const uint8_t *data, size_t count,
+                     ByteArray &output, CypherMode mode, bool withIV);
+
+        bool decrypt(const ByteArray &key, const ByteArray &iv, const uint8_t *data, size_t count,
+                     ByteArray &output, CypherMode mode);
+
     protected:
         ByteArray _key;
         ByteArray _iv;
@@ -133,12 +146,79 @@ namespace Crypto {
 
         Vector<KeySizes> _legalBlockSizes;
         Vector<KeySizes> _legalKeySizes;
+
+    private:
+        friend CipherContext;
+    };
+
+    // A cipher of an algorithm kept for many messages, so the key is set up once, not for each of them.
+    // Each message is init with an IV, updated by its parts, then final; it is not copied if output is input.
+    // The GCM messages are authenticated by the tag, get it after final when encrypting, set it before when decrypting.
+    class CipherContext {
+    public:
+        // Takes the key, IV, mode and padding of algorithm.
+        CipherContext(const SymmetricAlgorithm &algorithm, bool encrypt);
+
+        ~CipherContext();
+
+        CipherContext(const CipherContext &) = delete;
+
+        CipherContext &operator=(const CipherContext &) = delete;
+
+        bool isValid() const;
+
+        // Starts a message with the IV of the algorithm.
+        // The encryption of CTR, OFB, CFB and GCM needs a new IV for each message, it returns false.
+        bool init();
+
+        // The encryption of CTR, OFB, CFB and GCM returns false if iv is the one of the last message.
+        bool init(const ByteArray &iv);
+
+        bool init(const uint8_t *iv, size_t count);
+
+        // The additional authenticated data of GCM, before the update of the message.
+        bool updateAad(const uint8_t *data, size_t count);
+
+        // output holds count + blockSize bytes at least, it can be input.
+        bool update(const uint8_t *input, size_t count, uint8_t *output, size_t &length);
+
+        // output holds blockSize bytes at least.
+        bool final(uint8_t *output, size_t &length);
+
+        bool getTag(uint8_t *tag, size_t count = TagSize);
+
+        bool setTag(const uint8_t *tag, size_t count = TagSize);
+
+        // The block size, in bytes.
+        size_t blockSize() const;
+
+    public:
+        static const size_t TagSize = 16;
+
+    private:
+        friend SymmetricAlgorithm;
+
+        CipherContext(const EVP_CIPHER *cipher, const ByteArray &key, const ByteArray &iv,
+                      PaddingMode padding, bool encrypt);
+
+        bool setIV(const uint8_t *iv, size_t count);
+
+    private:
+        EVP_CIPHER_CTX *_context;
+        ByteArray _iv;
+        PaddingMode _padding;
+        bool _encrypt;
+        bool _gcm;
+        bool _stream;       // the key stream is repeated if the IV is reused.
+        ByteArray _lastIV;
     };
 
     class AsymmetricAlgorithm {
 
     };
 
+    class HashContext;
+
     class HashAlgorithm {
     public:
         // The hash size, in bits
@@ -154,10 +234,54 @@ namespace Crypto {
 
         bool computeFileHash(const String &path, String &output);
 
+        // Hashes the files on threadCount threads, 0 for the cores, the outputs are in the order of paths.
+        // The output of a file failed is empty, and false is returned.
+        bool computeFileHashes(const StringArray &paths, StringArray &outputs, int threadCount = 0);
+
+    public:
+        // The read size of the files.
+        static const size_t FileBufferSize = 1024 * 1024;
+
     protected:
         HashAlgorithm();
 
         virtual const EVP_MD *type() const = 0;
+
+    private:
+        friend HashContext;
+    };
+
+    // The incremental hashing of an algorithm, init once, update by the parts of the data, then final.
+    // It can be init again after final.
+    class HashContext {
+    public:
+        explicit HashContext(const HashAlgorithm &algorithm);
+
+        ~HashContext();
+
+        HashContext(const HashContext &) = delete;
+
+        HashContext &operator=(const HashContext &) = delete;
+
+        bool init();
+
+        bool update(const uint8_t *data, size_t count);
+
+        bool update(const ByteArray &data);
+
+        bool update(const String &data);
+
+        bool final(ByteArray &output);
+
+        bool final(String &output);
+
+        // Whether init is called and final is not.
+        bool isStarted() const;
+
+    private:
+        const EVP_MD *_type;
+        EVP_MD_CTX *_context;
+        bool _started;
     };
 }
 
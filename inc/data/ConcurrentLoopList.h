@@ -0,0 +1,351 @@
+//
+//  ConcurrentLoopList.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef ConcurrentLoopList_h
+#define ConcurrentLoopList_h
+
+#include <atomic>
+#include <cinttypes>
+#include <sys/types.h>
+#include "system/OsDefine.h"
+
+namespace Data {
+    // Shared by the lock free loop lists, the size is rounded up to a power of 2.
+    class LoopRing {
+    public:
+        static size_t roundSize(size_t size) {
+            if (size < MinSize || size > MaxSize) {
+                size = DefaultSize;
+            }
+            size_t result = MinSize;
+            while (result < size) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    public:
+        static const size_t CacheLineSize = 64;
+
+    protected:
+        static const size_t DefaultSize = 1024;         // 1K
+        static const size_t MinSize = 16;               // 16 Bytes
+        static const size_t MaxSize = 16 * 1024 * 1024; // 16 M
+    };
+
+    // Lock free bounded queue for one producer thread and one consumer thread.
+    // Unlike LoopVector, enqueue fails instead of overwriting the oldest value when it is full.
+    template<typename type>
+    class SpscLoopVector : public LoopRing {
+    public:
+        explicit SpscLoopVector(size_t size = DefaultSize) : _head(0), _tail(0), _cachedTail(0), _cachedHead(0) {
+            _size = roundSize(size);
+            _mask = _size - 1;
+            _array = new type[_size];
+        }
+
+        ~SpscLoopVector() {
+            delete[] _array;
+            _array = nullptr;
+        }
+
+        SpscLoopVector(const SpscLoopVector &) = delete;
+
+        SpscLoopVector &operator=(const SpscLoopVector &) = delete;
+
+        inline size_t size() const {
+            return _size;
+        }
+
+        // Producer only.
+        inline bool enqueue(const type &value) {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cachedHead >= _size) {
+                _cachedHead = _head.load(std::memory_order_acquire);
+                if (tail - _cachedHead >= _size) {
+                    return false;
+                }
+            }
+            _array[tail & _mask] = value;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer only.
+        inline bool dequeue(type &value) {
+            return dequeue(&value, 1) == 1;
+        }
+
+        // Consumer only, returns the number of the dequeued values.
+        inline size_t dequeue(type *values, size_t count) {
+            size_t head = _head.load(std::memory_order_relaxed);
+            if (_cachedTail - head < count) {
+                _cachedTail = _tail.load(std::memory_order_acquire);
+            }
+            size_t available = _cachedTail - head;
+            if (count > available) {
+                count = available;
+            }
+            for (size_t i = 0; i < count; i++) {
+                values[i] = std::move(_array[(head + i) & _mask]);
+            }
+            if (count > 0) {
+                _head.store(head + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        inline bool isEmpty() const {
+            return count() == 0;
+        }
+
+        inline bool isFull() const {
+            return count() >= _size;
+        }
+
+        // Approximate while the other side is running.
+        inline size_t count() const {
+            size_t head = _head.load(std::memory_order_acquire);
+            size_t tail = _tail.load(std::memory_order_acquire);
+            return tail - head;
+        }
+
+        // Consumer only, copy the values without dequeuing them.
+        inline void copyTo(type *values) const {
+            size_t head = _head.load(std::memory_order_relaxed);
+            size_t tail = _tail.load(std::memory_order_acquire);
+            for (size_t i = head; i != tail; i++) {
+                *values++ = _array[i & _mask];
+            }
+        }
+
+    private:
+        size_t _size;
+        size_t _mask;
+        type *_array;
+
+        char _pad0[CacheLineSize];
+        std::atomic<size_t> _head;       // written by the consumer.
+        char _pad1[CacheLineSize - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t> _tail;       // written by the producer.
+        char _pad2[CacheLineSize - sizeof(std::atomic<size_t>)];
+        size_t _cachedTail;              // consumer side copy of _tail.
+        char _pad3[CacheLineSize - sizeof(size_t)];
+        size_t _cachedHead;              // producer side copy of _head.
+        char _pad4[CacheLineSize - sizeof(size_t)];
+    };
+
+    // Lock free bounded queue for any number of producer and consumer threads, every cell has a sequence number.
+    // Unlike LoopVector, enqueue fails instead of overwriting the oldest value when it is full.
+    template<typename type>
+    class MpmcLoopVector : public LoopRing {
+    public:
+        explicit MpmcLoopVector(size_t size = DefaultSize) : _head(0), _tail(0) {
+            _size = roundSize(size);
+            _mask = _size - 1;
+            _cells = new Cell[_size];
+            for (size_t i = 0; i < _size; i++) {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~MpmcLoopVector() {
+            delete[] _cells;
+            _cells = nullptr;
+        }
+
+        MpmcLoopVector(const MpmcLoopVector &) = delete;
+
+        MpmcLoopVector &operator=(const MpmcLoopVector &) = delete;
+
+        inline size_t size() const {
+            return _size;
+        }
+
+        inline bool enqueue(const type &value) {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            while (true) {
+                Cell &cell = _cells[tail & _mask];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t) sequence - (intptr_t) tail;
+                if (diff == 0) {
+                    if (_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                        cell.value = value;
+                        cell.sequence.store(tail + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    // full.
+                    return false;
+                } else {
+                    tail = _tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        inline bool dequeue(type &value) {
+            return dequeue(&value, 1) == 1;
+        }
+
+        // Claim up to count ready cells with one CAS, returns the number of the dequeued values.
+        inline size_t dequeue(type *values, size_t count) {
+            if (count == 0) {
+                return 0;
+            }
+            size_t head = _head.load(std::memory_order_relaxed);
+            while (true) {
+                size_t ready = 0;
+                while (ready < count) {
+                    size_t position = head + ready;
+                    size_t sequence = _cells[position & _mask].sequence.load(std::memory_order_acquire);
+                    if (sequence != position + 1) {
+                        break;
+                    }
+                    ready++;
+                }
+                if (ready == 0) {
+                    size_t sequence = _cells[head & _mask].sequence.load(std::memory_order_acquire);
+                    if ((intptr_t) sequence - (intptr_t) (head + 1) < 0) {
+                        // empty.
+                        return 0;
+                    }
+                    // taken by another consumer.
+                    head = _head.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if (_head.compare_exchange_weak(head, head + ready, std::memory_order_relaxed)) {
+                    for (size_t i = 0; i < ready; i++) {
+                        Cell &cell = _cells[(head + i) & _mask];
+                        values[i] = std::move(cell.value);
+                        cell.sequence.store(head + i + _size, std::memory_order_release);
+                    }
+                    return ready;
+                }
+            }
+        }
+
+        inline bool isEmpty() const {
+            return count() == 0;
+        }
+
+        inline bool isFull() const {
+            return count() >= _size;
+        }
+
+        // Approximate while the producers or the consumers are running.
+        inline size_t count() const {
+            size_t head = _head.load(std::memory_order_acquire);
+            size_t tail = _tail.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        // Copy the completed values without dequeuing them, it is not a snapshot while the others are running.
+        inline size_t copyTo(type *values) const {
+            size_t head = _head.load(std::memory_order_acquire);
+            size_t tail = _tail.load(std::memory_order_acquire);
+            size_t count = 0;
+            for (size_t i = head; i < tail; i++) {
+                const Cell &cell = _cells[i & _mask];
+                if (cell.sequence.load(std::memory_order_acquire) != i + 1) {
+                    break;
+                }
+                values[count++] = cell.value;
+            }
+            return count;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            type value;
+        };
+
+        size_t _size;
+        size_t _mask;
+        Cell *_cells;
+
+        char _pad0[CacheLineSize];
+        std::atomic<size_t> _head;
+        char _pad1[CacheLineSize - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t> _tail;
+        char _pad2[CacheLineSize - sizeof(std::atomic<size_t>)];
+    };
+
+    // Lock free variant of LoopPList, the dequeued pointers are owned by the caller.
+    template<class type>
+    class MpmcLoopPList : public LoopRing {
+    public:
+        explicit MpmcLoopPList(size_t size = DefaultSize, bool autoDelete = true) : _values(size),
+                                                                                     _autoDelete(autoDelete) {
+        }
+
+        ~MpmcLoopPList() {
+            clear();
+        }
+
+        inline size_t size() const {
+            return _values.size();
+        }
+
+        inline bool enqueue(const type *value) {
+            return _values.enqueue((type *) value);
+        }
+
+        inline type *dequeue() {
+            type *value = nullptr;
+            return _values.dequeue(value) ? value : nullptr;
+        }
+
+        inline size_t dequeue(type **values, size_t count) {
+            return _values.dequeue(values, count);
+        }
+
+        inline bool empty() const {
+            return _values.isEmpty();
+        }
+
+        inline bool full() const {
+            return _values.isFull();
+        }
+
+        inline size_t count() const {
+            return _values.count();
+        }
+
+        inline size_t copyTo(type **values) const {
+            return _values.copyTo(values);
+        }
+
+        inline void setAutoDelete(bool autoDelete) {
+            _autoDelete = autoDelete;
+        }
+
+        inline bool autoDelete() const {
+            return _autoDelete;
+        }
+
+        // Dequeue all of the values, delete them if autoDelete.
+        inline void clear() {
+            type *values[64];
+            size_t count;
+            while ((count = _values.dequeue(values, 64)) > 0) {
+                if (_autoDelete) {
+                    for (size_t i = 0; i < count; i++) {
+                        delete values[i];
+                    }
+                }
+            }
+        }
+
+    private:
+        MpmcLoopVector<type *> _values;
+        bool _autoDelete;
+    };
+}
+
+#endif // ConcurrentLoopList_h
@@ -66,10 +66,11 @@ namespace Data {
         }
     };
 
-    template<typename TKey, typename TValue>
-    class Dictionary : public IEquatable<Dictionary<TKey, TValue>>,
-                       public IEvaluation<Dictionary<TKey, TValue>>,
-                       public IComparable<Dictionary<TKey, TValue>>,
+    // TMutex is NullMutex if the dictionary is only used by one thread.
+    template<typename TKey, typename TValue, class TMutex = Mutex>
+    class Dictionary : public IEquatable<Dictionary<TKey, TValue, TMutex>>,
+                       public IEvaluation<Dictionary<TKey, TValue, TMutex>>,
+                       public IComparable<Dictionary<TKey, TValue, TMutex>>,
                        public PairIterator<TKey, TValue>,
                        public IMutex {
     public:
@@ -196,14 +197,16 @@ namespace Data {
             return _map.erase(key) > 0;
         }
 
-        inline void keys(List<TKey> &k) const {
+        template<class M>
+        inline void keys(List<TKey, M> &k) const {
             auto it = _map.begin();
             for (; it != _map.end(); ++it) {
                 k.add(it->first);
             }
         }
 
-        inline void values(List<TValue> &v) const {
+        template<class M>
+        inline void values(List<TValue, M> &v) const {
             auto it = _map.begin();
             for (; it != _map.end(); ++it) {
                 v.add(it->second);
@@ -256,7 +259,7 @@ namespace Data {
 
     private:
         std::map<TKey, TValue> _map;
-        Mutex _mutex;
+        TMutex _mutex;
     };
 }
 
@@ -0,0 +1,482 @@
+//
+//  HashDictionary.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef HashDictionary_h
+#define HashDictionary_h
+
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "data/List.h"
+#include "data/String.h"
+#include "data/DataInterface.h"
+
+using namespace Threading;
+
+namespace Data {
+    template<typename T>
+    struct HashCode {
+        static size_t hash(const T &value) {
+            return std::hash<T>()(value);
+        }
+    };
+
+    template<>
+    struct HashCode<String> {
+        static size_t hash(const String &value) {
+            return value.hashCode();
+        }
+    };
+
+    // Flat hash map with open addressing and linear probing, the keys are not ordered.
+    // Use Dictionary or keys(k, true) if the order of the keys is needed.
+    // TMutex is NullMutex if the dictionary is only used by one thread.
+    template<typename TKey, typename TValue, class TMutex = Mutex>
+    class HashDictionary : public IEquatable<HashDictionary<TKey, TValue, TMutex>>,
+                           public IEvaluation<HashDictionary<TKey, TValue, TMutex>>,
+                           public IMutex {
+    private:
+        struct Node {
+            TKey key;
+            TValue value;
+
+            Node(const TKey &key, const TValue &value) : key(key), value(value) {
+            }
+        };
+
+    public:
+        typedef pair<const TKey, TValue> ValueType;
+
+        class const_iterator {
+        public:
+            const TKey &key() const {
+                return _owner->_nodes[_index].key;
+            }
+
+            const TValue &value() const {
+                return _owner->_nodes[_index].value;
+            }
+
+            inline const_iterator &operator++() {
+                _index = _owner->next(_index + 1);
+                return *this;
+            }
+
+            inline bool operator==(const const_iterator &other) const {
+                return _index == other._index;
+            }
+
+            inline bool operator!=(const const_iterator &other) const {
+                return _index != other._index;
+            }
+
+        private:
+            const_iterator(const HashDictionary *owner, size_t index) : _owner(owner), _index(index) {
+            }
+
+        private:
+            const HashDictionary *_owner;
+            size_t _index;
+
+            friend HashDictionary;
+        };
+
+        class iterator {
+        public:
+            const TKey &key() const {
+                return _owner->_nodes[_index].key;
+            }
+
+            TValue &value() const {
+                return _owner->_nodes[_index].value;
+            }
+
+            inline iterator &operator++() {
+                _index = _owner->next(_index + 1);
+                return *this;
+            }
+
+            inline bool operator==(const iterator &other) const {
+                return _index == other._index;
+            }
+
+            inline bool operator!=(const iterator &other) const {
+                return _index != other._index;
+            }
+
+            inline operator const_iterator() const {
+                return const_iterator(_owner, _index);
+            }
+
+        private:
+            iterator(HashDictionary *owner, size_t index) : _owner(owner), _index(index) {
+            }
+
+        private:
+            HashDictionary *_owner;
+            size_t _index;
+
+            friend HashDictionary;
+        };
+
+        explicit HashDictionary(size_t capacity = 0) : _hashes(nullptr), _nodes(nullptr), _capacity(0), _count(0),
+                                                       _shift(0) {
+            if (capacity > 0) {
+                reserve(capacity);
+            }
+        }
+
+        HashDictionary(const HashDictionary &other) : HashDictionary(other._count) {
+            addRange(other);
+        }
+
+        HashDictionary(HashDictionary &&other) noexcept: _hashes(other._hashes), _nodes(other._nodes),
+                                                         _capacity(other._capacity), _count(other._count),
+                                                         _shift(other._shift) {
+            other._hashes = nullptr;
+            other._nodes = nullptr;
+            other._capacity = 0;
+            other._count = 0;
+            other._shift = 0;
+        }
+
+        HashDictionary(std::initializer_list<ValueType> list) : HashDictionary(list.size()) {
+            for (auto it = list.begin(); it != list.end(); ++it) {
+                add(it->first, it->second);
+            }
+        }
+
+        ~HashDictionary() override {
+            clear();
+            ::operator delete(_nodes);
+            delete[] _hashes;
+        }
+
+        inline bool equals(const HashDictionary &other) const override {
+            if (_count != other._count) {
+                return false;
+            }
+            for (auto it = begin(); it != end(); ++it) {
+                size_t index = other.indexOf(it.key());
+                if (index == NotFound || !(other._nodes[index].value == it.value())) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline void evaluates(const HashDictionary &other) override {
+            if (this != &other) {
+                clear();
+                addRange(other);
+            }
+        }
+
+        inline HashDictionary &operator=(const HashDictionary &other) {
+            evaluates(other);
+            return *this;
+        }
+
+        // Make room for count entries without rehashing.
+        inline void reserve(size_t count) {
+            size_t capacity = MinCapacity;
+            while (capacity * MaxLoad / 100 < count) {
+                capacity <<= 1;
+            }
+            if (capacity > _capacity) {
+                rehash(capacity);
+            }
+        }
+
+        inline void add(const TKey &key, const TValue &value) {
+            size_t hash = hashOf(key);
+            size_t index = indexOf(key, hash);
+            if (index != NotFound) {
+                _nodes[index].value = value;
+            } else {
+                insert(hash, key, value);
+            }
+        }
+
+        inline void addRange(const HashDictionary &other) {
+            reserve(_count + other._count);
+            for (auto it = other.begin(); it != other.end(); ++it) {
+                add(it.key(), it.value());
+            }
+        }
+
+        inline bool contains(const TKey &key) const {
+            return indexOf(key) != NotFound;
+        }
+
+        inline bool contains(const TKey &key, const TValue &value) const {
+            size_t index = indexOf(key);
+            return index != NotFound && _nodes[index].value == value;
+        }
+
+        inline void clear() {
+            for (size_t i = 0; i < _capacity; i++) {
+                if (_hashes[i] != Empty) {
+                    _nodes[i].~Node();
+                    _hashes[i] = Empty;
+                }
+            }
+            _count = 0;
+        }
+
+        inline size_t count() const {
+            return _count;
+        }
+
+        inline bool isEmpty() const {
+            return _count == 0;
+        }
+
+        inline bool at(const TKey &key, TValue &value) const {
+            size_t index = indexOf(key);
+            if (index != NotFound) {
+                value = _nodes[index].value;
+                return true;
+            }
+            return false;
+        }
+
+        inline TValue &at(const TKey &key) {
+            size_t index = indexOf(key);
+            if (index != NotFound) {
+                return _nodes[index].value;
+            }
+            static TValue value;
+            return value;
+        }
+
+        inline const TValue &at(const TKey &key) const {
+            size_t index = indexOf(key);
+            if (index != NotFound) {
+                return _nodes[index].value;
+            }
+            static TValue value;
+            return value;
+        }
+
+        inline const TValue &operator[](const TKey &key) const {
+            return at(key);
+        }
+
+        inline TValue &operator[](const TKey &key) {
+            size_t hash = hashOf(key);
+            size_t index = indexOf(key, hash);
+            if (index == NotFound) {
+                index = insert(hash, key, TValue());
+            }
+            return _nodes[index].value;
+        }
+
+        inline bool set(const TKey &key, const TValue &value) {
+            size_t index = indexOf(key);
+            if (index == NotFound) {
+                return false;
+            }
+            _nodes[index].value = value;
+            return true;
+        }
+
+        inline bool remove(const TKey &key) {
+            size_t index = indexOf(key);
+            if (index == NotFound) {
+                return false;
+            }
+
+            _nodes[index].~Node();
+            _hashes[index] = Empty;
+            _count--;
+
+            // backward shift, so the lookups never need tombstones.
+            size_t mask = _capacity - 1;
+            size_t hole = index;
+            for (size_t i = (index + 1) & mask; _hashes[i] != Empty; i = (i + 1) & mask) {
+                size_t home = bucketOf(_hashes[i]);
+                if (((i - home) & mask) >= ((i - hole) & mask)) {
+                    new(&_nodes[hole]) Node(std::move(_nodes[i]));
+                    _hashes[hole] = _hashes[i];
+                    _nodes[i].~Node();
+                    _hashes[i] = Empty;
+                    hole = i;
+                }
+            }
+            return true;
+        }
+
+        template<class M>
+        inline void keys(List<TKey, M> &k, bool ordered = false) const {
+            if (ordered) {
+                std::vector<size_t> indexes = orderedIndexes();
+                for (size_t i = 0; i < indexes.size(); i++) {
+                    k.add(_nodes[indexes[i]].key);
+                }
+            } else {
+                for (auto it = begin(); it != end(); ++it) {
+                    k.add(it.key());
+                }
+            }
+        }
+
+        // The values are ordered by the keys if ordered is true.
+        template<class M>
+        inline void values(List<TValue, M> &v, bool ordered = false) const {
+            if (ordered) {
+                std::vector<size_t> indexes = orderedIndexes();
+                for (size_t i = 0; i < indexes.size(); i++) {
+                    v.add(_nodes[indexes[i]].value);
+                }
+            } else {
+                for (auto it = begin(); it != end(); ++it) {
+                    v.add(it.value());
+                }
+            }
+        }
+
+        inline const_iterator begin() const {
+            return const_iterator(this, next(0));
+        }
+
+        inline const_iterator end() const {
+            return const_iterator(this, _capacity);
+        }
+
+        inline iterator begin() {
+            return iterator(this, next(0));
+        }
+
+        inline iterator end() {
+            return iterator(this, _capacity);
+        }
+
+        void lock() override {
+            _mutex.lock();
+        }
+
+        bool tryLock() override {
+            return _mutex.tryLock();
+        }
+
+        void unlock() override {
+            _mutex.unlock();
+        }
+
+    private:
+        static size_t hashOf(const TKey &key) {
+            size_t hash = HashCode<TKey>::hash(key);
+            return hash != Empty ? hash : 1;
+        }
+
+        // Fibonacci hashing, spread the sequential keys over the buckets.
+        inline size_t bucketOf(size_t hash) const {
+            return (size_t) (((uint64_t) hash * 0x9E3779B97F4A7C15ULL) >> _shift);
+        }
+
+        inline size_t indexOf(const TKey &key) const {
+            return indexOf(key, hashOf(key));
+        }
+
+        inline size_t indexOf(const TKey &key, size_t hash) const {
+            if (_count == 0) {
+                return NotFound;
+            }
+            size_t mask = _capacity - 1;
+            for (size_t i = bucketOf(hash); _hashes[i] != Empty; i = (i + 1) & mask) {
+                if (_hashes[i] == hash && _nodes[i].key == key) {
+                    return i;
+                }
+            }
+            return NotFound;
+        }
+
+        inline size_t insert(size_t hash, const TKey &key, const TValue &value) {
+            if ((_count + 1) * 100 > _capacity * MaxLoad) {
+                rehash(_capacity > 0 ? _capacity << 1 : MinCapacity);
+            }
+            size_t index = place(hash);
+            new(&_nodes[index]) Node(key, value);
+            _count++;
+            return index;
+        }
+
+        inline size_t place(size_t hash) {
+            size_t mask = _capacity - 1;
+            size_t i = bucketOf(hash);
+            while (_hashes[i] != Empty) {
+                i = (i + 1) & mask;
+            }
+            _hashes[i] = hash;
+            return i;
+        }
+
+        void rehash(size_t capacity) {
+            size_t *hashes = _hashes;
+            Node *nodes = _nodes;
+            size_t oldCapacity = _capacity;
+
+            _hashes = new size_t[capacity];
+            std::fill(_hashes, _hashes + capacity, (size_t) Empty);
+            _nodes = static_cast<Node *>(::operator new(sizeof(Node) * capacity));
+            _capacity = capacity;
+            _shift = 64;
+            while (capacity > 1) {
+                capacity >>= 1;
+                _shift--;
+            }
+
+            for (size_t i = 0; i < oldCapacity; i++) {
+                if (hashes[i] != Empty) {
+                    size_t index = place(hashes[i]);
+                    new(&_nodes[index]) Node(std::move(nodes[i]));
+                    nodes[i].~Node();
+                }
+            }
+            ::operator delete(nodes);
+            delete[] hashes;
+        }
+
+        inline size_t next(size_t index) const {
+            while (index < _capacity && _hashes[index] == Empty) {
+                index++;
+            }
+            return index < _capacity ? index : _capacity;
+        }
+
+        std::vector<size_t> orderedIndexes() const {
+            std::vector<size_t> indexes;
+            indexes.reserve(_count);
+            for (size_t i = next(0); i < _capacity; i = next(i + 1)) {
+                indexes.push_back(i);
+            }
+            const Node *nodes = _nodes;
+            std::sort(indexes.begin(), indexes.end(), [nodes](size_t a, size_t b) {
+                return nodes[a].key < nodes[b].key;
+            });
+            return indexes;
+        }
+
+    private:
+        static const size_t Empty = 0;
+        static const size_t NotFound = (size_t) -1;
+        static const size_t MinCapacity = 8;
+        static const size_t MaxLoad = 75;       // percent.
+
+        size_t *_hashes;
+        Node *_nodes;
+        size_t _capacity;
+        size_t _count;
+        int _shift;
+        TMutex _mutex;
+    };
+}
+
+#endif // HashDictionary_h
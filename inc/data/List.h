@@ -27,10 +27,11 @@ namespace Data {
     // copy constructor need to be implemented.
     // operator= need to be implemented.
     // IEvaluation and IEquatable interfaces need to be implemented.
-    template<typename type>
+    // TMutex is NullMutex if the list is only used by one thread.
+    template<typename type, class TMutex = Mutex>
     class List
-            : public IEquatable<List<type>>,
-              public IEvaluation<List<type>>,
+            : public IEquatable<List<type, TMutex>>,
+              public IEvaluation<List<type, TMutex>>,
               public Iterator<type *>,
               public IIndexable<const type &, type>,
               public IMutex {
@@ -509,52 +510,52 @@ namespace Data {
         typePtr *_array;
         size_t _capacity;
         size_t _count;
-        Mutex _mutex;
+        TMutex _mutex;
     };
 
     // type can be a struct or class.
     // operator= need to be implemented.
     // copy constructor need to be implemented.
     // IComparable interfaces need to be implemented.
-    template<typename type>
-    class SortedList : public List<type>, public ISortable<type *> {
+    template<typename type, class TMutex = Mutex>
+    class SortedList : public List<type, TMutex>, public ISortable<type *> {
     public:
-        using List<type>::data;
+        using List<type, TMutex>::data;
 
-        explicit SortedList(size_t capacity = List<type>::DefaultCapacity) : List<type>(capacity) {
+        explicit SortedList(size_t capacity = List<type, TMutex>::DefaultCapacity) : List<type, TMutex>(capacity) {
         }
 
-        SortedList(const SortedList &array) : List<type>(array) {
+        SortedList(const SortedList &array) : List<type, TMutex>(array) {
         }
 
-        SortedList(SortedList &&array) noexcept: List<type>(std::move(array)) {
+        SortedList(SortedList &&array) noexcept: List<type, TMutex>(std::move(array)) {
         }
 
         SortedList(const SortedList &array, off_t offset, size_t count) :
-                List<type>(array, offset, count) {
+                List<type, TMutex>(array, offset, count) {
         }
 
-        SortedList(const type *array, size_t count, size_t capacity = List<type>::DefaultCapacity) :
-                List<type>(array, count, capacity) {
+        SortedList(const type *array, size_t count, size_t capacity = List<type, TMutex>::DefaultCapacity) :
+                List<type, TMutex>(array, count, capacity) {
         }
 
-        SortedList(const type &value, size_t count) : List<type>(value, count) {
+        SortedList(const type &value, size_t count) : List<type, TMutex>(value, count) {
         }
 
-        SortedList(std::initializer_list<type> list) : List<type>(list) {
+        SortedList(std::initializer_list<type> list) : List<type, TMutex>(list) {
         }
 
         SortedList &operator=(const SortedList &other) {
-            List<type>::evaluates(other);
+            List<type, TMutex>::evaluates(other);
             return *this;
         }
 
         inline size_t count() const override {
-            return List<type>::count();
+            return List<type, TMutex>::count();
         }
 
-        inline typename List<type>::typePtr *data() override {
-            return List<type>::data();
+        inline typename List<type, TMutex>::typePtr *data() override {
+            return List<type, TMutex>::data();
         }
     };
 }
@@ -86,10 +86,10 @@ namespace Data {
             delete _array[_front];
 
             _front++;
-            if (_front >= _size) {
-                if(_front == _rear) {
-                    _rear = 0;
-                }
+            if (_front == _rear) {
+                // empty, same as makeNull.
+                _front = _rear = 0;
+            } else if (_front >= _size) {
                 _front = 0;
             }
 
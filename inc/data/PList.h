@@ -21,7 +21,8 @@
 using namespace Threading;
 
 namespace Data {
-    template<class type>
+    // TMutex is NullMutex if the list is only used by one thread.
+    template<class type, class TMutex = Mutex>
     class PList : public Iterator<type *>,
                   public IIndexGetter<type *>,
                   public ISortable<type *>,
@@ -442,7 +443,7 @@ namespace Data {
         bool _autoDelete;
         size_t _capacity;
         size_t _count;
-        Mutex _mutex;
+        TMutex _mutex;
     };
 
     template<class type>
@@ -12,6 +12,9 @@
 #include "data/Vector.h"
 #include "data/DataInterface.h"
 #include <string>
+#include <atomic>
+#include <cstdarg>
+#include <type_traits>
 
 namespace IO {
     class Stream;
@@ -60,7 +63,7 @@ namespace Data {
         static const String NA;     // Not applicable
 
         // Constructor & destructor
-        String(size_t capacity = 256);
+        String(size_t capacity = 0);
 
         String(const String &value);
 
@@ -98,6 +101,14 @@ namespace Data {
 
         size_t length() const;
 
+        size_t capacity() const;
+
+        // No more allocation until the length exceeds capacity.
+        void reserve(size_t capacity);
+
+        // FNV-1a hash of the characters, cached until the string is changed.
+        size_t hashCode() const;
+
         // Iterators
         const_iterator begin() const override;
 
@@ -140,7 +151,7 @@ namespace Data {
 
         void appendLine(const String &str, off_t offset, size_t count);
 
-        void appendFormat(const char *format, ...);
+        void appendFormat(const char *format, ...) COMMON_ATTR_PRINTF(2, 3);
 
         String replace(const String &src, const String &dst);
 
@@ -269,9 +280,16 @@ namespace Data {
 
         static bool fromBase64(const char *inputPtr, size_t inputLength, ByteArray &array);
 
-        static String convert(const char *format, ...);
+        static String convert(const char *format, ...) COMMON_ATTR_PRINTF(1, 2);
 
-        static String format(const char *format, ...);
+        static String format(const char *format, ...) COMMON_ATTR_PRINTF(1, 2);
+
+        // Appends the formatted args to str, the strings are passed by c_str(),
+        // the other class types are rejected at compile time.
+        template<class... Args>
+        static void formatTo(String &str, const char *format, const Args &... args) {
+            str.addFormat(format, formatArg(args)...);
+        }
 
         static bool isNullOrEmpty(const String &value);
 
@@ -306,8 +324,31 @@ namespace Data {
 
         void addString(char value);
 
+        void addFormat(const char *format, ...);
+
+        void addFormatV(const char *format, va_list ap);
+
         const char *getString() const;
 
+        template<class T>
+        static T formatArg(const T &value) {
+            static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value,
+                          "the format argument must be a number, a pointer or a string.");
+            return value;
+        }
+
+        static const char *formatArg(const char *value) {
+            return value;
+        }
+
+        static const char *formatArg(const String &value) {
+            return value.c_str();
+        }
+
+        static const char *formatArg(const std::string &value) {
+            return value.c_str();
+        }
+
         static size_t
         convertToBase64Array(char *outChars, const uint8_t *inData, off_t offset, size_t length, bool insertLineBreaks);
 
@@ -331,11 +372,18 @@ namespace Data {
         trimInner(const String &str, const Vector<char> &trimChars, TrimType trimType);
 
     private:
-        Vector<char> _buffer;
+        // the short strings are stored inline, no allocation.
+        static const size_t InlineCapacity = 23;
+
+        char *_value;       // _inline or the heap, always '\0' terminated.
+        size_t _length;
+        size_t _capacity;   // without '\0'.
+        char _inline[InlineCapacity + 1];
+        mutable std::atomic<size_t> _hashCode{0};     // relaxed, 0 if not calculated.
 
         static const char base64Table[65];
         static const size_t base64LineBreakPosition = 76;
-        static const int MaxFormatStrLength = 65535;
+        static const size_t FormatBufferLength = 256;
     };
 }
 
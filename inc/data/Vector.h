@@ -27,15 +27,16 @@ namespace Data {
     // copy constructor need to be implemented.
     // operator= need to be implemented.
     // IEvaluation and IEquatable interfaces need to be implemented.
-    template<typename type>
+    // TMutex is NullMutex if the vector is only used by one thread.
+    template<typename type, class TMutex = Mutex>
     class Vector
-            : public IEquatable<Vector<type>>,
-              public IEvaluation<Vector<type>>,
+            : public IEquatable<Vector<type, TMutex>>,
+              public IEvaluation<Vector<type, TMutex>>,
               public Iterator<type>,
               public IIndexable<const type &, type>,
               public IMutex {
     public:
-        explicit Vector(size_t capacity = DefaultCapacity) : _array(nullptr), _capacity(0), _count(0) {
+        explicit Vector(size_t capacity = DefaultCapacity) : _array(nullptr), _capacity(0), _size(0), _count(0) {
             setCapacity(capacity);
         }
 
@@ -46,8 +47,10 @@ namespace Data {
         Vector(Vector &&array) noexcept {
             _array = array._array;
             _count = array._count;
+            _size = array._size;
             _capacity = array._capacity;
             array._array = nullptr;
+            array._size = 0;
             array._count = 0;
         }
 
@@ -97,17 +100,12 @@ namespace Data {
 
         inline void setCapacity(size_t capacity = DefaultCapacity) {
             if (capacity > 0 && capacity != _capacity) {
+                _capacity = capacity;
                 if (count() == 0) {
-                    _capacity = capacity;
                     clear();
                 } else {
                     // have data.
-                    size_t size = this->size(_count, capacity);
-                    type *temp = _array;
-                    _array = new type[size];
-                    copy(_array, temp, _count);
-                    _capacity = capacity;
-                    delete[] temp;
+                    reserve(capacity);
                 }
             }
         }
@@ -119,6 +117,20 @@ namespace Data {
             return *this;
         }
 
+        Vector &operator=(Vector &&other) noexcept {
+            if (this != &other) {
+                deleteArray();
+                _array = other._array;
+                _count = other._count;
+                _size = other._size;
+                _capacity = other._capacity;
+                other._array = nullptr;
+                other._size = 0;
+                other._count = 0;
+            }
+            return *this;
+        }
+
         inline type &at(size_t pos) override {
             if (pos < _count) {
                 return _array[pos];
@@ -172,18 +184,17 @@ namespace Data {
 
         inline bool addRange(const type *array, size_t count) {
             if (count > 0) {
-                if (_count + count > this->size()) {
+                if (_count + count > _size) {
+                    // the items may be a part of this vector, copy them before the old ones are moved.
+                    size_t size = grownSize(_count + count);
                     type *temp = _array;
-                    size_t size = this->size(_count + count);
                     _array = new type[size];
-                    copy(_array, temp, _count);
                     copy(_array + _count, array, count);
+                    moveTo(_array, temp, _count);
                     zero(_array + (_count + count), size - _count - count);
                     delete[] temp;
+                    _size = size;
                 } else {
-                    if (canResize()) {
-                        autoResize();
-                    }
                     copy(_array + _count, array, count);
                 }
                 _count += count;
@@ -214,14 +225,21 @@ namespace Data {
 
         inline bool insertRange(size_t pos, const type *array, size_t count) {
             if (count > 0 && pos <= _count) {
-                size_t size = this->size(_count + count);
-                type *temp = _array;
-                _array = new type[size];
-                copy(_array, temp, pos);
-                copy(_array + pos, array, count);
-                copy(_array + (pos + count), temp + pos, _count - pos);
-                zero(_array + (_count + pos + count), size - _count - pos - count);
-                delete[] temp;
+                if (_count + count > _size || (array + count > _array && array < _array + _count)) {
+                    // grows, or the items are a part of this vector.
+                    size_t size = grownSize(_count + count);
+                    type *temp = _array;
+                    _array = new type[size];
+                    copy(_array + pos, array, count);
+                    moveTo(_array, temp, pos);
+                    moveTo(_array + (pos + count), temp + pos, _count - pos);
+                    zero(_array + (_count + count), size - _count - count);
+                    delete[] temp;
+                    _size = size;
+                } else {
+                    moveBackward(_array + (pos + count), _array + pos, _count - pos);
+                    copy(_array + pos, array, count);
+                }
                 _count += count;
 
                 return true;
@@ -301,14 +319,10 @@ namespace Data {
             makeNull();
         }
 
+        // No more allocation until the count exceeds size.
         inline void reserve(size_t size) {
-            if (size > this->size()) {
-                type *temp = _array;
-                size_t count = this->size(size);
-                _array = new type[count];
-                copy(_array, temp, _count);
-                zero(_array + _count, count - _count);
-                delete[] temp;
+            if (size > _size) {
+                reallocate(size);
             }
         }
 
@@ -406,36 +420,29 @@ namespace Data {
             _array = nullptr;
         }
 
-        inline void autoResize() {
-            if (canResize()) {
-                autoResize(_capacity);
-            }
-        }
-
-        inline void autoResize(size_t capacity) {
-            type *temp = _array;
-            _array = new type[_count + capacity];
-            copy(_array, temp, _count);
-            zero(_array + _count, capacity);
-            delete[] temp;
-        }
-
-        inline bool canResize() const {
-            return (_count > 0 && (_count % _capacity) == 0);
-        }
-
         inline void makeNull() {
             _count = 0;
-            _array = new type[_capacity];
-            zero(_array, _capacity);
+            _size = _capacity;
+            _array = new type[_size];
+            zero(_array, _size);
         }
 
-        inline size_t size() const {
-            return size(count(), capacity());
+        inline void reallocate(size_t size) {
+            type *temp = _array;
+            _array = new type[size];
+            moveTo(_array, temp, _count);
+            zero(_array + _count, size - _count);
+            delete[] temp;
+            _size = size;
         }
 
-        inline size_t size(size_t count) const {
-            return size(count, capacity());
+        // grows by 1.5 times at least, so the appends are amortized O(1).
+        inline size_t grownSize(size_t count) const {
+            size_t size = _size + _size / 2;
+            if (size < _capacity) {
+                size = _capacity;
+            }
+            return size > count ? size : count;
         }
 
         inline bool equalsValue(size_t pos, const type &value) const {
@@ -445,11 +452,6 @@ namespace Data {
             return false;
         }
 
-        static size_t size(size_t count, size_t capacity) {
-            size_t size = (count / capacity) + 1;
-            return size * capacity;
-        }
-
         static void copy(type *dst, const type *src, size_t count) {
             if (TypeInfo<type>::isComplex) {
                 for (size_t i = 0; i < count; i++) {
@@ -461,10 +463,34 @@ namespace Data {
             }
         }
 
-        static void move(type *dst, const type *src, size_t count) {
+        // into the new array, the items of src are left in the moved-from state.
+        static void moveTo(type *dst, type *src, size_t count) {
+            if (TypeInfo<type>::isComplex) {
+                for (size_t i = 0; i < count; i++) {
+                    dst[i].~type();
+                    new(&dst[i]) type(std::move(src[i]));
+                }
+            } else if (count > 0) {
+                memcpy((void *) dst, (const void *) src, sizeof(type) * count);
+            }
+        }
+
+        // dst is before src in the same array.
+        static void move(type *dst, type *src, size_t count) {
             if (TypeInfo<type>::isComplex) {
                 for (size_t i = 0; i < count; i++) {
-                    dst[i] = src[i];
+                    dst[i] = std::move(src[i]);
+                }
+            } else {
+                memmove((void *) dst, (const void *) src, sizeof(type) * count);
+            }
+        }
+
+        // dst is after src in the same array.
+        static void moveBackward(type *dst, type *src, size_t count) {
+            if (TypeInfo<type>::isComplex) {
+                for (size_t i = count; i > 0; i--) {
+                    dst[i - 1] = std::move(src[i - 1]);
                 }
             } else {
                 memmove((void *) dst, (const void *) src, sizeof(type) * count);
@@ -482,55 +508,56 @@ namespace Data {
 
     private:
         type *_array;
-        size_t _capacity;
+        size_t _capacity;   // the initial size of the array.
+        size_t _size;       // the allocated items.
         size_t _count;
-        Mutex _mutex;
+        TMutex _mutex;
     };
 
     // type can be a struct or class.
     // operator= need to be implemented.
     // copy constructor need to be implemented.
     // IComparable interfaces need to be implemented.
-    template<typename type>
-    class SortedVector : public Vector<type>, public ISortable<type> {
+    template<typename type, class TMutex = Mutex>
+    class SortedVector : public Vector<type, TMutex>, public ISortable<type> {
     public:
-        using Vector<type>::data;
+        using Vector<type, TMutex>::data;
 
-        explicit SortedVector(size_t capacity = Vector<type>::DefaultCapacity) : Vector<type>(capacity) {
+        explicit SortedVector(size_t capacity = Vector<type, TMutex>::DefaultCapacity) :
+                Vector<type, TMutex>(capacity) {
         }
 
-        SortedVector(const SortedVector &array) : Vector<type>(array) {
+        SortedVector(const SortedVector &array) : Vector<type, TMutex>(array) {
         }
 
-        SortedVector(SortedVector &&array) noexcept: Vector<type>(std::move(array)) {
+        SortedVector(SortedVector &&array) noexcept: Vector<type, TMutex>(std::move(array)) {
         }
 
-        SortedVector(const SortedVector &array, off_t offset, size_t count) : Vector<type>(array, offset, count) {
+        SortedVector(const SortedVector &array, off_t offset, size_t count) :
+                Vector<type, TMutex>(array, offset, count) {
         }
 
-        SortedVector(const type *array, size_t count, size_t capacity = Vector<type>::DefaultCapacity) : Vector<type>(
-                array,
-                count,
-                capacity) {
+        SortedVector(const type *array, size_t count, size_t capacity = Vector<type, TMutex>::DefaultCapacity) :
+                Vector<type, TMutex>(array, count, capacity) {
         }
 
-        SortedVector(const type &value, size_t count) : Vector<type>(value, count) {
+        SortedVector(const type &value, size_t count) : Vector<type, TMutex>(value, count) {
         }
 
-        SortedVector(std::initializer_list<type> list) : Vector<type>(list) {
+        SortedVector(std::initializer_list<type> list) : Vector<type, TMutex>(list) {
         }
 
         SortedVector &operator=(const SortedVector &other) {
-            Vector<type>::evaluates(other);
+            Vector<type, TMutex>::evaluates(other);
             return *this;
         }
 
         inline size_t count() const override {
-            return Vector<type>::count();
+            return Vector<type, TMutex>::count();
         }
 
         inline type *data() override {
-            return Vector<type>::data();
+            return Vector<type, TMutex>::data();
         }
     };
 }
@@ -12,6 +12,7 @@
 #include "data/Vector.h"
 #include "data/DataInterface.h"
 #include <string>
+#include <cstdarg>
 
 namespace IO {
     class Stream;
@@ -306,6 +307,8 @@ namespace Data {
 
         void addString(wchar_t value);
 
+        void addFormatV(const wchar_t *format, va_list ap);
+
         const wchar_t *getString() const;
 
     private:
@@ -321,7 +324,8 @@ namespace Data {
     private:
         Vector<wchar_t> _buffer;
 
-        static const int MaxFormatStrLength = 65535;
+        static const size_t FormatBufferLength = 256;
+        static const size_t MaxFormatStrLength = 65535;
     };
 }
 
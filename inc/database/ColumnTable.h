@@ -0,0 +1,199 @@
+//
+//  ColumnTable.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef ColumnTable_h
+#define ColumnTable_h
+
+#include <vector>
+#include "data/PList.h"
+#include "database/DataTable.h"
+
+namespace Database {
+    // Values of one column in a typed contiguous array, the nulls are kept in a bitmap.
+    // The texts are dictionary encoded, every distinct text is stored once.
+    class ColumnVector : public IEvaluation<ColumnVector>, public IEquatable<ColumnVector> {
+    public:
+        explicit ColumnVector(const DataColumn &column = DataColumn::Empty);
+
+        ColumnVector(const ColumnVector &other);
+
+        ~ColumnVector() override;
+
+        void evaluates(const ColumnVector &other) override;
+
+        bool equals(const ColumnVector &other) const override;
+
+        ColumnVector &operator=(const ColumnVector &other);
+
+        const DataColumn &column() const;
+
+        DbType type() const;
+
+        size_t count() const;
+
+        bool isNullValue(size_t pos) const;
+
+        DbValue value(size_t pos) const;
+
+        String valueStr(size_t pos, bool hasQuote = false) const;
+
+        void addNull();
+
+        // Converted to the type of the column.
+        void addValue(const DbValue &value);
+
+        void addInteger(int64_t value);
+
+        void addFloat(double value);
+
+        // Parsed as the type of the column unless it is a text column.
+        void addText(const char *text, size_t length);
+
+        void addBlob(const uint8_t *data, size_t length);
+
+        void reserve(size_t count);
+
+        void clear();
+
+        // The number of the distinct texts, the blobs are not deduplicated.
+        size_t entryCount() const;
+
+        // Bytes of the values, the null bitmap and the dictionary.
+        size_t memorySize() const;
+
+    private:
+        void addRaw(const DbValue::Value &value);
+
+        // the first _width bytes of value.
+        void addBytes(const void *value);
+
+        uint32_t addEntry(const char *data, size_t length, bool text);
+
+        uint32_t findText(const char *text, size_t length, uint64_t hash) const;
+
+        void rehash(size_t capacity);
+
+        bool isEntryType() const;
+
+        static size_t widthOf(DbType type);
+
+        static uint64_t hashOf(const char *text, size_t length);
+
+    private:
+        static const uint32_t NoEntry = 0;
+
+        DataColumn _column;
+        size_t _width;
+        size_t _count;
+
+        std::vector<uint8_t> _values;
+        std::vector<uint64_t> _nulls;
+
+        // texts are '\0' terminated, blobs have the big endian length of 4 bytes before them.
+        std::vector<char> _pool;
+        std::vector<uint64_t> _entries;
+        std::vector<uint32_t> _slots;    // open addressing, entry + 1.
+    };
+
+    class ColumnTable;
+
+    // View of one row of a ColumnTable, the values are created on the fly.
+    class ColumnRow : public IIndexGetter<DbValue>, public IPositionGetter<DbValue, const String &> {
+    public:
+        using IIndexGetter<DbValue>::operator[];
+        using IPositionGetter<DbValue, const String &>::operator[];
+
+        ColumnRow(const ColumnTable *table, size_t row);
+
+        DbValue at(size_t pos) const override;
+
+        DbValue at(const String &columnName) const override;
+
+        bool isNullValue(size_t pos) const;
+
+        String valueStr(size_t pos, bool hasQuote = false) const;
+
+        size_t cellCount() const;
+
+        size_t index() const;
+
+        DataRow toDataRow() const;
+
+    private:
+        const ColumnTable *_table;
+        size_t _row;
+    };
+
+    // Columnar variant of DataTable, for the large result sets.
+    class ColumnTable : public IEvaluation<ColumnTable>, public IEquatable<ColumnTable> {
+    public:
+        explicit ColumnTable(const String &name = String::Empty);
+
+        ColumnTable(const ColumnTable &table);
+
+        explicit ColumnTable(const DataTable &table);
+
+        ~ColumnTable() override;
+
+        void evaluates(const ColumnTable &other) override;
+
+        bool equals(const ColumnTable &other) const override;
+
+        ColumnTable &operator=(const ColumnTable &other);
+
+        const String &name() const;
+
+        void setName(const String &name);
+
+        void addColumn(const DataColumn &column);
+
+        void addColumns(const DataColumns &columns);
+
+        const DataColumns &columns() const;
+
+        size_t columnCount() const;
+
+        ssize_t indexOf(const String &columnName) const;
+
+        ColumnVector &at(size_t pos);
+
+        const ColumnVector &at(size_t pos) const;
+
+        size_t rowCount() const;
+
+        ColumnRow row(size_t pos) const;
+
+        DbValue value(size_t row, size_t column) const;
+
+        void addRow(const DataRow &row);
+
+        void addRows(const DataRows &rows);
+
+        void reserve(size_t rowCount);
+
+        void clear();
+
+        void clearRows();
+
+        int totalCount() const;
+
+        void setTotalCount(int totalCount);
+
+        size_t memorySize() const;
+
+        void toDataTable(DataTable &table) const;
+
+    private:
+        String _name;
+        DataColumns _columns;
+        PList<ColumnVector, NullMutex> _vectors;
+        int _totalCount;
+    };
+}
+
+#endif // ColumnTable_h
@@ -9,10 +9,13 @@
 #ifndef DbClient_h
 #define DbClient_h
 
+#include <atomic>
 #include "thread/Mutex.h"
 #include "data/String.h"
 #include "data/StringMap.h"
 #include "database/DataTable.h"
+#include "database/ColumnTable.h"
+#include "database/DbCursor.h"
 #include "net/NetType.h"
 
 using namespace Data;
@@ -46,6 +49,13 @@ namespace Database {
 
         virtual bool executeSqlQuery(const String &sql, DataTable &table) = 0;
 
+        // Queries into the columnar table, the default one converts from a DataTable.
+        virtual bool executeSqlQuery(const String &sql, ColumnTable &table);
+
+        // Returns a cursor which must be deleted by the caller, or nullptr on error.
+        // The default one materializes the whole result first.
+        virtual DbCursor *executeSqlCursor(const String &sql, size_t batchSize = DbCursor::DefaultBatchSize);
+
         virtual bool executeSqlInsert(const DataTable &table, bool transaction) = 0;
 
         virtual bool executeSqlReplace(const DataTable &table, bool transaction) = 0;
@@ -75,6 +85,7 @@ namespace Database {
 
         bool retrieveCount(const String &sql, int &count);
 
+        // A query is running, or a cursor of the client is not deleted yet.
         bool isExecuting();
 
     protected:
@@ -86,6 +97,10 @@ namespace Database {
         void printErrorInfo(const String &methodName, const String &sql = String::Empty,
                             const String &error = String::Empty);
 
+        // The thread of an open cursor holds the recursive lock, a call of it fails instead of running
+        // another statement on the connection, call it after locking.
+        bool checkCursor(const String &methodName, const String &sql = String::Empty);
+
 #ifdef DEBUG
 
         static void createSqlFile(const String &fileName, const String &sql);
@@ -97,6 +112,9 @@ namespace Database {
 
     private:
         friend SqlConnection;
+        friend DbCursor;
+
+        std::atomic<bool> _cursorOpened;
     };
 
     typedef PList<DbClient> DbClients;
@@ -0,0 +1,95 @@
+//
+//  DbCursor.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef DbCursor_h
+#define DbCursor_h
+
+#include "thread/Thread.h"
+#include "database/ColumnTable.h"
+
+using namespace Threading;
+
+namespace Database {
+    class DbClient;
+
+    // Forward only cursor of a query, the rows are fetched in batches, so the memory does not grow with the result.
+    // The client is locked and kept busy until the cursor is deleted,
+    // so the cursor must be deleted by the thread which created it.
+    class DbCursor {
+    public:
+        // client is locked by the query, nullptr if the cursor does not hold it.
+        explicit DbCursor(DbClient *client = nullptr, size_t batchSize = DefaultBatchSize);
+
+        virtual ~DbCursor();
+
+        DbCursor(const DbCursor &) = delete;
+
+        DbCursor &operator=(const DbCursor &) = delete;
+
+        const DataColumns &columns() const;
+
+        size_t columnCount() const;
+
+        ssize_t indexOf(const String &columnName) const;
+
+        size_t batchSize() const;
+
+        // Fetches the next batch instead of the current one, returns false at the end or on error.
+        bool fetch();
+
+        // The rows of the last fetch.
+        const ColumnTable &batch() const;
+
+        // Moves to the next row, fetches the next batch when the current one is consumed.
+        bool moveNext();
+
+        // The values of the current row.
+        bool isNullValue(size_t column) const;
+
+        DbValue value(size_t column) const;
+
+        DbValue value(const String &columnName) const;
+
+        template<class T>
+        bool getValue(size_t column, T &value) const {
+            return !isNullValue(column) && this->value(column).getValue(value);
+        }
+
+        template<class T>
+        bool getValue(const String &columnName, T &value) const {
+            ssize_t column = indexOf(columnName);
+            return column >= 0 && getValue((size_t) column, value);
+        }
+
+        // The number of the rows fetched so far.
+        uint64_t rowCount() const;
+
+        bool hasError() const;
+
+    public:
+        static const size_t DefaultBatchSize = 1000;
+
+    protected:
+        void setColumns(const DataColumns &columns);
+
+        // Appends at most count rows to the batch, fewer rows mean the end of the result.
+        virtual bool fetchInner(ColumnTable &batch, size_t count) = 0;
+
+    private:
+        DbClient *_client;
+        ThreadId _threadId;
+        size_t _batchSize;
+        ColumnTable _batch;
+        size_t _next;
+        uint64_t _rowCount;
+        bool _end;
+        bool _error;
+    };
+}
+
+#endif // DbCursor_h
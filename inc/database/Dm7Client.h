@@ -25,6 +25,7 @@ namespace Database {
     public:
         using DbClient::open;
         using DbClient::executeSql;
+        using DbClient::executeSqlQuery;
         using DbClient::executeSqlInsert;
         using DbClient::executeSqlReplace;
 
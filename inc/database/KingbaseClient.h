@@ -20,10 +20,13 @@ namespace Database {
     class KingbaseInner;
     class ResultInner;
 
+    class KingbaseCursor;
+
     class KingbaseClient : public DbClient {
     public:
         using DbClient::open;
         using DbClient::executeSql;
+        using DbClient::executeSqlQuery;
         using DbClient::executeSqlInsert;
         using DbClient::executeSqlReplace;
 
@@ -41,6 +44,8 @@ namespace Database {
 
         bool executeSqlQuery(const String &sql, DataTable &table) override;
 
+        DbCursor *executeSqlCursor(const String &sql, size_t batchSize = DbCursor::DefaultBatchSize) override;
+
         bool executeSqlInsert(const DataTable &table, bool transaction) override;
 
         bool executeSqlReplace(const DataTable &table, bool transaction) override;
@@ -94,6 +99,8 @@ namespace Database {
         static String toMergeStr(const DataTable &table, const DataRow &row);
 
     private:
+        friend KingbaseCursor;
+
         KingbaseInner *_kingbaseDb;
 
         StringMap _connectionParams;
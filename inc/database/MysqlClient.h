@@ -19,6 +19,7 @@ namespace Database {
     public:
         using DbClient::open;
         using DbClient::executeSql;
+        using DbClient::executeSqlQuery;
         using DbClient::executeSqlInsert;
         using DbClient::executeSqlReplace;
 
@@ -36,6 +37,8 @@ namespace Database {
 
         bool executeSqlQuery(const String &sql, DataTable &table) override;
 
+        DbCursor *executeSqlCursor(const String &sql, size_t batchSize = DbCursor::DefaultBatchSize) override;
+
         bool executeSqlInsert(const DataTable &table, bool transaction) override;
 
         bool executeSqlReplace(const DataTable &table, bool transaction) override;
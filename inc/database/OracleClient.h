@@ -18,6 +18,7 @@ namespace Database {
     public:
         using DbClient::open;
         using DbClient::executeSql;
+        using DbClient::executeSqlQuery;
         using DbClient::executeSqlInsert;
         using DbClient::executeSqlReplace;
 
@@ -39,6 +39,9 @@ namespace Database {
 
         bool executeSqlQuery(const String &sql, DataTable &table);
 
+        // The connection is not used by the other queries until the cursor is deleted.
+        DbCursor *executeSqlCursor(const String &sql, size_t batchSize = DbCursor::DefaultBatchSize);
+
         bool executeSqlInsert(const DataTable &table, bool transaction = true);
 
         bool executeSqlReplace(const DataTable &table, bool transaction = true);
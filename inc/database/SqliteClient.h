@@ -14,6 +14,8 @@
 namespace Database {
     class SqliteInner;
 
+    class SqliteCursor;
+
     class SqliteClient : public DbClient {
     public:
         using DbClient::open;
@@ -35,6 +37,10 @@ namespace Database {
 
         bool executeSqlQuery(const String &sql, DataTable &table) override;
 
+        bool executeSqlQuery(const String &sql, ColumnTable &table) override;
+
+        DbCursor *executeSqlCursor(const String &sql, size_t batchSize = DbCursor::DefaultBatchSize) override;
+
         bool executeSqlInsert(const DataTable &table, bool transaction) override;
 
         bool executeSqlReplace(const DataTable &table, bool transaction) override;
@@ -70,6 +76,12 @@ namespace Database {
 
         int executeSqlQueryInner(const String &sql, DataTable &table);
 
+        int executeSqlQueryInner(const String &sql, ColumnTable &table);
+
+        static DataColumn getColumn(void *tag, int index);
+
+        static void addRow(void *tag, ColumnTable &table);
+
         int beginTransactionInner();
 
         int commitTransactionInner();
@@ -79,6 +91,8 @@ namespace Database {
         static bool isSucceed(int result);
 
     private:
+        friend SqliteCursor;
+
         SqliteInner *_sqliteDb;
     };
 }
@@ -65,6 +65,8 @@ namespace Diag {
     protected:
         void write(const String &message, const String &category) override;
 
+        void writeBatch(const TraceRecord *records, size_t count, bool flush) override;
+
     protected:
         void processProc();
 
@@ -85,6 +87,8 @@ namespace Diag {
 
         void flushInner(bool locked = true);
 
+        void checkFile();
+
         bool isDiskFull() const;
 
         void removeFile(const String &dir, const String &fileName, int days);
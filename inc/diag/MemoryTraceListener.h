@@ -9,10 +9,10 @@
 #ifndef MemoryTraceListener_h
 #define MemoryTraceListener_h
 
+#include <atomic>
+#include <cstdint>
 #include "TraceListener.h"
-#include "data/LoopList.h"
 #include "data/StringArray.h"
-#include "thread/Mutex.h"
 #include "system/Delegate.h"
 
 using namespace System;
@@ -21,8 +21,9 @@ namespace Diag {
     class MemoryTraceListenerContext : public TraceListenerContext {
     public:
         int maxMessageCount;
+        size_t bufferSize;      // bytes of the ring, the oldest messages are overwritten when it is full.
 
-        explicit MemoryTraceListenerContext(int maxMessageCount = 10000);
+        explicit MemoryTraceListenerContext(int maxMessageCount = 10000, size_t bufferSize = DefaultBufferSize);
 
         MemoryTraceListenerContext(const MemoryTraceListenerContext &context);
 
@@ -36,6 +37,80 @@ namespace Diag {
 
     public:
         static const MemoryTraceListenerContext Default;
+
+        static const size_t DefaultBufferSize = 4 * 1024 * 1024;       // 4 M
+        static const size_t MinBufferSize = 64 * 1024;                 // 64 K
+        static const size_t MaxBufferSize = 1024 * 1024 * 1024;        // 1 G
+    };
+
+    // Lock free ring of the formatted messages, written by any thread, the oldest ones are overwritten when it is full.
+    // A message takes one or more slots, its sequence is the position of the first one, so the sequences increase.
+    // The readers tail from a cursor and never block the writers, the messages overwritten while read are skipped.
+    class TraceRing {
+    public:
+        explicit TraceRing(size_t size);
+
+        ~TraceRing();
+
+        TraceRing(const TraceRing &) = delete;
+
+        TraceRing &operator=(const TraceRing &) = delete;
+
+        // Any thread, returns the sequence of the message, the text longer than MaxTextLength is truncated.
+        uint64_t write(const char *text, size_t length);
+
+        // Adds the messages from cursor to messages, the cursor is moved to the sequence after the last one.
+        // The cursor older than the ring is moved to the oldest message, returns the count of the messages added.
+        size_t read(uint64_t &cursor, StringArray &messages, size_t maxCount = SIZE_MAX) const;
+
+        // The sequence of the oldest message may be still in the ring.
+        uint64_t first() const;
+
+        // The sequence of the count-th last message, or the oldest one if the ring has fewer.
+        uint64_t last(size_t count) const;
+
+        // The sequence of the next message.
+        uint64_t next() const;
+
+        size_t size() const;
+
+    public:
+        static const size_t SlotSize = 128;
+        static const size_t MaxTextLength = 4096 - 8;
+
+    private:
+        struct Slot {
+            // 0 while it is written, else (position + 1) << 1, the low bit is set on the first slot of a message.
+            std::atomic<uint64_t> stamp;
+            char data[SlotSize - sizeof(uint64_t)];
+        };
+
+        struct Header {
+            uint32_t length;
+            uint32_t count;
+        };
+
+        static const size_t DataSize = sizeof(Slot::data);
+
+        static uint64_t headStamp(uint64_t position);
+
+        static uint64_t bodyStamp(uint64_t position);
+
+        enum ReadResult {
+            ReadDone = 0,
+            ReadPending = 1,    // not written yet.
+            ReadSkipped = 2     // overwritten, or not the first slot of a message.
+        };
+
+        // Copies the message at position, the slots are checked after copied, so a torn one is skipped.
+        ReadResult readAt(uint64_t position, char *text, size_t &length, size_t &count) const;
+
+    private:
+        Slot *_slots;
+        size_t _capacity;
+        size_t _mask;
+
+        std::atomic<uint64_t> _next;
     };
 
     class MemoryTraceListener : public TraceListener {
@@ -44,8 +119,15 @@ namespace Diag {
 
         ~MemoryTraceListener() override;
 
+        // The last maxMessageCount messages of the ring.
         void getAllMessages(StringArray &messages);
 
+        // Tails the messages from cursor, start it with position() for the new messages only.
+        size_t getMessages(uint64_t &cursor, StringArray &messages, size_t maxCount = SIZE_MAX) const;
+
+        // The sequence of the next message.
+        uint64_t position() const;
+
         Delegates *updatedDelegates();
 
         const MemoryTraceListenerContext &context() const;
@@ -53,8 +135,10 @@ namespace Diag {
     protected:
         void write(const String &message, const String &category) override;
 
+        void writeBatch(const TraceRecord *records, size_t count, bool flush) override;
+
     private:
-        LoopList<String> _messages;
+        TraceRing _ring;
 
         Delegates _updateDelegates;
 
@@ -14,6 +14,8 @@
 #include <cassert>
 
 namespace Diag {
+    class TraceWriter;
+
     class Trace {
     public:
         static void writeFormat(const char *format, ...);
@@ -58,10 +60,26 @@ namespace Diag {
 
         static void fatal(const String &message);
 
+        // The messages are staged per thread and written by a background thread in batches,
+        // the errors are flushed within flushInterval(ms).
+        static bool enableAsync(TraceOverflow overflow = TraceDrop, size_t bufferSize = 64 * 1024,
+                                uint32_t flushInterval = 100);
+
+        static void disableAsync();
+
+        static bool isAsync();
+
+        // Wait until the staged messages are written.
+        static void flush();
+
+        static TraceStatistics asyncStatistics();
+
     private:
         static void writeInner(const char *message, bool newLine = false,
                                const char *category = nullptr, bool showTime = true);
 
+        static size_t formatPrefix(char *buffer, const char *category, bool showTime);
+
     public:
         static const char *Information;
         static const char *Info;
@@ -76,6 +94,13 @@ namespace Diag {
     private:
         friend class Debug;
 
+        friend class TraceWriter;
+
+        static const int MaxPrefixLength = 64;
+        static const int MaxCategoryLength = 32;
+
+        static TraceWriter *_writer;
+
         static bool _enableLog;
         static TraceListeners _traceListeners;
         static bool _enableConsoleOutput;
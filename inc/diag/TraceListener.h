@@ -50,6 +50,27 @@ namespace Diag {
         static const TraceListenerContexts Empty;
     };
 
+    // One formatted message of the async trace, the text ends with '\0' and length does not count it.
+    struct TraceRecord {
+        const char *text;
+        size_t length;
+        const char *category;
+    };
+
+    enum TraceOverflow {
+        // Drop the message if the staging buffer of the thread is full.
+        TraceDrop = 0,
+        // Wait for the writer thread if the staging buffer of the thread is full.
+        TraceBlock = 1
+    };
+
+    struct TraceStatistics {
+        uint64_t written;
+        uint64_t dropped;
+        uint64_t blocked;
+        uint64_t batches;
+    };
+
     class TraceListener {
     public:
         TraceListener();
@@ -62,8 +83,13 @@ namespace Diag {
     protected:
         virtual void write(const String &message, const String &category) = 0;
 
+        // Called by the writer thread of the async trace, flush is true if the batch has an error message.
+        virtual void writeBatch(const TraceRecord *records, size_t count, bool flush);
+
     private:
         friend class Trace;
+
+        friend class TraceWriter;
     };
 
     typedef PList<TraceListener> TraceListeners;
@@ -0,0 +1,145 @@
+//
+//  TraceWriter.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef TraceWriter_h
+#define TraceWriter_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <condition_variable>
+#include "diag/TraceListener.h"
+#include "thread/Thread.h"
+
+using namespace Threading;
+
+namespace Diag {
+    // Lock free staging buffer of one thread, only the thread writes and only the writer thread reads.
+    class TraceBuffer {
+    public:
+        explicit TraceBuffer(size_t size);
+
+        ~TraceBuffer();
+
+        TraceBuffer(const TraceBuffer &) = delete;
+
+        TraceBuffer &operator=(const TraceBuffer &) = delete;
+
+        // Producer only, returns nullptr if it is full, the text must be committed before the next reserve.
+        char *reserve(const char *category, bool error, size_t length);
+
+        void commit();
+
+        // Consumer only.
+        bool isEmpty() const;
+
+        size_t maxTextLength() const;
+
+    private:
+        struct Header {
+            uint32_t size;
+            uint32_t length;
+        };
+
+        static size_t align(size_t size);
+
+    private:
+        friend class TraceWriter;
+
+        static const uint32_t ErrorFlag = 0x80000000;
+        static const uint32_t Padding = 0x7FFFFFFF;
+
+        char *_data;
+        size_t _size;
+        size_t _mask;
+
+        // producer side.
+        size_t _reservedTail;
+        size_t _cachedHead;
+
+        std::atomic<size_t> _head;
+        std::atomic<size_t> _tail;
+        std::atomic<uint64_t> _dropped;
+        std::atomic<uint64_t> _blocked;
+    };
+
+    // The background writer of the async trace, drains the staging buffers of all threads in batches.
+    class TraceWriter {
+    public:
+        static TraceWriter *instance();
+
+        bool start(TraceOverflow overflow, size_t bufferSize, uint32_t flushInterval);
+
+        void stop();
+
+        bool running() const;
+
+        // Copy the message into the staging buffer of the current thread, returns false if it is dropped.
+        bool write(const char *prefix, size_t prefixLength, const char *message, size_t length, bool newLine,
+                   const char *category, bool error);
+
+        // Wait until the messages written before are delivered.
+        void flush();
+
+        TraceStatistics statistics() const;
+
+        // Write all of the records to fd, retry the partial writes.
+        static bool writeFully(int fd, const TraceRecord *records, size_t count);
+
+    public:
+        static const size_t DefaultBufferSize = 64 * 1024;     // 64 K
+        static const uint32_t DefaultFlushInterval = 100;      // ms
+        static const size_t MaxBatchCount = 1024;
+
+    private:
+        TraceWriter();
+
+        ~TraceWriter();
+
+        TraceBuffer *currentBuffer();
+
+        void writeProc();
+
+        bool writeBatch();
+
+        void deliver(const TraceRecord *records, size_t count, bool flush);
+
+        void wakeup();
+
+    private:
+        std::atomic<bool> _running;
+        TraceOverflow _overflow;
+        size_t _bufferSize;
+        uint32_t _flushInterval;
+        Thread *_thread;
+
+        std::vector<std::shared_ptr<TraceBuffer>> _buffers;
+        std::vector<std::shared_ptr<TraceBuffer>> _snapshot;
+        std::vector<size_t> _heads;
+        std::vector<TraceRecord> _records;
+        mutable std::mutex _buffersMutex;
+        uint64_t _retiredDropped;
+        uint64_t _retiredBlocked;
+
+        std::mutex _signalMutex;
+        std::condition_variable _signal;
+        std::condition_variable _flushed;
+        std::condition_variable _drained;   // the blocked writers wait for the heads to advance.
+        uint64_t _drainCount;
+        bool _wakeup;
+        bool _stopped;
+        uint64_t _flushRequest;
+        uint64_t _flushDone;
+
+        std::atomic<uint64_t> _written;
+        std::atomic<uint64_t> _batches;
+    };
+}
+
+#endif // TraceWriter_h
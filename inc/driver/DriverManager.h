@@ -1,8 +1,12 @@
 #ifndef DRIVERMANAGER_H
 #define DRIVERMANAGER_H
 
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include "thread/Mutex.h"
 #include "data/PList.h"
+#include "data/HashDictionary.h"
 #include "data/StringArray.h"
 #include "thread/Locker.h"
 #include "thread/Task.h"
@@ -61,6 +65,11 @@ namespace Drivers {
 
         void addPool(const InstructionPool *ip);
 
+        // All the pools are published at once, e.g. the pools of many devices, ips does not own them.
+        void addPools(const InstructionPools &ips);
+
+        // The pools are indexed by InstructionPool::deviceName(), the first pool added wins,
+        // or the first pool which InstructionPool::containsDevice is found if none is indexed.
         InstructionPool *getPool(const String &deviceName) const;
 
         InstructionPool *getPoolByChannelName(const String &channelName) const;
@@ -80,8 +89,42 @@ namespace Drivers {
         Delegates *channelClosedDelegates();
 
     private:
+        // The indexes of the devices and the channels, immutable once published, so the readers never lock.
+        struct Registry {
+            HashDictionary<String, Device *, NullMutex> devices;
+            HashDictionary<const Channel *, std::vector<Device *>, NullMutex> channelDevices;
+            HashDictionary<String, Channel *, NullMutex> channels;
+            HashDictionary<const ChannelDescription *, Channel *, NullMutex> channelDescriptions;
+        };
+
+        // The pools by the device name and by the channel name, apart from the devices so addPool does not copy them.
+        struct PoolRegistry {
+            HashDictionary<String, InstructionPool *, NullMutex> devices;
+            HashDictionary<String, InstructionPool *, NullMutex> channels;
+            std::vector<InstructionPool *> pools;   // in the order added.
+        };
+
+        template<class T>
+        struct Retired {
+            const T *registry;
+            uint64_t tick;
+        };
+
         void createDevices();
 
+        void publish(Registry *registry);
+
+        void publish(PoolRegistry *registry);
+
+        // The registries replaced may be still read, they are deleted after RetiredTimeout.
+        template<class T>
+        static void retire(std::vector<Retired<T>> &retired, const T *registry);
+
+        // Deletes all the registries replaced, e.g. when the devices are closed.
+        void clearRegistries();
+
+        static void addPool(PoolRegistry *registry, InstructionPool *ip);
+
         void reopen(const String &channelName = String::Empty, bool allowConnected = false);
 
         void reopen(Channel *channel, bool allowConnected = false);
@@ -100,12 +143,21 @@ namespace Drivers {
         Channels *_channels;
         InstructionPools *_pools;
 
+        std::mutex _registryMutex;      // the writers of the registries.
+        std::atomic<const Registry *> _registry;
+        std::atomic<const PoolRegistry *> _poolRegistry;
+        std::vector<Retired<Registry>> _retiredRegistries;
+        std::vector<Retired<PoolRegistry>> _retiredPoolRegistries;
+
         bool _opened;
 
         Delegates _channelOpenedDelegates;
         Delegates _channelClosedDelegates;
 
         Task _resetTask;
+
+    private:
+        static const uint64_t RetiredTimeout = 10 * 1000;     // ms.
     };
 }
 #endif // DRIVERMANAGER_H
@@ -45,6 +45,8 @@ namespace Drivers {
 
         size_t available() override;
 
+        bool waitAvailable(uint32_t timeout) override;
+
         ssize_t send(const uint8_t *buffer, off_t offset, size_t count) override;
 
         ssize_t receive(uint8_t *buffer, off_t offset, size_t count) override;
@@ -83,6 +85,13 @@ namespace Drivers {
 
         Delegates *closedDelegates();
 
+    protected:
+        size_t availableInner() override;
+
+        ssize_t receiveInner(uint8_t *buffer, off_t offset, size_t count) override;
+
+        bool waitAvailableInner(uint32_t timeout) override;
+
     private:
         DriverManager *manager();
 
@@ -39,6 +39,8 @@ namespace Drivers {
 
         virtual size_t available() = 0;
 
+        virtual bool waitAvailable(uint32_t timeout);
+
         virtual ssize_t send(const uint8_t *buffer, off_t offset, size_t count) = 0;
 
         virtual ssize_t receive(uint8_t *buffer, off_t offset, size_t count) = 0;
@@ -56,6 +58,9 @@ namespace Drivers {
     protected:
         DriverManager *manager() const;
 
+    private:
+        static bool hasAvailable(void *parameter);
+
     protected:
         Channel *_channel;
         bool _useReceiveTimeout;
@@ -80,6 +85,9 @@ namespace Drivers {
 
     protected:
         bool receiveFromBuffer(Device *device);
+
+        // The channel of the device has bytes read ahead past the last frame.
+        static bool hasBuffered(const Device *device);
     };
 }
 
@@ -21,6 +21,8 @@ namespace Drivers
 		bool connected() override;
         size_t available() override;
 
+        bool waitAvailable(uint32_t timeout) override;
+
 		ssize_t send(const uint8_t* buffer, off_t offset, size_t count) override;
 		ssize_t receive(uint8_t* buffer, off_t offset, size_t count) override;
 		ssize_t receive(uint8_t* buffer, off_t offset, size_t count, uint32_t timeout) override;
@@ -14,7 +14,8 @@ namespace Drivers {
         enum Types {
             Sync = 0,
             Async = 1,
-            Multiplexing = 2
+            Multiplexing = 2,
+            Reactor = 3
         };
 
         TcpChannelContext();
@@ -65,6 +66,8 @@ namespace Drivers {
 
         bool multiplexingReceiver() const;
 
+        bool reactorReceiver() const;
+
         void setReceiverType(Types type);
 
         bool asyncSender() const;
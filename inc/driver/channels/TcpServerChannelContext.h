@@ -22,12 +22,17 @@ namespace Drivers
         const TimeSpan& closeTimeout() const override;
         void setCloseTimeout(const TimeSpan& timeout);
         void setCloseTimeout(uint32_t milliSeconds);
+
+        // Event loop threads used by the reactor receiver, 0 means one per core.
+        int eventLoopCount() const;
+        void setEventLoopCount(int count);
         
         void copyFrom(const TcpChannelContext* context) override;
 
 	private:
 		int _maxConnections;
         TimeSpan _closeTimeout;
+        int _eventLoopCount;
         
 	};
     
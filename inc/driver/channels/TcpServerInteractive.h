@@ -6,6 +6,7 @@
 #include "thread/Timer.h"
 #include "thread/TickTimeout.h"
 #include "thread/Locker.h"
+#include "data/Dictionary.h"
 #include "net/TcpClient.h"
 #include "net/TcpServer.h"
 #include "Interactive.h"
@@ -141,6 +142,49 @@ namespace Drivers {
 //            Mutex _deleteClientsMutex;
         };
 
+        // One epoll set per loop thread, owns accept, read and close of its own clients.
+        class EventLoop {
+        public:
+            EventLoop(TcpServerInteractive *owner, int index);
+
+            ~EventLoop();
+
+            bool start();
+
+            void stop();
+
+            size_t clientCount() const;
+
+        private:
+            void loopProc();
+
+            void acceptClients();
+
+            void processClient(int socketId, uint32_t events);
+
+            void closeClient(Client *client);
+
+            void closeUnusedClients();
+
+        private:
+            TcpServerInteractive *_owner;
+            int _index;
+
+            int _fd;
+            int _listenFd;
+            int _exitSockets[2];
+
+            Thread *_thread;
+            bool _loop;
+
+            Dictionary<int, Client *> _clients;
+
+            uint8_t *_buffer;
+            size_t _bufferLength;
+        };
+
+        typedef PList<EventLoop> EventLoops;
+
         TcpServerInteractive(DriverManager *dm, Channel *channel);
 
         ~TcpServerInteractive() override;
@@ -206,12 +250,16 @@ namespace Drivers {
 
         Device *getSenderDevice(const Endpoint &peerEndpoint);
 
-        void openClient(TcpClient *tc);
+        Client *openClient(TcpClient *tc);
 
         void closeClient(Client *client);
 
         bool hasMultiplexing() const;
 
+        bool startEventLoops(const TcpServerChannelContext *tcc);
+
+        void stopEventLoops();
+
     protected:
         TcpServer *_tcpServer;
 
@@ -233,6 +281,8 @@ namespace Drivers {
 
         int _exitSockets[2];
 
+        EventLoops _eventLoops;
+
 //        static const int MaxEventCount = 1000;
     };
 
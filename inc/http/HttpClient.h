@@ -16,7 +16,6 @@
 #include "data/String.h"
 #include "data/Dictionary.h"
 #include "data/StringArray.h"
-#include "system/PoolService.h"
 #include "http/HttpContent.h"
 
 using namespace System;
@@ -24,7 +23,12 @@ using namespace System;
 namespace Http {
     typedef void (*HttpSendCallback)(HttpResponse &);
 
-    class HttpClient : public PoolService {
+    // Called on the engine thread when an async request is completed, result is false if it is not sent.
+    typedef void (*HttpCompletion)(bool result, HttpResponse &response, void *state);
+
+    class HttpEngine;
+
+    class HttpClient {
     public:
         TimeSpan connectionTimeout;
         TimeSpan receiveTimeout;
@@ -34,7 +38,11 @@ namespace Http {
 
         HttpClient(std::initializer_list<KeyValuePair<String, String>> list);
 
-        ~HttpClient() override;
+        HttpClient(const HttpClient &) = delete;
+
+        ~HttpClient();
+
+        HttpClient &operator=(const HttpClient &) = delete;
 
         bool get(const Url &url, const HttpHeaders &headers, String &response) const;
 
@@ -98,24 +106,48 @@ namespace Http {
         //    Return false if uploading failed.
         bool upload(const Url &url, const HttpHeaders &headers, const String &fileName, String &response) const;
 
+        // Thread safe, the connections are reused by the next requests.
         bool send(const HttpRequest &request, HttpResponse &response) const;
 
         void sendAsync(const HttpRequest &request, HttpSendCallback callback = nullptr);
 
+        // Sends the request without waiting, the requests are multiplexed by the engine thread.
+        // The response content is owned by the response, it is a string content if nullptr.
+        bool sendAsync(const HttpRequest &request, HttpCompletion completion, void *state = nullptr,
+                       HttpContent *responseContent = nullptr);
+
+        // The limit of the connections to one host of the async requests.
+        size_t maxHostConnections() const;
+
+        void setMaxHostConnections(size_t maxHostConnections);
+
+        // The async requests not completed.
+        size_t pendingCount() const;
+
     public:
         static String escape(const String &str);
 
         static String unescape(const String &str);
 
-    protected:
-        void process(const IPoolEntry *value) override;
-
     private:
+        String requestUrl(const HttpRequest &request) const;
+
+        // Returns the header list of the request, it is freed after the transfer.
+        void *setOptions(void *curl, const HttpRequest &request, HttpResponse &response, const String &url) const;
+
+        static bool complete(void *curl, int code, HttpResponse &response, const String &url);
+
         static size_t write_data(void *buffer, size_t size, size_t nmemb, void *userdata);
 
         static size_t write_header(char *buffer, size_t size, size_t nitems, void *userdata);
 
         static size_t read_data(void *buffer, size_t size, size_t nmemb, void *userdata);
+
+    private:
+        friend class HttpClientTransfer;
+
+        HttpEngine *_engine;
+        size_t _maxHostConnections;
     };
 }
 #endif  // HttpClient_h
@@ -9,6 +9,7 @@
 #ifndef HttpContent_h
 #define HttpContent_h
 
+#include <vector>
 #include "data/String.h"
 #include "data/DataInterface.h"
 #include "data/StringArray.h"
@@ -22,6 +23,8 @@
 using namespace Net;
 using namespace Json;
 
+struct evbuffer;
+
 namespace Http {
     enum HttpStatus {
         HttpOk = 200,
@@ -311,6 +314,8 @@ namespace Http {
 
         explicit HttpStringContent(const String &value);
 
+        explicit HttpStringContent(String &&value);
+
         HttpStringContent(const HttpStringContent &other);
 
         ~HttpStringContent() override;
@@ -333,7 +338,7 @@ namespace Http {
         String _value;
 
     private:
-        MemoryStream *_stream;
+        size_t _position;   // the reads are served from _value, it is not copied.
     };
 
     class HttpJsonContent : public HttpStringContent {
@@ -342,6 +347,8 @@ namespace Http {
 
         explicit HttpJsonContent(const String &value);
 
+        explicit HttpJsonContent(String &&value);
+
         explicit HttpJsonContent(const JsonNode &value);
 
         HttpJsonContent(const HttpJsonContent &other);
@@ -377,7 +384,7 @@ namespace Http {
 
     private:
         ByteArray _value;
-        MemoryStream *_stream;
+        size_t _position;
     };
 
     class HttpStreamContent : public HttpContent {
@@ -411,6 +418,92 @@ namespace Http {
         String _value;
     };
 
+    // The body written part by part while it is sent, e.g. the rows of a query, so it is never in memory as a whole.
+    // The writer is called again each time the parts written before are read, until it returns false.
+    class HttpChunkedContent : public HttpContent {
+    public:
+        // Writes the next part of the body to the stream, returns false after the last part.
+        typedef bool (*Writer)(void *state, Stream &stream);
+
+        HttpChunkedContent(void *state, Writer writer);
+
+        HttpChunkedContent(const HttpChunkedContent &other);
+
+        ~HttpChunkedContent() override;
+
+        bool equals(const HttpContent &other) const override;
+
+        void evaluates(const HttpContent &other) override;
+
+        // The body is written by the writer only.
+        void write(void *buffer, size_t size, size_t nmemb) override;
+
+        ssize_t read(void *buffer, size_t size, size_t nmemb) override;
+
+        // The size is unknown until the end, it is 0.
+        size_t size() override;
+
+        HttpContent *clone() const override;
+
+        bool isEnd() const;
+
+    protected:
+        HttpChunkedContent();
+
+        virtual bool writeNext(Stream &stream);
+
+    private:
+        void *_state;
+        Writer _writer;
+        MemoryStream _buffer;   // the part written and not read yet.
+        bool _end;
+    };
+
+    // The body received by the server, its parts stay in the chains of a libevent buffer, they are not copied.
+    class HttpBufferContent : public HttpContent {
+    public:
+        // Visits a part of the body, returns false to stop.
+        typedef bool (*Visitor)(void *owner, const uint8_t *data, size_t length);
+
+        HttpBufferContent();
+
+        // The chains of the buffer are moved to the content, the buffer is empty after it.
+        explicit HttpBufferContent(struct evbuffer *buffer);
+
+        HttpBufferContent(const HttpBufferContent &other);
+
+        ~HttpBufferContent() override;
+
+        bool equals(const HttpContent &other) const override;
+
+        void evaluates(const HttpContent &other) override;
+
+        void write(void *buffer, size_t size, size_t nmemb) override;
+
+        ssize_t read(void *buffer, size_t size, size_t nmemb) override;
+
+        size_t size() override;
+
+        HttpContent *clone() const override;
+
+        // Visits the parts in order, returns false if the visitor stops.
+        bool peek(void *owner, Visitor visitor) const;
+
+        // The body as a text, it is copied from the parts once, at the first call.
+        const String &value() const;
+
+    private:
+        static bool add(void *owner, const uint8_t *data, size_t length);
+
+        static bool append(void *owner, const uint8_t *data, size_t length);
+
+    private:
+        struct evbuffer *_buffer;
+        size_t _position;
+        mutable String _value;
+        mutable bool _copied;
+    };
+
     class HttpMethod : public IEquatable<HttpMethod>, public IEvaluation<HttpMethod> {
     public:
         explicit HttpMethod(const String &method);
@@ -586,6 +679,47 @@ namespace Http {
         StringMap _values;
     };
 
+    // The {name} segments of the path matched by HttpRouter.
+    // The values are the ranges of the relative url of the request, the names are copied,
+    // so they are still valid when the mappings are changed.
+    class HttpPathVariables {
+    public:
+        HttpPathVariables();
+
+        // The first InlineCount variables are kept in place, the rest are kept in the heap.
+        void add(const String &name, const char *value, size_t length);
+
+        void clear();
+
+        size_t count() const;
+
+        // Removes the variables added after count, used by the backtracking of the router.
+        void truncate(size_t count);
+
+        bool at(const String &name, String &value) const;
+
+        const String &nameAt(size_t index) const;
+
+        String valueAt(size_t index) const;
+
+    public:
+        static const size_t InlineCount = 8;
+
+    private:
+        struct Variable {
+            String name;
+            const char *value;
+            size_t length;
+        };
+
+        const Variable &variableAt(size_t index) const;
+
+    private:
+        Variable _values[InlineCount];
+        std::vector<Variable> _overflow;
+        size_t _count;
+    };
+
     class HttpRequest : public IEquatable<HttpRequest>, public IEvaluation<HttpRequest> {
     public:
         HttpRequest(const Url &url, const HttpMethod &method);
@@ -616,6 +750,11 @@ namespace Http {
 
         String getPathSegment(int segment) const;
 
+        // The value of the {name} segment of the mapping matched by the router.
+        bool getPathVariable(const String &name, String &value) const;
+
+        String getPathVariable(const String &name) const;
+
         bool findHeader(const String &name, const String &value) const;
 
         String toPropsStr() const;
@@ -635,6 +774,8 @@ namespace Http {
         String userAgent;
         bool verb;
         HttpCookie cookie;
+        // set by the router while the request is dispatched, they refer to url.
+        mutable HttpPathVariables pathVariables;
 
     public:
         static const char PathSplitSymbol;
@@ -654,6 +795,9 @@ namespace Http {
 
         void setContent(Stream *stream);
 
+        // The body is written part by part by the writer while it is sent.
+        void setContent(void *state, HttpChunkedContent::Writer writer);
+
     public:
         const HttpRequest *request;
         HttpHeaders headers;
@@ -0,0 +1,106 @@
+//
+//  HttpEngine.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef HttpEngine_h
+#define HttpEngine_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "thread/Thread.h"
+
+using namespace Threading;
+
+namespace Http {
+    class HttpEngine;
+
+    // One request of the engine, completed on the engine thread.
+    class HttpTransfer {
+    public:
+        explicit HttpTransfer(void *handle);
+
+        virtual ~HttpTransfer();
+
+        void *handle() const;
+
+        // code is the CURLcode of the transfer.
+        virtual void complete(int code) = 0;
+
+    private:
+        friend HttpEngine;
+
+        void *_handle;
+    };
+
+    // The curl handles of a client, reused with their live connections, the DNS cache and the TLS sessions.
+    // The async transfers run on one thread with curl_multi, at most maxHostConnections per host.
+    class HttpEngine {
+    public:
+        explicit HttpEngine(size_t maxHostConnections = DefaultMaxHostConnections);
+
+        ~HttpEngine();
+
+        HttpEngine(const HttpEngine &) = delete;
+
+        HttpEngine &operator=(const HttpEngine &) = delete;
+
+        // Gets an easy handle from the cache, it is shared by all the handles of the engine.
+        void *acquire();
+
+        // Resets the handle and caches it for the next request, the connections of it are kept alive.
+        void release(void *handle);
+
+        // Runs the transfer on the engine thread, it is deleted after the completion.
+        // The transfers not done when the engine is stopped are completed with CURLE_ABORTED_BY_CALLBACK.
+        bool add(HttpTransfer *transfer);
+
+        // Applied on the engine thread, to the connections opened after it.
+        void setMaxHostConnections(size_t maxHostConnections);
+
+        // The transfers added but not completed.
+        size_t activeCount() const;
+
+    public:
+        static const size_t DefaultMaxHostConnections = 16;
+
+    private:
+        bool start();
+
+        void stop();
+
+        void runProc();
+
+        static void lockShare(void *handle, int data, int access, void *userptr);
+
+        static void unlockShare(void *handle, int data, void *userptr);
+
+    private:
+        void *_share;
+        std::mutex _shareMutexes[16];    // one for each curl_lock_data.
+
+        std::mutex _handlesMutex;
+        std::vector<void *> _handles;
+
+        void *_multi;
+        size_t _maxHostConnections;
+        Thread *_thread;
+        std::atomic<bool> _running;
+        std::atomic<size_t> _activeCount;
+
+        std::mutex _pendingMutex;
+        std::vector<HttpTransfer *> _pending;
+        bool _stopping;     // no transfer is added after it, e.g. by a completion.
+        bool _optionsChanged;   // _maxHostConnections is set, not applied to the multi handle yet.
+
+    private:
+        // the handles more than it are cleaned up when released.
+        static const size_t MaxCachedHandles = 64;
+    };
+}
+
+#endif // HttpEngine_h
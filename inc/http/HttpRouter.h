@@ -0,0 +1,80 @@
+//
+//  HttpRouter.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef HttpRouter_h
+#define HttpRouter_h
+
+#include <vector>
+#include "http/HttpContent.h"
+
+namespace Http {
+    // The trie of the path segments of the mappings, compiled once when they are added.
+    // A request is routed by walking its relative url once, the text segments are preferred to the {name} ones,
+    // and the {name} segments are captured into HttpRequest::pathVariables, the values are not copied.
+    // It is not locked, the owner locks it if it is changed while routing.
+    class HttpRouter {
+    public:
+        typedef std::vector<void *> Values;
+
+        HttpRouter();
+
+        ~HttpRouter();
+
+        HttpRouter(const HttpRouter &) = delete;
+
+        HttpRouter &operator=(const HttpRouter &) = delete;
+
+        // The values of the same method and path are kept in the order of adding.
+        void add(const HttpMethod &method, const String &path, void *value);
+
+        bool remove(const HttpMethod &method, const String &path, void *value);
+
+        void clear();
+
+        // Returns nullptr if not found, the path variables of the request are set if found.
+        const Values *route(const HttpRequest &request) const;
+
+        const Values *route(const HttpMethod &method, const String &path, HttpPathVariables &variables) const;
+
+        size_t count() const;
+
+    private:
+        struct Route {
+            String method;
+            Values values;
+        };
+
+        struct Node {
+            String segment;                 // the text, or the name of the variable.
+            std::vector<Node *> children;   // the text ones, sorted by segment.
+            std::vector<Node *> variables;
+            std::vector<Route> routes;
+
+            explicit Node(const String &segment);
+
+            ~Node();
+
+            const Values *find(const String &method) const;
+        };
+
+        Node *insert(const String &path);
+
+        Node *findNode(const String &path) const;
+
+        static const Values *match(const Node *node, const String &method, const char *path, const char *end,
+                                   HttpPathVariables &variables);
+
+        static bool parseVarName(const String &segment, String &name);
+
+    private:
+        Node *_root;
+        size_t _count;
+    };
+}
+
+#endif // HttpRouter_h
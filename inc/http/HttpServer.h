@@ -9,6 +9,11 @@
 #ifndef HttpServer_h
 #define HttpServer_h
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <condition_variable>
 #include "http/HttpContent.h"
 #include "thread/Thread.h"
 
@@ -35,6 +40,8 @@ using namespace Threading;
 namespace Http {
     class HttpServer {
     public:
+        class ContextEntry;
+
         typedef void (*action_send_document_cb)(struct evhttp_request *, void *);
 
         typedef bool (*action_check_access_key)(void *, const String &);
@@ -93,9 +100,11 @@ namespace Http {
             Endpoint endpoint;
             Secure secure;
             TimeSpan timeout;
+            int loopCount;      // the event loop threads, they share the port by SO_REUSEPORT.
+            int workerCount;    // the threads running the actions, 0 runs them on the event loops.
 
             explicit Context(const Endpoint &endpoint = Endpoint::Empty, const Secure &secure = Secure::None,
-                    const TimeSpan &timeout = TimeSpan::fromSeconds(30));
+                    const TimeSpan &timeout = TimeSpan::fromSeconds(30), int loopCount = 1, int workerCount = 0);
 
             Context(const Context &context);
 
@@ -120,16 +129,79 @@ namespace Http {
 
         bool isAlive() const;
 
+    public:
+        static const int MaxLoopCount = 64;
+        static const int MaxWorkerCount = 256;
+
+        // the bodies larger than it are sent by reference, not copied.
+        static const size_t ReferenceSize = 4 * 1024;
+        // the part size of the streamed bodies.
+        static const size_t ChunkSize = 64 * 1024;
+
     public:
         static bool getMessage(struct evhttp_request *req, String &buffer);
 
         static bool getFileName(struct evhttp_request *req, String &fileName);
 
     private:
+        class LoopEntry;
+
+        // One request, parsed and replied on its event loop, processed on a worker or on the loop.
+        class Job {
+        public:
+            LoopEntry *loop;
+            struct evhttp_request *req;
+            HttpRequest *request;
+            HttpResponse response;
+            int code;
+            String fileName;        // the uploaded file.
+            FileStream *stream;
+            bool closed;            // the client is gone before the reply, it is dropped.
+            bool streaming;         // the body is being sent part by part.
+            bool working;           // on a worker, the loop does not touch it until it is posted back.
+            struct evbuffer *chunk; // the next part of the streamed body.
+
+            Job(LoopEntry *loop, struct evhttp_request *req);
+
+            ~Job();
+
+            void process(const Actions &actions);
+
+            // Reads the next part of the body into the chunk, it is empty after the last part.
+            void readChunk();
+        };
+
+        // One event loop thread with its own listen socket of the port.
+        class LoopEntry {
+        public:
+            ContextEntry *entry;
+            struct event_base *base;
+            struct evhttp *http;
+            struct event *replyEvent;
+            Thread *thread;
+            std::atomic<bool> stopping;
+
+            std::mutex repliesMutex;
+            std::vector<Job *> replies;
+
+            explicit LoopEntry(ContextEntry *entry);
+
+            ~LoopEntry();
+
+            bool open(evutil_socket_t fd);
+
+            // Any thread, the job is replied and deleted on the loop.
+            void post(Job *job);
+        };
+
         bool startHttpServer(const Context &context);
 
         bool startHttpsServer(const Context &context);
 
+        static bool start(ContextEntry &entry, const Context &context);
+
+        static void stop(ContextEntry &entry);
+
     private:
         static char *find_http_header(struct evhttp_request *req, struct evkeyvalq *params, const char *query_char);
 
@@ -146,10 +218,41 @@ namespace Http {
 
         static void httpServerStart(void *parameter);
 
+        static void workerProc(void *parameter);
+
+        static evutil_socket_t bindSocket(const String &address, Port port, bool reusePort);
+
         static void send_document_cb(struct evhttp_request *req, void *arg);
 
+        // Returns false if the request is replied already.
+        static bool parseRequest(struct evhttp_request *req, const ContextEntry *entry, Job *job);
+
+        // The job is deleted after the reply is sent.
+        static void sendReply(Job *job);
+
+        // The part is read on a worker if any, the loop only sends it.
+        static void readNextChunk(Job *job);
+
+        static void sendChunk(Job *job);
+
+        static void chunk_sent_cb(struct evhttp_connection *evcon, void *arg);
+
+        // Installed while the job is processed or streamed, so the job knows the request is gone.
+        static void connection_closed_cb(struct evhttp_connection *evcon, void *arg);
+
+        static void reference_cleanup(const void *data, size_t length, void *arg);
+
+        static void replies_cb(evutil_socket_t fd, short events, void *arg);
+
         static bool isIllegal(struct evhttp_request *req, const String &str);
 
+        // The parts of the body are filtered where they are, they are not copied to a text.
+        static bool isIllegal(struct evhttp_request *req, const HttpBufferContent *content);
+
+        static bool matchFilter(const char *str, size_t length);
+
+        static bool filter_cb(void *owner, const uint8_t *data, size_t length);
+
         static void returnIllegalInfo(struct evhttp_request *req);
 
     private:
@@ -162,19 +265,27 @@ namespace Http {
             struct sockaddr_in6 i6;
         } sock_hop;
 
-        Thread *_httpThread;
-        Thread *_httpsThread;
-
     public:
         class ContextEntry {
         public:
             Context context;
             Actions actions;
+            SSL_CTX *ssl;
+            std::atomic<bool> running;
 
-            struct event_base *base;
-            bool loopExit;
+            std::vector<LoopEntry *> loops;
+
+            // the jobs of the workers.
+            std::vector<Thread *> workers;
+            std::mutex jobsMutex;
+            std::condition_variable jobsSignal;
+            std::deque<Job *> jobs;
+            bool stopping;
 
             ContextEntry();
+
+            // Returns false if the workers are stopping, the job is not posted.
+            bool post(Job *job);
         };
 
         ContextEntry _httpContext;
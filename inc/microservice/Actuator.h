@@ -53,6 +53,8 @@ namespace Microservice {
         HttpStatus onEnvironment(const HttpRequest &request, HttpResponse &response);
 
         HttpStatus onProcessId(const HttpRequest &request, HttpResponse &response);
+
+        HttpStatus onServiceRegistry(const HttpRequest &request, HttpResponse &response);
     };
 
     class Actuator : public IHttpAction, public IActuator {
@@ -67,12 +69,18 @@ namespace Microservice {
 
         HttpStatus onAction(const HttpRequest &request, HttpResponse &response) override;
 
+    private:
+        void addRoute(const String &path, HttpCallback<IActuator>::Method method);
+
     private:
         static HttpStatus onAction(void *parameter, const HttpRequest &request, HttpResponse &response);
 
     private:
         HttpServer _httpServer;
 
+        HttpRouter _router;
+        PList<HttpCallback<IActuator>> _callbacks;
+
     private:
         static const HttpHeader ContentTypeHeader;
     };
@@ -10,11 +10,13 @@
 #define HttpService_h
 
 #include "data/String.h"
+#include "data/HashDictionary.h"
 #include "database/SqlSelectFilter.h"
 #include "system/ServiceFactory.h"
 #include "database/DataTable.h"
 #include "thread/Timer.h"
 #include "http/HttpServer.h"
+#include "http/HttpRouter.h"
 
 using namespace Data;
 using namespace Http;
@@ -149,6 +151,10 @@ namespace Microservice {
 
         const HttpMethod &method() const;
 
+        const String &path() const;
+
+        virtual BaseHttpMapping *clone() const = 0;
+
         virtual HttpStatus execute(const HttpRequest &request, HttpResponse &response) = 0;
 
     protected:
@@ -163,7 +169,7 @@ namespace Microservice {
                 method, path), _callback(callback) {
         }
 
-        HttpMapping *clone() const {
+        HttpMapping *clone() const override {
             return new HttpMapping(_method, _path, _callback);
         }
 
@@ -186,7 +192,7 @@ namespace Microservice {
                 : BaseHttpMapping(method, path), _callback(callback) {
         }
 
-        HttpQueryMapping *clone() const {
+        HttpQueryMapping *clone() const override {
             return new HttpQueryMapping(_method, _path, _callback);
         }
 
@@ -262,8 +268,7 @@ namespace Microservice {
 
         template<class T>
         void registerMapping(const HttpMapping<T> &mapping) {
-            Locker locker(&_mappingsMutex);
-            _mappings.add(mapping.clone());
+            addMapping(mapping.clone());
         }
 
         template<class T>
@@ -275,8 +280,7 @@ namespace Microservice {
 
         template<class T>
         void registerQuery(const HttpQueryMapping<T> &mapping) {
-            Locker locker(&_mappingsMutex);
-            _mappings.add(mapping.clone());
+            addMapping(mapping.clone());
         }
 
         template<class T>
@@ -302,15 +306,22 @@ namespace Microservice {
                 }
             }
             for (size_t i = 0; i < removed.count(); i++) {
-                _mappings.remove(removed[i]);
+                BaseHttpMapping *mapping = removed[i];
+                _router.remove(mapping->method(), mapping->path(), mapping);
+                _mappings.remove(mapping);
             }
         }
 
         void clearMapping();
 
+    protected:
+        void addMapping(BaseHttpMapping *mapping);
+
     protected:
         Mutex _mappingsMutex;
         HttpMappings _mappings;
+        // the mappings by the method and the path.
+        HttpRouter _router;
     };
 
     class IHttpSession : public IService {
@@ -414,7 +425,7 @@ namespace Microservice {
         Mutex _sessionsMutex;
         Timer *_sessionTimer;
 
-        StringMap _extMineTypes;
+        HashDictionary<String, String> _extMineTypes;
     };
 }
 
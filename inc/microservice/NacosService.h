@@ -11,9 +11,11 @@
 
 #include "data/String.h"
 #include "http/HttpContent.h"
+#include "thread/Timer.h"
 #include "microservice/ServiceGovernance.h"
 
 using namespace Data;
+using namespace Threading;
 
 namespace Microservice
 {
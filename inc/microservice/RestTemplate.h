@@ -45,6 +45,7 @@ namespace Microservice {
 
         bool put(const String &url, const String &body, String &result, const HttpHeaders &headers = DefaultHeaders);
 
+        // Resolves the url by the load balancer, under the lock, the balancer is shared by the requests.
         Url parseUrl(const String &original);
 
     private:
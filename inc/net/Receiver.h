@@ -12,10 +12,60 @@
 #include "data/String.h"
 #include "data/TimeSpan.h"
 #include "EscapeOption.h"
+#include "thread/TickTimeout.h"
 
 using namespace Data;
+using namespace Threading;
 
 namespace Net {
+    class Receiver;
+
+    // Byte ring buffer holding the data read ahead by a receiver, frames are cut from it in memory.
+    class ReceiveBuffer {
+    public:
+        explicit ReceiveBuffer(size_t capacity = DefaultCapacity);
+
+        ReceiveBuffer(const ReceiveBuffer &) = delete;
+
+        ~ReceiveBuffer();
+
+        ReceiveBuffer &operator=(const ReceiveBuffer &) = delete;
+
+        size_t count() const;
+
+        bool isEmpty() const;
+
+        size_t capacity() const;
+
+        uint8_t at(size_t pos) const;
+
+        ssize_t find(const uint8_t *bytes, size_t length, size_t from = 0) const;
+
+        size_t read(uint8_t *data, size_t count);
+
+        size_t read(ByteArray *buffer, size_t count);
+
+        size_t skip(size_t count);
+
+        size_t write(const uint8_t *data, size_t count);
+
+        ssize_t receive(Receiver *receiver, size_t count);
+
+        void clear();
+
+    private:
+        void reserve(size_t capacity);
+
+    private:
+        uint8_t *_array;
+        size_t _capacity;
+        size_t _front;
+        size_t _count;
+
+    private:
+        static const size_t DefaultCapacity = 1024;     // 1K
+    };
+
     class Receiver {
     public:
         Receiver();
@@ -36,6 +86,8 @@ namespace Net {
 
         virtual void clearReceiveBuffer();
 
+        virtual bool waitAvailable(uint32_t timeout);
+
         ssize_t receive(size_t count, ByteArray &buffer);
 
         ssize_t receive(size_t count, String &str);
@@ -70,6 +122,23 @@ namespace Net {
 
         ssize_t getLengthByLine(uint32_t timeout, const char *newLine = "\n");
 
+        size_t bufferedCount() const;
+
+    public:
+        // Checks the condition of the owner periodically, used if there is no readiness notification.
+        static bool pollAvailable(uint32_t timeout, delay_callback available, void *owner);
+
+    protected:
+        // The data is read ahead from the source by them, the subclasses counting the buffered data
+        // in available() and returning it by receive() override them to bypass the buffer.
+        virtual size_t availableInner();
+
+        virtual ssize_t receiveInner(uint8_t *buffer, off_t offset, size_t count);
+
+        virtual bool waitAvailableInner(uint32_t timeout);
+
+        size_t receiveFromBuffer(uint8_t *buffer, size_t count);
+
     private:
         ssize_t getLengthByEndBytes(const ByteArray &endBuffer, uint32_t timeout);
 
@@ -89,6 +158,17 @@ namespace Net {
 
         ssize_t receiveDirectly(ByteArray *buffer, size_t count);
 
+        bool waitUntil(uint32_t startTime, uint32_t deadTime);
+
+        size_t receiveToBuffer(uint32_t startTime, uint32_t deadTime);
+
+        static bool hasAvailable(void *parameter);
+
+    private:
+        friend class ReceiveBuffer;
+
+        ReceiveBuffer _buffer;
+
     public:
         static const size_t BufferLength = 65535;
     };
@@ -38,6 +38,8 @@ namespace Net {
 
         size_t available() override;
 
+        bool waitAvailable(uint32_t timeout) override;
+
         ssize_t send(const uint8_t *buffer, off_t offset, size_t count) override;
 
         ssize_t receive(uint8_t *buffer, off_t offset, size_t count) override;
@@ -105,6 +107,13 @@ namespace Net {
     public:
         static void initializeSocket();
 
+    protected:
+        size_t availableInner() override;
+
+        ssize_t receiveInner(uint8_t *buffer, off_t offset, size_t count) override;
+
+        bool waitAvailableInner(uint32_t timeout) override;
+
     private:
         bool updateEndpoints(int ai_family);
 
@@ -118,6 +127,8 @@ namespace Net {
 
         bool isWriteSet(uint32_t timeout) const;
 
+        bool isReadSet(uint32_t timeout) const;
+
     protected:
         int _socket;
         bool _connected;
@@ -157,8 +168,6 @@ namespace Net {
 
         ssize_t peek(uint8_t *data, size_t count);
 
-        size_t available() override;
-
         SSLVersion sslVersion() const;
 
         bool peek() const;
@@ -176,6 +185,9 @@ namespace Net {
     public:
         static void initializeSSL();
 
+    protected:
+        size_t availableInner() override;
+
     private:
         void setSSLContext(void *context);
 
@@ -209,8 +221,6 @@ namespace Net {
 
         ~WebSocketClient() override;
 
-        size_t available() override;
-
         void clearReceiveBuffer() override;
 
         void disableDecoding();
@@ -234,6 +244,8 @@ namespace Net {
         };
 
     protected:
+        size_t availableInner() override;
+
         ssize_t write(const uint8_t *data, size_t count) override;
 
         ssize_t read(uint8_t *data, size_t count) override;
@@ -268,8 +280,6 @@ namespace Net {
 
         ~WebSocketSSLClient() override;
 
-        size_t available() override;
-
         void clearReceiveBuffer() override;
 
         void disableDecoding();
@@ -293,6 +303,8 @@ namespace Net {
         };
 
     protected:
+        size_t availableInner() override;
+
         ssize_t write(const uint8_t *data, size_t count) override;
 
         ssize_t read(uint8_t *data, size_t count) override;
@@ -21,8 +21,10 @@ namespace Rpc {
     class RpcClientContext : IEvaluation<RpcClientContext>, IEquatable<RpcClientContext> {
     public:
         Endpoint endpoint;
+        // the sync calls share the connection without waiting for each other, see RpcPipeline.
+        bool pipelined;
 
-        explicit RpcClientContext(const Endpoint &endpoint);
+        explicit RpcClientContext(const Endpoint &endpoint, bool pipelined = false);
 
         RpcClientContext(const RpcClientContext &other);
 
@@ -58,6 +60,9 @@ namespace Rpc {
 
         RpcStatus notify(const RpcMethodContext &context, const IRpcNotifyInfo &info) final;
 
+        // The pipelined calls waiting for the responses.
+        size_t pendingCount() const;
+
     protected:
         bool sendSync(const RpcMethodContext &context, const RpcSyncRequest &request, RpcSyncResponse &response,
                       const String &name) final;
@@ -68,6 +73,8 @@ namespace Rpc {
 
         bool sendAsync(const Endpoint &peerEndpoint, const RpcAsyncResponse &response, const String &name) final;
 
+        bool onPipelinedResponse(const Uuid &token, Stream *stream) final;
+
         virtual void onServerStatusChanged(bool online);
 
     private:
@@ -82,9 +89,12 @@ namespace Rpc {
 
         static void samplerStatusEventHandler(void *owner, void *sender, EventArgs *args);
 
+        static bool sendBatch(void *owner);
+
     private:
         RpcClientContext _context;
         ClientService *_service;
+        RpcPipeline _pipeline;
     };
 
     typedef PList<RpcClient> RpcClients;
@@ -23,6 +23,8 @@ using namespace Data;
 using namespace Communication;
 
 namespace Rpc {
+    class RpcPipeline;
+
     class RpcStreamContext {
     public:
         RpcStreamContext();
@@ -199,6 +201,29 @@ namespace Rpc {
     class RpcAsyncResponseContext : public ElementAContext<RpcAsyncResponse>, public RpcStreamContext {
     };
 
+    // The queued requests of a pipeline in one frame, each of them is answered by an async response.
+    class RpcBatchRequest {
+    public:
+        explicit RpcBatchRequest(RpcPipeline *pipeline = nullptr);
+
+        // Drains the requests of the pipeline.
+        void write(Stream *stream) const;
+
+        // Reads the count only, the requests follow it in the stream.
+        void read(Stream *stream);
+
+        void copyFrom(const RpcBatchRequest *value);
+
+        uint32_t count() const;
+
+    private:
+        RpcPipeline *_pipeline;
+        uint32_t _count;
+    };
+
+    class RpcBatchRequestContext : public ElementAContext<RpcBatchRequest>, public RpcStreamContext {
+    };
+
     class RpcNotifyInfo {
     public:
         explicit RpcNotifyInfo(const RpcMethodContext &context = RpcMethodContext(), const IRpcNotifyInfo *info = nullptr);
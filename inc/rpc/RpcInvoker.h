@@ -9,6 +9,9 @@
 #ifndef RpcInvoker_h
 #define RpcInvoker_h
 
+#include <condition_variable>
+#include <mutex>
+#include <vector>
 #include "data/String.h"
 #include "rpc/RpcContext.h"
 #include "rpc/RpcInstructionContext.h"
@@ -94,6 +97,75 @@ namespace Rpc {
         PList<RpcMethod> _methods;
     };
 
+    // The calls of a connection sent without waiting for the responses of the former ones.
+    // The responses are matched by the tokens of the requests, so they may come back in any order.
+    // The requests are serialized into one reused buffer, the ones queued before a send go in one batch frame.
+    class RpcPipeline {
+    public:
+        // Queues a batch request of the pipeline, false if it can not be sent.
+        typedef bool (*schedule_callback)(void *owner);
+
+        RpcPipeline(schedule_callback action, void *owner);
+
+        ~RpcPipeline();
+
+        RpcPipeline(const RpcPipeline &) = delete;
+
+        RpcPipeline &operator=(const RpcPipeline &) = delete;
+
+        // Waits for the response at most timeout milliseconds, the other threads may call it at the same time.
+        RpcStatus invoke(const RpcMethodContext &context, const IRpcSyncRequestData &request,
+                         IRpcSyncResponseData &response, uint32_t timeout);
+
+        // Writes the queued requests of one batch, called when the batch frame is built.
+        void drain(Stream *stream);
+
+        // Reads the response into the waiting call, false if the token is not of a pending call.
+        bool complete(const Uuid &token, Stream *stream);
+
+        // Fails all the pending calls, e.g. the connection is lost.
+        void cancel();
+
+        size_t pendingCount() const;
+
+    public:
+        // the queued requests over it are sent in the next batch.
+        static const size_t MaxBatchLength = 1024 * 1024;
+
+    private:
+        struct Call {
+            IRpcSyncResponseData *response;
+            int status;
+            std::condition_variable condition;
+
+            explicit Call(IRpcSyncResponseData *response);
+        };
+
+        typedef Map<Uuid, Call> Calls;
+
+        // A request queued in the buffer, not drained yet.
+        struct Request {
+            Uuid token;
+            size_t length;
+        };
+
+        bool schedule();
+
+        // Removes the call and the request of it if not drained, called in the lock.
+        void remove(const Uuid &token);
+
+    private:
+        schedule_callback _action;
+        void *_owner;
+
+        mutable std::mutex _mutex;
+        Calls _calls;
+        ByteArray _buffer;
+        std::vector<Request> _requests; // the requests in the buffer, in order.
+        bool _scheduled;                // a batch request is queued but not drained.
+        uint64_t _drainCount;
+    };
+
     class RpcSenderEventContainer;
 
     class IRpcSenderEvent {
@@ -139,6 +211,9 @@ namespace Rpc {
 
         bool onAsyncResponseSetValue(const RpcMethodContext &context, Stream *stream, const Uuid &token) final;
 
+        // Completes a pipelined call by the token of the response, false if it is not one.
+        virtual bool onPipelinedResponse(const Uuid &token, Stream *stream);
+
     private:
         Mutex _asyncElementsMutex;
         RpcAsyncElements _asyncElements;
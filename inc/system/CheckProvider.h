@@ -81,6 +81,14 @@ namespace System {
     typedef CrcConfig<Crc16Type> Crc16Config;
     typedef CrcConfig<Crc32Type> Crc32Config;
 
+    // The slice-by-8 tables of config, the k-th 256 entries are for a byte followed by k bytes.
+    // The tables of the standard presets are generated at compile time, the others are built once and shared.
+    const Crc8Type *crcTables(const Crc8Config &config);
+
+    const Crc16Type *crcTables(const Crc16Config &config);
+
+    const Crc32Type *crcTables(const Crc32Config &config);
+
     // Cyclic Redundancy Check
     template<class Type>
     class CrcProvider : public CheckProvider<Type> {
@@ -95,23 +103,7 @@ namespace System {
         }
 
         Type calc(const uint8_t *buffer, size_t count) override {
-            Type pos;
-            Type crc;
-            if (_config.refIn) {
-                assert(_config.refOut);
-                crc = reverseValue(_config.init, _width);
-                while (count--) {
-                    pos = (0xFF & crc) ^ (*buffer++);
-                    crc = _width == 8 ? _table[pos & 0xFF] : (crc >> 8) ^ _table[pos & 0xFF];
-                }
-            } else {
-                crc = _config.init;
-                while (count--) {
-                    pos = (crc >> (_width - 8)) ^ (*buffer++);
-                    crc = _width == 8 ? _table[pos & 0xFF] : (crc << 8) ^ _table[pos & 0xFF];
-                }
-            }
-            return crc ^ _config.xorOut;
+            return update(_initial, buffer, count) ^ _config.xorOut;
         }
 
         // calcDirectly from buffer.
@@ -161,42 +153,62 @@ namespace System {
             return calcDirectly((const uint8_t *) buffer.c_str(), 0, buffer.length());
         }
 
+    public:
+        static const int Count = 256;
+        static const int Slices = 8;
+
     protected:
         void init() {
-            Type crc;
             if (_config.refIn) {
                 assert(_config.refOut);
-                Type bits = 1;
-                auto reversePoly = reverseValue(_config.poly, _width);
-                for (int i = 0; i < Count; ++i) {
-                    crc = (Type) (i);
-                    for (int j = 0; j < 8; ++j) {
-                        if (crc & bits)
-                            crc = (crc >> 1) ^ reversePoly;
-                        else
-                            crc = (crc >> 1);
-                    }
-                    _table[i] = crc;
-                }
+                _initial = reverseValue(_config.init, _width);
             } else {
-                Type bits = 1 << (_width - 1);
-                for (int i = 0; i < Count; ++i) {
-                    crc = (Type) (i << (_width - 8));
-                    for (int j = 0; j < 8; ++j) {
-                        if (crc & bits)
-                            crc = (crc << 1) ^ _config.poly;
-                        else
-                            crc = (crc << 1);
-                    }
-                    _table[i] = crc;
-                }
+                _initial = _config.init;
             }
+            _tables = crcTables(_config);
         }
 
         const CrcConfig<Type> &config() const {
             return _config;
         }
 
+        // Updates the register crc by buffer, 8 bytes a step, the register is reflected if refIn.
+        virtual Type update(Type crc, const uint8_t *buffer, size_t count) const {
+            const Type *t = _tables;
+            if (_config.refIn) {
+                for (; count >= 8; buffer += 8, count -= 8) {
+                    uint64_t value = (uint64_t) crc ^
+                                     ((uint64_t) buffer[0] | (uint64_t) buffer[1] << 8 |
+                                      (uint64_t) buffer[2] << 16 | (uint64_t) buffer[3] << 24 |
+                                      (uint64_t) buffer[4] << 32 | (uint64_t) buffer[5] << 40 |
+                                      (uint64_t) buffer[6] << 48 | (uint64_t) buffer[7] << 56);
+                    crc = t[7 * Count + (value & 0xFF)] ^ t[6 * Count + ((value >> 8) & 0xFF)] ^
+                          t[5 * Count + ((value >> 16) & 0xFF)] ^ t[4 * Count + ((value >> 24) & 0xFF)] ^
+                          t[3 * Count + ((value >> 32) & 0xFF)] ^ t[2 * Count + ((value >> 40) & 0xFF)] ^
+                          t[1 * Count + ((value >> 48) & 0xFF)] ^ t[value >> 56];
+                }
+                while (count--) {
+                    crc = (Type) (crc >> 8) ^ t[(crc ^ *buffer++) & 0xFF];
+                }
+            } else {
+                for (; count >= 8; buffer += 8, count -= 8) {
+                    uint64_t value = ((uint64_t) crc << (64 - _width)) ^
+                                     ((uint64_t) buffer[0] << 56 | (uint64_t) buffer[1] << 48 |
+                                      (uint64_t) buffer[2] << 40 | (uint64_t) buffer[3] << 32 |
+                                      (uint64_t) buffer[4] << 24 | (uint64_t) buffer[5] << 16 |
+                                      (uint64_t) buffer[6] << 8 | (uint64_t) buffer[7]);
+                    crc = t[7 * Count + (value >> 56)] ^ t[6 * Count + ((value >> 48) & 0xFF)] ^
+                          t[5 * Count + ((value >> 40) & 0xFF)] ^ t[4 * Count + ((value >> 32) & 0xFF)] ^
+                          t[3 * Count + ((value >> 24) & 0xFF)] ^ t[2 * Count + ((value >> 16) & 0xFF)] ^
+                          t[1 * Count + ((value >> 8) & 0xFF)] ^ t[value & 0xFF];
+                }
+                while (count--) {
+                    crc = (Type) (crc << 8) ^ t[((crc >> (_width - 8)) ^ *buffer++) & 0xFF];
+                }
+            }
+            return crc;
+        }
+
     private:
         Type reverseValue(Type val, int width) {
             Type rv = 0;
@@ -212,8 +224,8 @@ namespace System {
 
         Type _width;
 
-        static const int Count = 256;
-        Type _table[Count];
+        Type _initial;          // the register before the first byte.
+        const Type *_tables;    // Slices * Count entries, shared by the providers of the same poly.
     };
 
     class Crc8Provider : public CrcProvider<Crc8Type> {
@@ -273,6 +285,9 @@ namespace System {
 
         ~Crc32Provider() override;
 
+        // Whether calc runs on the CPU instructions.
+        bool isAccelerated() const;
+
     public:
         static Crc32Provider CRC32;
         static Crc32Provider BZIP2;
@@ -284,6 +299,21 @@ namespace System {
         static Crc32Provider C;
         static Crc32Provider D;
         static Crc32Provider Q;
+
+    protected:
+        // Runs on PCLMULQDQ for CRC32, on SSE4.2 for C, or on the ARMv8 CRC32 instructions if the CPU has them.
+        Crc32Type update(Crc32Type crc, const uint8_t *buffer, size_t count) const override;
+
+    private:
+        typedef Crc32Type (*Kernel)(Crc32Type crc, const uint8_t *buffer, size_t count);
+
+        static Kernel hardwareKernel(const Crc32Config &config);
+
+    private:
+        Kernel _kernel;     // nullptr if the CPU has no instructions for the config.
+
+        // the buffers shorter than it run on the tables.
+        static const size_t MinHardwareCount = 64;
     };
 }
 
@@ -29,6 +29,11 @@
 #  define COMMON_ATTR_DEPRECATED(msg) COMMON_ATTRIBUTE(deprecated)
 #endif
 
+#if !defined(COMMON_ATTR_PRINTF)
+// the literal format strings are checked against the arguments by the compiler.
+#  define COMMON_ATTR_PRINTF(formatIndex, firstArg) COMMON_ATTRIBUTE(format(printf, formatIndex, firstArg))
+#endif
+
 #ifdef __APPLE__
 # include <TargetConditionals.h>
 #endif
@@ -41,6 +41,9 @@ namespace System {
 
         bool isMatch(const String &input);
 
+        // The input is not copied, it needs no terminating zero.
+        bool isMatch(const char *input, size_t length);
+
         bool match(const String &input, StringArray &groups);
 
     private:
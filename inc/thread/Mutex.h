@@ -10,6 +10,7 @@
 #define Mutex_h
 
 #include <mutex>
+#include <atomic>
 
 using namespace std;
 
@@ -42,7 +43,11 @@ namespace Threading {
         void unlock() override;
 
     private:
-        mutex *_mutex;
+        mutex *get();
+
+    private:
+        // created at the first lock, most of the containers are never locked.
+        std::atomic<mutex *> _mutex;
     };
 
     class RecursiveMutex : public IMutex {
@@ -62,6 +67,20 @@ namespace Threading {
     private:
         recursive_mutex *_mutex;
     };
+
+    // No lock at all, used by the containers which are never shared between threads.
+    class NullMutex {
+    public:
+        inline void lock() {
+        }
+
+        inline bool tryLock() {
+            return true;
+        }
+
+        inline void unlock() {
+        }
+    };
 }
 
 #endif // Mutex_h
@@ -12,6 +12,8 @@
 #include "system/Action.h"
 #include "thread/Thread.h"
 #include "thread/Locker.h"
+#include <mutex>
+#include <condition_variable>
 
 using namespace System;
 
@@ -58,11 +60,15 @@ namespace Threading {
         Mutex _mutex;
     };
 
+    class TaskWhen;
+
+    class Task;
+
     class TaskBackground {
     public:
         TaskBackground();
 
-        virtual ~TaskBackground() = default;
+        virtual ~TaskBackground();
 
         virtual void *resultPtr() = 0;
 
@@ -86,16 +92,65 @@ namespace Threading {
             return r != nullptr ? r->getValue() : TResult();
         }
 
+        // Execute it in the current thread, returns false if it has been taken by another thread.
+        bool run();
+
+        void retain();
+
+        void release();
+
     protected:
         void start();
 
+        void complete();
+
+    private:
+        void addContinuation(TaskWhen *when, size_t index);
+
     private:
-        Thread _thread;
+        struct Continuation {
+            TaskWhen *when;
+            size_t index;
+            Continuation *next;
+        };
+
+        std::atomic<TaskStatus> _status;
+        std::atomic<bool> _taken;
+        std::atomic<int> _refCount;
+
+        bool _completed;
+        std::thread::id _runner;
+        Continuation *_continuations;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _completedSignal;
 
-        TaskStatus _status;
+        friend TaskWhen;
+        friend Task;
     };
 
-    class Task;
+    // Completed by the continuations of the other tasks, never executed by the executor.
+    class TaskWhen : public TaskBackground {
+    public:
+        TaskWhen(bool any, size_t count);
+
+        ~TaskWhen() override;
+
+        void *resultPtr() override;
+
+    private:
+        void notify(size_t index);
+
+    private:
+        bool _any;
+        std::atomic<size_t> _remaining;
+        std::atomic<bool> _notified;
+
+        TaskResult<int> _result;
+
+        friend TaskBackground;
+        friend Task;
+    };
 
     template<class TResult>
     class TaskState : public TaskBackground {
@@ -222,6 +277,24 @@ namespace Threading {
             return Task(f, args...);
         }
 
+        // The task is completed when all of the tasks are completed.
+        static Task whenAll(Task *tasks[], size_t count);
+
+        template<class... Tasks>
+        static Task whenAll(Task &task, Tasks &... tasks) {
+            Task *list[] = {&task, &tasks...};
+            return whenAll(list, sizeof...(tasks) + 1);
+        }
+
+        // The task is completed when any of the tasks is completed, result<int>() is the index of it.
+        static Task whenAny(Task *tasks[], size_t count);
+
+        template<class... Tasks>
+        static Task whenAny(Task &task, Tasks &... tasks) {
+            Task *list[] = {&task, &tasks...};
+            return whenAny(list, sizeof...(tasks) + 1);
+        }
+
     private:
         TaskBackground *_state;
     };
@@ -0,0 +1,91 @@
+//
+//  TaskExecutor.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef TaskExecutor_h
+#define TaskExecutor_h
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "thread/Thread.h"
+#include "thread/Timer.h"
+
+namespace Threading {
+    class TaskBackground;
+
+    // Work stealing pool, one deque per worker, the idle workers steal from the others.
+    class TaskExecutor {
+    public:
+        static TaskExecutor *instance();
+
+        void post(TaskBackground *task);
+
+        size_t workerCount() const;
+
+        size_t maxWorkerCount() const;
+
+        void setMaxWorkerCount(size_t count);
+
+    public:
+        static const size_t MaxWorkerCount = 256;
+
+    private:
+        class Worker {
+        public:
+            Worker();
+
+            ~Worker();
+
+            void push(TaskBackground *task);
+
+            TaskBackground *pop();
+
+            TaskBackground *steal();
+
+        public:
+            Thread *thread;
+
+        private:
+            std::mutex _mutex;
+            std::deque<TaskBackground *> _tasks;
+        };
+
+        TaskExecutor();
+
+        ~TaskExecutor();
+
+        void addWorker();
+
+        TaskBackground *take(size_t index);
+
+        void workerProc(size_t index);
+
+        void monitorProc();
+
+    private:
+        static const uint64_t BlockedTime = 50;
+
+        Worker *_workers[MaxWorkerCount];
+        std::atomic<size_t> _workerCount;
+        size_t _maxWorkerCount;
+        std::mutex _workersMutex;
+
+        std::atomic<size_t> _next;
+        std::atomic<size_t> _pending;
+        std::atomic<size_t> _idleCount;
+        std::atomic<uint64_t> _progress;
+
+        std::mutex _idleMutex;
+        std::condition_variable _idleSignal;
+
+        Timer *_monitorTimer;
+    };
+}
+
+#endif // TaskExecutor_h
@@ -24,8 +24,10 @@ namespace Threading {
                 return false;
 
             auto group = new Group(name, interval, f, args...);
-            Locker locker(&_groups);
+            _groups.lock();
             _groups.add(group);
+            _groups.unlock();
+            reschedule();
             return true;
         }
 
@@ -50,6 +52,8 @@ namespace Threading {
     private:
         void taskTimeUp();
 
+        void reschedule();
+
     private:
         class Group {
         public:
@@ -64,6 +68,9 @@ namespace Threading {
 
             bool isTimeUp();
 
+            // milliseconds until the next time up.
+            uint64_t remaining(uint64_t now) const;
+
             void execute() const;
 
             void change(const String &name, const TimeSpan &interval);
@@ -77,7 +84,12 @@ namespace Threading {
 
         typedef PList<Group> Groups;
 
+#ifdef __EMSCRIPTEN__
         Timer *_timer;
+#else
+        TimerService::Entry *_entry;
+        std::atomic<bool> _fired;
+#endif
 
         String _name;
         Groups _groups;
@@ -15,6 +15,12 @@
 #include "data/PList.h"
 #include "data/Dictionary.h"
 
+#ifndef __EMSCRIPTEN__
+
+#include "thread/TimerService.h"
+
+#endif
+
 namespace Threading {
     class Timer {
     public:
@@ -76,13 +82,9 @@ namespace Threading {
 
         void move(Timer &other);
 
-        void fire();
-
-#ifndef __EMSCRIPTEN__
-
-        void threadProc();
+#ifdef __EMSCRIPTEN__
 
-        bool msleepWithBreak(uint32_t start, uint32_t msec) const;
+        void fire();
 
 #endif
 
@@ -114,11 +116,7 @@ namespace Threading {
 #ifdef __EMSCRIPTEN__
         std::atomic<bool> _running;
 #else
-        bool _firstInvoke;
-        uint32_t _start;
-        std::atomic<bool> _loop;
-
-        Thread _thread;
+        TimerService::Entry *_entry;
 #endif
 
     private:
@@ -0,0 +1,119 @@
+//
+//  TimerService.h
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef TimerService_h
+#define TimerService_h
+
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "thread/Thread.h"
+#include "data/PList.h"
+
+namespace Threading {
+    // Shared hierarchical timer wheel, the timers are fired by a small worker pool instead of one thread per timer.
+    class TimerService {
+    public:
+        class Entry;
+
+        static TimerService *instance();
+
+        Entry *create(const String &name, Action &&action, int dueTime, int period);
+
+        // Stop the entry, wait at most timeout ms for the running callback and release it.
+        // A callback still running, or a caller on its worker, leaves the entry to the worker to release.
+        void destroy(Entry *entry, uint32_t timeout = DestroyTimeout);
+
+        void start(Entry *entry);
+
+        // Unschedule the entry, wait at most timeout ms for the running callback.
+        void stop(Entry *entry, uint32_t timeout);
+
+        void change(Entry *entry, int dueTime, int period);
+
+        bool running(const Entry *entry) const;
+
+        size_t timerCount() const;
+
+        size_t workerCount() const;
+
+        size_t maxWorkerCount() const;
+
+        void setMaxWorkerCount(size_t count);
+
+    public:
+        static const int MinPeriod = 10;    // same as Thread::msleep.
+        static const uint32_t DestroyTimeout = 10 * 1000;   // same as Timer::stop.
+
+    private:
+        TimerService();
+
+        ~TimerService();
+
+        void schedule(Entry *entry, uint64_t deadline);
+
+        void scheduleFirst(Entry *entry);
+
+        void addToWheel(Entry *entry);
+
+        void addToReady(Entry *entry);
+
+        void addWorker();
+
+        void unlink(Entry *entry);
+
+        void cascade(int level, size_t index);
+
+        void advance(uint64_t now);
+
+        uint64_t nextWakeTick() const;
+
+        uint64_t now() const;
+
+        void wheelProc();
+
+        void workerProc();
+
+    private:
+        static const int SlotBits = 6;
+        static const int SlotCount = 1 << SlotBits;
+        static const int SlotMask = SlotCount - 1;
+        static const int LevelCount = 5;
+        static const uint64_t MaxRange = (uint64_t) 1 << (SlotBits * LevelCount);
+        static const uint64_t NoWake = UINT64_MAX;
+        static const size_t DefaultMaxWorkerCount = 1024;
+        static const uint64_t BlockedTime = 10;
+
+        std::chrono::steady_clock::time_point _epoch;
+
+        Entry *_wheel[LevelCount][SlotCount];
+        uint64_t _level0Bitmap;
+        uint64_t _current;
+        uint64_t _wakeTick;
+        size_t _scheduledCount;
+
+        Entry *_readyHead;
+        Entry *_readyTail;
+        size_t _readyCount;
+
+        size_t _count;
+        size_t _idleCount;
+        size_t _coreWorkerCount;
+        size_t _maxWorkerCount;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _wheelSignal;
+        std::condition_variable _readySignal;
+        std::condition_variable _doneSignal;
+
+        Thread *_wheelThread;
+        PList<Thread> _workers;
+    };
+}
+
+#endif // TimerService_h
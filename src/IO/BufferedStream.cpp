@@ -0,0 +1,175 @@
+//
+//  BufferedStream.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "IO/BufferedStream.h"
+#include "exception/Exception.h"
+#include "system/Math.h"
+
+using namespace System;
+
+namespace IO {
+    BufferedStream::BufferedStream(Stream *stream, size_t bufferSize) : _stream(stream), _writeCount(0),
+                                                                        _readPosition(0), _readCount(0) {
+        if (stream == nullptr) {
+            throw ArgumentNullException("stream");
+        }
+        _bufferSize = bufferSize > 0 ? bufferSize : DefaultBufferSize;
+        _buffer = new uint8_t[_bufferSize];
+    }
+
+    BufferedStream::~BufferedStream() {
+        flushWrite();
+        delete[] _buffer;
+        _buffer = nullptr;
+    }
+
+    ssize_t BufferedStream::write(const uint8_t *array, off_t offset, size_t count) {
+        if (array == nullptr || count == 0) {
+            return 0;
+        }
+        if (!discardRead()) {
+            return -1;
+        }
+
+        if (_writeCount + count > _bufferSize) {
+            if (!flushWrite()) {
+                return -1;
+            }
+            if (count >= _bufferSize) {
+                // too large to be buffered.
+                return _stream->write(array, offset, count);
+            }
+        }
+        memcpy(_buffer + _writeCount, array + offset, count);
+        _writeCount += count;
+        return (ssize_t) count;
+    }
+
+    ssize_t BufferedStream::read(uint8_t *array, off_t offset, size_t count) {
+        if (array == nullptr || count == 0) {
+            return 0;
+        }
+        if (!flushWrite()) {
+            return -1;
+        }
+
+        size_t total = 0;
+        while (total < count) {
+            if (_readPosition < _readCount) {
+                size_t length = Math::min(count - total, _readCount - _readPosition);
+                memcpy(array + offset + total, _buffer + _readPosition, length);
+                _readPosition += length;
+                total += length;
+            } else if (count - total >= _bufferSize) {
+                // too large to be buffered.
+                ssize_t length = _stream->read(array, offset + (off_t) total, count - total);
+                if (length <= 0) {
+                    break;
+                }
+                total += length;
+            } else {
+                ssize_t length = _stream->read(_buffer, 0, _bufferSize);
+                if (length <= 0) {
+                    break;
+                }
+                _readPosition = 0;
+                _readCount = length;
+            }
+        }
+        return (ssize_t) total;
+    }
+
+    off_t BufferedStream::position() const {
+        off_t position = _stream->position();
+        if (position < 0) {
+            return position;
+        }
+        return position + (off_t) _writeCount - (off_t) (_readCount - _readPosition);
+    }
+
+    size_t BufferedStream::length() const {
+        size_t length = _stream->length();
+        if (_writeCount > 0) {
+            off_t end = _stream->position() + (off_t) _writeCount;
+            if (end > (off_t) length) {
+                length = end;
+            }
+        }
+        return length;
+    }
+
+    off_t BufferedStream::seek(off_t offset, SeekOrigin origin) {
+        if (!flushWrite()) {
+            return -1;
+        }
+        if (origin == SeekCurrent) {
+            // the stream is ahead of this one by the unread bytes.
+            offset -= (off_t) (_readCount - _readPosition);
+        }
+        _readPosition = _readCount = 0;
+        return _stream->seek(offset, origin);
+    }
+
+    bool BufferedStream::canWrite() const {
+        return _stream->canWrite();
+    }
+
+    bool BufferedStream::canRead() const {
+        return _stream->canRead();
+    }
+
+    bool BufferedStream::canSeek() const {
+        return _stream->canSeek();
+    }
+
+    void BufferedStream::flush() {
+        flushWrite();
+        _stream->flush();
+    }
+
+    void BufferedStream::close() {
+        flushWrite();
+        _readPosition = _readCount = 0;
+        _stream->close();
+    }
+
+    Stream *BufferedStream::stream() const {
+        return _stream;
+    }
+
+    size_t BufferedStream::bufferSize() const {
+        return _bufferSize;
+    }
+
+    bool BufferedStream::flushWrite() {
+        size_t written = 0;
+        while (written < _writeCount) {
+            ssize_t length = _stream->write(_buffer, (off_t) written, _writeCount - written);
+            if (length <= 0) {
+                // keeps the unwritten bytes for the next flush.
+                memmove(_buffer, _buffer + written, _writeCount - written);
+                _writeCount -= written;
+                return false;
+            }
+            written += length;
+        }
+        _writeCount = 0;
+        return true;
+    }
+
+    bool BufferedStream::discardRead() {
+        if (_readPosition < _readCount) {
+            // the unread bytes can not be given back to a stream without seeking, keeps them.
+            if (!_stream->canSeek() || _stream->seek(-(off_t) (_readCount - _readPosition), SeekCurrent) < 0) {
+                return false;
+            }
+        }
+        _readPosition = _readCount = 0;
+        return true;
+    }
+}
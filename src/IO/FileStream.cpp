@@ -14,6 +14,7 @@
 #else
 
 #include <termios.h>
+#include <fcntl.h>
 
 #endif
 
@@ -188,6 +189,15 @@ namespace IO {
         }
     }
 
+    bool FileStream::setSequential(bool sequential) {
+#ifdef POSIX_FADV_SEQUENTIAL
+        if (isOpen()) {
+            return posix_fadvise(_fd, 0, 0, sequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL) == 0;
+        }
+#endif
+        return false;
+    }
+
     off_t FileStream::seek(off_t offset, SeekOrigin origin) {
         if (isOpen()) {
             return ::lseek(_fd, offset, origin);
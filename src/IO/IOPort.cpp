@@ -37,6 +37,7 @@
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
+#include <poll.h>
 
 #endif
 
@@ -74,6 +75,15 @@ namespace IO {
     }
 
     ssize_t IOPort::receive(uint8_t *buffer, off_t offset, size_t count) {
+        // the bytes read ahead are returned at first.
+        size_t length = receiveFromBuffer(buffer + offset, count);
+        if (length > 0) {
+            return (ssize_t) length;
+        }
+        return receiveInner(buffer, offset, count);
+    }
+
+    ssize_t IOPort::receiveInner(uint8_t *buffer, off_t offset, size_t count) {
         ssize_t len = 0;
         if (isOpen()) {
 #ifdef WIN32
@@ -153,6 +163,15 @@ namespace IO {
     }
 
     size_t IOPort::available() {
+        // the bytes read ahead past the last frame are counted.
+        return bufferedCount() + availableInner();
+    }
+
+    bool IOPort::waitAvailable(uint32_t timeout) {
+        return bufferedCount() > 0 || waitAvailableInner(timeout);
+    }
+
+    size_t IOPort::availableInner() {
         size_t nb = 0;
         if (isOpen()) {
 #ifdef WIN32
@@ -169,6 +188,23 @@ namespace IO {
         return nb;
     }
 
+    bool IOPort::waitAvailableInner(uint32_t timeout) {
+#if defined(WIN32) || defined(MSYS)
+        return Receiver::waitAvailable(timeout);
+#else
+        if (availableInner() > 0) {
+            return true;
+        }
+        if (isOpen()) {
+            struct pollfd pfd_read{};
+            pfd_read.fd = _handle;
+            pfd_read.events = POLLIN;
+            return poll(&pfd_read, 1, (int) timeout) == 1 && availableInner() > 0;
+        }
+        return false;
+#endif
+    }
+
     bool IOPort::useReceiveTimeout() const {
         return false;
     }
@@ -14,6 +14,64 @@
 using namespace System;
 
 namespace IO {
+    // the spans up to it are swapped on the stack.
+    static const size_t SwapBufferSize = 4096;
+
+    static inline uint16_t byteSwap(uint16_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap16(value);
+#else
+        return (uint16_t) ((value >> 8) | (value << 8));
+#endif
+    }
+
+    static inline uint32_t byteSwap(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap32(value);
+#else
+        return ((value & 0xFF000000) >> 24) | ((value & 0x00FF0000) >> 8) |
+               ((value & 0x0000FF00) << 8) | ((value & 0x000000FF) << 24);
+#endif
+    }
+
+    static inline uint64_t byteSwap(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(value);
+#else
+        return ((uint64_t) byteSwap((uint32_t) value) << 32) | byteSwap((uint32_t) (value >> 32));
+#endif
+    }
+
+    // a plain loop without the aliasing of the value types, so the compiler vectorizes it.
+    template<class type>
+    static void byteSwap(uint8_t *dst, const uint8_t *src, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            type value;
+            memcpy(&value, src + i * sizeof(type), sizeof(type));
+            value = byteSwap(value);
+            memcpy(dst + i * sizeof(type), &value, sizeof(type));
+        }
+    }
+
+    static void byteSwap(uint8_t *dst, const uint8_t *src, size_t count, size_t size) {
+        switch (size) {
+            case 2:
+                byteSwap<uint16_t>(dst, src, count);
+                break;
+            case 4:
+                byteSwap<uint32_t>(dst, src, count);
+                break;
+            case 8:
+                byteSwap<uint64_t>(dst, src, count);
+                break;
+            default:
+                if (dst != src) {
+                    memcpy(dst, src, count * size);
+                }
+                break;
+        }
+    }
+
     Stream::Stream() = default;
 
     Stream::Stream(const Stream &stream) = default;
@@ -512,6 +570,117 @@ namespace IO {
         return true;
     }
 
+    bool Stream::writeInt16s(const int16_t *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(int16_t), bigEndian);
+    }
+
+    size_t Stream::readInt16s(int16_t *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(int16_t), bigEndian);
+    }
+
+    bool Stream::writeUInt16s(const uint16_t *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(uint16_t), bigEndian);
+    }
+
+    size_t Stream::readUInt16s(uint16_t *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(uint16_t), bigEndian);
+    }
+
+    bool Stream::writeInt32s(const int32_t *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(int32_t), bigEndian);
+    }
+
+    size_t Stream::readInt32s(int32_t *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(int32_t), bigEndian);
+    }
+
+    bool Stream::writeUInt32s(const uint32_t *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(uint32_t), bigEndian);
+    }
+
+    size_t Stream::readUInt32s(uint32_t *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(uint32_t), bigEndian);
+    }
+
+    bool Stream::writeInt64s(const int64_t *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(int64_t), bigEndian);
+    }
+
+    size_t Stream::readInt64s(int64_t *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(int64_t), bigEndian);
+    }
+
+    bool Stream::writeUInt64s(const uint64_t *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(uint64_t), bigEndian);
+    }
+
+    size_t Stream::readUInt64s(uint64_t *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(uint64_t), bigEndian);
+    }
+
+    bool Stream::writeFloats(const float *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(float), bigEndian);
+    }
+
+    size_t Stream::readFloats(float *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(float), bigEndian);
+    }
+
+    bool Stream::writeDoubles(const double *values, size_t count, bool bigEndian) {
+        return writeSpan(values, count, sizeof(double), bigEndian);
+    }
+
+    size_t Stream::readDoubles(double *values, size_t count, bool bigEndian) {
+        return readSpan(values, count, sizeof(double), bigEndian);
+    }
+
+    bool Stream::writeSpan(const void *values, size_t count, size_t size, bool bigEndian) {
+        if (count == 0) {
+            return true;
+        }
+        if (values == nullptr) {
+            return false;
+        }
+
+        size_t length = count * size;
+        auto data = (const uint8_t *) values;
+        if (isBigEndian() == bigEndian) {
+            return write(data, 0, length) == (ssize_t) length;
+        }
+
+        uint8_t stackBuffer[SwapBufferSize];
+        uint8_t *buffer = length <= SwapBufferSize ? stackBuffer : new uint8_t[length];
+        byteSwap(buffer, data, count, size);
+        bool result = write(buffer, 0, length) == (ssize_t) length;
+        if (buffer != stackBuffer) {
+            delete[] buffer;
+        }
+        return result;
+    }
+
+    size_t Stream::readSpan(void *values, size_t count, size_t size, bool bigEndian) {
+        if (values == nullptr || count == 0) {
+            return 0;
+        }
+
+        // read in place, then swapped in place.
+        size_t length = count * size;
+        auto data = (uint8_t *) values;
+        size_t total = 0;
+        while (total < length) {
+            ssize_t len = read(data, (off_t) total, length - total);
+            if (len <= 0) {
+                break;
+            }
+            total += len;
+        }
+        count = total / size;
+        if (isBigEndian() != bigEndian) {
+            byteSwap(data, data, count, size);
+        }
+        return count;
+    }
+
     const Version &Stream::version() const {
         return _version;
     }
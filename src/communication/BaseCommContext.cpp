@@ -210,16 +210,23 @@ namespace Communication {
         ByteArray buffer;
         bool result = md5.computeFileHash(filename, buffer);
         if (result) {
-            for (size_t i = 0; i < MD5_COUNT; i++) {
-                if (buffer[i] != filemd5[i]) {
-                    return false;
-                }
-            }
-            return true;
+            return matchmd5(buffer);
         }
         return false;
     }
 
+    bool FileHeader::matchmd5(const ByteArray &md5) const {
+        if (md5.count() != MD5_COUNT) {
+            return false;
+        }
+        for (size_t i = 0; i < MD5_COUNT; i++) {
+            if (md5[i] != filemd5[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     String FileHeader::md5Str() const {
         // a23ffa1f42606a4f55754648881465e9
         ByteArray array(filemd5, MD5_COUNT);
@@ -258,6 +265,7 @@ namespace Communication {
         memset(filemd5, 0, MD5_COUNT);
         file_name.empty();
         packetCount = 0;
+        hashedmd5.clear();
     }
 
     FileData::FileData() : packetNo(0) {
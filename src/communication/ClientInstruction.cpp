@@ -18,6 +18,7 @@
 
 using namespace Data;
 using namespace Diag;
+using namespace Crypto;
 
 namespace Communication {
     struct ClientInstructionHolder {
@@ -457,7 +458,7 @@ namespace Communication {
 
     FileInstructionEntry *FileInstructionEntry::_instance = nullptr;
 
-    FileInstructionEntry::FileInstructionEntry() {
+    FileInstructionEntry::FileInstructionEntry() : _hash(Md5Provider()), _hashPacketNo(0) {
     }
 
     FileInstructionEntry::~FileInstructionEntry() {
@@ -476,7 +477,7 @@ namespace Communication {
         return result;
     }
 
-    bool FileInstructionEntry::saveFile(const FileHeader *header, const FileDatas *fds) {
+    bool FileInstructionEntry::saveFile(FileHeader *header, const FileDatas *fds) {
         for (size_t i = 0; i < fds->count(); i++) {
             if (!saveFile(header, fds->at(i)))
                 return false;
@@ -484,7 +485,7 @@ namespace Communication {
         return true;
     }
 
-    bool FileInstructionEntry::saveFile(const FileHeader *header, const FileData *fd) {
+    bool FileInstructionEntry::saveFile(FileHeader *header, const FileData *fd) {
 #ifdef __EMSCRIPTEN__
         //        Debug::writeFormatLine("FileInstructionEntry::saveFile, packet no: %d", fd->packetNo);
                 if(fd->isFirstPart())
@@ -512,7 +513,7 @@ namespace Communication {
 #endif  // __EMSCRIPTEN__
     }
 
-    bool FileInstructionEntry::saveFileInner(const FileHeader *header, const FileDatas *fds) {
+    bool FileInstructionEntry::saveFileInner(FileHeader *header, const FileDatas *fds) {
         for (size_t i = 0; i < fds->count(); i++) {
             if (!saveFileInner(header, fds->at(i)))
                 return false;
@@ -520,7 +521,7 @@ namespace Communication {
         return true;
     }
 
-    bool FileInstructionEntry::saveFileInner(const FileHeader *header, const FileData *fd) {
+    bool FileInstructionEntry::saveFileInner(FileHeader *header, const FileData *fd) {
         String path = header->path;
         if (!Directory::exists(path)) {
             if (!Directory::createDirectory(path))
@@ -560,6 +561,8 @@ namespace Communication {
         fs.write(fd->data.data(), 0, dataCount);
         fs.close();
 
+        hashPacket(header, fd);
+
         //            MappingStream ms(filename.c_str(), header->fileLength);
         //            ms.seek(position);
         //            ms.write(fd->data.data(), 0, dataCount);
@@ -575,6 +578,28 @@ namespace Communication {
         return true;
     }
 
+    void FileInstructionEntry::hashPacket(FileHeader *header, const FileData *fd) {
+        Locker locker(&_hashMutex);
+
+        String fileName = header->tempFullFileName();
+        if (fd->isFirstPart()) {
+            _hashFileName = _hash.init() ? fileName : String::Empty;
+            _hashPacketNo = 0;
+        }
+        if (_hashFileName.isNullOrEmpty() || _hashFileName != fileName || fd->packetNo != _hashPacketNo) {
+            // resent, out of order or interleaved with another file, the file will be read again.
+            _hashFileName = String::Empty;
+            return;
+        }
+
+        _hash.update(fd->data);
+        _hashPacketNo++;
+        if (fd->isLastPart(header)) {
+            _hash.final(header->hashedmd5);
+            _hashFileName = String::Empty;
+        }
+    }
+
     bool FileInstructionEntry::readFile(Stream *stream, const FileHeader *header, uint32_t packetNo,
                                         uint32_t packetLength) const {
         String fileName = Path::combine(header->path, header->file_name);
@@ -92,7 +92,7 @@ namespace Communication {
         String str;
         for (size_t i = 0; i < Type::Count; i++) {
             String scheme;
-            const String prefix = String::format("servers[%d]", i);
+            const String prefix = String::format("servers[%d]", (int) i);
             if (properties.at(String::format("%s.scheme", prefix.c_str()), scheme)) {
                 int index = -1;
                 if ((_type & Tcp) == Tcp && scheme == TypeString::Tcp.str) {
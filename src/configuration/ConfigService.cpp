@@ -22,8 +22,25 @@ using namespace Net;
 using namespace Crypto;
 
 namespace Config {
+    ConfigChangedEventArgs::ConfigChangedEventArgs(const ConfigSnapshot *snapshot, const StringArray &keys) :
+            snapshot(snapshot), keys(keys) {
+    }
+
+    const ConfigSnapshot *IConfigService::snapshot() const {
+        return nullptr;
+    }
+
+    ConfigHandle IConfigService::getHandle(const String &key) {
+        return {key, ConfigHandle::NoIndex};
+    }
+
+    Delegates *IConfigService::changedDelegates() {
+        return nullptr;
+    }
+
     bool IConfigService::contains(const String &key) const {
-        return properties().contains(key);
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->contains(key) : properties().contains(key);
     }
 
     void IConfigService::printProperties() const {
@@ -42,10 +59,15 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, String &value) const {
-        return properties().at(key, value);
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(key, value) : properties().at(key, value);
     }
 
     bool IConfigService::getProperty(const String &key, bool &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Boolean v;
         if (getProperty(key, v)) {
             value = v;
@@ -55,6 +77,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, uint8_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Byte v;
         if (getProperty(key, v)) {
             value = v;
@@ -64,6 +90,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, char &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Char v;
         if (getProperty(key, v)) {
             value = v;
@@ -73,6 +103,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, int16_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Int16 v;
         if (getProperty(key, v)) {
             value = v;
@@ -82,6 +116,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, uint16_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         UInt16 v;
         if (getProperty(key, v)) {
             value = v;
@@ -91,6 +129,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, int32_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Int32 v;
         if (getProperty(key, v)) {
             value = v;
@@ -100,6 +142,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, uint32_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         UInt32 v;
         if (getProperty(key, v)) {
             value = v;
@@ -109,6 +155,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, int64_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Int64 v;
         if (getProperty(key, v)) {
             value = v;
@@ -118,6 +168,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, uint64_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         UInt64 v;
         if (getProperty(key, v)) {
             value = v;
@@ -127,6 +181,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, float &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Float v;
         if (getProperty(key, v)) {
             value = v;
@@ -136,6 +194,10 @@ namespace Config {
     }
 
     bool IConfigService::getProperty(const String &key, double &value) const {
+        const ConfigSnapshot *s = snapshot();
+        if (s != nullptr) {
+            return s->getValue(key, value);
+        }
         Double v;
         if (getProperty(key, v)) {
             value = v;
@@ -144,6 +206,66 @@ namespace Config {
         return false;
     }
 
+    bool IConfigService::getProperty(const ConfigHandle &handle, String &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, bool &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, uint8_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, char &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, int16_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, uint16_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, int32_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, uint32_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, int64_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, uint64_t &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, float &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
+    bool IConfigService::getProperty(const ConfigHandle &handle, double &value) const {
+        const ConfigSnapshot *s = snapshot();
+        return s != nullptr ? s->getValue(handle, value) : getProperty(handle.key(), value);
+    }
+
     bool IConfigService::setProperty(const String &key, const bool &value) {
         return setProperty(key, Boolean(value).toString());
     }
@@ -195,7 +317,7 @@ namespace Config {
     const ByteArray ConfigService::Sm4Key = {0x81, 0x50, 0xD4, 0xB6, 0x68, 0xAA, 0xD8, 0xCC, 0x7E, 0x35, 0xFB, 0xA6,
                                              0x5D, 0x4C, 0x83, 0xB0};
 
-    ConfigService::ConfigService() {
+    ConfigService::ConfigService() : _snapshot(nullptr), _version(0) {
         ServiceFactory *factory = ServiceFactory::instance();
         assert(factory);
         factory->addService<IConfigService>(this);
@@ -205,9 +327,14 @@ namespace Config {
         ServiceFactory *factory = ServiceFactory::instance();
         assert(factory);
         factory->removeService<IConfigService>();
+
+        clearSnapshots();
     }
 
     bool ConfigService::initialize() {
+        // the properties are read from _properties until they are published again.
+        retireSnapshot();
+
         // init system variables, included environment variables.
         initSystemVariables();
 
@@ -237,6 +364,8 @@ namespace Config {
         // update the passwords.
         updatePasswords();
 
+        publish();
+
         // set app culture.
         setCulture();
 
@@ -251,6 +380,7 @@ namespace Config {
 
     bool ConfigService::unInitialize() {
         _properties.clear();
+        retireSnapshot();
         return true;
     }
 
@@ -345,9 +475,80 @@ namespace Config {
 
     bool ConfigService::setProperty(const String &key, const String &value) {
         _properties.add(key, value);
+        if (_snapshot.load(std::memory_order_acquire) != nullptr) {
+            publish();
+        }
         return true;
     }
 
+    const ConfigSnapshot *ConfigService::snapshot() const {
+        return _snapshot.load(std::memory_order_acquire);
+    }
+
+    ConfigHandle ConfigService::getHandle(const String &key) {
+        std::lock_guard<std::mutex> locker(_snapshotMutex);
+        size_t index;
+        if (!_indexes.at(key, index)) {
+            // the key may be added by a reload later.
+            index = _indexes.count();
+            _indexes.add(key, index);
+        }
+        return {key, index};
+    }
+
+    Delegates *ConfigService::changedDelegates() {
+        return &_changedDelegates;
+    }
+
+    void ConfigService::publish() {
+        const ConfigSnapshot *snapshot;
+        StringArray keys;
+        {
+            std::lock_guard<std::mutex> locker(_snapshotMutex);
+            const ConfigSnapshot *old = _snapshot.load(std::memory_order_acquire);
+            // the values not changed are copied from the old one instead of being parsed again.
+            snapshot = new ConfigSnapshot(_properties, _indexes, ++_version, old);
+            snapshot->getChangedKeys(old, keys);
+            _snapshot.store(snapshot, std::memory_order_release);
+            if (old != nullptr) {
+                retire(old);
+            }
+        }
+
+        if (keys.count() > 0) {
+            ConfigChangedEventArgs args(snapshot, keys);
+            _changedDelegates.invoke(this, &args);
+        }
+    }
+
+    void ConfigService::retire(const ConfigSnapshot *snapshot) {
+        uint64_t tick = Environment::getTickCount();
+        size_t expired = 0;
+        while (expired < _retired.size() && tick - _retired[expired].tick >= RetiredTimeout) {
+            delete _retired[expired].snapshot;
+            expired++;
+        }
+        _retired.erase(_retired.begin(), _retired.begin() + (ptrdiff_t) expired);
+        _retired.push_back({snapshot, tick});
+    }
+
+    void ConfigService::retireSnapshot() {
+        std::lock_guard<std::mutex> locker(_snapshotMutex);
+        const ConfigSnapshot *old = _snapshot.exchange(nullptr);
+        if (old != nullptr) {
+            retire(old);
+        }
+    }
+
+    void ConfigService::clearSnapshots() {
+        std::lock_guard<std::mutex> locker(_snapshotMutex);
+        delete _snapshot.exchange(nullptr);
+        for (const Retired &retired: _retired) {
+            delete retired.snapshot;
+        }
+        _retired.clear();
+    }
+
     void ConfigService::updateVariables() {
         // search and replace var.
         StringArray keys;
@@ -358,7 +559,7 @@ namespace Config {
             if (_properties.at(key, value)) {
                 String newValue;
                 if (updateVariables(key, value, newValue))
-                    setProperty(key, newValue);
+                    _properties.add(key, newValue);
             }
         }
 
@@ -369,8 +570,8 @@ namespace Config {
             String value;
             if (_systemVariables.at(var, value)) {
                 String varKey = String::trim(var, '$', '{', '}');
-                if (!contains(varKey)) {
-                    setProperty(varKey, value);
+                if (!_properties.contains(varKey)) {
+                    _properties.add(varKey, value);
                 }
             }
         }
@@ -409,7 +610,7 @@ namespace Config {
                     value = String::replace(value, ENC, String::Empty);
                     if (!value.isNullOrEmpty() && value[value.length() - 1] == ')') {
                         value = value.substr(0, value.length() - 1);
-                        setProperty(key, computePlainText(value));
+                        _properties.add(key, computePlainText(value));
                     }
                 }
             }
@@ -521,17 +722,19 @@ namespace Config {
                 }
             }
 
-            // update debug flag.
-            bool debug = false;
-            if (getProperty("debug", debug) && debug) {
-                Trace::enableDebugOutput(debug);
-            }
-
             // update the vars.
             updateVariables();
 
             // update the passwords.
             updatePasswords();
+
+            publish();
+
+            // update debug flag.
+            bool debug = false;
+            if (getProperty("debug", debug) && debug) {
+                Trace::enableDebugOutput(debug);
+            }
         }
         return result;
     }
@@ -566,7 +769,7 @@ namespace Config {
             return true;
         } else {
             String varKey = String::trim(name, '$', '{', '}');
-            if (getProperty(varKey, value)) {
+            if (_properties.at(varKey, value)) {
                 return true;
             }
         }
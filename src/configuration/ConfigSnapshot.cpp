@@ -0,0 +1,284 @@
+//
+//  ConfigSnapshot.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "configuration/ConfigSnapshot.h"
+#include "data/ValueType.h"
+
+namespace Config {
+    ConfigHandle::ConfigHandle() : _index(NoIndex) {
+    }
+
+    ConfigHandle::ConfigHandle(const String &key, size_t index) : _key(key), _index(index) {
+    }
+
+    bool ConfigHandle::isEmpty() const {
+        return _key.isNullOrEmpty();
+    }
+
+    const String &ConfigHandle::key() const {
+        return _key;
+    }
+
+    size_t ConfigHandle::index() const {
+        return _index;
+    }
+
+    ConfigSnapshot::Value::Value() : types(0), boolValue(false), byteValue(0), charValue(0), int16Value(0),
+                                     uint16Value(0), int32Value(0), uint32Value(0), int64Value(0), uint64Value(0),
+                                     floatValue(0.0f), doubleValue(0.0) {
+    }
+
+    void ConfigSnapshot::Value::parse(const String &str) {
+        // the same parsers as IConfigService::getProperty.
+        text = str;
+        types = TypeText;
+        Boolean b;
+        if (Boolean::parse(str, b)) {
+            boolValue = b;
+            types |= TypeBool;
+        }
+        Byte u8;
+        if (Byte::parse(str, u8)) {
+            byteValue = u8;
+            types |= TypeByte;
+        }
+        Char c;
+        if (Char::parse(str, c)) {
+            charValue = c;
+            types |= TypeChar;
+        }
+        Int16 i16;
+        if (Int16::parse(str, i16)) {
+            int16Value = i16;
+            types |= TypeInt16;
+        }
+        UInt16 u16;
+        if (UInt16::parse(str, u16)) {
+            uint16Value = u16;
+            types |= TypeUInt16;
+        }
+        Int32 i32;
+        if (Int32::parse(str, i32)) {
+            int32Value = i32;
+            types |= TypeInt32;
+        }
+        UInt32 u32;
+        if (UInt32::parse(str, u32)) {
+            uint32Value = u32;
+            types |= TypeUInt32;
+        }
+        Int64 i64;
+        if (Int64::parse(str, i64)) {
+            int64Value = i64;
+            types |= TypeInt64;
+        }
+        UInt64 u64;
+        if (UInt64::parse(str, u64)) {
+            uint64Value = u64;
+            types |= TypeUInt64;
+        }
+        Float f;
+        if (Float::parse(str, f)) {
+            floatValue = f;
+            types |= TypeFloat;
+        }
+        Double d;
+        if (Double::parse(str, d)) {
+            doubleValue = d;
+            types |= TypeDouble;
+        }
+    }
+
+    ConfigSnapshot::ConfigSnapshot(const YmlNode::Properties &properties, Indexes &indexes, uint64_t version,
+                                   const ConfigSnapshot *base) : _count(0), _version(version) {
+        for (auto it = properties.begin(); it != properties.end(); ++it) {
+            if (!indexes.contains(it.key())) {
+                indexes.add(it.key(), indexes.count());
+            }
+        }
+        _indexes = indexes;
+
+        _values.resize(_indexes.count());
+        for (auto it = properties.begin(); it != properties.end(); ++it) {
+            size_t index = 0;
+            if (_indexes.at(it.key(), index)) {
+                // the indexes are shared, so the base has the same index of the key.
+                if (base != nullptr && index < base->_values.size() && base->_values[index].types != 0 &&
+                    base->_values[index].text == it.value()) {
+                    _values[index] = base->_values[index];
+                } else {
+                    _values[index].parse(it.value());
+                }
+                _count++;
+            }
+        }
+    }
+
+    uint64_t ConfigSnapshot::version() const {
+        return _version;
+    }
+
+    size_t ConfigSnapshot::count() const {
+        return _count;
+    }
+
+    bool ConfigSnapshot::contains(const String &key) const {
+        return find(getHandle(key), TypeText) != nullptr;
+    }
+
+    ConfigHandle ConfigSnapshot::getHandle(const String &key) const {
+        size_t index = ConfigHandle::NoIndex;
+        _indexes.at(key, index);
+        return {key, index};
+    }
+
+    void ConfigSnapshot::getChangedKeys(const ConfigSnapshot *other, StringArray &keys) const {
+        for (auto it = _indexes.begin(); it != _indexes.end(); ++it) {
+            const Value &value = _values[it.value()];
+            const Value *otherValue = other != nullptr ? other->find(other->getHandle(it.key()), TypeText) : nullptr;
+            if (value.types == 0 && otherValue == nullptr) {
+                continue;
+            }
+            if (value.types == 0 || otherValue == nullptr || value.text != otherValue->text) {
+                keys.add(it.key());
+            }
+        }
+        if (other != nullptr) {
+            // the keys removed and not known by this one.
+            for (auto it = other->_indexes.begin(); it != other->_indexes.end(); ++it) {
+                if (!_indexes.contains(it.key()) && other->_values[it.value()].types != 0) {
+                    keys.add(it.key());
+                }
+            }
+        }
+    }
+
+    bool ConfigSnapshot::getValue(const String &key, String &value) const {
+        return getValue(getHandle(key), value);
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, String &value) const {
+        const Value *v = find(handle, TypeText);
+        if (v != nullptr) {
+            value = v->text;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, bool &value) const {
+        const Value *v = find(handle, TypeBool);
+        if (v != nullptr) {
+            value = v->boolValue;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, uint8_t &value) const {
+        const Value *v = find(handle, TypeByte);
+        if (v != nullptr) {
+            value = v->byteValue;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, char &value) const {
+        const Value *v = find(handle, TypeChar);
+        if (v != nullptr) {
+            value = v->charValue;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, int16_t &value) const {
+        const Value *v = find(handle, TypeInt16);
+        if (v != nullptr) {
+            value = v->int16Value;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, uint16_t &value) const {
+        const Value *v = find(handle, TypeUInt16);
+        if (v != nullptr) {
+            value = v->uint16Value;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, int32_t &value) const {
+        const Value *v = find(handle, TypeInt32);
+        if (v != nullptr) {
+            value = v->int32Value;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, uint32_t &value) const {
+        const Value *v = find(handle, TypeUInt32);
+        if (v != nullptr) {
+            value = v->uint32Value;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, int64_t &value) const {
+        const Value *v = find(handle, TypeInt64);
+        if (v != nullptr) {
+            value = v->int64Value;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, uint64_t &value) const {
+        const Value *v = find(handle, TypeUInt64);
+        if (v != nullptr) {
+            value = v->uint64Value;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, float &value) const {
+        const Value *v = find(handle, TypeFloat);
+        if (v != nullptr) {
+            value = v->floatValue;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConfigSnapshot::getValue(const ConfigHandle &handle, double &value) const {
+        const Value *v = find(handle, TypeDouble);
+        if (v != nullptr) {
+            value = v->doubleValue;
+            return true;
+        }
+        return false;
+    }
+
+    const ConfigSnapshot::Value *ConfigSnapshot::find(const ConfigHandle &handle, Type type) const {
+        size_t index = handle.index();
+        if (index == ConfigHandle::NoIndex && !handle.isEmpty()) {
+            // resolved by another service, or the key is new.
+            _indexes.at(handle.key(), index);
+        }
+        if (index < _values.size() && (_values[index].types & type) != 0) {
+            return &_values[index];
+        }
+        return nullptr;
+    }
+}
@@ -64,11 +64,14 @@ namespace Crypto {
 
     const EVP_CIPHER *AESProvider::cipher(CypherMode mode) const {
         static const EVP_CIPHER *ciphers128[] = {EVP_aes_128_cbc(), EVP_aes_128_ecb(),
-                                                 EVP_aes_128_ofb(), EVP_aes_128_cfb(), EVP_aes_128_ctr()};
+                                                 EVP_aes_128_ofb(), EVP_aes_128_cfb(), EVP_aes_128_ctr(),
+                                                 EVP_aes_128_gcm()};
         static const EVP_CIPHER *ciphers192[] = {EVP_aes_192_cbc(), EVP_aes_192_ecb(),
-                                                 EVP_aes_192_ofb(), EVP_aes_192_cfb(), EVP_aes_192_ctr()};
+                                                 EVP_aes_192_ofb(), EVP_aes_192_cfb(), EVP_aes_192_ctr(),
+                                                 EVP_aes_192_gcm()};
         static const EVP_CIPHER *ciphers256[] = {EVP_aes_256_cbc(), EVP_aes_256_ecb(),
-                                                 EVP_aes_256_ofb(), EVP_aes_256_cfb(), EVP_aes_256_ctr()};
+                                                 EVP_aes_256_ofb(), EVP_aes_256_cfb(), EVP_aes_256_ctr(),
+                                                 EVP_aes_256_gcm()};
         switch (_keySize) {
             case 128:
                 return ciphers128[mode];
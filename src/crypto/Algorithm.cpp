@@ -8,9 +8,17 @@
 
 #include "crypto/Algorithm.h"
 #include "data/DateTime.h"
+#include "IO/File.h"
+#include "IO/FileStream.h"
+#include "thread/Thread.h"
+#include <atomic>
+#include <climits>
 #include <openssl/rand.h>
 #include <openssl/err.h>
 
+using namespace IO;
+using namespace Threading;
+
 namespace Crypto {
     SymmetricAlgorithm::SymmetricAlgorithm() :
             _mode(CypherMode::CBC), _padding(PaddingMode::PKCS7) {
@@ -21,27 +29,72 @@ namespace Crypto {
     }
 
     bool SymmetricAlgorithm::encrypt(const ByteArray &data, ByteArray &output) {
+        if (_mode == CypherMode::GCM) {
+            // the nonce of GCM is never reused with the key, a random one precedes the cipher text.
+            uint8_t nonce[EVP_MAX_IV_LENGTH];
+            auto nonceSize = (size_t) (blockSize() / 8);
+            if (nonceSize > sizeof(nonce) || RAND_bytes(nonce, (int) nonceSize) != 1) {
+                return false;
+            }
+            return encrypt(_key, ByteArray(nonce, nonceSize), data.data(), data.count(), output, _mode, true);
+        }
         return encrypt(_key, _iv, data, output, _mode);
     }
 
     bool SymmetricAlgorithm::decrypt(const ByteArray &data, ByteArray &output) {
+        if (_mode == CypherMode::GCM) {
+            auto nonceSize = (size_t) (blockSize() / 8);
+            if (data.count() < nonceSize) {
+                return false;
+            }
+            ByteArray nonce(data.data(), nonceSize);
+            return decrypt(_key, nonce, data.data() + nonceSize, data.count() - nonceSize, output, _mode);
+        }
         return decrypt(_key, _iv, data, output, _mode);
     }
 
     bool SymmetricAlgorithm::encrypt(const String &data, String &output) {
-        return encrypt(_key, _iv, data, output, _mode);
+        ByteArray in((uint8_t *) data.c_str(), data.length());
+        ByteArray out;
+        if (encrypt(in, out)) {
+            output = out.toString(ByteArray::HexFormat, String::Empty);
+            return true;
+        }
+        return false;
     }
 
     bool SymmetricAlgorithm::decrypt(const String &data, String &output) {
-        return decrypt(_key, _iv, data, output, _mode);
+        ByteArray in;
+        if (ByteArray::parse(data, in, String::Empty)) {
+            ByteArray out;
+            if (decrypt(in, out)) {
+                output = String((const char *) out.data(), out.count());
+                return true;
+            }
+        }
+        return false;
     }
 
     bool SymmetricAlgorithm::encryptToBase64(const String &data, String &output) {
-        return encryptToBase64(_key, _iv, data, output, _mode);
+        ByteArray in((uint8_t *) data.c_str(), data.length());
+        ByteArray out;
+        if (encrypt(in, out)) {
+            output = String::toBase64(out.data(), 0, out.count());
+            return true;
+        }
+        return false;
     }
 
     bool SymmetricAlgorithm::decryptFromBase64(const String &data, String &output) {
-        return decryptFromBase64(_key, _iv, data, output, _mode);
+        ByteArray in;
+        if (String::fromBase64(data, in)) {
+            ByteArray out;
+            if (decrypt(in, out)) {
+                output = String((const char *) out.data(), out.count());
+                return true;
+            }
+        }
+        return false;
     }
 
     const ByteArray &SymmetricAlgorithm::key() const {
@@ -54,97 +107,65 @@ namespace Crypto {
 
     bool SymmetricAlgorithm::encrypt(const ByteArray &key, const ByteArray &iv,
                                      const ByteArray &data, ByteArray &output, CypherMode mode) {
-        const EVP_CIPHER *cipher = this->cipher(mode);
-        if (cipher == nullptr) {
-            return false;
-        }
+        return encrypt(key, iv, data.data(), data.count(), output, mode, false);
+    }
 
-        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
-        if (!ctx) {
-            return false;
-        }
-        if (!EVP_CIPHER_CTX_init(ctx)) {
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        if (!EVP_EncryptInit_ex(ctx, cipher, nullptr, key.data(), iv.data())) {
-            ERR_print_errors_fp(stderr);
+    bool SymmetricAlgorithm::encrypt(const ByteArray &key, const ByteArray &iv, const uint8_t *data, size_t count,
+                                     ByteArray &output, CypherMode mode, bool withIV) {
+        CipherContext context(cipher(mode), key, iv, _padding, true);
+        if (!context.init(iv)) {
             return false;
         }
-        if (!EVP_CIPHER_CTX_set_padding(ctx, _padding)) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
+
+        size_t ivCount = withIV ? iv.count() : 0;
+        auto out = new uint8_t[ivCount + count + context.blockSize() + CipherContext::TagSize];
+        if (ivCount > 0) {
+            memcpy(out, iv.data(), ivCount);
         }
-        auto out = (uint8_t *) malloc(((data.count() >> 4) + 1) << 4);
-        int currentLen = 0;
-        if (!EVP_EncryptUpdate(ctx, out, &currentLen, data.data(), (int) data.count())) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
-            free(out);
-            return false;
+        size_t len = 0, finalLen = 0;
+        bool result = context.update(data, count, out + ivCount, len) && context.final(out + ivCount + len, finalLen);
+        len += ivCount + finalLen;
+        // the tag of GCM follows the cipher text.
+        if (result && mode == CypherMode::GCM) {
+            result = context.getTag(out + len);
+            len += CipherContext::TagSize;
         }
-        int len = currentLen;
-        if (!EVP_EncryptFinal_ex(ctx, out + len, &currentLen)) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
-            free(out);
-            return false;
+        if (result) {
+            output = ByteArray(out, len);
         }
-        len += currentLen;
-
-        output = ByteArray(out, len);
-        free(out);
-        EVP_CIPHER_CTX_free(ctx);
-
-        return true;
+        delete[] out;
+        return result;
     }
 
     bool SymmetricAlgorithm::decrypt(const ByteArray &key, const ByteArray &iv,
                                      const ByteArray &data, ByteArray &output, CypherMode mode) {
-        const EVP_CIPHER *cipher = this->cipher(mode);
-        if (cipher == nullptr) {
-            return false;
-        }
+        return decrypt(key, iv, data.data(), data.count(), output, mode);
+    }
 
-        EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
-        if (!ctx) {
-            return false;
-        }
-        if (!EVP_CIPHER_CTX_init(ctx)) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        if (!EVP_DecryptInit_ex(ctx, cipher, nullptr, key.data(), iv.data())) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        if (!EVP_CIPHER_CTX_set_padding(ctx, _padding)) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
+    bool SymmetricAlgorithm::decrypt(const ByteArray &key, const ByteArray &iv, const uint8_t *data, size_t count,
+                                     ByteArray &output, CypherMode mode) {
+        CipherContext context(cipher(mode), key, iv, _padding, false);
+        if (mode == CypherMode::GCM) {
+            if (count < CipherContext::TagSize) {
+                return false;
+            }
+            count -= CipherContext::TagSize;
         }
-        uint8_t out[1024 + EVP_MAX_BLOCK_LENGTH];
-        int currentLen = 0;
-        if (!EVP_DecryptUpdate(ctx, out, &currentLen, data.data(), (int) data.count())) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
+        if (!context.init()) {
             return false;
         }
-        int len = currentLen;
-        if (!EVP_DecryptFinal_ex(ctx, out + len, &currentLen)) {
-            ERR_print_errors_fp(stderr);
-            EVP_CIPHER_CTX_free(ctx);
+        if (mode == CypherMode::GCM && !context.setTag(data + count)) {
             return false;
         }
-        len += currentLen;
-
-        output = ByteArray(out, len);
-        EVP_CIPHER_CTX_free(ctx);
 
-        return true;
+        auto out = new uint8_t[count + context.blockSize()];
+        size_t len = 0, finalLen = 0;
+        bool result = context.update(data, count, out, len) && context.final(out + len, finalLen);
+        if (result) {
+            output = ByteArray(out, len + finalLen);
+        }
+        delete[] out;
+        return result;
     }
 
     bool SymmetricAlgorithm::encrypt(const ByteArray &key, const ByteArray &iv,
@@ -303,46 +324,285 @@ namespace Crypto {
     }
 
     bool HashAlgorithm::computeFileHash(const String &path, ByteArray &output) {
-        const EVP_MD *type = this->type();
-        if (type == nullptr) {
+        if (!File::exists(path)) {
+            return false;
+        }
+        FileStream fs(path, FileMode::FileOpen, FileAccess::FileRead);
+        if (!fs.isOpen()) {
+            return false;
+        }
+        fs.setSequential();
+
+        HashContext context(*this);
+        if (!context.init()) {
+            return false;
+        }
+        auto buffer = new uint8_t[FileBufferSize];
+        bool result = true;
+        ssize_t length;
+        while ((length = fs.read(buffer, 0, FileBufferSize)) > 0) {
+            if (!context.update(buffer, length)) {
+                result = false;
+                break;
+            }
+        }
+        delete[] buffer;
+        if (length < 0) {
+            result = false;
+        }
+        return context.final(output) && result;
+    }
+
+    bool HashAlgorithm::computeFileHash(const String &path, String &output) {
+        ByteArray array;
+        if (computeFileHash(path, array)) {
+            output = array.toString("%02X", String::Empty);
+            return true;
+        }
+        return false;
+    }
+
+    bool HashAlgorithm::computeFileHashes(const StringArray &paths, StringArray &outputs, int threadCount) {
+        size_t count = paths.count();
+        outputs = StringArray(String::Empty, count);
+        if (count == 0) {
+            return true;
+        }
+        if (threadCount <= 0) {
+            threadCount = (int) Thread::concurrency();
+        }
+        if (threadCount > (int) count) {
+            threadCount = (int) count;
+        }
+
+        std::atomic<size_t> next(0);
+        std::atomic<bool> result(true);
+        auto hashProc = [this, &paths, &outputs, &next, &result]() {
+            size_t i;
+            while ((i = next++) < paths.count()) {
+                String output;
+                if (computeFileHash(paths[i], output)) {
+                    outputs.set(i, output);
+                } else {
+                    result = false;
+                }
+            }
+        };
+        if (threadCount <= 1) {
+            hashProc();
+        } else {
+            PList<Thread> threads;
+            for (int i = 0; i < threadCount; i++) {
+                auto thread = new Thread("hash.file", hashProc);
+                thread->start();
+                threads.add(thread);
+            }
+            for (size_t i = 0; i < threads.count(); i++) {
+                threads[i]->join();
+            }
+        }
+        return result;
+    }
+
+    CipherContext::CipherContext(const SymmetricAlgorithm &algorithm, bool encrypt) :
+            CipherContext(algorithm.cipher(algorithm._mode), algorithm._key, algorithm._iv, algorithm._padding,
+                          encrypt) {
+    }
+
+    CipherContext::CipherContext(const EVP_CIPHER *cipher, const ByteArray &key, const ByteArray &iv,
+                                 PaddingMode padding, bool encrypt) : _context(nullptr), _iv(iv), _padding(padding),
+                                                                      _encrypt(encrypt), _gcm(false), _stream(false) {
+        if (cipher == nullptr) {
+            return;
+        }
+        _context = EVP_CIPHER_CTX_new();
+        if (_context == nullptr) {
+            return;
+        }
+
+        // the key is set up once, the IV is set by init for each message.
+        unsigned long mode = EVP_CIPHER_mode(cipher);
+        _gcm = mode == EVP_CIPH_GCM_MODE;
+        _stream = mode == EVP_CIPH_CTR_MODE || mode == EVP_CIPH_OFB_MODE || mode == EVP_CIPH_CFB_MODE ||
+                  mode == EVP_CIPH_GCM_MODE || mode == EVP_CIPH_CCM_MODE || mode == EVP_CIPH_OCB_MODE ||
+                  mode == EVP_CIPH_STREAM_CIPHER;
+        if (!EVP_CipherInit_ex(_context, cipher, nullptr, key.data(), nullptr, encrypt ? 1 : 0)) {
+            ERR_print_errors_fp(stderr);
+            EVP_CIPHER_CTX_free(_context);
+            _context = nullptr;
+        }
+    }
+
+    CipherContext::~CipherContext() {
+        EVP_CIPHER_CTX_free(_context);
+        _context = nullptr;
+    }
+
+    bool CipherContext::isValid() const {
+        return _context != nullptr;
+    }
+
+    bool CipherContext::init() {
+        // the fixed IV would encrypt the messages with the same key stream.
+        if (_encrypt && _stream) {
             return false;
         }
+        return setIV(_iv.data(), _iv.count());
+    }
 
-        FILE *f;
-        size_t n;
-        unsigned char buf[1024];
+    bool CipherContext::init(const ByteArray &iv) {
+        return setIV(iv.data(), iv.count());
+    }
+
+    bool CipherContext::init(const uint8_t *iv, size_t count) {
+        return setIV(iv, count);
+    }
 
-        if ((f = fopen(path, "rb")) == nullptr)
+    bool CipherContext::updateAad(const uint8_t *data, size_t count) {
+        if (_context == nullptr || !_gcm || count > INT_MAX) {
             return false;
+        }
+        int len = 0;
+        return count == 0 || EVP_CipherUpdate(_context, nullptr, &len, data, (int) count) == 1;
+    }
 
-        EVP_MD_CTX *ctx = EVP_MD_CTX_new();
-        EVP_DigestInit(ctx, type);
+    bool CipherContext::update(const uint8_t *input, size_t count, uint8_t *output, size_t &length) {
+        length = 0;
+        if (_context == nullptr || count > INT_MAX) {
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
 
-        while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
-            EVP_DigestUpdate(ctx, buf, n);
+        int len = 0;
+        if (!EVP_CipherUpdate(_context, output, &len, input, (int) count)) {
+            ERR_print_errors_fp(stderr);
+            return false;
+        }
+        length = len;
+        return true;
+    }
 
-        unsigned char buffer[EVP_MAX_MD_SIZE] = {0};
-        unsigned int len;
-        EVP_DigestFinal(ctx, buffer, &len);
-        EVP_MD_CTX_free(ctx);
+    bool CipherContext::final(uint8_t *output, size_t &length) {
+        length = 0;
+        if (_context == nullptr) {
+            return false;
+        }
 
-        output = ByteArray(buffer, len);
+        int len = 0;
+        if (!EVP_CipherFinal_ex(_context, output, &len)) {
+            // a wrong padding or tag when decrypting.
+            ERR_clear_error();
+            return false;
+        }
+        length = len;
+        return true;
+    }
+
+    bool CipherContext::getTag(uint8_t *tag, size_t count) {
+        if (_context == nullptr || !_gcm || !_encrypt) {
+            return false;
+        }
+        return EVP_CIPHER_CTX_ctrl(_context, EVP_CTRL_GCM_GET_TAG, (int) count, tag) == 1;
+    }
+
+    bool CipherContext::setTag(const uint8_t *tag, size_t count) {
+        if (_context == nullptr || !_gcm || _encrypt) {
+            return false;
+        }
+        return EVP_CIPHER_CTX_ctrl(_context, EVP_CTRL_GCM_SET_TAG, (int) count, (void *) tag) == 1;
+    }
+
+    size_t CipherContext::blockSize() const {
+        return _context != nullptr ? (size_t) EVP_CIPHER_CTX_block_size(_context) : 0;
+    }
 
-        if (ferror(f) != 0) {
-            fclose(f);
+    bool CipherContext::setIV(const uint8_t *iv, size_t count) {
+        if (_context == nullptr) {
             return false;
         }
+        if (_gcm) {
+            if (count == 0 || !EVP_CIPHER_CTX_ctrl(_context, EVP_CTRL_GCM_SET_IVLEN, (int) count, nullptr)) {
+                return false;
+            }
+        } else if (count < (size_t) EVP_CIPHER_CTX_iv_length(_context)) {
+            return false;
+        }
+        if (_encrypt && _stream) {
+            if (_lastIV.count() == count && memcmp(_lastIV.data(), iv, count) == 0) {
+                return false;
+            }
+            _lastIV.clear();
+            _lastIV.addRange(iv, count);
+        }
 
-        fclose(f);
+        // the key schedule is kept.
+        if (!EVP_CipherInit_ex(_context, nullptr, nullptr, nullptr, iv, -1) ||
+            !EVP_CIPHER_CTX_set_padding(_context, _padding)) {
+            ERR_print_errors_fp(stderr);
+            return false;
+        }
         return true;
     }
 
-    bool HashAlgorithm::computeFileHash(const String &path, String &output) {
+    HashContext::HashContext(const HashAlgorithm &algorithm) : _type(algorithm.type()), _started(false) {
+        _context = EVP_MD_CTX_new();
+    }
+
+    HashContext::~HashContext() {
+        EVP_MD_CTX_free(_context);
+        _context = nullptr;
+    }
+
+    bool HashContext::init() {
+        if (_type == nullptr || _context == nullptr) {
+            return false;
+        }
+        _started = EVP_DigestInit_ex(_context, _type, nullptr) == 1;
+        return _started;
+    }
+
+    bool HashContext::update(const uint8_t *data, size_t count) {
+        if (!_started) {
+            return false;
+        }
+        return count == 0 || EVP_DigestUpdate(_context, data, count) == 1;
+    }
+
+    bool HashContext::update(const ByteArray &data) {
+        return update(data.data(), data.count());
+    }
+
+    bool HashContext::update(const String &data) {
+        return update((const uint8_t *) data.c_str(), data.length());
+    }
+
+    bool HashContext::final(ByteArray &output) {
+        if (!_started) {
+            return false;
+        }
+        _started = false;
+
+        uint8_t buffer[EVP_MAX_MD_SIZE] = {0};
+        unsigned int length = 0;
+        if (EVP_DigestFinal_ex(_context, buffer, &length) == 1) {
+            output = ByteArray(buffer, length);
+            return true;
+        }
+        return false;
+    }
+
+    bool HashContext::final(String &output) {
         ByteArray array;
-        if (computeFileHash(path, array)) {
+        if (final(array)) {
             output = array.toString("%02X", String::Empty);
             return true;
         }
         return false;
     }
+
+    bool HashContext::isStarted() const {
+        return _started;
+    }
 }
@@ -55,7 +55,8 @@ namespace Crypto {
     }
 
     const EVP_CIPHER *DESProvider::cipher(CypherMode mode) const {
-        static const EVP_CIPHER *ciphers[] = {EVP_des_cbc(), EVP_des_ecb(), EVP_des_ofb(), EVP_des_cfb(), nullptr};
+        static const EVP_CIPHER *ciphers[] = {EVP_des_cbc(), EVP_des_ecb(), EVP_des_ofb(), EVP_des_cfb(), nullptr,
+                                              nullptr};
         return ciphers[mode];
     }
 
@@ -113,7 +114,7 @@ namespace Crypto {
 
     const EVP_CIPHER *TripleDESProvider::cipher(CypherMode mode) const {
         static const EVP_CIPHER *ciphers[] = {EVP_des_ede3_cbc(), EVP_des_ede3_ecb(),
-                                              EVP_des_ede3_ofb(), EVP_des_ede3_cfb(), nullptr};
+                                              EVP_des_ede3_ofb(), EVP_des_ede3_cfb(), nullptr, nullptr};
         return ciphers[mode];
     }
 
@@ -472,7 +472,8 @@ namespace Crypto {
     }
 
     const EVP_CIPHER *Sm4Provider::cipher(CypherMode mode) const {
-        static const EVP_CIPHER *ciphers[] = {EVP_sm4_cbc(), EVP_sm4_ecb(), EVP_sm4_ofb(), EVP_sm4_cfb(), EVP_sm4_ctr()};
+        static const EVP_CIPHER *ciphers[] = {EVP_sm4_cbc(), EVP_sm4_ecb(), EVP_sm4_ofb(), EVP_sm4_cfb(), EVP_sm4_ctr(),
+                                              nullptr};
         return ciphers[mode];
     }
 
@@ -54,14 +54,21 @@ namespace Data {
     void ByteArray::read(Stream *stream, bool bigEndian) {
         auto c = stream->readUInt32(bigEndian);
         if (c > 0) {
+            // one buffer for all the chunks, the count is not trusted, the array grows as the chunks arrive.
             const size_t size = 65535;
-            for (size_t i = 0; i < c / size + 1; i++) {
-                size_t cc = i == c / size ? (c % size) : size;
-                auto *buffer = new uint8_t[cc];
-                stream->read(buffer, 0, cc);
+            size_t chunk = Math::min((size_t) c, size);
+            reserve(count() + chunk);
+            auto *buffer = new uint8_t[chunk];
+            size_t remain = c;
+            while (remain > 0) {
+                ssize_t cc = stream->read(buffer, 0, Math::min(remain, chunk));
+                if (cc <= 0) {
+                    break;
+                }
                 addRange(buffer, 0, cc);
-                delete[] buffer;
+                remain -= cc;
             }
+            delete[] buffer;
         }
     }
 
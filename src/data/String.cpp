@@ -35,72 +35,129 @@ namespace Data {
                                           't', 'u', 'v', 'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7',
                                           '8', '9', '+', '/', '='};
 
-    String::String(size_t capacity) : _buffer(capacity) {
+    String::String(size_t capacity) : _value(_inline), _length(0), _capacity(InlineCapacity) {
+        _inline[0] = '\0';
+        reserve(capacity);
     }
 
-    String::String(const String &value) {
+    String::String(const String &value) : String() {
         this->operator=(value);
     }
 
-    String::String(String &&value) noexcept {
-        this->operator=(value);
-        value.empty();
+    String::String(String &&value) noexcept: String() {
+        this->operator=(std::move(value));
     }
 
     String::String(const string &value) : String(value.c_str()) {
     }
 
-    String::String(const char *value, size_t count) {
+    String::String(const char *value, size_t count) : String() {
         if (value != nullptr)
             setString(value, count == 0 ? strlen(value) : count);
     }
 
-    String::String(char ch, size_t count) : String() {
+    String::String(char ch, size_t count) : String(count) {
         for (size_t i = 0; i < count; i++) {
             addString(ch);
         }
     }
 
-    String::~String() = default;
+    String::~String() {
+        if (_value != _inline) {
+            delete[] _value;
+        }
+    }
 
     void String::setString(const String &value) {
-        _buffer.clear();
-        addString(value.c_str());
+        setString(value.c_str(), value.length());
     }
 
     void String::setString(const char *value, size_t count) {
-        _buffer.clear();
+        if (value != nullptr && value >= _value && value <= _value + _length) {
+            // a part of itself.
+            String temp(value, count);
+            setString(temp.c_str(), temp.length());
+            return;
+        }
+
+        _length = 0;
+        _value[0] = '\0';
+        _hashCode.store(0, std::memory_order_relaxed);
         addString(value, count);
     }
 
     void String::addString(const char *value, size_t count) {
         if (value != nullptr) {
-            size_t len = strlen(value);
-            if(count == 0) {
-                count = len;
-            }
-            size_t length = Math::min(len, count);
+            size_t length = count == 0 ? strlen(value) : strnlen(value, count);
             if (length > 0) {
-                if (isNullOrEmpty()) {
-                    _buffer.clear();
-                    _buffer.addRange(value, length);
-                } else {
-                    // replace '\0' position.
-                    _buffer.set(_buffer.count() - 1, value[0]);
-                    _buffer.addRange(value + 1, length - 1);
+                _hashCode.store(0, std::memory_order_relaxed);
+                if (_length + length > _capacity) {
+                    // a part of itself is moved with the buffer.
+                    bool self = value >= _value && value <= _value + _length;
+                    size_t offset = self ? value - _value : 0;
+                    reserve(_length + length);
+                    if (self) {
+                        value = _value + offset;
+                    }
                 }
-                _buffer.add('\0');
+                memcpy(_value + _length, value, length);
+                _length += length;
+                _value[_length] = '\0';
+            }
+        }
+    }
+
+    void String::addFormat(const char *format, ...) {
+        va_list ap;
+        va_start(ap, format);
+        addFormatV(format, ap);
+        va_end(ap);
+    }
+
+    void String::addFormatV(const char *format, va_list ap) {
+        if (format == nullptr) {
+            return;
+        }
+
+        // the short results are formatted on the stack, the long ones are measured by the first pass.
+        char buffer[FormatBufferLength];
+        va_list ap2;
+        va_copy(ap2, ap);
+        int length = vsnprintf(buffer, sizeof(buffer), format, ap2);
+        va_end(ap2);
+        if (length <= 0) {
+            return;
+        }
+
+        if ((size_t) length < sizeof(buffer)) {
+            addString(buffer, length);
+        } else {
+            // the args may point to this string, so it is formatted to a right-sized one.
+            String temp;
+            temp.reserve(length);
+            vsnprintf(temp._value, length + 1, format, ap);
+            temp._length = length;
+            if (_length == 0) {
+                operator=(std::move(temp));
+            } else {
+                addString(temp._value, temp._length);
             }
         }
     }
 
     void String::addString(char value) {
-        char buffer[2] = {value, '\0'};
-        addString(buffer);
+        if (value != '\0') {
+            _hashCode.store(0, std::memory_order_relaxed);
+            if (_length + 1 > _capacity) {
+                reserve(_length + 1);
+            }
+            _value[_length++] = value;
+            _value[_length] = '\0';
+        }
     }
 
     const char *String::getString() const {
-        return _buffer.data();
+        return _value;
     }
 
     String String::operator+=(const String &value) {
@@ -138,14 +195,28 @@ namespace Data {
 
     String &String::operator=(const String &value) {
         if (this != &value) {
-            setString(value.getString());
+            setString(value._value, value._length);
+            _hashCode.store(value._hashCode.load(std::memory_order_relaxed), std::memory_order_relaxed);
         }
         return *this;
     }
 
     String &String::operator=(String &&value) noexcept {
         if (this != &value) {
-            setString(value.getString());
+            if (value._value != value._inline) {
+                // take the heap buffer.
+                if (_value != _inline) {
+                    delete[] _value;
+                }
+                _value = value._value;
+                _capacity = value._capacity;
+                value._value = value._inline;
+                value._capacity = InlineCapacity;
+            } else {
+                setString(value._value, value._length);
+            }
+            _length = value._length;
+            _hashCode.store(value._hashCode.load(std::memory_order_relaxed), std::memory_order_relaxed);
             value.empty();
         }
         return *this;
@@ -162,15 +233,30 @@ namespace Data {
     }
 
     char &String::at(size_t pos) {
-        return _buffer.at(pos);
+        _hashCode.store(0, std::memory_order_relaxed);
+        if (pos <= _length) {
+            return _value[pos];
+        }
+        static char ch;
+        ch = '\0';
+        return ch;
     }
 
     const char &String::at(size_t pos) const {
-        return _buffer.at(pos);
+        if (pos <= _length) {
+            return _value[pos];
+        }
+        static const char ch = '\0';
+        return ch;
     }
 
     bool String::set(size_t pos, const char &value) {
-        return _buffer.set(pos, value);
+        _hashCode.store(0, std::memory_order_relaxed);
+        if (pos < _length) {
+            _value[pos] = value;
+            return true;
+        }
+        return false;
     }
 
     const char *String::c_str() const {
@@ -315,17 +401,56 @@ namespace Data {
     }
 
     bool String::isNullOrEmpty(const String &value) {
-        return value._buffer.count() <= 1;
+        return value._length == 0;
     }
 
     size_t String::length() const {
-        if (isNullOrEmpty())
-            return 0;
-        return _buffer.count() - 1;
+        return _length;
+    }
+
+    size_t String::capacity() const {
+        return _capacity;
+    }
+
+    void String::reserve(size_t capacity) {
+        if (capacity > _capacity) {
+            // grows by 2 times at least, so the appends are amortized O(1).
+            size_t size = _capacity * 2;
+            if (size < capacity) {
+                size = capacity;
+            }
+            auto value = new char[size + 1];
+            memcpy(value, _value, _length + 1);
+            if (_value != _inline) {
+                delete[] _value;
+            }
+            _value = value;
+            _capacity = size;
+        }
+    }
+
+    size_t String::hashCode() const {
+        // the const strings may be hashed by many threads, they store the same value.
+        size_t hashCode = _hashCode.load(std::memory_order_relaxed);
+        if (hashCode == 0) {
+            uint64_t hash = 14695981039346656037ULL;
+            const char *str = getString();
+            size_t length = this->length();
+            for (size_t i = 0; i < length; i++) {
+                hash ^= (uint8_t) str[i];
+                hash *= 1099511628211ULL;
+            }
+            // 0 means not calculated.
+            hashCode = hash != 0 ? (size_t) hash : 1;
+            _hashCode.store(hashCode, std::memory_order_relaxed);
+        }
+        return hashCode;
     }
 
     void String::empty() {
-        _buffer.clear();
+        _length = 0;
+        _value[0] = '\0';
+        _hashCode.store(0, std::memory_order_relaxed);
     }
 
     String::operator const char *() const {
@@ -1017,8 +1142,7 @@ namespace Data {
     }
 
     void String::append(const String &str, off_t offset, size_t count) {
-        const char *buffer = str._buffer.data();
-        append(buffer + offset, count);
+        append(str._value + offset, count);
     }
 
     void String::appendLine(char ch) {
@@ -1042,14 +1166,10 @@ namespace Data {
     }
 
     void String::appendFormat(const char *format, ...) {
-        char *message = new char[MaxFormatStrLength];
-        memset(message, 0, MaxFormatStrLength);
         va_list ap;
         va_start(ap, format);
-        vsnprintf(message, MaxFormatStrLength, format, ap);
+        addFormatV(format, ap);
         va_end(ap);
-        append(message);
-        delete[] message;
     }
 
     String String::replace(const String &src, const String &dst) {
@@ -1093,9 +1213,11 @@ namespace Data {
         if (count > strLength)
             count = strLength;
 
+        if (count == 0)
+            return Empty;
+
         String result;
-        result._buffer.addRange(str.c_str(), offset, count);
-        result._buffer.add('\0');
+        result.addString(str.c_str() + offset, count);
         return result;
     }
 
@@ -1120,11 +1242,17 @@ namespace Data {
     }
 
     bool String::removeAt(size_t pos) {
-        return _buffer.removeAt(pos);
+        return removeRange(pos, 1);
     }
 
     bool String::removeRange(size_t pos, size_t count) {
-        return _buffer.removeRange(pos, count);
+        if (count > 0 && pos + count <= _length) {
+            _hashCode.store(0, std::memory_order_relaxed);
+            memmove(_value + pos, _value + pos + count, _length - pos - count + 1);
+            _length -= count;
+            return true;
+        }
+        return false;
     }
 
     String String::trim(char trimChar1, char trimChar2, char trimChar3,
@@ -1143,26 +1271,20 @@ namespace Data {
     }
 
     String String::convert(const char *format, ...) {
-        char *message = new char[MaxFormatStrLength];
-        memset(message, 0, MaxFormatStrLength);
+        String result;
         va_list ap;
         va_start(ap, format);
-        vsnprintf(message, MaxFormatStrLength, format, ap);
+        result.addFormatV(format, ap);
         va_end(ap);
-        String result = message;
-        delete[] message;
         return result;
     }
 
     String String::format(const char *format, ...) {
-        char *message = new char[MaxFormatStrLength];
-        memset(message, 0, MaxFormatStrLength);
+        String result;
         va_list ap;
         va_start(ap, format);
-        vsnprintf(message, MaxFormatStrLength, format, ap);
+        result.addFormatV(format, ap);
         va_end(ap);
-        String result = message;
-        delete[] message;
         return result;
     }
 
@@ -1198,34 +1320,38 @@ namespace Data {
     }
 
     Iterator<char>::const_iterator String::begin() const {
-        return {_buffer.data()};
+        return {_value};
     }
 
     Iterator<char>::const_iterator String::end() const {
-        return {_buffer.data() + length()};
+        return {_value + length()};
     }
 
     Iterator<char>::iterator String::begin() {
-        return {_buffer.data()};
+        _hashCode.store(0, std::memory_order_relaxed);
+        return {_value};
     }
 
     Iterator<char>::iterator String::end() {
-        return {_buffer.data() + length()};
+        _hashCode.store(0, std::memory_order_relaxed);
+        return {_value + length()};
     }
 
     Iterator<char>::const_reverse_iterator String::rbegin() const {
-        return {_buffer.data() + length() - 1};
+        return {_value + length() - 1};
     }
 
     Iterator<char>::const_reverse_iterator String::rend() const {
-        return {_buffer.data() - 1};
+        return {_value - 1};
     }
 
     Iterator<char>::reverse_iterator String::rbegin() {
-        return {_buffer.data() + length() - 1};
+        _hashCode.store(0, std::memory_order_relaxed);
+        return {_value + length() - 1};
     }
 
     Iterator<char>::reverse_iterator String::rend() {
-        return {_buffer.data() - 1};
+        _hashCode.store(0, std::memory_order_relaxed);
+        return {_value - 1};
     }
 }
@@ -90,6 +90,38 @@ namespace Data {
         addString(buffer);
     }
 
+    void WString::addFormatV(const wchar_t *format, va_list ap) {
+        if (format == nullptr) {
+            return;
+        }
+
+        // the short results are formatted on the stack.
+        wchar_t buffer[FormatBufferLength];
+        va_list ap2;
+        va_copy(ap2, ap);
+        int length = vswprintf(buffer, FormatBufferLength, format, ap2);
+        va_end(ap2);
+        if (length >= 0) {
+            addString(buffer, length);
+            return;
+        }
+
+        // vswprintf can not measure, so the buffer is doubled until the result fits.
+        for (size_t size = FormatBufferLength * 4; size <= MaxFormatStrLength + 1; size *= 2) {
+            auto *message = new wchar_t[size];
+            va_copy(ap2, ap);
+            length = vswprintf(message, size, format, ap2);
+            va_end(ap2);
+            if (length >= 0) {
+                addString(message, length);
+            }
+            delete[] message;
+            if (length >= 0) {
+                break;
+            }
+        }
+    }
+
     const wchar_t *WString::getString() const {
         return _buffer.data();
     }
@@ -640,14 +672,10 @@ namespace Data {
     }
 
     void WString::appendFormat(const wchar_t *format, ...) {
-        auto *message = new wchar_t[MaxFormatStrLength];
-        wmemset(message, 0, MaxFormatStrLength);
         va_list ap;
         va_start(ap, format);
-        vswprintf(message, MaxFormatStrLength, format, ap);
+        addFormatV(format, ap);
         va_end(ap);
-        append(message);
-        delete[] message;
     }
 
     WString WString::replace(const WString &src, const WString &dst) {
@@ -726,26 +754,20 @@ namespace Data {
     }
 
     WString WString::convert(const wchar_t *format, ...) {
-        auto *message = new wchar_t[MaxFormatStrLength];
-        wmemset(message, 0, MaxFormatStrLength);
+        WString result;
         va_list ap;
         va_start(ap, format);
-        vswprintf(message, MaxFormatStrLength, format, ap);
+        result.addFormatV(format, ap);
         va_end(ap);
-        WString result = message;
-        delete[] message;
         return result;
     }
 
     WString WString::format(const wchar_t *format, ...) {
-        auto *message = new wchar_t[MaxFormatStrLength];
-        wmemset(message, 0, MaxFormatStrLength);
+        WString result;
         va_list ap;
         va_start(ap, format);
-        vswprintf(message, MaxFormatStrLength, format, ap);
+        result.addFormatV(format, ap);
         va_end(ap);
-        WString result = message;
-        delete[] message;
         return result;
     }
 
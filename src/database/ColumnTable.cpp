@@ -0,0 +1,550 @@
+//
+//  ColumnTable.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "database/ColumnTable.h"
+
+namespace Database {
+    ColumnVector::ColumnVector(const DataColumn &column) : _column(column), _width(widthOf(column.type())),
+                                                           _count(0) {
+    }
+
+    ColumnVector::ColumnVector(const ColumnVector &other) : _width(0), _count(0) {
+        ColumnVector::evaluates(other);
+    }
+
+    ColumnVector::~ColumnVector() = default;
+
+    void ColumnVector::evaluates(const ColumnVector &other) {
+        _column = other._column;
+        _width = other._width;
+        _count = other._count;
+        _values = other._values;
+        _nulls = other._nulls;
+        _pool = other._pool;
+        _entries = other._entries;
+        _slots = other._slots;
+    }
+
+    bool ColumnVector::equals(const ColumnVector &other) const {
+        if (!(_column == other._column) || _count != other._count) {
+            return false;
+        }
+        for (size_t i = 0; i < _count; i++) {
+            bool isNull = isNullValue(i);
+            if (isNull != other.isNullValue(i)) {
+                return false;
+            }
+            if (!isNull && value(i) != other.value(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ColumnVector &ColumnVector::operator=(const ColumnVector &other) {
+        if (this != &other) {
+            evaluates(other);
+        }
+        return *this;
+    }
+
+    const DataColumn &ColumnVector::column() const {
+        return _column;
+    }
+
+    DbType ColumnVector::type() const {
+        return _column.type();
+    }
+
+    size_t ColumnVector::count() const {
+        return _count;
+    }
+
+    bool ColumnVector::isNullValue(size_t pos) const {
+        if (pos >= _count) {
+            return true;
+        }
+        return (_nulls[pos / 64] & ((uint64_t) 1 << (pos % 64))) != 0;
+    }
+
+    DbValue ColumnVector::value(size_t pos) const {
+        if (isNullValue(pos)) {
+            return DbValue(type());
+        }
+
+        DbValue::Value value;
+        if (isEntryType()) {
+            uint32_t entry;
+            memcpy(&entry, &_values[pos * _width], sizeof(entry));
+            char *data = (char *) &_pool[_entries[entry]];
+            if (type() == DbType::Blob) {
+                value.blobValue = (uint8_t *) data;
+            } else {
+                value.strValue = data;
+            }
+        } else if (_width > 0) {
+            memcpy(&value, &_values[pos * _width], _width);
+        }
+        return DbValue(type(), value);
+    }
+
+    String ColumnVector::valueStr(size_t pos, bool hasQuote) const {
+        String valueStr = value(pos).valueStr();
+        DbType t = type();
+        if (hasQuote && (t == DbType::Text || t == DbType::Date || t == DbType::Time ||
+                         t == DbType::Timestamp || t == DbType::Interval)) {
+            return String::convert("'%s'", valueStr.c_str());
+        }
+        return valueStr;
+    }
+
+    void ColumnVector::addNull() {
+        if (_count % 64 == 0) {
+            _nulls.push_back(0);
+        }
+        _nulls[_count / 64] |= (uint64_t) 1 << (_count % 64);
+        _values.resize(_values.size() + _width);
+        _count++;
+    }
+
+    void ColumnVector::addValue(const DbValue &value) {
+        if (value.isNullValue()) {
+            addNull();
+            return;
+        }
+
+        DbType t = type();
+        if (t == DbType::Text || t == DbType::Decimal) {
+            String str = value.valueStr();
+            addText(str.c_str(), str.length());
+        } else if (t == DbType::Blob) {
+            ByteArray array;
+            value.getValue(array);
+            addBlob(array.data(), array.count());
+        } else if (value.type() == t) {
+            addRaw(value.value());
+        } else {
+            DbValue::Value dest;
+            if (DbValue::changeValue(value.type(), value.value(), t, dest)) {
+                addRaw(dest);
+            } else {
+                addNull();
+            }
+        }
+    }
+
+    void ColumnVector::addInteger(int64_t value) {
+        DbType t = type();
+        if (t == DbType::Integer64 || t == DbType::UInteger64) {
+            addRaw(DbValue::Value(value));
+        } else if (isEntryType() || t == DbType::Null) {
+            addValue(DbValue(value));
+        } else {
+            DbValue::Value dest;
+            if (DbValue::changeValue(DbType::Integer64, DbValue::Value(value), t, dest)) {
+                addRaw(dest);
+            } else {
+                addNull();
+            }
+        }
+    }
+
+    void ColumnVector::addFloat(double value) {
+        DbType t = type();
+        if (t == DbType::Float64) {
+            addRaw(DbValue::Value(value));
+        } else if (isEntryType() || t == DbType::Null) {
+            addValue(DbValue(value));
+        } else {
+            DbValue::Value dest;
+            if (DbValue::changeValue(DbType::Float64, DbValue::Value(value), t, dest)) {
+                addRaw(dest);
+            } else {
+                addNull();
+            }
+        }
+    }
+
+    void ColumnVector::addText(const char *text, size_t length) {
+        if (text == nullptr) {
+            addNull();
+            return;
+        }
+
+        DbType t = type();
+        if (t == DbType::Text || t == DbType::Decimal) {
+            uint32_t entry = addEntry(text, length, true);
+            addBytes(&entry);
+        } else {
+            addValue(DbValue(t, String(text, length)));
+        }
+    }
+
+    void ColumnVector::addBlob(const uint8_t *data, size_t length) {
+        if (type() != DbType::Blob) {
+            addValue(DbValue(type(), ByteArray(data, length)));
+            return;
+        }
+        if (data == nullptr || length == 0) {
+            addNull();
+            return;
+        }
+
+        uint32_t entry = addEntry((const char *) data, length, false);
+        addBytes(&entry);
+    }
+
+    void ColumnVector::reserve(size_t count) {
+        _values.reserve(count * _width);
+        _nulls.reserve((count + 63) / 64);
+    }
+
+    void ColumnVector::clear() {
+        _count = 0;
+        _values.clear();
+        _nulls.clear();
+        _pool.clear();
+        _entries.clear();
+        _slots.clear();
+    }
+
+    size_t ColumnVector::entryCount() const {
+        return _entries.size();
+    }
+
+    size_t ColumnVector::memorySize() const {
+        return _values.capacity() + _nulls.capacity() * sizeof(uint64_t) + _pool.capacity() +
+               _entries.capacity() * sizeof(uint64_t) + _slots.capacity() * sizeof(uint32_t);
+    }
+
+    void ColumnVector::addRaw(const DbValue::Value &value) {
+        addBytes(&value);
+    }
+
+    void ColumnVector::addBytes(const void *value) {
+        size_t offset = _values.size();
+        _values.resize(offset + _width);
+        if (_width > 0) {
+            memcpy(&_values[offset], value, _width);
+        }
+        if (_count % 64 == 0) {
+            _nulls.push_back(0);
+        }
+        _count++;
+    }
+
+    uint32_t ColumnVector::addEntry(const char *data, size_t length, bool text) {
+        uint64_t hash = 0;
+        if (text) {
+            hash = hashOf(data, length);
+            uint32_t entry = findText(data, length, hash);
+            if (entry != NoEntry) {
+                return entry - 1;
+            }
+        }
+
+        auto entry = (uint32_t) _entries.size();
+        size_t offset = _pool.size();
+        _entries.push_back(offset);
+        if (text) {
+            _pool.resize(offset + length + 1);
+            memcpy(&_pool[offset], data, length);
+            _pool[offset + length] = '\0';
+
+            // the load factor is 50% at most.
+            if (_entries.size() * 2 > _slots.size()) {
+                rehash(_slots.empty() ? 64 : _slots.size() * 2);
+            } else {
+                size_t mask = _slots.size() - 1;
+                size_t i = hash & mask;
+                while (_slots[i] != NoEntry) {
+                    i = (i + 1) & mask;
+                }
+                _slots[i] = entry + 1;
+            }
+        } else {
+            _pool.resize(offset + 4 + length);
+            _pool[offset] = (char) ((length >> 24) & 0xFF);
+            _pool[offset + 1] = (char) ((length >> 16) & 0xFF);
+            _pool[offset + 2] = (char) ((length >> 8) & 0xFF);
+            _pool[offset + 3] = (char) (length & 0xFF);
+            memcpy(&_pool[offset + 4], data, length);
+        }
+        return entry;
+    }
+
+    uint32_t ColumnVector::findText(const char *text, size_t length, uint64_t hash) const {
+        if (_slots.empty()) {
+            return NoEntry;
+        }
+        size_t mask = _slots.size() - 1;
+        for (size_t i = hash & mask; _slots[i] != NoEntry; i = (i + 1) & mask) {
+            const char *entry = &_pool[_entries[_slots[i] - 1]];
+            if (strncmp(entry, text, length) == 0 && entry[length] == '\0') {
+                return _slots[i];
+            }
+        }
+        return NoEntry;
+    }
+
+    void ColumnVector::rehash(size_t capacity) {
+        _slots.assign(capacity, (uint32_t) NoEntry);
+        size_t mask = capacity - 1;
+        for (size_t entry = 0; entry < _entries.size(); entry++) {
+            const char *text = &_pool[_entries[entry]];
+            size_t i = hashOf(text, strlen(text)) & mask;
+            while (_slots[i] != NoEntry) {
+                i = (i + 1) & mask;
+            }
+            _slots[i] = (uint32_t) entry + 1;
+        }
+    }
+
+    bool ColumnVector::isEntryType() const {
+        DbType t = type();
+        return t == DbType::Text || t == DbType::Decimal || t == DbType::Blob;
+    }
+
+    size_t ColumnVector::widthOf(DbType type) {
+        switch (type) {
+            case DbType::Null:
+                return 0;
+            case DbType::Digital:
+            case DbType::Integer8:
+            case DbType::UInteger8:
+                return 1;
+            case DbType::Integer16:
+            case DbType::UInteger16:
+                return 2;
+            case DbType::Integer32:
+            case DbType::UInteger32:
+            case DbType::Float32:
+                return 4;
+            case DbType::Decimal:
+            case DbType::Text:
+            case DbType::Blob:
+                return sizeof(uint32_t);
+            default:
+                return 8;
+        }
+    }
+
+    uint64_t ColumnVector::hashOf(const char *text, size_t length) {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= (uint8_t) text[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    ColumnRow::ColumnRow(const ColumnTable *table, size_t row) : _table(table), _row(row) {
+    }
+
+    DbValue ColumnRow::at(size_t pos) const {
+        return _table->value(_row, pos);
+    }
+
+    DbValue ColumnRow::at(const String &columnName) const {
+        ssize_t pos = _table->indexOf(columnName);
+        return pos >= 0 ? _table->value(_row, pos) : DbValue::NullValue;
+    }
+
+    bool ColumnRow::isNullValue(size_t pos) const {
+        return pos >= cellCount() || _table->at(pos).isNullValue(_row);
+    }
+
+    String ColumnRow::valueStr(size_t pos, bool hasQuote) const {
+        return pos < cellCount() ? _table->at(pos).valueStr(_row, hasQuote) : String::Empty;
+    }
+
+    size_t ColumnRow::cellCount() const {
+        return _table->columnCount();
+    }
+
+    size_t ColumnRow::index() const {
+        return _row;
+    }
+
+    DataRow ColumnRow::toDataRow() const {
+        DataRow row;
+        for (size_t i = 0; i < cellCount(); i++) {
+            row.addCell(DataCell(_table->columns()[i], at(i)));
+        }
+        return row;
+    }
+
+    ColumnTable::ColumnTable(const String &name) : _name(name), _totalCount(0) {
+    }
+
+    ColumnTable::ColumnTable(const ColumnTable &table) : _totalCount(0) {
+        ColumnTable::evaluates(table);
+    }
+
+    ColumnTable::ColumnTable(const DataTable &table) : _name(table.name()), _totalCount(table.totalCount()) {
+        addColumns(table.columns());
+        addRows(table.rows());
+    }
+
+    ColumnTable::~ColumnTable() = default;
+
+    void ColumnTable::evaluates(const ColumnTable &other) {
+        _name = other._name;
+        _columns = other._columns;
+        _vectors.clear();
+        for (size_t i = 0; i < other._vectors.count(); i++) {
+            _vectors.add(new ColumnVector(*other._vectors[i]));
+        }
+        _totalCount = other._totalCount;
+    }
+
+    bool ColumnTable::equals(const ColumnTable &other) const {
+        if (!(_name == other._name && _columns == other._columns && _totalCount == other._totalCount)) {
+            return false;
+        }
+        for (size_t i = 0; i < _vectors.count(); i++) {
+            if (*_vectors[i] != *other._vectors[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ColumnTable &ColumnTable::operator=(const ColumnTable &other) {
+        if (this != &other) {
+            evaluates(other);
+        }
+        return *this;
+    }
+
+    const String &ColumnTable::name() const {
+        return _name;
+    }
+
+    void ColumnTable::setName(const String &name) {
+        _name = name;
+    }
+
+    void ColumnTable::addColumn(const DataColumn &column) {
+        _columns.add(column);
+        auto vector = new ColumnVector(column);
+        // the rows added before have no value in the new column.
+        for (size_t i = 0; i < rowCount(); i++) {
+            vector->addNull();
+        }
+        _vectors.add(vector);
+    }
+
+    void ColumnTable::addColumns(const DataColumns &columns) {
+        for (size_t i = 0; i < columns.count(); i++) {
+            addColumn(columns[i]);
+        }
+    }
+
+    const DataColumns &ColumnTable::columns() const {
+        return _columns;
+    }
+
+    size_t ColumnTable::columnCount() const {
+        return _columns.count();
+    }
+
+    ssize_t ColumnTable::indexOf(const String &columnName) const {
+        for (size_t i = 0; i < _columns.count(); i++) {
+            if (String::equals(_columns[i].name(), columnName, true)) {
+                return (ssize_t) i;
+            }
+        }
+        return -1;
+    }
+
+    ColumnVector &ColumnTable::at(size_t pos) {
+        return *_vectors[pos];
+    }
+
+    const ColumnVector &ColumnTable::at(size_t pos) const {
+        return *_vectors[pos];
+    }
+
+    size_t ColumnTable::rowCount() const {
+        return _vectors.count() > 0 ? _vectors[0]->count() : 0;
+    }
+
+    ColumnRow ColumnTable::row(size_t pos) const {
+        return {this, pos};
+    }
+
+    DbValue ColumnTable::value(size_t row, size_t column) const {
+        return column < _vectors.count() ? _vectors[column]->value(row) : DbValue::NullValue;
+    }
+
+    void ColumnTable::addRow(const DataRow &row) {
+        for (size_t i = 0; i < _vectors.count(); i++) {
+            ColumnVector *vector = _vectors[i];
+            if (i < row.cellCount()) {
+                vector->addValue(row.cells()[i].value());
+            } else {
+                vector->addNull();
+            }
+        }
+    }
+
+    void ColumnTable::addRows(const DataRows &rows) {
+        reserve(rowCount() + rows.count());
+        for (size_t i = 0; i < rows.count(); i++) {
+            addRow(rows[i]);
+        }
+    }
+
+    void ColumnTable::reserve(size_t rowCount) {
+        for (size_t i = 0; i < _vectors.count(); i++) {
+            _vectors[i]->reserve(rowCount);
+        }
+    }
+
+    void ColumnTable::clear() {
+        _name = String::Empty;
+        _columns.clear();
+        _vectors.clear();
+        _totalCount = 0;
+    }
+
+    void ColumnTable::clearRows() {
+        for (size_t i = 0; i < _vectors.count(); i++) {
+            _vectors[i]->clear();
+        }
+    }
+
+    int ColumnTable::totalCount() const {
+        return _totalCount;
+    }
+
+    void ColumnTable::setTotalCount(int totalCount) {
+        _totalCount = totalCount >= 0 ? totalCount : 0;
+    }
+
+    size_t ColumnTable::memorySize() const {
+        size_t size = 0;
+        for (size_t i = 0; i < _vectors.count(); i++) {
+            size += _vectors[i]->memorySize();
+        }
+        return size;
+    }
+
+    void ColumnTable::toDataTable(DataTable &table) const {
+        table.setName(_name);
+        table.setTotalCount(_totalCount);
+        if (table.columnCount() == 0) {
+            table.addColumns(_columns);
+        }
+        for (size_t i = 0; i < rowCount(); i++) {
+            table.addRow(row(i).toDataRow());
+        }
+    }
+}
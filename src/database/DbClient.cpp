@@ -38,7 +38,36 @@ using namespace System;
 using namespace Diag;
 
 namespace Database {
-    DbClient::DbClient() = default;
+    // The cursor of the clients without the native one, reads the batches from the whole result.
+    class TableCursor : public DbCursor {
+    public:
+        explicit TableCursor(size_t batchSize) : DbCursor(nullptr, batchSize), _row(0) {
+        }
+
+        bool open(DbClient *client, const String &sql) {
+            if (!client->executeSqlQuery(sql, _table)) {
+                return false;
+            }
+            setColumns(_table.columns());
+            return true;
+        }
+
+    protected:
+        bool fetchInner(ColumnTable &batch, size_t count) override {
+            const DataRows &rows = _table.rows();
+            for (size_t i = 0; i < count && _row < rows.count(); i++, _row++) {
+                batch.addRow(rows[_row]);
+            }
+            return true;
+        }
+
+    private:
+        DataTable _table;
+        size_t _row;
+    };
+
+    DbClient::DbClient() : _cursorOpened(false) {
+    }
 
     DbClient::~DbClient() = default;
 
@@ -76,6 +105,28 @@ namespace Database {
         return executeSqlReplace(table, false);
     }
 
+    bool DbClient::executeSqlQuery(const String &sql, ColumnTable &table) {
+        DataTable temp(table.name());
+        if (!executeSqlQuery(sql, temp)) {
+            return false;
+        }
+        if (table.columnCount() == 0) {
+            table.addColumns(temp.columns());
+        }
+        table.addRows(temp.rows());
+        table.setTotalCount(temp.totalCount());
+        return true;
+    }
+
+    DbCursor *DbClient::executeSqlCursor(const String &sql, size_t batchSize) {
+        auto cursor = new TableCursor(batchSize);
+        if (!cursor->open(this, sql)) {
+            delete cursor;
+            return nullptr;
+        }
+        return cursor;
+    }
+
     bool DbClient::retrieveCount(const String &sql, int &count) {
         DataTable table("countTable");
         table.addColumn(DataColumn("count", DbType::Integer32));
@@ -89,6 +140,10 @@ namespace Database {
     }
 
     bool DbClient::isExecuting() {
+        // the thread of the cursor holds the lock, the tryLock succeeds on it.
+        if (_cursorOpened) {
+            return true;
+        }
         if (_dbMutex.tryLock()) {
             _dbMutex.unlock();
             return false;
@@ -96,6 +151,14 @@ namespace Database {
         return true;
     }
 
+    bool DbClient::checkCursor(const String &methodName, const String &sql) {
+        if (_cursorOpened) {
+            printErrorInfo(methodName, sql, "a cursor of the client is not deleted yet");
+            return false;
+        }
+        return true;
+    }
+
     void DbClient::printErrorInfo(const String &methodName, const String &sql, const String &error) {
         const int maxCount = 512;
         const char *sqlStr;
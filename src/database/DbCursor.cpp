@@ -0,0 +1,117 @@
+//
+//  DbCursor.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "database/DbCursor.h"
+#include "database/DbClient.h"
+#include <cassert>
+
+namespace Database {
+    DbCursor::DbCursor(DbClient *client, size_t batchSize) : _client(client), _batch("cursor"), _next(0),
+                                                             _rowCount(0), _end(false), _error(false) {
+        _batchSize = batchSize > 0 ? batchSize : DefaultBatchSize;
+        if (_client != nullptr) {
+            // the lock of the client is recursive, so the flag keeps the same thread from reusing it.
+            _threadId = Thread::currentThreadId();
+            _client->_cursorOpened = true;
+        }
+    }
+
+    DbCursor::~DbCursor() {
+        // the client is locked by the query which created the cursor.
+        if (_client != nullptr) {
+            assert(_threadId == Thread::currentThreadId());
+            _client->_cursorOpened = false;
+            _client->_dbMutex.unlock();
+            _client = nullptr;
+        }
+    }
+
+    const DataColumns &DbCursor::columns() const {
+        return _batch.columns();
+    }
+
+    size_t DbCursor::columnCount() const {
+        return _batch.columnCount();
+    }
+
+    ssize_t DbCursor::indexOf(const String &columnName) const {
+        return _batch.indexOf(columnName);
+    }
+
+    size_t DbCursor::batchSize() const {
+        return _batchSize;
+    }
+
+    bool DbCursor::fetch() {
+        if (_end || _error) {
+            return false;
+        }
+
+        // the vectors keep their capacity, so the batches reuse the same memory.
+        _batch.clearRows();
+        _next = 0;
+        if (!fetchInner(_batch, _batchSize)) {
+            _error = true;
+            return false;
+        }
+        size_t count = _batch.rowCount();
+        if (count < _batchSize) {
+            _end = true;
+        }
+        _rowCount += count;
+        return count > 0;
+    }
+
+    const ColumnTable &DbCursor::batch() const {
+        return _batch;
+    }
+
+    bool DbCursor::moveNext() {
+        if (_next >= _batch.rowCount()) {
+            if (!fetch()) {
+                return false;
+            }
+        }
+        _next++;
+        return true;
+    }
+
+    bool DbCursor::isNullValue(size_t column) const {
+        if (_next == 0 || column >= _batch.columnCount()) {
+            return true;
+        }
+        return _batch.at(column).isNullValue(_next - 1);
+    }
+
+    DbValue DbCursor::value(size_t column) const {
+        if (_next == 0 || column >= _batch.columnCount()) {
+            return DbValue::NullValue;
+        }
+        return _batch.value(_next - 1, column);
+    }
+
+    DbValue DbCursor::value(const String &columnName) const {
+        ssize_t column = indexOf(columnName);
+        return column >= 0 ? value((size_t) column) : DbValue::NullValue;
+    }
+
+    uint64_t DbCursor::rowCount() const {
+        return _rowCount;
+    }
+
+    bool DbCursor::hasError() const {
+        return _error;
+    }
+
+    void DbCursor::setColumns(const DataColumns &columns) {
+        _batch.clear();
+        _batch.setName("cursor");
+        _batch.addColumns(columns);
+        _batch.reserve(_batchSize);
+    }
+}
@@ -41,6 +41,110 @@ namespace Database {
         }
     };
 
+    static const char *const CursorPrefix = "common_cursor";
+    static std::atomic<uint32_t> cursorCount(0);
+
+    // Server side cursor in a transaction, every batch is read by a FETCH statement.
+    class KingbaseCursor : public DbCursor {
+    public:
+        KingbaseCursor(KingbaseClient *client, size_t batchSize) : DbCursor(client, batchSize),
+                                                                   _client(client), _pending(nullptr),
+                                                                   _transaction(false), _declared(false) {
+            // the names are unique, so the cursors of a connection do not conflict.
+            _name = String::format("%s%u", CursorPrefix, (uint32_t) ++cursorCount);
+            _fetchSql = String::format("FETCH FORWARD %d FROM %s", (int) this->batchSize(), _name.c_str());
+        }
+
+        ~KingbaseCursor() override {
+            if (_pending != nullptr) {
+                KCIResultDealloc(_pending);
+                _pending = nullptr;
+            }
+            if (_declared) {
+                ResultInner result;
+                if (KingbaseClient::isSucceed(_client->executeInner(String("CLOSE ") + _name, result))) {
+                    KCIResultDealloc(result.res);
+                }
+            }
+            if (_transaction) {
+                _client->commitTransactionInner();
+            }
+        }
+
+        bool open(const String &sql) {
+            int status = _client->beginTransactionInner();
+            if (!KingbaseClient::isSucceed(status)) {
+                return false;
+            }
+            _transaction = true;
+
+            ResultInner result;
+            status = _client->executeInner(String("DECLARE ") + _name + " NO SCROLL CURSOR FOR " + sql, result);
+            if (!KingbaseClient::isSucceed(status)) {
+                return false;
+            }
+            KCIResultDealloc(result.res);
+            _declared = true;
+
+            // the columns are known after the first batch.
+            status = _client->executeInner(_fetchSql, result);
+            if (!KingbaseClient::isSucceed(status)) {
+                return false;
+            }
+            _pending = result.res;
+
+            DataColumns columns;
+            int columnCount = KCIResultGetColumnCount(_pending);
+            for (int i = 0; i < columnCount; i++) {
+                const char *nameStr = KCIResultGetColumnName(_pending, i);
+                String name;
+                if (nameStr != nullptr) {
+                    name = nameStr;
+                } else {
+                    char temp[32];
+                    sprintf(temp, "tempCol%d", i);
+                    name = temp;
+                }
+                columns.add(DataColumn(name, _client->getColumnType((int) KCIResultGetColumnType(_pending, i))));
+            }
+            setColumns(columns);
+            return true;
+        }
+
+    protected:
+        bool fetchInner(ColumnTable &batch, size_t count) override {
+            KCIResult *res = _pending;
+            _pending = nullptr;
+            if (res == nullptr) {
+                ResultInner result;
+                int status = _client->executeInner(_fetchSql, result);
+                if (!KingbaseClient::isSucceed(status)) {
+                    return false;
+                }
+                res = result.res;
+            }
+
+            int columnCount = (int) batch.columnCount();
+            int rowCount = KCIResultGetRowCount(res);
+            for (int i = 0; i < rowCount && i < (int) count; i++) {
+                for (int j = 0; j < columnCount; j++) {
+                    String str = String::GBKtoUTF8(KCIResultGetColumnValue(res, i, j));
+                    batch.at(j).addText(str.c_str(), str.length());
+                }
+            }
+            KCIResultDealloc(res);
+            return true;
+        }
+
+    private:
+        KingbaseClient *_client;
+        String _name;
+        String _fetchSql;
+        KCIResult *_pending;
+        bool _transaction;
+        bool _declared;
+    };
+
     KingbaseClient::KingbaseClient() {
         _kingbaseDb = new KingbaseInner();
     }
@@ -442,6 +546,18 @@ namespace Database {
 //        return result;
     }
 
+    DbCursor *KingbaseClient::executeSqlCursor(const String &sql, size_t batchSize) {
+        _dbMutex.lock();
+
+        // the cursor unlocks the client when it is deleted.
+        auto cursor = new KingbaseCursor(this, batchSize);
+        if (!cursor->open(sql)) {
+            delete cursor;
+            return nullptr;
+        }
+        return cursor;
+    }
+
     void KingbaseClient::updateDataTable(void *tag, DataTable &table) {
         auto *res = (KCIResult *) tag;
 #if DEBUG
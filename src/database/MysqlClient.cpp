@@ -29,6 +29,40 @@ namespace Database {
         }
     };
 
+    class MysqlCursor : public DbCursor {
+    public:
+        MysqlCursor(DbClient *client, MYSQL_RES *result, const DataColumns &columns, size_t batchSize) :
+                DbCursor(client, batchSize), _result(result) {
+            setColumns(columns);
+        }
+
+        ~MysqlCursor() override {
+            // the rest of the rows are read and discarded, the connection is ready for the next query.
+            mysql_free_result(_result);
+            _result = nullptr;
+        }
+
+    protected:
+        bool fetchInner(ColumnTable &batch, size_t count) override {
+            auto columnCount = (int) batch.columnCount();
+            for (size_t i = 0; i < count; i++) {
+                MYSQL_ROW sql_row = mysql_fetch_row(_result);
+                if (sql_row == nullptr) {
+                    // the end of the rows or an error of the connection.
+                    return mysql_errno(_result->handle) == 0;
+                }
+                unsigned long *lengths = mysql_fetch_lengths(_result);
+                for (int j = 0; j < columnCount; j++) {
+                    batch.at(j).addText(sql_row[j], lengths[j]);
+                }
+            }
+            return true;
+        }
+
+    private:
+        MYSQL_RES *_result;
+    };
+
     MysqlClient::MysqlClient() {
         _mysqlDb = new MysqlInner();
         _mysqlDb->mysqlDb = mysql_init(nullptr);
@@ -110,6 +144,9 @@ namespace Database {
 
     bool MysqlClient::isConnected() {
         Locker locker(&_dbMutex);
+        if (!checkCursor("isConnected")) {
+            return false;
+        }
         int result = mysql_ping(_mysqlDb->mysqlDb);
         return result == 0;
     }
@@ -124,6 +161,9 @@ namespace Database {
 
     bool MysqlClient::executeSql(const String &sql, bool transaction) {
         Locker locker(&_dbMutex);
+        if (!checkCursor("executeSql", sql)) {
+            return false;
+        }
 
         int result;
         if (transaction) {
@@ -150,6 +190,9 @@ namespace Database {
 
     bool MysqlClient::beginTransaction() {
         Locker locker(&_dbMutex);
+        if (!checkCursor("beginTransaction")) {
+            return false;
+        }
 
         int result = beginTransactionInner();
         return isSucceed(result);
@@ -157,6 +200,9 @@ namespace Database {
 
     bool MysqlClient::commitTransaction() {
         Locker locker(&_dbMutex);
+        if (!checkCursor("commitTransaction")) {
+            return false;
+        }
 
         int result = commitTransactionInner();
         return isSucceed(result);
@@ -164,6 +210,9 @@ namespace Database {
 
     bool MysqlClient::rollbackTransaction() {
         Locker locker(&_dbMutex);
+        if (!checkCursor("rollbackTransaction")) {
+            return false;
+        }
 
         int result = rollbackTransactionInner();
         return isSucceed(result);
@@ -171,6 +220,9 @@ namespace Database {
 
     bool MysqlClient::executeSqlQuery(const String &sql, DataTable &table) {
         Locker locker(&_dbMutex);
+        if (!checkCursor("executeSqlQuery", sql)) {
+            return false;
+        }
 
         int result = executeSqlQueryInner(sql, table);
         return isSucceed(result);
@@ -178,6 +230,9 @@ namespace Database {
 
     bool MysqlClient::executeSqlInsert(const DataTable &table, bool transaction) {
         Locker locker(&_dbMutex);
+        if (!checkCursor("executeSqlInsert")) {
+            return false;
+        }
 
         int result;
         if (transaction) {
@@ -204,6 +259,9 @@ namespace Database {
 
     bool MysqlClient::executeSqlReplace(const DataTable &table, bool transaction) {
         Locker locker(&_dbMutex);
+        if (!checkCursor("executeSqlReplace")) {
+            return false;
+        }
 
         int result;
         if (transaction) {
@@ -351,6 +409,47 @@ namespace Database {
         return MysqlInner::MYSQL_OK;
     }
 
+    DbCursor *MysqlClient::executeSqlCursor(const String &sql, size_t batchSize) {
+        _dbMutex.lock();
+        if (!checkCursor("executeSqlCursor", sql)) {
+            _dbMutex.unlock();
+            return nullptr;
+        }
+
+        mysql_ping(_mysqlDb->mysqlDb);
+        int result = mysql_query(_mysqlDb->mysqlDb, sql.c_str());
+        if (!isSucceed(result)) {
+            printErrorInfo("mysql_query", sql);
+            _dbMutex.unlock();
+            return nullptr;
+        }
+
+        // the rows are read from the server on demand instead of being stored in the client.
+        MYSQL_RES *result_set = mysql_use_result(_mysqlDb->mysqlDb);
+        if (result_set == nullptr) {
+            printErrorInfo("mysql_use_result", sql);
+            _dbMutex.unlock();
+            return nullptr;
+        }
+
+        DataColumns columns;
+        auto columnCount = (int) mysql_num_fields(result_set);
+        for (int i = 0; i < columnCount; i++) {
+            MYSQL_FIELD *fd = mysql_fetch_field(result_set);
+            String name;
+            if (fd->name != nullptr) {
+                name = fd->name;
+            } else {
+                char temp[32];
+                sprintf(temp, "tempCol%d", i);
+                name = temp;
+            }
+            columns.add(DataColumn(name, getColumnType(fd->type)));
+        }
+        // the cursor unlocks the client when it is deleted.
+        return new MysqlCursor(this, result_set, columns, batchSize);
+    }
+
     void MysqlClient::updateDataTable(void *tag, DataTable &table) {
         auto result = (MYSQL_RES *) tag;
 #if DEBUG
@@ -292,6 +292,14 @@ namespace Database {
         return false;
     }
 
+    DbCursor *SqlConnection::executeSqlCursor(const String &sql, size_t batchSize) {
+        DbClient *client = getClient();
+        if (client != nullptr) {
+            return client->executeSqlCursor(sql, batchSize);
+        }
+        return nullptr;
+    }
+
     bool SqlConnection::executeSqlInsert(const DataTable &table, bool transaction) {
         DbClient *client = getClient();
         if (client != nullptr) {
@@ -23,6 +23,36 @@ namespace Database {
         }
     };
 
+    class SqliteCursor : public DbCursor {
+    public:
+        SqliteCursor(DbClient *client, sqlite3_stmt *stmt, const DataColumns &columns, size_t batchSize) :
+                DbCursor(client, batchSize), _stmt(stmt) {
+            setColumns(columns);
+        }
+
+        ~SqliteCursor() override {
+            sqlite3_finalize(_stmt);
+            _stmt = nullptr;
+        }
+
+    protected:
+        bool fetchInner(ColumnTable &batch, size_t count) override {
+            for (size_t i = 0; i < count; i++) {
+                int result = sqlite3_step(_stmt);
+                if (result == SQLITE_DONE) {
+                    break;
+                } else if (result != SQLITE_ROW) {
+                    return false;
+                }
+                SqliteClient::addRow(_stmt, batch);
+            }
+            return true;
+        }
+
+    private:
+        sqlite3_stmt *_stmt;
+    };
+
     SqliteClient::SqliteClient() {
         _sqliteDb = new SqliteInner();
     }
@@ -172,6 +202,33 @@ namespace Database {
         return isSucceed(result);
     }
 
+    bool SqliteClient::executeSqlQuery(const String &sql, ColumnTable &table) {
+        Locker locker(&_dbMutex);
+
+        int result = executeSqlQueryInner(sql, table);
+        return isSucceed(result);
+    }
+
+    DbCursor *SqliteClient::executeSqlCursor(const String &sql, size_t batchSize) {
+        _dbMutex.lock();
+
+        sqlite3_stmt *stmt;
+        int result = sqlite3_prepare_v2(_sqliteDb->sqliteDb, sql.c_str(), (int) sql.length(), &stmt, nullptr);
+        if (!isSucceed(result)) {
+            printErrorInfo("sqlite3_prepare_v2", sql);
+            _dbMutex.unlock();
+            return nullptr;
+        }
+
+        DataColumns columns;
+        int columnCount = sqlite3_column_count(stmt);
+        for (int i = 0; i < columnCount; i++) {
+            columns.add(getColumn(stmt, i));
+        }
+        // the cursor unlocks the client when it is deleted.
+        return new SqliteCursor(this, stmt, columns, batchSize);
+    }
+
     bool SqliteClient::executeSqlInsert(const DataTable &table, bool transaction) {
         Locker locker(&_dbMutex);
 
@@ -393,19 +450,7 @@ namespace Database {
             table_columnCount == 0) {
             if (table_columnCount == 0) {
                 for (int i = 0; i < columnCount; i++) {
-                    const char *nameStr = sqlite3_column_name(stmt, i);
-                    String name;
-                    if (nameStr != nullptr) {
-                        name = nameStr;
-                    } else {
-                        char temp[32];
-                        sprintf(temp, "tempCol%d", i);
-                        name = temp;
-                    }
-
-                    const char *typeStr = sqlite3_column_decltype(stmt, i);
-                    String type = typeStr != nullptr ? typeStr : "text";
-                    table.addColumn(DataColumn(name, getColumnType(type)));
+                    table.addColumn(getColumn(stmt, i));
                 }
             }
 
@@ -430,6 +475,84 @@ namespace Database {
         return SQLITE_OK;
     }
 
+    int SqliteClient::executeSqlQueryInner(const String &sql, ColumnTable &table) {
+#if DEBUG
+        String info = String::convert("SqliteClient::executeSqlQueryInner, tabl name: %s", table.name().c_str());
+        Stopwatch sw(info, 100);
+#endif
+        sqlite3_stmt *stmt;
+        int result = sqlite3_prepare_v2(_sqliteDb->sqliteDb, sql.c_str(), (int) sql.length(), &stmt, nullptr);
+        if (!isSucceed(result)) {
+            printErrorInfo("sqlite3_prepare_v2", sql);
+            return result;
+        }
+
+        if (table.name().isNullOrEmpty()) {
+            table.setName("temp");
+        }
+
+        int columnCount = sqlite3_column_count(stmt);
+        int table_columnCount = (int) table.columnCount();
+        if ((table_columnCount > 0 && table_columnCount == columnCount) ||
+            table_columnCount == 0) {
+            if (table_columnCount == 0) {
+                for (int i = 0; i < columnCount; i++) {
+                    table.addColumn(getColumn(stmt, i));
+                }
+            }
+
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                addRow(stmt, table);
+            }
+        }
+
+        result = sqlite3_finalize(stmt);
+        if (!isSucceed(result)) {
+            printErrorInfo("sqlite3_finalize", sql);
+            return result;
+        }
+
+        return SQLITE_OK;
+    }
+
+    DataColumn SqliteClient::getColumn(void *tag, int index) {
+        auto stmt = (sqlite3_stmt *) tag;
+        const char *nameStr = sqlite3_column_name(stmt, index);
+        String name;
+        if (nameStr != nullptr) {
+            name = nameStr;
+        } else {
+            char temp[32];
+            sprintf(temp, "tempCol%d", index);
+            name = temp;
+        }
+
+        const char *typeStr = sqlite3_column_decltype(stmt, index);
+        String type = typeStr != nullptr ? typeStr : "text";
+        return DataColumn(name, getColumnType(type));
+    }
+
+    void SqliteClient::addRow(void *tag, ColumnTable &table) {
+        auto stmt = (sqlite3_stmt *) tag;
+        // the values are appended to the column vectors directly, no DataRow is created.
+        for (int i = 0; i < (int) table.columnCount(); i++) {
+            ColumnVector &vector = table.at(i);
+            DbType type = vector.type();
+            int valueType = sqlite3_column_type(stmt, i);
+            if (valueType == SQLITE_NULL) {
+                vector.addNull();
+            } else if (valueType == SQLITE_INTEGER && type >= DbType::Integer8 && type <= DbType::UInteger64) {
+                vector.addInteger(sqlite3_column_int64(stmt, i));
+            } else if ((valueType == SQLITE_INTEGER || valueType == SQLITE_FLOAT) &&
+                       (type == DbType::Float32 || type == DbType::Float64)) {
+                vector.addFloat(sqlite3_column_double(stmt, i));
+            } else {
+                auto str = (const char *) sqlite3_column_text(stmt, i);
+                vector.addText(str, (size_t) sqlite3_column_bytes(stmt, i));
+            }
+        }
+    }
+
     int SqliteClient::beginTransactionInner() {
 //#if DEBUG
 //		Debug::writeLine("sqlite: BEGIN TRANSACTION");
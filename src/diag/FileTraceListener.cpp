@@ -5,8 +5,16 @@
 //  Created by baowei on 2015/7/14.
 //  Copyright (c) 2015 com. All rights reserved.
 //
+
+#ifndef WIN32
+
+#include <unistd.h>
+
+#endif
+
 #include "diag/FileTraceListener.h"
 #include "diag/Trace.h"
+#include "diag/TraceWriter.h"
 #include "IO/Metrics.h"
 #include "system/Resources.h"
 #include "IO/Path.h"
@@ -219,7 +227,34 @@ namespace Diag {
         }
     }
 
-    void FileTraceListener::flushInner(bool locked) {
+    void FileTraceListener::writeBatch(const TraceRecord *records, size_t count, bool flush) {
+        if (!_context.enable)
+            return;
+
+        Locker locker(&_messageMutex);
+
+        if (_diskIsFull)
+            return;
+
+        // the messages written before the async trace is enabled.
+        flushInner(false);
+        if (!fileOpened())
+            return;
+
+        int fd = _file->fd();
+        TraceWriter::writeFully(fd, records, count);
+        if (flush) {
+            // the errors must be on the disk.
+#if WIN32
+#elif __APPLE__
+            fsync(fd);
+#else
+            fdatasync(fd);
+#endif
+        }
+    }
+
+    void FileTraceListener::checkFile() {
         if (!isCurrentDate()) {
             if (fileOpened()) {
                 _file->close();
@@ -228,6 +263,10 @@ namespace Diag {
             }
             createFile(_context.path);
         }
+    }
+
+    void FileTraceListener::flushInner(bool locked) {
+        checkFile();
 
         if (!fileOpened())
             return;
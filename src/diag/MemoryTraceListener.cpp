@@ -8,20 +8,24 @@
 
 #include "diag/MemoryTraceListener.h"
 #include "diag/Trace.h"
-#include "thread/Locker.h"
+#include "system/Math.h"
 
 namespace Diag {
     const MemoryTraceListenerContext MemoryTraceListenerContext::Default = MemoryTraceListenerContext();
 
-    MemoryTraceListenerContext::MemoryTraceListenerContext(int maxMessageCount) {
+    MemoryTraceListenerContext::MemoryTraceListenerContext(int maxMessageCount, size_t bufferSize) {
         if (maxMessageCount >= 1000 && maxMessageCount < 64 * 1024)
             this->maxMessageCount = maxMessageCount;
         else
             this->maxMessageCount = 10000;
+        if (bufferSize >= MinBufferSize && bufferSize <= MaxBufferSize)
+            this->bufferSize = bufferSize;
+        else
+            this->bufferSize = DefaultBufferSize;
     }
 
     MemoryTraceListenerContext::MemoryTraceListenerContext(const MemoryTraceListenerContext &context)
-            : MemoryTraceListenerContext(context.maxMessageCount) {
+            : MemoryTraceListenerContext(context.maxMessageCount, context.bufferSize) {
     }
 
     MemoryTraceListenerContext::~MemoryTraceListenerContext() = default;
@@ -33,7 +37,7 @@ namespace Diag {
 
         auto context = dynamic_cast<const MemoryTraceListenerContext *>(&other);
         if (context != nullptr) {
-            return this->maxMessageCount == context->maxMessageCount;
+            return this->maxMessageCount == context->maxMessageCount && this->bufferSize == context->bufferSize;
         }
         return false;
     }
@@ -44,6 +48,7 @@ namespace Diag {
         auto context = dynamic_cast<const MemoryTraceListenerContext *>(&other);
         if (context != nullptr) {
             this->maxMessageCount = context->maxMessageCount;
+            this->bufferSize = context->bufferSize;
         }
     }
 
@@ -52,8 +57,161 @@ namespace Diag {
         return *this;
     }
 
+    TraceRing::TraceRing(size_t size) : _next(0) {
+        // a power of 2, large enough for the longest message.
+        _capacity = 64;
+        while (_capacity * 2 * SlotSize <= size) {
+            _capacity *= 2;
+        }
+        _mask = _capacity - 1;
+        _slots = new Slot[_capacity];
+        for (size_t i = 0; i < _capacity; i++) {
+            _slots[i].stamp.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    TraceRing::~TraceRing() {
+        delete[] _slots;
+        _slots = nullptr;
+    }
+
+    uint64_t TraceRing::write(const char *text, size_t length) {
+        if (length > MaxTextLength) {
+            length = MaxTextLength;
+        }
+        size_t count = (sizeof(Header) + length + DataSize - 1) / DataSize;
+        uint64_t position = _next.fetch_add(count, std::memory_order_relaxed);
+
+        // the slots are marked before written, so the readers copying the old messages of them skip them.
+        for (size_t i = 0; i < count; i++) {
+            _slots[(position + i) & _mask].stamp.store(0, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        // the first slot is stamped at last, a message is complete if its first slot is stamped.
+        Slot &head = _slots[position & _mask];
+        Header header = {(uint32_t) length, (uint32_t) count};
+        memcpy(head.data, &header, sizeof(header));
+        size_t offset = Math::min(length, DataSize - sizeof(Header));
+        memcpy(head.data + sizeof(Header), text, offset);
+        for (size_t i = 1; i < count; i++) {
+            Slot &slot = _slots[(position + i) & _mask];
+            size_t size = Math::min(length - offset, DataSize);
+            memcpy(slot.data, text + offset, size);
+            offset += size;
+            slot.stamp.store(bodyStamp(position + i), std::memory_order_release);
+        }
+        head.stamp.store(headStamp(position), std::memory_order_release);
+        return position;
+    }
+
+    size_t TraceRing::read(uint64_t &cursor, StringArray &messages, size_t maxCount) const {
+        char text[MaxTextLength];
+        size_t added = 0;
+        while (added < maxCount) {
+            uint64_t next = _next.load(std::memory_order_acquire);
+            if (cursor >= next) {
+                break;
+            }
+            if (next - cursor > _capacity) {
+                cursor = next - _capacity;
+            }
+
+            size_t length = 0, count = 0;
+            ReadResult result = readAt(cursor, text, length, count);
+            if (result == ReadPending) {
+                break;
+            } else if (result == ReadDone) {
+                messages.add(String(text, length));
+                cursor += count;
+                added++;
+            } else {
+                cursor++;
+            }
+        }
+        return added;
+    }
+
+    uint64_t TraceRing::first() const {
+        uint64_t next = _next.load(std::memory_order_acquire);
+        return next > _capacity ? next - _capacity : 0;
+    }
+
+    uint64_t TraceRing::last(size_t count) const {
+        uint64_t next = _next.load(std::memory_order_acquire);
+        uint64_t first = next > _capacity ? next - _capacity : 0;
+        // back over the stamps only, the first slot of a message has its own.
+        uint64_t position = next;
+        size_t found = 0;
+        while (position > first && found < count) {
+            position--;
+            if (_slots[position & _mask].stamp.load(std::memory_order_acquire) == headStamp(position)) {
+                found++;
+            }
+        }
+        return position;
+    }
+
+    uint64_t TraceRing::next() const {
+        return _next.load(std::memory_order_acquire);
+    }
+
+    size_t TraceRing::size() const {
+        return _capacity * SlotSize;
+    }
+
+    uint64_t TraceRing::headStamp(uint64_t position) {
+        return ((position + 1) << 1) | 1;
+    }
+
+    uint64_t TraceRing::bodyStamp(uint64_t position) {
+        return (position + 1) << 1;
+    }
+
+    TraceRing::ReadResult TraceRing::readAt(uint64_t position, char *text, size_t &length, size_t &count) const {
+        const Slot &head = _slots[position & _mask];
+        uint64_t stamp = head.stamp.load(std::memory_order_acquire);
+        if (stamp != headStamp(position)) {
+            // being written, or the old message of the slot.
+            if (stamp == 0 || (stamp >> 1) <= position) {
+                return ReadPending;
+            }
+            return ReadSkipped;
+        }
+
+        Header header;
+        memcpy(&header, head.data, sizeof(header));
+        size_t offset = Math::min((size_t) header.length, DataSize - sizeof(Header));
+        memcpy(text, head.data + sizeof(Header), offset);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (head.stamp.load(std::memory_order_relaxed) != stamp) {
+            return ReadSkipped;
+        }
+        if (header.length > MaxTextLength || header.count == 0 || header.count > _capacity) {
+            return ReadSkipped;
+        }
+
+        for (size_t i = 1; i < header.count; i++) {
+            const Slot &slot = _slots[(position + i) & _mask];
+            uint64_t bstamp = slot.stamp.load(std::memory_order_acquire);
+            if (bstamp != bodyStamp(position + i)) {
+                return ReadSkipped;
+            }
+            size_t size = Math::min(header.length - offset, DataSize);
+            memcpy(text + offset, slot.data, size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.stamp.load(std::memory_order_relaxed) != bstamp) {
+                return ReadSkipped;
+            }
+            offset += size;
+        }
+        length = header.length;
+        count = header.count;
+        return ReadDone;
+    }
+
     MemoryTraceListener::MemoryTraceListener(const MemoryTraceListenerContext &context) :
-            _messages(context.maxMessageCount), _context(context) {
+            _ring(context.bufferSize), _context(context) {
     }
 
     MemoryTraceListener::~MemoryTraceListener() = default;
@@ -63,29 +221,41 @@ namespace Diag {
             return;
         }
 
-        {
-            Locker locker(&_messages);
-            _messages.enqueue(message);
-        }
+        _ring.write(message.c_str(), message.length());
 
-        TraceUpdatedEventArgs args(message, !category.isNullOrEmpty() ? category.c_str() : Trace::Info);
-        _updateDelegates.invoke(this, &args);
+        if (_updateDelegates.count() > 0) {
+            TraceUpdatedEventArgs args(message, !category.isNullOrEmpty() ? category.c_str() : Trace::Info);
+            _updateDelegates.invoke(this, &args);
+        }
     }
 
-    void MemoryTraceListener::getAllMessages(StringArray &messages) {
-        Locker locker(&_messages);
-
-        size_t count = _messages.count();
-        if (count > 0) {
-            auto values = new String*[count];
-            _messages.copyTo(values);
-            for (size_t i = 0; i < count; i++) {
-                messages.add(*values[i]);
+    void MemoryTraceListener::writeBatch(const TraceRecord *records, size_t count, bool flush) {
+        for (size_t i = 0; i < count; i++) {
+            const TraceRecord &record = records[i];
+            _ring.write(record.text, record.length);
+
+            if (_updateDelegates.count() > 0) {
+                TraceUpdatedEventArgs args(String(record.text, record.length), record.category);
+                _updateDelegates.invoke(this, &args);
             }
-            delete[] values;
         }
     }
 
+    void MemoryTraceListener::getAllMessages(StringArray &messages) {
+        // only the last messages are copied, not the whole ring.
+        auto count = (size_t) _context.maxMessageCount;
+        uint64_t cursor = _ring.last(count);
+        _ring.read(cursor, messages, count);
+    }
+
+    size_t MemoryTraceListener::getMessages(uint64_t &cursor, StringArray &messages, size_t maxCount) const {
+        return _ring.read(cursor, messages, maxCount);
+    }
+
+    uint64_t MemoryTraceListener::position() const {
+        return _ring.next();
+    }
+
     Delegates *MemoryTraceListener::updatedDelegates() {
         return &_updateDelegates;
     }
@@ -16,8 +16,14 @@
 #endif
 
 #include <cstdarg>
+#include <ctime>
+#include <chrono>
 #include "data/DateTime.h"
 #include "diag/Trace.h"
+#include "diag/TraceWriter.h"
+#include "thread/Locker.h"
+
+using namespace std::chrono;
 
 namespace Diag {
     const char *Trace::Information = "INFO";
@@ -34,29 +40,26 @@ namespace Diag {
     bool Trace::_enableDebug = false;
     bool Trace::_colorShown = true;
     TraceListeners Trace::_traceListeners = TraceListeners(false, 10);
+    TraceWriter *Trace::_writer = nullptr;
 
     void Trace::writeFormat(const char *format, ...) {
-        char *message = new char[MaxMessageLength];
-        memset(message, 0, MaxMessageLength);
+        char message[MaxMessageLength];
         va_list ap;
         va_start(ap, format);
-        vsprintf(message, format, ap);
+        vsnprintf(message, sizeof(message), format, ap);
         va_end(ap);
 
         writeInner(message, false);
-        delete[] message;
     }
 
     void Trace::writeFormatLine(const char *format, ...) {
-        char *message = new char[MaxMessageLength];
-        memset(message, 0, MaxMessageLength);
+        char message[MaxMessageLength];
         va_list ap;
         va_start(ap, format);
-        vsprintf(message, format, ap);
+        vsnprintf(message, sizeof(message), format, ap);
         va_end(ap);
 
         writeInner(message, true);
-        delete[] message;
     }
 
     void Trace::write(const String &message, const String &category, bool showTime) {
@@ -68,19 +71,19 @@ namespace Diag {
     }
 
     void Trace::writeInner(const char *message, bool newLine, const char *category, bool showTime) {
-        if (message == nullptr || strlen(message) == 0)
+        if (message == nullptr || message[0] == '\0')
             return;
 
-        String str;
-        if (showTime) {
-            str.append(DateTime::now().toString("yyyy-MM-dd HH:mm:ss.fff"));
-            str.append(" ");
+        const char *name = (category != nullptr && category[0] != '\0') ? category : Trace::Info;
+        char prefix[MaxPrefixLength];
+        size_t prefixLength = formatPrefix(prefix, name, showTime);
+        if (_writer != nullptr && _writer->running()) {
+            bool error = strcmp(name, Trace::Error) == 0 || strcmp(name, Trace::Fatal) == 0;
+            _writer->write(prefix, prefixLength, message, strlen(message), newLine, name, error);
+            return;
         }
 
-        String categoryStr = (category != nullptr && strlen(category) > 0) ? category : Trace::Info;
-        static const size_t MaxCategoryLen = 6;
-        size_t spaceLen = categoryStr.length() < MaxCategoryLen ? MaxCategoryLen - categoryStr.length() : 1;
-        str.append(String::format("[%s]%*s", categoryStr.c_str(), spaceLen, ""));
+        String str(prefix, prefixLength);
         str.append(message);
         if (newLine) {
             str.append(String::NewLine);
@@ -131,7 +134,11 @@ namespace Diag {
 #elif __EMSCRIPTEN__
         printf("%s", dstr);
 #else
-        if(_colorShown)
+        if(!_enableConsoleOutput)
+        {
+            // the listeners only.
+        }
+        else if(_colorShown)
         {
 #define COLOR_NONE			"\033[0m"
 #define FONT_COLOR_RED		"\033[0;31m"
@@ -178,8 +185,54 @@ namespace Diag {
         }
     }
 
+    size_t Trace::formatPrefix(char *buffer, const char *category, bool showTime) {
+        size_t length = 0;
+        if (showTime) {
+            // "yyyy-MM-dd HH:mm:ss." is formatted once a second, only the milliseconds are updated.
+            static thread_local time_t cachedSecond = -1;
+            static thread_local char cachedTime[32];
+            static thread_local size_t cachedLength = 0;
+
+            int64_t now = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+            auto second = (time_t) (now / 1000);
+            auto millisecond = (int) (now % 1000);
+            if (second != cachedSecond) {
+                struct tm tm = {};
+#if WIN32
+                localtime_s(&tm, &second);
+#else
+                localtime_r(&second, &tm);
+#endif
+                cachedLength = strftime(cachedTime, sizeof(cachedTime), "%Y-%m-%d %H:%M:%S.", &tm);
+                cachedSecond = second;
+            }
+            memcpy(buffer, cachedTime, cachedLength);
+            length = cachedLength;
+            buffer[length++] = (char) ('0' + millisecond / 100);
+            buffer[length++] = (char) ('0' + millisecond / 10 % 10);
+            buffer[length++] = (char) ('0' + millisecond % 10);
+            buffer[length++] = ' ';
+        }
+
+        static const size_t MaxCategoryLen = 6;
+        size_t categoryLength = strlen(category);
+        if (categoryLength > MaxCategoryLength) {
+            categoryLength = MaxCategoryLength;
+        }
+        buffer[length++] = '[';
+        memcpy(buffer + length, category, categoryLength);
+        length += categoryLength;
+        buffer[length++] = ']';
+        size_t spaceLen = categoryLength < MaxCategoryLen ? MaxCategoryLen - categoryLength : 1;
+        memset(buffer + length, ' ', spaceLen);
+        length += spaceLen;
+        buffer[length] = '\0';
+        return length;
+    }
+
     void Trace::addTraceListener(TraceListener *tl) {
         if (tl != nullptr) {
+            Locker locker(&_traceListeners);
             _enableLog = true;
             _traceListeners.add(tl);
         }
@@ -187,16 +240,49 @@ namespace Diag {
 
     void Trace::removeTraceListener(TraceListener *tl) {
         if (tl != nullptr) {
+            // deliver the staged messages before the listener is deleted.
+            flush();
+            Locker locker(&_traceListeners);
             _traceListeners.remove(tl, false);
             _enableLog = _traceListeners.count() > 0;
         }
     }
 
     void Trace::removeTraceListeners() {
+        flush();
+        Locker locker(&_traceListeners);
         _enableLog = false;
         _traceListeners.clear();
     }
 
+    bool Trace::enableAsync(TraceOverflow overflow, size_t bufferSize, uint32_t flushInterval) {
+        _writer = TraceWriter::instance();
+        return _writer->start(overflow, bufferSize, flushInterval);
+    }
+
+    void Trace::disableAsync() {
+        if (_writer != nullptr) {
+            _writer->stop();
+        }
+    }
+
+    bool Trace::isAsync() {
+        return _writer != nullptr && _writer->running();
+    }
+
+    void Trace::flush() {
+        if (_writer != nullptr) {
+            _writer->flush();
+        }
+    }
+
+    TraceStatistics Trace::asyncStatistics() {
+        if (_writer != nullptr) {
+            return _writer->statistics();
+        }
+        return TraceStatistics{0, 0, 0, 0};
+    }
+
     void Trace::enableConsoleOutput() {
         _enableConsoleOutput = true;
     }
@@ -271,29 +357,25 @@ namespace Diag {
 
     void Debug::writeFormat(const char *format, ...) {
 #ifdef DEBUG
-        char *message = new char[Trace::MaxMessageLength];
-        memset(message, 0, Trace::MaxMessageLength);
+        char message[Trace::MaxMessageLength];
         va_list ap;
         va_start(ap, format);
-        vsprintf(message, format, ap);
+        vsnprintf(message, sizeof(message), format, ap);
         va_end(ap);
 
         writeInner(message, false);
-        delete[] message;
 #endif
     }
 
     void Debug::writeFormatLine(const char *format, ...) {
 #ifdef DEBUG
-        char *message = new char[Trace::MaxMessageLength];
-        memset(message, 0, Trace::MaxMessageLength);
+        char message[Trace::MaxMessageLength];
         va_list ap;
         va_start(ap, format);
-        vsprintf(message, format, ap);
+        vsnprintf(message, sizeof(message), format, ap);
         va_end(ap);
 
         writeInner(message, true);
-        delete[] message;
 #endif
     }
 
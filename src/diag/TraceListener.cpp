@@ -52,6 +52,12 @@ namespace Diag {
 
     TraceListener::~TraceListener() = default;
 
+    void TraceListener::writeBatch(const TraceRecord *records, size_t count, bool flush) {
+        for (size_t i = 0; i < count; i++) {
+            write(String(records[i].text, records[i].length), records[i].category);
+        }
+    }
+
     TraceListener *TraceListener::create(const TraceListenerContext *context) {
         auto fileContext = dynamic_cast<const FileTraceListenerContext *>(context);
         if (fileContext != nullptr) {
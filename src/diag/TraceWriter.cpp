@@ -0,0 +1,387 @@
+//
+//  TraceWriter.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#ifndef WIN32
+
+#include <unistd.h>
+#include <climits>
+#include <cerrno>
+#include <sys/uio.h>
+
+#endif
+
+#include <cstring>
+#include "diag/TraceWriter.h"
+#include "diag/Trace.h"
+#include "thread/Locker.h"
+
+namespace Diag {
+    static thread_local bool writerThread = false;
+
+    TraceBuffer::TraceBuffer(size_t size) : _reservedTail(0), _cachedHead(0), _head(0), _tail(0),
+                                            _dropped(0), _blocked(0) {
+        _size = 1024;
+        while (_size < size) {
+            _size <<= 1;
+        }
+        _mask = _size - 1;
+        _data = new char[_size];
+    }
+
+    TraceBuffer::~TraceBuffer() {
+        delete[] _data;
+        _data = nullptr;
+    }
+
+    size_t TraceBuffer::align(size_t size) {
+        return (size + 7) & ~(size_t) 7;
+    }
+
+    char *TraceBuffer::reserve(const char *category, bool error, size_t length) {
+        size_t categoryLength = strlen(category);
+        size_t size = align(sizeof(Header) + categoryLength + 1 + length + 1);
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t position = tail & _mask;
+        // a record never wraps, the rest of the buffer is skipped by a padding record.
+        size_t padding = _size - position < size ? _size - position : 0;
+        if (tail + padding + size - _cachedHead > _size) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail + padding + size - _cachedHead > _size) {
+                return nullptr;
+            }
+        }
+
+        if (padding > 0) {
+            auto header = (Header *) (_data + position);
+            header->size = (uint32_t) padding;
+            header->length = Padding;
+            tail += padding;
+            position = 0;
+        }
+        auto header = (Header *) (_data + position);
+        header->size = (uint32_t) size;
+        header->length = (uint32_t) length | (error ? ErrorFlag : 0);
+        char *text = _data + position + sizeof(Header);
+        memcpy(text, category, categoryLength + 1);
+        text += categoryLength + 1;
+        text[length] = '\0';
+        _reservedTail = tail + size;
+        return text;
+    }
+
+    void TraceBuffer::commit() {
+        _tail.store(_reservedTail, std::memory_order_release);
+    }
+
+    bool TraceBuffer::isEmpty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+    size_t TraceBuffer::maxTextLength() const {
+        return _size / 4;
+    }
+
+    TraceWriter::TraceWriter() : _running(false), _overflow(TraceDrop), _bufferSize(DefaultBufferSize),
+                                 _flushInterval(DefaultFlushInterval), _thread(nullptr),
+                                 _retiredDropped(0), _retiredBlocked(0),
+                                 _drainCount(0), _wakeup(false), _stopped(true), _flushRequest(0), _flushDone(0),
+                                 _written(0), _batches(0) {
+        _records.resize(MaxBatchCount);
+    }
+
+    TraceWriter::~TraceWriter() {
+        stop();
+    }
+
+    TraceWriter *TraceWriter::instance() {
+        // never released, the staging buffers may be used by the other threads at exit.
+        static TraceWriter *writer = new TraceWriter();
+        return writer;
+    }
+
+    bool TraceWriter::start(TraceOverflow overflow, size_t bufferSize, uint32_t flushInterval) {
+#ifdef WIN32
+        return false;
+#else
+        if (_running) {
+            return false;
+        }
+
+        _overflow = overflow;
+        _bufferSize = bufferSize > 0 ? bufferSize : DefaultBufferSize;
+        _flushInterval = flushInterval > 0 ? flushInterval : DefaultFlushInterval;
+        {
+            std::lock_guard<std::mutex> lock(_signalMutex);
+            _stopped = false;
+        }
+        // the console is written by writev from now on.
+        fflush(stdout);
+        _running = true;
+        _thread = new Thread("trace.writer", &TraceWriter::writeProc, this);
+        _thread->start();
+        return true;
+#endif
+    }
+
+    void TraceWriter::stop() {
+        if (!_running.exchange(false)) {
+            return;
+        }
+
+        wakeup();
+        // the thread drains all of the buffers before it exits.
+        delete _thread;
+        _thread = nullptr;
+        _drained.notify_all();
+    }
+
+    bool TraceWriter::running() const {
+        return _running.load(std::memory_order_relaxed);
+    }
+
+    TraceBuffer *TraceWriter::currentBuffer() {
+        static thread_local std::shared_ptr<TraceBuffer> buffer;
+        if (buffer == nullptr) {
+            buffer = std::make_shared<TraceBuffer>(_bufferSize);
+            std::lock_guard<std::mutex> lock(_buffersMutex);
+            _buffers.push_back(buffer);
+        }
+        return buffer.get();
+    }
+
+    bool TraceWriter::write(const char *prefix, size_t prefixLength, const char *message, size_t length,
+                            bool newLine, const char *category, bool error) {
+        TraceBuffer *buffer = currentBuffer();
+        size_t newLineLength = newLine ? String::NewLine.length() : 0;
+        size_t maxLength = buffer->maxTextLength() - newLineLength;
+        // a long prefix is clamped too, so the subtraction below does not wrap around.
+        if (prefixLength > maxLength) {
+            prefixLength = maxLength;
+        }
+        maxLength -= prefixLength;
+        if (length > maxLength) {
+            length = maxLength;
+        }
+        size_t total = prefixLength + length + newLineLength;
+
+        char *text = buffer->reserve(category, error, total);
+        if (text == nullptr) {
+            // the writer thread can not wait for itself.
+            if (_overflow == TraceDrop || writerThread) {
+                buffer->_dropped.fetch_add(1, std::memory_order_relaxed);
+                wakeup();
+                return false;
+            }
+
+            buffer->_blocked.fetch_add(1, std::memory_order_relaxed);
+            while ((text = buffer->reserve(category, error, total)) == nullptr) {
+                if (!_running) {
+                    buffer->_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                // sleep until the writer drains a batch, it runs a batch at least once after the wakeup.
+                std::unique_lock<std::mutex> lock(_signalMutex);
+                uint64_t drainCount = _drainCount;
+                _wakeup = true;
+                _signal.notify_one();
+                _drained.wait(lock, [this, drainCount] { return _drainCount != drainCount || !_running; });
+            }
+        }
+
+        memcpy(text, prefix, prefixLength);
+        memcpy(text + prefixLength, message, length);
+        if (newLine) {
+            memcpy(text + prefixLength + length, String::NewLine.c_str(), newLineLength);
+        }
+        size_t tail = buffer->_tail.load(std::memory_order_relaxed);
+        buffer->commit();
+
+        // wake the writer for the errors and every half of the buffer.
+        size_t half = buffer->_size / 2;
+        if (error || tail / half != buffer->_reservedTail / half) {
+            wakeup();
+        }
+        return true;
+    }
+
+    void TraceWriter::flush() {
+        if (!_running) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(_signalMutex);
+        uint64_t request = ++_flushRequest;
+        _signal.notify_one();
+        _flushed.wait(lock, [this, request] { return _flushDone >= request || _stopped; });
+    }
+
+    TraceStatistics TraceWriter::statistics() const {
+        TraceStatistics statistics;
+        statistics.written = _written;
+        statistics.batches = _batches;
+
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        statistics.dropped = _retiredDropped;
+        statistics.blocked = _retiredBlocked;
+        for (size_t i = 0; i < _buffers.size(); i++) {
+            statistics.dropped += _buffers[i]->_dropped;
+            statistics.blocked += _buffers[i]->_blocked;
+        }
+        return statistics;
+    }
+
+    void TraceWriter::wakeup() {
+        {
+            std::lock_guard<std::mutex> lock(_signalMutex);
+            _wakeup = true;
+        }
+        _signal.notify_one();
+    }
+
+    void TraceWriter::writeProc() {
+        writerThread = true;
+        while (true) {
+            bool running = _running;
+            uint64_t request;
+            {
+                std::unique_lock<std::mutex> lock(_signalMutex);
+                if (running && !_wakeup && _flushRequest == _flushDone) {
+                    _signal.wait_for(lock, std::chrono::milliseconds(_flushInterval));
+                }
+                _wakeup = false;
+                request = _flushRequest;
+            }
+
+            while (writeBatch()) {
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(_signalMutex);
+                _flushDone = request;
+                _stopped = !running;
+            }
+            _flushed.notify_all();
+
+            if (!running) {
+                break;
+            }
+        }
+    }
+
+    bool TraceWriter::writeBatch() {
+        {
+            std::lock_guard<std::mutex> lock(_buffersMutex);
+            // the threads of the empty buffers are exited.
+            for (auto it = _buffers.begin(); it != _buffers.end();) {
+                if (it->use_count() == 1 && (*it)->isEmpty()) {
+                    _retiredDropped += (*it)->_dropped;
+                    _retiredBlocked += (*it)->_blocked;
+                    it = _buffers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            _snapshot = _buffers;
+        }
+
+        size_t count = 0;
+        bool error = false;
+        _heads.resize(_snapshot.size());
+        for (size_t i = 0; i < _snapshot.size(); i++) {
+            TraceBuffer *buffer = _snapshot[i].get();
+            size_t head = buffer->_head.load(std::memory_order_relaxed);
+            size_t tail = buffer->_tail.load(std::memory_order_acquire);
+            while (head != tail && count < MaxBatchCount) {
+                auto header = (const TraceBuffer::Header *) (buffer->_data + (head & buffer->_mask));
+                if (header->length != TraceBuffer::Padding) {
+                    TraceRecord &record = _records[count++];
+                    record.category = (const char *) (header + 1);
+                    record.text = record.category + strlen(record.category) + 1;
+                    record.length = header->length & ~TraceBuffer::ErrorFlag;
+                    if ((header->length & TraceBuffer::ErrorFlag) != 0) {
+                        error = true;
+                    }
+                }
+                head += header->size;
+            }
+            _heads[i] = head;
+        }
+
+        if (count > 0) {
+            deliver(_records.data(), count, error);
+            _written += count;
+            _batches++;
+        }
+        // the records are written in place, release them after the delivery.
+        for (size_t i = 0; i < _snapshot.size(); i++) {
+            _snapshot[i]->_head.store(_heads[i], std::memory_order_release);
+        }
+        _snapshot.clear();
+        {
+            std::lock_guard<std::mutex> lock(_signalMutex);
+            _drainCount++;
+        }
+        _drained.notify_all();
+        return count == MaxBatchCount;
+    }
+
+    void TraceWriter::deliver(const TraceRecord *records, size_t count, bool flush) {
+#ifndef WIN32
+        if (Trace::_enableConsoleOutput) {
+            writeFully(STDOUT_FILENO, records, count);
+        }
+#endif
+
+        if (Trace::_enableLog) {
+            Locker locker(&Trace::_traceListeners);
+            for (size_t i = 0; i < Trace::_traceListeners.count(); i++) {
+                Trace::_traceListeners[i]->writeBatch(records, count, flush);
+            }
+        }
+    }
+
+    bool TraceWriter::writeFully(int fd, const TraceRecord *records, size_t count) {
+#ifdef WIN32
+        return false;
+#else
+        static const size_t MaxVectorCount = IOV_MAX < (int) MaxBatchCount ? IOV_MAX : MaxBatchCount;
+        struct iovec vectors[MaxBatchCount];
+        size_t index = 0;
+        while (index < count) {
+            size_t vectorCount = count - index < MaxVectorCount ? count - index : MaxVectorCount;
+            for (size_t i = 0; i < vectorCount; i++) {
+                vectors[i].iov_base = (void *) records[index + i].text;
+                vectors[i].iov_len = records[index + i].length;
+            }
+            index += vectorCount;
+
+            struct iovec *vector = vectors;
+            while (vectorCount > 0) {
+                ssize_t written = ::writev(fd, vector, (int) vectorCount);
+                if (written < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                // partial write, skip the written vectors and retry the rest.
+                while (vectorCount > 0 && (size_t) written >= vector->iov_len) {
+                    written -= (ssize_t) vector->iov_len;
+                    vector++;
+                    vectorCount--;
+                }
+                if (vectorCount > 0) {
+                    vector->iov_base = (char *) vector->iov_base + written;
+                    vector->iov_len -= written;
+                }
+            }
+        }
+        return true;
+#endif
+    }
+}
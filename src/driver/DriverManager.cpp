@@ -2,6 +2,7 @@
 #include "exception/Exception.h"
 #include "diag/Trace.h"
 #include "thread/Locker.h"
+#include "system/Environment.h"
 #include "driver/devices/DeviceDescription.h"
 #include "driver/channels/ChannelDescription.h"
 #include "driver/devices/Sampler.h"
@@ -15,6 +16,8 @@ namespace Drivers {
         _devices = new Devices();
         _channels = new Channels();
         _pools = new InstructionPools();
+        _registry = new Registry();
+        _poolRegistry = new PoolRegistry();
 
         _opened = false;
     }
@@ -30,6 +33,12 @@ namespace Drivers {
         _channels = nullptr;
         delete _pools;
         _pools = nullptr;
+
+        clearRegistries();
+        delete _registry.load();
+        _registry = nullptr;
+        delete _poolRegistry.load();
+        _poolRegistry = nullptr;
     }
 
     DriverDescription *DriverManager::description() const {
@@ -147,6 +156,10 @@ namespace Drivers {
         for (size_t i = 0; i < _pools->count(); i++) {
             _pools->at(i)->stop();
         }
+        {
+            std::lock_guard<std::mutex> registryLocker(_registryMutex);
+            publish(new PoolRegistry());
+        }
         _pools->clear();
 
         DeviceDescriptions *dds = _description->getDevices();
@@ -159,8 +172,11 @@ namespace Drivers {
                 channel->close();
             }
         }
+        std::lock_guard<std::mutex> registryLocker(_registryMutex);
+        publish(new Registry());
         _devices->clear();
         _channels->clear();
+        clearRegistries();
     }
 
     bool DriverManager::hasDevice(const String &deviceName) {
@@ -182,35 +198,24 @@ namespace Drivers {
     }
 
     Device *DriverManager::getDevice(const String &deviceName) const {
-        for (size_t i = 0; i < _devices->count(); i++) {
-            Device *device = _devices->at(i);
-            if (device != nullptr &&
-                device->description()->name() == deviceName) {
-                return device;
-            }
-        }
-        return nullptr;
+        const Registry *registry = _registry.load(std::memory_order_acquire);
+        Device *device = nullptr;
+        registry->devices.at(deviceName, device);
+        return device;
     }
 
     Device *DriverManager::getDevice(const Channel *channel) const {
-        for (size_t i = 0; i < _devices->count(); i++) {
-            Device *device = _devices->at(i);
-            if (device != nullptr &&
-                device->getChannel() == channel) {
-                return device;
-            }
-        }
-        return nullptr;
+        const Registry *registry = _registry.load(std::memory_order_acquire);
+        const std::vector<Device *> &devices = registry->channelDevices.at(channel);
+        return !devices.empty() ? devices.front() : nullptr;
     }
 
     void DriverManager::getDevices(const Channel *channel, Devices &devices) const {
         devices.setAutoDelete(false);
-        for (size_t i = 0; i < _devices->count(); i++) {
-            Device *device = _devices->at(i);
-            if (device != nullptr &&
-                device->getChannel() == channel) {
-                devices.add(device);
-            }
+        const Registry *registry = _registry.load(std::memory_order_acquire);
+        const std::vector<Device *> &items = registry->channelDevices.at(channel);
+        for (Device *device: items) {
+            devices.add(device);
         }
     }
 
@@ -223,24 +228,15 @@ namespace Drivers {
     }
 
     bool DriverManager::hasChannel(ChannelDescription *cd) {
-        for (size_t i = 0; i < _channels->count(); i++) {
-            const Channel *channel = _channels->at(i);
-            if (channel != nullptr &&
-                channel->description() == cd) {
-                return true;
-            }
-        }
-        return false;
+        const Registry *registry = _registry.load(std::memory_order_acquire);
+        return registry->channelDescriptions.contains(cd);
     }
 
     Channel *DriverManager::getChannel(const String &channelName) const {
-        for (size_t i = 0; i < _channels->count(); i++) {
-            Channel *channel = _channels->at(i);
-            if (channel->description()->name() == channelName) {
-                return channel;
-            }
-        }
-        return nullptr;
+        const Registry *registry = _registry.load(std::memory_order_acquire);
+        Channel *channel = nullptr;
+        registry->channels.at(channelName, channel);
+        return channel;
     }
 
     Channel *DriverManager::getChannel(ChannelDescription *cd) const {
@@ -249,40 +245,72 @@ namespace Drivers {
 
     void DriverManager::addPool(const InstructionPool *ip) {
         if (ip != nullptr) {
+            std::lock_guard<std::mutex> locker(_registryMutex);
             _pools->add(ip);
+
+            auto registry = new PoolRegistry(*_poolRegistry.load(std::memory_order_relaxed));
+            addPool(registry, (InstructionPool *) ip);
+            publish(registry);
         }
     }
 
-    InstructionPool *DriverManager::getPool(const String &deviceName) const {
-        for (size_t i = 0; i < _pools->count(); i++) {
-            InstructionPool *ip = _pools->at(i);
-            if (ip->containsDevice(deviceName)) {
-                return ip;
+    void DriverManager::addPools(const InstructionPools &ips) {
+        if (ips.count() == 0) {
+            return;
+        }
+
+        // all the new pools are published at once.
+        std::lock_guard<std::mutex> locker(_registryMutex);
+        auto registry = new PoolRegistry(*_poolRegistry.load(std::memory_order_relaxed));
+        for (size_t i = 0; i < ips.count(); i++) {
+            InstructionPool *ip = ips.at(i);
+            if (ip != nullptr) {
+                _pools->add(ip);
+                addPool(registry, ip);
             }
         }
-        return nullptr;
+        publish(registry);
     }
 
-    InstructionPool *DriverManager::getPoolByChannelName(const String &channelName) const {
-        for (size_t i = 0; i < _pools->count(); i++) {
-            InstructionPool *ip = _pools->at(i);
-            if (ip->channelName() == channelName) {
-                return ip;
-            }
+    void DriverManager::addPool(PoolRegistry *registry, InstructionPool *ip) {
+        registry->pools.push_back(ip);
+        if (!registry->devices.contains(ip->deviceName())) {
+            registry->devices.add(ip->deviceName(), ip);
+        }
+        if (!registry->channels.contains(ip->channelName())) {
+            registry->channels.add(ip->channelName(), ip);
         }
-        return nullptr;
     }
 
-    InstructionPool *DriverManager::getPoolByDeviceName(const String &deviceName) const {
-        for (size_t i = 0; i < _pools->count(); i++) {
-            InstructionPool *ip = _pools->at(i);
-            if (ip->deviceName() == deviceName) {
-                return ip;
+    InstructionPool *DriverManager::getPool(const String &deviceName) const {
+        const PoolRegistry *registry = _poolRegistry.load(std::memory_order_acquire);
+        InstructionPool *ip = nullptr;
+        if (registry->devices.at(deviceName, ip)) {
+            return ip;
+        }
+        // a pool may contain the other devices, e.g. a sampler of many devices.
+        for (InstructionPool *pool: registry->pools) {
+            if (pool->containsDevice(deviceName)) {
+                return pool;
             }
         }
         return nullptr;
     }
 
+    InstructionPool *DriverManager::getPoolByChannelName(const String &channelName) const {
+        const PoolRegistry *registry = _poolRegistry.load(std::memory_order_acquire);
+        InstructionPool *ip = nullptr;
+        registry->channels.at(channelName, ip);
+        return ip;
+    }
+
+    InstructionPool *DriverManager::getPoolByDeviceName(const String &deviceName) const {
+        const PoolRegistry *registry = _poolRegistry.load(std::memory_order_acquire);
+        InstructionPool *ip = nullptr;
+        registry->devices.at(deviceName, ip);
+        return ip;
+    }
+
     void DriverManager::getPoolsWithoutDevice(const StringArray &deviceNames, InstructionPools &ips) const {
         ips.setAutoDelete(false);
         for (size_t i = 0; i < _pools->count(); i++) {
@@ -323,22 +351,67 @@ namespace Drivers {
             return;
         }
 
+        // all the new devices are published at once.
+        std::lock_guard<std::mutex> locker(_registryMutex);
+        auto registry = new Registry(*_registry.load(std::memory_order_relaxed));
         for (size_t i = 0; i < dds->count(); i++) {
             DeviceDescription *dd = dds->at(i);
-            if (!containsDevice(dd)) {
+            if (!registry->devices.contains(dd->name())) {
                 ChannelDescription *cd = dd->getChannel();
-                Channel *channel = getChannel(cd);
-                if (channel == nullptr) {
+                Channel *channel = nullptr;
+                if (!registry->channels.at(cd->name(), channel)) {
                     channel = new Channel(this, cd);
                     channel->openedDelegates()->add(Delegate(this, channelOpened));
                     channel->closedDelegates()->add(Delegate(this, channelClosed));
                     _channels->add(channel);
+                    registry->channels.add(cd->name(), channel);
+                    registry->channelDescriptions.add(cd, channel);
                 }
 
                 auto device = new Device(dd, channel);
                 _devices->add(device);
+                registry->devices.add(dd->name(), device);
+                registry->channelDevices[channel].push_back(device);
             }
         }
+        publish(registry);
+    }
+
+    template<class T>
+    void DriverManager::retire(std::vector<Retired<T>> &retired, const T *registry) {
+        uint64_t tick = Environment::getTickCount();
+        size_t expired = 0;
+        while (expired < retired.size() && tick - retired[expired].tick >= RetiredTimeout) {
+            delete retired[expired].registry;
+            expired++;
+        }
+        retired.erase(retired.begin(), retired.begin() + (ptrdiff_t) expired);
+        retired.push_back({registry, tick});
+    }
+
+    void DriverManager::publish(Registry *registry) {
+        const Registry *old = _registry.exchange(registry, std::memory_order_acq_rel);
+        if (old != nullptr) {
+            retire(_retiredRegistries, old);
+        }
+    }
+
+    void DriverManager::publish(PoolRegistry *registry) {
+        const PoolRegistry *old = _poolRegistry.exchange(registry, std::memory_order_acq_rel);
+        if (old != nullptr) {
+            retire(_retiredPoolRegistries, old);
+        }
+    }
+
+    void DriverManager::clearRegistries() {
+        for (const Retired<Registry> &retired: _retiredRegistries) {
+            delete retired.registry;
+        }
+        _retiredRegistries.clear();
+        for (const Retired<PoolRegistry> &retired: _retiredPoolRegistries) {
+            delete retired.registry;
+        }
+        _retiredPoolRegistries.clear();
     }
 
     InstructionContext *DriverManager::executeInstruction(const String &deviceName, InstructionDescription *id) {
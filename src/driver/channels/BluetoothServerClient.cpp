@@ -104,7 +104,7 @@ namespace Drivers {
         Stopwatch sw("BluetoothServerClient_receiveProc", 1000);
 #endif
 
-        if (connected() && available() > 0) {
+        if (connected() && (available() > 0 || hasBuffered(_device))) {
             receiveFromBuffer(_device);
         }
     }
@@ -100,8 +100,12 @@ namespace Drivers {
     }
 
     size_t Channel::available() {
-        Interactive *i = interactive();
-        return i != nullptr ? i->available() : 0;
+        // the bytes read ahead past the last frame are counted.
+        return bufferedCount() + availableInner();
+    }
+
+    bool Channel::waitAvailable(uint32_t timeout) {
+        return bufferedCount() > 0 || waitAvailableInner(timeout);
     }
 
     ssize_t Channel::send(const uint8_t *buffer, off_t offset, size_t count) {
@@ -110,8 +114,12 @@ namespace Drivers {
     }
 
     ssize_t Channel::receive(uint8_t *buffer, off_t offset, size_t count) {
-        Interactive *i = interactive();
-        return i != nullptr ? i->receive(buffer, offset, count) : 0;
+        // the bytes read ahead are returned at first.
+        size_t length = receiveFromBuffer(buffer + offset, count);
+        if (length > 0) {
+            return (ssize_t) length;
+        }
+        return receiveInner(buffer, offset, count);
     }
 
     ssize_t Channel::receive(uint8_t *buffer, off_t offset, size_t count, uint32_t timeout) {
@@ -124,6 +132,21 @@ namespace Drivers {
         return i != nullptr ? i->receive(buffer, count, timeout) : 0;
     }
 
+    size_t Channel::availableInner() {
+        Interactive *i = interactive();
+        return i != nullptr ? i->available() : 0;
+    }
+
+    ssize_t Channel::receiveInner(uint8_t *buffer, off_t offset, size_t count) {
+        Interactive *i = interactive();
+        return i != nullptr ? i->receive(buffer, offset, count) : 0;
+    }
+
+    bool Channel::waitAvailableInner(uint32_t timeout) {
+        Interactive *i = interactive();
+        return i != nullptr && i->waitAvailable(timeout);
+    }
+
     bool Channel::open() {
         _opening = true;
         bool result = false;
@@ -1,6 +1,8 @@
 #include "data/ByteArray.h"
 #include "driver/channels/Interactive.h"
+#include "driver/channels/Channel.h"
 #include "driver/devices/Device.h"
+#include "thread/TickTimeout.h"
 
 namespace Drivers {
     Interactive::Interactive(DriverManager *dm, Channel *channel) {
@@ -20,6 +22,17 @@ namespace Drivers {
         return false;
     }
 
+    bool Interactive::waitAvailable(uint32_t timeout) {
+        // no readiness notification in general.
+        return Receiver::pollAvailable(timeout, hasAvailable, this);
+    }
+
+    bool Interactive::hasAvailable(void *parameter) {
+        auto interactive = static_cast<Interactive *>(parameter);
+        assert(interactive);
+        return interactive->available() > 0;
+    }
+
     ssize_t Interactive::receive(uint8_t *buffer, off_t offset, size_t count, uint32_t timeout) {
         if (timeout == 0) {
             return receive(buffer, offset, count);
@@ -69,4 +82,9 @@ namespace Drivers {
         // receive & match & execute
         return device->executeInstruction();
     }
+
+    bool BackgroundReceiver::hasBuffered(const Device *device) {
+        Channel *channel = device != nullptr ? device->getChannel() : nullptr;
+        return channel != nullptr && channel->bufferedCount() > 0;
+    }
 }
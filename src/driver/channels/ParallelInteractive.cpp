@@ -49,6 +49,10 @@ namespace Drivers {
         return _port->available();
     }
 
+    bool ParallelInteractive::waitAvailable(uint32_t timeout) {
+        return _port->waitAvailable(timeout);
+    }
+
     ssize_t ParallelInteractive::send(const uint8_t *buffer, off_t offset, size_t count) {
 #ifdef DEBUG
         Stopwatch sw("parallel send", 1000);
@@ -63,6 +63,10 @@ namespace Drivers {
         return _port->available();
     }
 
+    bool SerialInteractive::waitAvailable(uint32_t timeout) {
+        return _port->waitAvailable(timeout);
+    }
+
     ssize_t SerialInteractive::send(const uint8_t *buffer, off_t offset, size_t count) {
 #ifdef DEBUG
         Stopwatch sw("serial send", 1000);
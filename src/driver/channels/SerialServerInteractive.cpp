@@ -75,6 +75,10 @@ namespace Drivers {
         return connected() ? _port->available() : 0;
     }
 
+    bool SerialServerInteractive::waitAvailable(uint32_t timeout) {
+        return connected() && _port->waitAvailable(timeout);
+    }
+
     ssize_t SerialServerInteractive::send(const uint8_t *buffer, off_t offset, size_t count) {
 #ifdef DEBUG
         Stopwatch sw("serial send", 1000);
@@ -118,7 +122,7 @@ namespace Drivers {
             _device = dm->getDevice(_channel);
         }
 
-        if (connected() && available() > 0) {
+        if (connected() && (available() > 0 || hasBuffered(_device))) {
             receiveFromBuffer(_device);
         }
     }
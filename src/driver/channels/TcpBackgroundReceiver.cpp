@@ -168,7 +168,7 @@ namespace Drivers {
 //        Stopwatch sw(1000);
 //#endif
         try {
-            if (connected() && available() > 0) {
+            if (connected() && (available() > 0 || hasBuffered(_device))) {
                 receiveFromBuffer(_device);
             }
         }
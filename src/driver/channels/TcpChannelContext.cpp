@@ -128,6 +128,10 @@ namespace Drivers {
         return _receiverType == Types::Multiplexing;
     }
 
+    bool TcpChannelContext::reactorReceiver() const {
+        return _receiverType == Types::Reactor;
+    }
+
     void TcpChannelContext::setReceiverType(Types type) {
         _receiverType = type;
     }
@@ -163,6 +167,8 @@ namespace Drivers {
             return Sync;
         else if (String::equals(str, "multiplexing", true))
             return Multiplexing;
+        else if (String::equals(str, "reactor", true))
+            return Reactor;
         else
             return Multiplexing;
     }
@@ -175,6 +181,8 @@ namespace Drivers {
                 return "sync";
             case Multiplexing:
                 return "multiplexing";
+            case Reactor:
+                return "reactor";
             default:
                 return "multiplexing";
         }
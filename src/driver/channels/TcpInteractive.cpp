@@ -563,6 +563,10 @@ namespace Drivers {
         return _tcpClient != nullptr ? _tcpClient->available() : 0;
     }
 
+    bool TcpInteractive::waitAvailable(uint32_t timeout) {
+        return _tcpClient != nullptr && _tcpClient->waitAvailable(timeout);
+    }
+
     TcpClientChannelContext *TcpInteractive::getChannelContext() const {
         if (_channel == nullptr || _channel->description() == nullptr)
             return nullptr;
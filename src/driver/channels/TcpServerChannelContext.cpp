@@ -7,7 +7,7 @@ namespace Drivers
     TcpServerChannelContext::TcpServerChannelContext() : TcpServerChannelContext(Endpoint::Empty)
     {
     }
-    TcpServerChannelContext::TcpServerChannelContext(const Endpoint& endpoint, int maxConnections) : TcpChannelContext(endpoint), _maxConnections(maxConnections), _closeTimeout(0, 1, 0)
+    TcpServerChannelContext::TcpServerChannelContext(const Endpoint& endpoint, int maxConnections) : TcpChannelContext(endpoint), _maxConnections(maxConnections), _closeTimeout(0, 1, 0), _eventLoopCount(0)
     {
     }
     TcpServerChannelContext::~TcpServerChannelContext()
@@ -36,6 +36,15 @@ namespace Drivers
         _closeTimeout = TimeSpan::fromMilliseconds((double)milliSeconds);
     }
 
+    int TcpServerChannelContext::eventLoopCount() const
+    {
+        return _eventLoopCount;
+    }
+    void TcpServerChannelContext::setEventLoopCount(int count)
+    {
+        _eventLoopCount = count >= 0 ? count : 0;
+    }
+
     void TcpServerChannelContext::copyFrom(const TcpChannelContext* context)
     {
         TcpChannelContext::copyFrom(context);
@@ -43,6 +52,7 @@ namespace Drivers
         const TcpServerChannelContext* tc = (const TcpServerChannelContext*)context;
         _maxConnections = tc->_maxConnections;
         _closeTimeout = tc->_closeTimeout;
+        _eventLoopCount = tc->_eventLoopCount;
     }
 
     TcpSSLServerChannelContext::TcpSSLServerChannelContext() : TcpSSLServerChannelContext(Endpoint::Empty)
@@ -75,6 +75,9 @@ namespace Drivers {
         } else if (tcc->multiplexingReceiver()) {
             Trace::info("Start a tcp server receiver(multiplexing).");
             _receiver = new TcpServerSyncReceiver(dm, channel, client);
+        } else if (tcc->reactorReceiver()) {
+            Trace::info("Start a tcp server receiver(reactor).");
+            _receiver = new TcpServerSyncReceiver(dm, channel, client);
         }
 
         if (tcc->asyncSender()) {
@@ -478,7 +481,9 @@ namespace Drivers {
                 } else if (tcc->syncReceiver()) {
                     Trace::info("Start a tcp server receiver(sync).");
                     _acceptTimer = new Timer("acceptProc", 1, &TcpServerInteractive::acceptProc, this);
-                } else if (tcc->multiplexingReceiver()) {
+                } else if (tcc->multiplexingReceiver() ||
+                           (tcc->reactorReceiver() && !startEventLoops(tcc))) {
+                    // the reactor falls back to multiplexing if the event loops can not be started.
                     Trace::info("Start a tcp server receiver(multiplexing).");
                     _multiplexingThread = new Thread("server.multiplexingProc",
                                                      &TcpServerInteractive::multiplexingProc, this);
@@ -486,7 +491,10 @@ namespace Drivers {
                 }
 #endif
 
-                _closeTimer = new Timer("server.closeProc", 1000, &TcpServerInteractive::closeProc, this);
+                // the event loops close their own unused clients.
+                if (_eventLoops.count() == 0) {
+                    _closeTimer = new Timer("server.closeProc", 1000, &TcpServerInteractive::closeProc, this);
+                }
 
                 message = String::convert("listen a socket, address = %s, port = %d, max connections: %d",
                                           !tcc->address().isNullOrEmpty() ? tcc->address().c_str() : "any",
@@ -549,6 +557,8 @@ namespace Drivers {
             _multiplexingThread = nullptr;
         }
 
+        stopEventLoops();
+
         if (_closeTimer != nullptr) {
             delete _closeTimer;
             _closeTimer = nullptr;
@@ -920,7 +930,264 @@ namespace Drivers {
         return _fd != -1;
     }
 
-    void TcpServerInteractive::openClient(TcpClient *tc) {
+    bool TcpServerInteractive::startEventLoops(const TcpServerChannelContext *tcc) {
+#ifdef HAS_EPOLL
+        int count = tcc->eventLoopCount();
+        if (count <= 0)
+            count = (int) Thread::concurrency();
+        if (count <= 0)
+            count = 1;
+
+        for (int i = 0; i < count; i++) {
+            auto loop = new EventLoop(this, i);
+            if (!loop->start()) {
+                delete loop;
+                break;
+            }
+            _eventLoops.add(loop);
+        }
+        if (_eventLoops.count() == 0) {
+            return false;
+        }
+
+        int maxConnections = tcc->maxConnections();
+        int loopCount = (int) _eventLoops.count();
+        Trace::info(String::convert(
+                "Start a tcp server receiver(reactor), event loops: %d, max connections: %d, connections per loop: %d",
+                loopCount, maxConnections, (maxConnections + loopCount - 1) / loopCount));
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void TcpServerInteractive::stopEventLoops() {
+        for (size_t i = 0; i < _eventLoops.count(); i++) {
+            _eventLoops[i]->stop();
+        }
+        _eventLoops.clear();
+    }
+
+    TcpServerInteractive::EventLoop::EventLoop(TcpServerInteractive *owner, int index) : _owner(owner), _index(index),
+                                                                                        _fd(-1), _listenFd(-1),
+                                                                                        _exitSockets{-1, -1},
+                                                                                        _thread(nullptr), _loop(false),
+                                                                                        _buffer(nullptr),
+                                                                                        _bufferLength(0) {
+    }
+
+    TcpServerInteractive::EventLoop::~EventLoop() {
+        stop();
+    }
+
+    size_t TcpServerInteractive::EventLoop::clientCount() const {
+        return _clients.count();
+    }
+
+#ifdef HAS_EPOLL
+
+    bool TcpServerInteractive::EventLoop::start() {
+        TcpServer *server = _owner->_tcpServer;
+        if (server == nullptr || !server->isListening()) {
+            return false;
+        }
+
+        _fd = epoll_create1(EPOLL_CLOEXEC);
+        if (_fd == -1) {
+            Debug::writeFormatLine("epoll_create failed: %d", errno);
+            return false;
+        }
+
+        // for listen socket, every loop accepts into its own epoll set.
+        _listenFd = server->socketId();
+        struct epoll_event ev{};
+        memset(&ev.data, 0, sizeof(ev.data));
+        ev.events = EPOLLIN;
+#ifdef EPOLLEXCLUSIVE
+        ev.events |= EPOLLEXCLUSIVE;
+#endif
+        ev.data.fd = _listenFd;
+        if (epoll_ctl(_fd, EPOLL_CTL_ADD, _listenFd, &ev) == -1) {
+            Debug::writeFormatLine("epoll_ctl failed: %d", errno);
+            stop();
+            return false;
+        }
+
+        // for exit
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, _exitSockets) == -1) {
+            Debug::writeFormatLine("socketpair failed: %d", errno);
+            stop();
+            return false;
+        }
+        ev.events = EPOLLIN;
+        ev.data.fd = _exitSockets[1];
+        epoll_ctl(_fd, EPOLL_CTL_ADD, _exitSockets[1], &ev);
+
+        int receiveBufferSize = _owner->getChannelContext()->receiveBufferSize();
+        _bufferLength = receiveBufferSize > 0 ? receiveBufferSize : 65535;
+        _buffer = new uint8_t[_bufferLength];
+
+        _loop = true;
+        _thread = new Thread(String::convert("server.eventLoop%d", _index),
+                             &TcpServerInteractive::EventLoop::loopProc, this);
+        _thread->start();
+        return true;
+    }
+
+    void TcpServerInteractive::EventLoop::stop() {
+        _loop = false;
+        if (_exitSockets[0] != -1) {
+            uint8_t dummy[1] = {0};
+            ::write(_exitSockets[0], dummy, sizeof(dummy));
+        }
+        if (_thread != nullptr) {
+            delete _thread;
+            _thread = nullptr;
+        }
+
+        // the clients are released by the owner.
+        _clients.clear();
+
+        if (_exitSockets[0] != -1) {
+            ::close(_exitSockets[0]);
+            ::close(_exitSockets[1]);
+            _exitSockets[0] = _exitSockets[1] = -1;
+        }
+        if (_fd != -1) {
+            ::close(_fd);
+            _fd = -1;
+        }
+        delete[] _buffer;
+        _buffer = nullptr;
+    }
+
+    void TcpServerInteractive::EventLoop::loopProc() {
+        static const int MaxEventCount = 256;
+        static const int CloseInterval = 1000;  // 1s, same as closeProc.
+
+        struct epoll_event eventList[MaxEventCount];
+        uint32_t closeTick = TickTimeout::getCurrentTickCount();
+        while (_loop) {
+            int ret = ::epoll_wait(_fd, eventList, MaxEventCount, CloseInterval);
+            for (int i = 0; i < ret && _loop; i++) {
+                const struct epoll_event &event = eventList[i];
+                int sockId = event.data.fd;
+                if (sockId == _listenFd) {
+                    acceptClients();
+                } else if (sockId == _exitSockets[1]) {
+                    _loop = false;
+                } else {
+                    processClient(sockId, event.events);
+                }
+            }
+
+            if (_loop && TickTimeout::isTimeout(closeTick, TimeSpan::fromMilliseconds(CloseInterval))) {
+                closeUnusedClients();
+                closeTick = TickTimeout::getCurrentTickCount();
+            }
+        }
+    }
+
+    void TcpServerInteractive::EventLoop::acceptClients() {
+        TcpServer *server = _owner->_tcpServer;
+        int maxConnections = _owner->getChannelContext()->maxConnections();
+        TcpClient *tc;
+        while (_loop && server != nullptr && (tc = server->accept()) != nullptr) {
+            // the clients of all loops are counted, the accept delegates are invoked one by one.
+            Locker locker(&_owner->_tcpServerMutex);
+            if (maxConnections > 0 && _owner->clientCount() >= (size_t) maxConnections) {
+                Trace::writeLine(String::convert("Reject a client, max connections: %d, peer endpoint: %s",
+                                                 maxConnections, tc->peerEndpoint().toString().c_str()),
+                                 Trace::Warning);
+                delete tc;
+                continue;
+            }
+
+            Client *client = _owner->openClient(tc);
+            int sockId = client->socketId();
+
+            struct epoll_event ev{};
+            memset(&ev.data, 0, sizeof(ev.data));
+            ev.events = EPOLLIN | EPOLLRDHUP;
+            ev.data.fd = sockId;
+            if (epoll_ctl(_fd, EPOLL_CTL_ADD, sockId, &ev) == -1) {
+                Debug::writeFormatLine("epoll_ctl failed: %d", errno);
+                _owner->closeClient(client);
+            } else {
+                _clients.add(sockId, client);
+            }
+        }
+    }
+
+    void TcpServerInteractive::EventLoop::processClient(int socketId, uint32_t events) {
+        Client *client = nullptr;
+        if (!_clients.at(socketId, client)) {
+            return;
+        }
+
+        // level-triggered, read once per event unless the peer is going away.
+        bool hangup = (events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+        if (events & EPOLLIN) {
+            ssize_t length;
+            do {
+                length = client->tcpClient()->receive(_buffer, 0, _bufferLength);
+                if (length > 0) {
+                    client->processReceivedBuffer(ByteArray(_buffer, length));
+                }
+            } while (hangup && length > 0);
+        }
+
+        if (hangup) {
+            closeClient(client);
+        }
+    }
+
+    void TcpServerInteractive::EventLoop::closeClient(Client *client) {
+        int sockId = client->socketId();
+        epoll_ctl(_fd, EPOLL_CTL_DEL, sockId, nullptr);
+        _clients.remove(sockId);
+        Locker locker(&_owner->_tcpServerMutex);
+        _owner->closeClient(client);
+    }
+
+    void TcpServerInteractive::EventLoop::closeUnusedClients() {
+        List<Client *> clients;
+        _clients.values(clients);
+        for (size_t i = 0; i < clients.count(); i++) {
+            Client *client = clients[i];
+            if (!client->connected() || client->closeFlag()) {
+                closeClient(client);
+            }
+        }
+    }
+
+#else
+
+    bool TcpServerInteractive::EventLoop::start() {
+        return false;
+    }
+
+    void TcpServerInteractive::EventLoop::stop() {
+    }
+
+    void TcpServerInteractive::EventLoop::loopProc() {
+    }
+
+    void TcpServerInteractive::EventLoop::acceptClients() {
+    }
+
+    void TcpServerInteractive::EventLoop::processClient(int, uint32_t) {
+    }
+
+    void TcpServerInteractive::EventLoop::closeClient(Client *) {
+    }
+
+    void TcpServerInteractive::EventLoop::closeUnusedClients() {
+    }
+
+#endif
+
+    TcpServerInteractive::Client *TcpServerInteractive::openClient(TcpClient *tc) {
 #ifdef DEBUG
         Stopwatch sw("TcpServerInteractive::openClient", 200);
 #endif
@@ -936,11 +1203,7 @@ namespace Drivers {
         }
         tc->setBlocking(false);
 
-#ifdef DEBUG
         Client *client = _clients.add(manager(), _channel, tc);
-#else
-        _clients.add(manager(), _channel, tc);
-#endif
 
         TcpClientEventArgs e(tc->peerEndpoint());
         _acceptAction.invoke(this, &e);
@@ -970,6 +1233,7 @@ namespace Drivers {
         Trace::writeLine(String::convert("client connected, endpoint: %s, peer endpoint: %s, socketId: %d",
                                          tc->endpoint().toString().c_str(), tc->peerEndpoint().toString().c_str(),
                                          tc->socketId()), Trace::Info);
+        return client;
     }
 
     void TcpServerInteractive::closeClient(Client *client) {
@@ -7,30 +7,56 @@
 //
 
 #include "http/HttpClient.h"
+#include "http/HttpEngine.h"
 #include "diag/Trace.h"
 #include "data/StringArray.h"
 #include "IO/FileStream.h"
-#include "system/PoolService.h"
 #include "curl/curl.h"
 
 using namespace Diag;
 
 namespace Http {
-    class HttpRequestEntry : public IPoolEntry {
+    // The async request, the request and the response live until it is completed.
+    class HttpClientTransfer : public HttpTransfer {
     public:
         HttpRequest request;
+        HttpResponse response;
+        String url;
+        void *headerList;
+        HttpCompletion completion;
         HttpSendCallback callback;
+        void *state;
 
-        HttpRequestEntry(const HttpRequest &request, HttpSendCallback callback) : request(request), callback(callback) {
+        HttpClientTransfer(void *handle, const HttpRequest &request, HttpContent *responseContent) :
+                HttpTransfer(handle), request(request), response(responseContent), headerList(nullptr),
+                completion(nullptr), callback(nullptr), state(nullptr) {
+        }
+
+        ~HttpClientTransfer() override {
+            if (headerList != nullptr) {
+                curl_slist_free_all((curl_slist *) headerList);
+            }
+        }
+
+        void complete(int code) override {
+            bool result = HttpClient::complete(handle(), code, response, url);
+            if (completion != nullptr) {
+                completion(result, response, state);
+            }
+            if (callback != nullptr) {
+                callback(response);
+            }
         }
     };
 
-    HttpClient::HttpClient() {
+    HttpClient::HttpClient() : _maxHostConnections(HttpEngine::DefaultMaxHostConnections) {
         connectionTimeout = TimeSpan::fromSeconds(30);
         receiveTimeout = TimeSpan::fromSeconds(30);
 
         /* In windows, this will init the winsock stuff */
         curl_global_init(CURL_GLOBAL_ALL);
+
+        _engine = new HttpEngine(_maxHostConnections);
     }
 
     HttpClient::HttpClient(std::initializer_list<KeyValuePair<String, String>> list) : HttpClient() {
@@ -39,11 +65,19 @@ namespace Http {
                 TimeSpan::parse(item.value, connectionTimeout);
             } else if (String::equals(item.key, "receiveTimeout")) {
                 TimeSpan::parse(item.value, receiveTimeout);
+            } else if (String::equals(item.key, "maxHostConnections")) {
+                uint32_t value;
+                if (UInt32::parse(item.value, value) && value > 0) {
+                    setMaxHostConnections(value);
+                }
             }
         }
     }
 
     HttpClient::~HttpClient() {
+        delete _engine;
+        _engine = nullptr;
+
         curl_global_cleanup();
     }
 
@@ -97,9 +131,6 @@ namespace Http {
 
     void HttpClient::postAsync(const Url &url, const HttpHeaders &headers, const String &request,
                                HttpSendCallback callback) {
-        if (!isStarted()) {
-            start();
-        }
         HttpRequest httpRequest(url, HttpMethod::Post, headers, new HttpStringContent(request));
         sendAsync(httpRequest, callback);
     }
@@ -122,9 +153,6 @@ namespace Http {
 
     void
     HttpClient::putAsync(const Url &url, const HttpHeaders &headers, const String &request, HttpSendCallback callback) {
-        if (!isStarted()) {
-            start();
-        }
         HttpRequest httpRequest(url, HttpMethod::Put, headers, new HttpStringContent(request));
         sendAsync(httpRequest, callback);
     }
@@ -147,9 +175,6 @@ namespace Http {
 
     void
     HttpClient::delAsync(const Url &url, const HttpHeaders &headers, HttpSendCallback callback) {
-        if (!isStarted()) {
-            start();
-        }
         HttpRequest httpRequest(url, HttpMethod::Delete, headers, new HttpStringContent());
         sendAsync(httpRequest, callback);
     }
@@ -179,104 +204,159 @@ namespace Http {
         if (request.url.isEmpty())
             return false;
 
-        Url url = request.url;
-        if (request.properties.count() > 0) {
-            url = Url(url, String::format("?%s", request.properties.toString().c_str()));
+        String url = requestUrl(request);
+        void *curl = _engine->acquire();
+        if (curl == nullptr) {
+            return false;
         }
 
-        CURLcode res = CURL_LAST;
-        CURL *curl = curl_easy_init();
-        if (curl) {
-            curl_easy_setopt(curl, CURLOPT_URL, url.toString().c_str());
-            if (!request.userAgent.isNullOrEmpty())
-                curl_easy_setopt(curl, CURLOPT_USERAGENT, request.userAgent.c_str());
-            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, (int) connectionTimeout.totalSeconds());
-            curl_easy_setopt(curl, CURLOPT_TIMEOUT, (int) receiveTimeout.totalSeconds());
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
-            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, false);
-//            curl_easy_setopt(curl, CURLOPT_SSLVERSION, 1);
-            curl_easy_setopt(curl, CURLOPT_VERBOSE, request.verb);
-            curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
-            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
+        void *headerList = setOptions(curl, request, response, url);
+        CURLcode res = curl_easy_perform(curl);
+        bool result = complete(curl, res, response, url);
 
-            // request method.
-            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.method.c_str());
+        if (headerList != nullptr)
+            curl_slist_free_all((curl_slist *) headerList); /* free the header list */
 
-            // request headers.
-            struct curl_slist *headerList = nullptr;
-            if (request.headers.count() > 0) {
-                for (size_t i = 0; i < request.headers.count(); i++) {
-                    const HttpHeader &header = request.headers[i];
-                    headerList = curl_slist_append(headerList, header.toString().c_str());
-                }
-                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
-            }
+        // the handle is reused with its connection.
+        _engine->release(curl);
 
-            // request data.
-            curl_easy_setopt(curl, CURLOPT_READFUNCTION, read_data);
-            curl_easy_setopt(curl, CURLOPT_READDATA, &request);
-            curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, request.contentSize());
-            if (request.method == HttpMethod::Post) {
-                curl_easy_setopt(curl, CURLOPT_UPLOAD, true);
-            } else if (request.method == HttpMethod::Get) {
-                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
-            } else if (request.method == HttpMethod::Put) {
-                curl_easy_setopt(curl, CURLOPT_PUT, true);
-            } else if (request.method == HttpMethod::Delete) {
-                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-            } else {
-                curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.method.c_str());
-            }
+        return result;
+    }
 
-            // response headers.
-            curl_easy_setopt(curl, CURLOPT_HEADER, false);
-            curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, write_header);
-            curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers);
+    void HttpClient::sendAsync(const HttpRequest &request, HttpSendCallback callback) {
+        if (request.url.isEmpty())
+            return;
 
-            // response data.
-            response.request = &request;
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+        void *curl = _engine->acquire();
+        if (curl == nullptr) {
+            return;
+        }
+        auto transfer = new HttpClientTransfer(curl, request, new HttpStringContent());
+        transfer->callback = callback;
+        transfer->url = requestUrl(transfer->request);
+        transfer->headerList = setOptions(curl, transfer->request, transfer->response, transfer->url);
+        if (!_engine->add(transfer)) {
+            delete transfer;
+            _engine->release(curl);
+        }
+    }
 
-            res = curl_easy_perform(curl);
-            /* Check for errors */
-            if (res != CURLE_OK) {
-                Debug::writeFormatLine("curl_easy_perform(%s) failed: %s", url.toString().c_str(),
-                                       curl_easy_strerror(res));
-                if (res == CURLE_OPERATION_TIMEDOUT)
-                    response.status = (HttpStatus) HttpRequestTimeout;
-            } else {
-                /* Check for errors */
-                int responseCode = HttpStatus::HttpInternalServerError;
-                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
-                response.status = (HttpStatus) responseCode;
-            }
+    bool HttpClient::sendAsync(const HttpRequest &request, HttpCompletion completion, void *state,
+                               HttpContent *responseContent) {
+        if (responseContent == nullptr) {
+            responseContent = new HttpStringContent();
+        }
+        void *curl = request.url.isEmpty() ? nullptr : _engine->acquire();
+        if (curl == nullptr) {
+            delete responseContent;
+            return false;
+        }
+        auto transfer = new HttpClientTransfer(curl, request, responseContent);
+        transfer->completion = completion;
+        transfer->state = state;
+        transfer->url = requestUrl(transfer->request);
+        transfer->headerList = setOptions(curl, transfer->request, transfer->response, transfer->url);
+        if (!_engine->add(transfer)) {
+            delete transfer;
+            _engine->release(curl);
+            return false;
+        }
+        return true;
+    }
 
-            if (headerList != nullptr)
-                curl_slist_free_all(headerList); /* free the header list */
+    size_t HttpClient::maxHostConnections() const {
+        return _maxHostConnections;
+    }
 
-            /* always cleanup */
-            curl_easy_cleanup(curl);
-        }
+    void HttpClient::setMaxHostConnections(size_t maxHostConnections) {
+        _maxHostConnections = maxHostConnections;
+        _engine->setMaxHostConnections(maxHostConnections);
+    }
 
-        return res == CURLE_OK;
+    size_t HttpClient::pendingCount() const {
+        return _engine->activeCount();
     }
 
-    void HttpClient::sendAsync(const HttpRequest &request, HttpSendCallback callback) {
-        if (!isStarted()) {
-            start();
+    String HttpClient::requestUrl(const HttpRequest &request) const {
+        Url url = request.url;
+        if (request.properties.count() > 0) {
+            url = Url(url, String::format("?%s", request.properties.toString().c_str()));
+        }
+        return url.toString();
+    }
+
+    void *HttpClient::setOptions(void *curl, const HttpRequest &request, HttpResponse &response,
+                                 const String &url) const {
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        if (!request.userAgent.isNullOrEmpty())
+            curl_easy_setopt(curl, CURLOPT_USERAGENT, request.userAgent.c_str());
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, (int) connectionTimeout.totalSeconds());
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, (int) receiveTimeout.totalSeconds());
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, false);
+//            curl_easy_setopt(curl, CURLOPT_SSLVERSION, 1);
+        curl_easy_setopt(curl, CURLOPT_VERBOSE, request.verb);
+        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+        // request method.
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.method.c_str());
+
+        // request headers.
+        struct curl_slist *headerList = nullptr;
+        if (request.headers.count() > 0) {
+            for (size_t i = 0; i < request.headers.count(); i++) {
+                const HttpHeader &header = request.headers[i];
+                headerList = curl_slist_append(headerList, header.toString().c_str());
+            }
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
+        }
+
+        // request data.
+        curl_easy_setopt(curl, CURLOPT_READFUNCTION, read_data);
+        curl_easy_setopt(curl, CURLOPT_READDATA, &request);
+        curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, request.contentSize());
+        if (request.method == HttpMethod::Post) {
+            curl_easy_setopt(curl, CURLOPT_UPLOAD, true);
+        } else if (request.method == HttpMethod::Get) {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
+        } else if (request.method == HttpMethod::Put) {
+            curl_easy_setopt(curl, CURLOPT_PUT, true);
+        } else if (request.method == HttpMethod::Delete) {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+        } else {
+            curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.method.c_str());
         }
-        add(new HttpRequestEntry(request, callback));
+
+        // response headers.
+        curl_easy_setopt(curl, CURLOPT_HEADER, false);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, write_header);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers);
+
+        // response data.
+        response.request = &request;
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+
+        return headerList;
     }
 
-    void HttpClient::process(const IPoolEntry *value) {
-        auto entry = dynamic_cast<const HttpRequestEntry *>(value);
-        assert(entry);
-        HttpResponse response(new HttpStringContent());
-        send(entry->request, response);
-        if (entry->callback != nullptr) {
-            entry->callback(response);
+    bool HttpClient::complete(void *curl, int code, HttpResponse &response, const String &url) {
+        auto res = (CURLcode) code;
+        /* Check for errors */
+        if (res != CURLE_OK) {
+            Debug::writeFormatLine("curl_easy_perform(%s) failed: %s", url.c_str(), curl_easy_strerror(res));
+            if (res == CURLE_OPERATION_TIMEDOUT)
+                response.status = (HttpStatus) HttpRequestTimeout;
+        } else {
+            /* Check for errors */
+            long responseCode = HttpStatus::HttpInternalServerError;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+            response.status = (HttpStatus) responseCode;
         }
+        return res == CURLE_OK;
     }
 
     size_t HttpClient::write_data(void *buffer, size_t size, size_t nmemb, void *userdata) {
@@ -9,9 +9,13 @@
 #include "http/HttpContent.h"
 #include "thread/TickTimeout.h"
 #include "diag/Trace.h"
+#include "system/Math.h"
 #include "curl/curl.h"
+#include <vector>
+#include <event2/buffer.h>
 
 using namespace Diag;
+using namespace System;
 
 namespace Http {
     HttpHeader::HttpHeader(const String &name, const String &value) : name(name), value(value) {
@@ -555,23 +559,21 @@ namespace Http {
         return result;
     }
 
-    HttpStringContent::HttpStringContent() {
-        _stream = new MemoryStream();
+    HttpStringContent::HttpStringContent() : _position(0) {
     }
 
-    HttpStringContent::HttpStringContent(const String &value) : _value(value) {
-        _stream = new MemoryStream((const uint8_t *) value.c_str(), value.length());
+    HttpStringContent::HttpStringContent(const String &value) : _value(value), _position(0) {
     }
 
-    HttpStringContent::HttpStringContent(const HttpStringContent &other) : _stream(nullptr) {
-        HttpStringContent::evaluates(other);
+    HttpStringContent::HttpStringContent(String &&value) : _value(std::move(value)), _position(0) {
     }
 
-    HttpStringContent::~HttpStringContent() {
-        delete _stream;
-        _stream = nullptr;
+    HttpStringContent::HttpStringContent(const HttpStringContent &other) : _position(0) {
+        HttpStringContent::evaluates(other);
     }
 
+    HttpStringContent::~HttpStringContent() = default;
+
     bool HttpStringContent::equals(const HttpContent &other) const {
         auto content = dynamic_cast<const HttpStringContent *>(&other);
         return content != nullptr && _value == content->_value;
@@ -581,7 +583,7 @@ namespace Http {
         auto content = dynamic_cast<const HttpStringContent *>(&other);
         if (content != nullptr) {
             _value = content->_value;
-            _stream = new MemoryStream((const uint8_t *) _value.c_str(), _value.length());
+            _position = 0;
         }
     }
 
@@ -590,7 +592,10 @@ namespace Http {
     }
 
     ssize_t HttpStringContent::read(void *buffer, size_t size, size_t nmemb) {
-        return _stream->read((uint8_t *) buffer, 0, (uint32_t) (size * nmemb));
+        size_t count = Math::min(size * nmemb, _value.length() - Math::min(_position, _value.length()));
+        memcpy(buffer, _value.c_str() + _position, count);
+        _position += count;
+        return (ssize_t) count;
     }
 
     size_t HttpStringContent::size() {
@@ -610,6 +615,9 @@ namespace Http {
     HttpJsonContent::HttpJsonContent(const String &value) : HttpStringContent(value) {
     }
 
+    HttpJsonContent::HttpJsonContent(String &&value) : HttpStringContent(std::move(value)) {
+    }
+
     HttpJsonContent::HttpJsonContent(const JsonNode &value) : HttpJsonContent(value.toString()) {
     }
 
@@ -627,22 +635,17 @@ namespace Http {
         return new HttpJsonContent(*this);
     }
 
-    HttpByteArrayContent::HttpByteArrayContent() {
-        _stream = new MemoryStream();
+    HttpByteArrayContent::HttpByteArrayContent() : _position(0) {
     }
 
-    HttpByteArrayContent::HttpByteArrayContent(const ByteArray &value) : _value(value) {
-        _stream = new MemoryStream(&_value, false);
+    HttpByteArrayContent::HttpByteArrayContent(const ByteArray &value) : _value(value), _position(0) {
     }
 
-    HttpByteArrayContent::HttpByteArrayContent(const HttpByteArrayContent &other) : _stream(nullptr) {
+    HttpByteArrayContent::HttpByteArrayContent(const HttpByteArrayContent &other) : _position(0) {
         HttpByteArrayContent::evaluates(other);
     }
 
-    HttpByteArrayContent::~HttpByteArrayContent() {
-        delete _stream;
-        _stream = nullptr;
-    }
+    HttpByteArrayContent::~HttpByteArrayContent() = default;
 
     bool HttpByteArrayContent::equals(const HttpContent &other) const {
         auto content = dynamic_cast<const HttpByteArrayContent *>(&other);
@@ -653,6 +656,7 @@ namespace Http {
         auto content = dynamic_cast<const HttpByteArrayContent *>(&other);
         if (content != nullptr) {
             _value = content->_value;
+            _position = 0;
         }
     }
 
@@ -661,7 +665,10 @@ namespace Http {
     }
 
     ssize_t HttpByteArrayContent::read(void *buffer, size_t size, size_t nmemb) {
-        return _stream->read((uint8_t *) buffer, 0, (uint32_t) (size * nmemb));
+        size_t count = Math::min(size * nmemb, _value.count() - Math::min(_position, _value.count()));
+        memcpy(buffer, _value.data() + _position, count);
+        _position += count;
+        return (ssize_t) count;
     }
 
     size_t HttpByteArrayContent::size() {
@@ -676,6 +683,101 @@ namespace Http {
         return _value;
     }
 
+    HttpBufferContent::HttpBufferContent() : _buffer(evbuffer_new()), _position(0), _copied(false) {
+    }
+
+    HttpBufferContent::HttpBufferContent(struct evbuffer *buffer) : HttpBufferContent() {
+        evbuffer_add_buffer(_buffer, buffer);
+    }
+
+    HttpBufferContent::HttpBufferContent(const HttpBufferContent &other) : HttpBufferContent() {
+        HttpBufferContent::evaluates(other);
+    }
+
+    HttpBufferContent::~HttpBufferContent() {
+        evbuffer_free(_buffer);
+    }
+
+    bool HttpBufferContent::equals(const HttpContent &other) const {
+        auto content = dynamic_cast<const HttpBufferContent *>(&other);
+        return content != nullptr && value() == content->value();
+    }
+
+    void HttpBufferContent::evaluates(const HttpContent &other) {
+        auto content = dynamic_cast<const HttpBufferContent *>(&other);
+        if (content != nullptr && content != this) {
+            // copied, the chains of the other one are not shared.
+            evbuffer_drain(_buffer, evbuffer_get_length(_buffer));
+            content->peek(_buffer, add);
+            _position = 0;
+            _value = String::Empty;
+            _copied = false;
+        }
+    }
+
+    void HttpBufferContent::write(void *buffer, size_t size, size_t nmemb) {
+        evbuffer_add(_buffer, buffer, size * nmemb);
+        _copied = false;
+    }
+
+    ssize_t HttpBufferContent::read(void *buffer, size_t size, size_t nmemb) {
+        struct evbuffer_ptr ptr{};
+        if (_position >= evbuffer_get_length(_buffer) ||
+            evbuffer_ptr_set(_buffer, &ptr, _position, EVBUFFER_PTR_SET) < 0) {
+            return 0;
+        }
+        ev_ssize_t count = evbuffer_copyout_from(_buffer, &ptr, buffer, size * nmemb);
+        if (count > 0) {
+            _position += count;
+        }
+        return count;
+    }
+
+    size_t HttpBufferContent::size() {
+        return evbuffer_get_length(_buffer);
+    }
+
+    HttpContent *HttpBufferContent::clone() const {
+        return new HttpBufferContent(*this);
+    }
+
+    bool HttpBufferContent::peek(void *owner, Visitor visitor) const {
+        int count = evbuffer_peek(_buffer, -1, nullptr, nullptr, 0);
+        if (count <= 0) {
+            return true;
+        }
+        std::vector<struct evbuffer_iovec> chains((size_t) count);
+        count = evbuffer_peek(_buffer, -1, nullptr, chains.data(), count);
+        for (int i = 0; i < count; i++) {
+            if (!visitor(owner, (const uint8_t *) chains[i].iov_base, chains[i].iov_len)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const String &HttpBufferContent::value() const {
+        if (!_copied) {
+            _value = String::Empty;
+            _value.reserve(evbuffer_get_length(_buffer));
+            peek(&_value, append);
+            _copied = true;
+        }
+        return _value;
+    }
+
+    bool HttpBufferContent::add(void *owner, const uint8_t *data, size_t length) {
+        evbuffer_add(static_cast<struct evbuffer *>(owner), data, length);
+        return true;
+    }
+
+    bool HttpBufferContent::append(void *owner, const uint8_t *data, size_t length) {
+        if (length > 0) {
+            static_cast<String *>(owner)->append((const char *) data, length);
+        }
+        return true;
+    }
+
     HttpStreamContent::HttpStreamContent() {
         _stream = nullptr;
     }
@@ -730,6 +832,65 @@ namespace Http {
         return _stream;
     }
 
+    HttpChunkedContent::HttpChunkedContent() : HttpChunkedContent(nullptr, nullptr) {
+    }
+
+    HttpChunkedContent::HttpChunkedContent(void *state, Writer writer) : _state(state), _writer(writer), _end(false) {
+    }
+
+    HttpChunkedContent::HttpChunkedContent(const HttpChunkedContent &other) : HttpChunkedContent() {
+        HttpChunkedContent::evaluates(other);
+    }
+
+    HttpChunkedContent::~HttpChunkedContent() = default;
+
+    bool HttpChunkedContent::equals(const HttpContent &other) const {
+        auto content = dynamic_cast<const HttpChunkedContent *>(&other);
+        return content != nullptr && _state == content->_state && _writer == content->_writer;
+    }
+
+    void HttpChunkedContent::evaluates(const HttpContent &other) {
+        auto content = dynamic_cast<const HttpChunkedContent *>(&other);
+        if (content != nullptr) {
+            _state = content->_state;
+            _writer = content->_writer;
+            _buffer.clear();
+            _end = false;
+        }
+    }
+
+    void HttpChunkedContent::write(void *, size_t, size_t) {
+    }
+
+    ssize_t HttpChunkedContent::read(void *buffer, size_t size, size_t nmemb) {
+        size_t count = size * nmemb;
+        if (count == 0) {
+            return 0;
+        }
+        while (_buffer.position() >= (off_t) _buffer.length() && !_end) {
+            _buffer.clear();
+            _end = !writeNext(_buffer);
+            _buffer.seek(0, SeekBegin);
+        }
+        return _buffer.read((uint8_t *) buffer, 0, count);
+    }
+
+    size_t HttpChunkedContent::size() {
+        return 0;
+    }
+
+    HttpContent *HttpChunkedContent::clone() const {
+        return new HttpChunkedContent(*this);
+    }
+
+    bool HttpChunkedContent::isEnd() const {
+        return _end && _buffer.position() >= (off_t) _buffer.length();
+    }
+
+    bool HttpChunkedContent::writeNext(Stream &stream) {
+        return _writer != nullptr && _writer(_state, stream);
+    }
+
     const HttpMethod HttpMethod::Get("GET");
     const HttpMethod HttpMethod::Put("PUT");
     const HttpMethod HttpMethod::Post("POST");
@@ -843,6 +1004,64 @@ namespace Http {
 
     const char HttpRequest::PathSplitSymbol = '/';
 
+    HttpPathVariables::HttpPathVariables() : _values(), _count(0) {
+    }
+
+    void HttpPathVariables::add(const String &name, const char *value, size_t length) {
+        if (_count < InlineCount) {
+            Variable &variable = _values[_count];
+            variable.name = name;
+            variable.value = value;
+            variable.length = length;
+        } else {
+            _overflow.push_back(Variable{name, value, length});
+        }
+        _count++;
+    }
+
+    void HttpPathVariables::clear() {
+        _overflow.clear();
+        _count = 0;
+    }
+
+    size_t HttpPathVariables::count() const {
+        return _count;
+    }
+
+    void HttpPathVariables::truncate(size_t count) {
+        if (count < _count) {
+            _overflow.resize(count > InlineCount ? count - InlineCount : 0);
+            _count = count;
+        }
+    }
+
+    bool HttpPathVariables::at(const String &name, String &value) const {
+        for (size_t i = 0; i < _count; i++) {
+            const Variable &variable = variableAt(i);
+            if (variable.name == name) {
+                value = String(variable.value, variable.length);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const String &HttpPathVariables::nameAt(size_t index) const {
+        return index < _count ? variableAt(index).name : String::Empty;
+    }
+
+    String HttpPathVariables::valueAt(size_t index) const {
+        if (index < _count) {
+            const Variable &variable = variableAt(index);
+            return String(variable.value, variable.length);
+        }
+        return String::Empty;
+    }
+
+    const HttpPathVariables::Variable &HttpPathVariables::variableAt(size_t index) const {
+        return index < InlineCount ? _values[index] : _overflow[index - InlineCount];
+    }
+
     HttpRequest::HttpRequest(const Url &url, const HttpMethod &method) : url(url), method(method), content(nullptr),
                                                                          version("1.1"), verb(false) {
         headers.add("Accept", "*/*");
@@ -911,7 +1130,11 @@ namespace Http {
 
     const String &HttpRequest::text() const {
         auto sc = dynamic_cast<const HttpStringContent *>(this->content);
-        return sc != nullptr ? sc->value() : String::Empty;
+        if (sc != nullptr) {
+            return sc->value();
+        }
+        auto bc = dynamic_cast<const HttpBufferContent *>(this->content);
+        return bc != nullptr ? bc->value() : String::Empty;
     }
 
     bool HttpRequest::match(const String &path) const {
@@ -932,6 +1155,16 @@ namespace Http {
         return false;
     }
 
+    bool HttpRequest::getPathVariable(const String &name, String &value) const {
+        return pathVariables.at(name, value);
+    }
+
+    String HttpRequest::getPathVariable(const String &name) const {
+        String value;
+        pathVariables.at(name, value);
+        return value;
+    }
+
     bool HttpRequest::getPropValue(const String &key, String &value) const {
         return this->properties.at(key, value);
     }
@@ -1037,6 +1270,14 @@ namespace Http {
         this->content = new HttpStreamContent(stream);
     }
 
+    void HttpResponse::setContent(void *state, HttpChunkedContent::Writer writer) {
+        if (content != nullptr) {
+            delete content;
+            content = nullptr;
+        }
+        this->content = new HttpChunkedContent(state, writer);
+    }
+
     HttpCode::Item::Item() : code(Unknown) {
     }
 
@@ -0,0 +1,243 @@
+//
+//  HttpEngine.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "http/HttpEngine.h"
+#include "diag/Trace.h"
+#include "curl/curl.h"
+
+using namespace Diag;
+
+namespace Http {
+    HttpTransfer::HttpTransfer(void *handle) : _handle(handle) {
+    }
+
+    HttpTransfer::~HttpTransfer() = default;
+
+    void *HttpTransfer::handle() const {
+        return _handle;
+    }
+
+    HttpEngine::HttpEngine(size_t maxHostConnections) : _multi(nullptr), _maxHostConnections(maxHostConnections),
+                                                        _thread(nullptr), _running(false), _activeCount(0),
+                                                        _stopping(false), _optionsChanged(false) {
+        _share = curl_share_init();
+        if (_share != nullptr) {
+            curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lockShare);
+            curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlockShare);
+            curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        }
+    }
+
+    HttpEngine::~HttpEngine() {
+        stop();
+
+        for (void *handle: _handles) {
+            curl_easy_cleanup(handle);
+        }
+        _handles.clear();
+
+        if (_share != nullptr) {
+            curl_share_cleanup(_share);
+            _share = nullptr;
+        }
+    }
+
+    void *HttpEngine::acquire() {
+        void *handle = nullptr;
+        {
+            std::lock_guard<std::mutex> locker(_handlesMutex);
+            if (!_handles.empty()) {
+                handle = _handles.back();
+                _handles.pop_back();
+            }
+        }
+        if (handle == nullptr) {
+            handle = curl_easy_init();
+        }
+        if (handle != nullptr && _share != nullptr) {
+            curl_easy_setopt(handle, CURLOPT_SHARE, _share);
+        }
+        return handle;
+    }
+
+    void HttpEngine::release(void *handle) {
+        if (handle == nullptr) {
+            return;
+        }
+
+        // the options are cleared, the connections and the caches are kept.
+        curl_easy_reset(handle);
+        {
+            std::lock_guard<std::mutex> locker(_handlesMutex);
+            if (_handles.size() < MaxCachedHandles) {
+                _handles.push_back(handle);
+                return;
+            }
+        }
+        curl_easy_cleanup(handle);
+    }
+
+    bool HttpEngine::add(HttpTransfer *transfer) {
+        if (transfer == nullptr || transfer->_handle == nullptr) {
+            return false;
+        }
+        if (!_running && !start()) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> locker(_pendingMutex);
+            if (_stopping) {
+                return false;
+            }
+            _activeCount++;
+            _pending.push_back(transfer);
+        }
+        curl_multi_wakeup(_multi);
+        return true;
+    }
+
+    void HttpEngine::setMaxHostConnections(size_t maxHostConnections) {
+        // the multi handle is not thread-safe, the engine thread applies it.
+        std::lock_guard<std::mutex> locker(_pendingMutex);
+        _maxHostConnections = maxHostConnections;
+        _optionsChanged = true;
+        if (_running && !_stopping) {
+            curl_multi_wakeup(_multi);
+        }
+    }
+
+    size_t HttpEngine::activeCount() const {
+        return _activeCount;
+    }
+
+    bool HttpEngine::start() {
+        std::lock_guard<std::mutex> locker(_pendingMutex);
+        if (_running) {
+            return true;
+        }
+        if (_stopping) {
+            return false;
+        }
+
+        _multi = curl_multi_init();
+        if (_multi == nullptr) {
+            return false;
+        }
+        curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long) _maxHostConnections);
+        _optionsChanged = false;
+
+        _running = true;
+        _thread = new Thread("http.engine", &HttpEngine::runProc, this);
+        _thread->start();
+        return true;
+    }
+
+    void HttpEngine::stop() {
+        {
+            std::lock_guard<std::mutex> locker(_pendingMutex);
+            _stopping = true;
+        }
+        if (!_running) {
+            return;
+        }
+
+        _running = false;
+        curl_multi_wakeup(_multi);
+        if (_thread != nullptr) {
+            _thread->join();
+            delete _thread;
+            _thread = nullptr;
+        }
+
+        curl_multi_cleanup(_multi);
+        _multi = nullptr;
+    }
+
+    void HttpEngine::runProc() {
+        std::vector<HttpTransfer *> pending;
+        std::vector<HttpTransfer *> transfers;
+        while (_running) {
+            {
+                std::lock_guard<std::mutex> locker(_pendingMutex);
+                pending.swap(_pending);
+                if (_optionsChanged) {
+                    curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long) _maxHostConnections);
+                    _optionsChanged = false;
+                }
+            }
+            for (HttpTransfer *transfer: pending) {
+                curl_easy_setopt(transfer->_handle, CURLOPT_PRIVATE, transfer);
+                curl_multi_add_handle(_multi, transfer->_handle);
+                transfers.push_back(transfer);
+            }
+            pending.clear();
+
+            int running = 0;
+            curl_multi_perform(_multi, &running);
+
+            CURLMsg *msg;
+            int left = 0;
+            while ((msg = curl_multi_info_read(_multi, &left)) != nullptr) {
+                if (msg->msg == CURLMSG_DONE) {
+                    CURL *handle = msg->easy_handle;
+                    CURLcode code = msg->data.result;
+                    HttpTransfer *transfer = nullptr;
+                    curl_easy_getinfo(handle, CURLINFO_PRIVATE, (char **) &transfer);
+                    curl_multi_remove_handle(_multi, handle);
+                    if (transfer != nullptr) {
+                        for (size_t i = 0; i < transfers.size(); i++) {
+                            if (transfers[i] == transfer) {
+                                transfers[i] = transfers.back();
+                                transfers.pop_back();
+                                break;
+                            }
+                        }
+                        transfer->complete(code);
+                        delete transfer;
+                        _activeCount--;
+                    }
+                    release(handle);
+                }
+            }
+
+            // wakes up by the socket events, a new transfer or stop.
+            curl_multi_poll(_multi, nullptr, 0, 1000, nullptr);
+        }
+
+        // the transfers not completed are completed with an error, their owners are not left waiting.
+        {
+            std::lock_guard<std::mutex> locker(_pendingMutex);
+            pending.swap(_pending);
+        }
+        transfers.insert(transfers.end(), pending.begin(), pending.end());
+        for (HttpTransfer *transfer: transfers) {
+            void *handle = transfer->_handle;
+            curl_multi_remove_handle(_multi, handle);
+            transfer->complete(CURLE_ABORTED_BY_CALLBACK);
+            delete transfer;
+            _activeCount--;
+            release(handle);
+        }
+        if (!transfers.empty()) {
+            Debug::writeFormatLine("http engine stopped with %d transfers aborted.", (int) transfers.size());
+        }
+    }
+
+    void HttpEngine::lockShare(void *, int data, int, void *userptr) {
+        auto engine = (HttpEngine *) userptr;
+        engine->_shareMutexes[data & 15].lock();
+    }
+
+    void HttpEngine::unlockShare(void *, int data, void *userptr) {
+        auto engine = (HttpEngine *) userptr;
+        engine->_shareMutexes[data & 15].unlock();
+    }
+}
@@ -0,0 +1,235 @@
+//
+//  HttpRouter.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "http/HttpRouter.h"
+#include <algorithm>
+
+namespace Http {
+    static int compareSegment(const String &segment, const char *text, size_t length) {
+        size_t size = segment.length();
+        int result = memcmp(segment.c_str(), text, size < length ? size : length);
+        if (result != 0) {
+            return result;
+        }
+        return size < length ? -1 : (size > length ? 1 : 0);
+    }
+
+    HttpRouter::Node::Node(const String &segment) : segment(segment) {
+    }
+
+    HttpRouter::Node::~Node() {
+        for (Node *child: children) {
+            delete child;
+        }
+        for (Node *child: variables) {
+            delete child;
+        }
+    }
+
+    const HttpRouter::Values *HttpRouter::Node::find(const String &method) const {
+        for (const Route &route: routes) {
+            if (String::equals(route.method, method, true)) {
+                return &route.values;
+            }
+        }
+        return nullptr;
+    }
+
+    HttpRouter::HttpRouter() : _root(new Node(String::Empty)), _count(0) {
+    }
+
+    HttpRouter::~HttpRouter() {
+        delete _root;
+        _root = nullptr;
+    }
+
+    void HttpRouter::add(const HttpMethod &method, const String &path, void *value) {
+        Node *node = insert(path);
+        for (Route &route: node->routes) {
+            if (String::equals(route.method, method.method, true)) {
+                route.values.push_back(value);
+                _count++;
+                return;
+            }
+        }
+        Route route;
+        route.method = method.method;
+        route.values.push_back(value);
+        node->routes.push_back(route);
+        _count++;
+    }
+
+    bool HttpRouter::remove(const HttpMethod &method, const String &path, void *value) {
+        Node *node = findNode(path);
+        if (node == nullptr) {
+            return false;
+        }
+        for (auto it = node->routes.begin(); it != node->routes.end(); ++it) {
+            if (String::equals(it->method, method.method, true)) {
+                auto position = std::find(it->values.begin(), it->values.end(), value);
+                if (position == it->values.end()) {
+                    return false;
+                }
+                it->values.erase(position);
+                if (it->values.empty()) {
+                    node->routes.erase(it);
+                }
+                _count--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void HttpRouter::clear() {
+        delete _root;
+        _root = new Node(String::Empty);
+        _count = 0;
+    }
+
+    const HttpRouter::Values *HttpRouter::route(const HttpRequest &request) const {
+        request.pathVariables.clear();
+        return route(request.method, request.url.relativeUrl(), request.pathVariables);
+    }
+
+    const HttpRouter::Values *
+    HttpRouter::route(const HttpMethod &method, const String &path, HttpPathVariables &variables) const {
+        const char *str = path.c_str();
+        const Values *values = match(_root, method.method, str, str + path.length(), variables);
+        if (values == nullptr) {
+            variables.clear();
+        }
+        return values;
+    }
+
+    size_t HttpRouter::count() const {
+        return _count;
+    }
+
+    HttpRouter::Node *HttpRouter::insert(const String &path) {
+        StringArray segments;
+        StringArray::parse(path, segments, HttpRequest::PathSplitSymbol);
+
+        Node *node = _root;
+        for (size_t i = 0; i < segments.count(); i++) {
+            const String &segment = segments[i];
+            if (segment.isNullOrEmpty()) {
+                continue;
+            }
+
+            String name;
+            if (parseVarName(segment, name)) {
+                Node *child = nullptr;
+                for (Node *variable: node->variables) {
+                    if (variable->segment == name) {
+                        child = variable;
+                        break;
+                    }
+                }
+                if (child == nullptr) {
+                    child = new Node(name);
+                    node->variables.push_back(child);
+                }
+                node = child;
+            } else {
+                auto it = std::lower_bound(node->children.begin(), node->children.end(), segment,
+                                           [](const Node *child, const String &text) {
+                                               return compareSegment(child->segment, text.c_str(),
+                                                                     text.length()) < 0;
+                                           });
+                if (it == node->children.end() || (*it)->segment != segment) {
+                    it = node->children.insert(it, new Node(segment));
+                }
+                node = *it;
+            }
+        }
+        return node;
+    }
+
+    HttpRouter::Node *HttpRouter::findNode(const String &path) const {
+        StringArray segments;
+        StringArray::parse(path, segments, HttpRequest::PathSplitSymbol);
+
+        Node *node = _root;
+        for (size_t i = 0; i < segments.count() && node != nullptr; i++) {
+            const String &segment = segments[i];
+            if (segment.isNullOrEmpty()) {
+                continue;
+            }
+
+            String name;
+            bool variable = parseVarName(segment, name);
+            const std::vector<Node *> &children = variable ? node->variables : node->children;
+            const String &text = variable ? name : segment;
+            Node *next = nullptr;
+            for (Node *child: children) {
+                if (child->segment == text) {
+                    next = child;
+                    break;
+                }
+            }
+            node = next;
+        }
+        return node;
+    }
+
+    const HttpRouter::Values *HttpRouter::match(const Node *node, const String &method, const char *path,
+                                                const char *end, HttpPathVariables &variables) {
+        while (path < end && *path == HttpRequest::PathSplitSymbol) {
+            path++;
+        }
+        if (path == end) {
+            return node->find(method);
+        }
+        const char *next = path;
+        while (next < end && *next != HttpRequest::PathSplitSymbol) {
+            next++;
+        }
+        auto length = (size_t) (next - path);
+
+        // the text segment first.
+        const std::vector<Node *> &children = node->children;
+        size_t low = 0, high = children.size();
+        while (low < high) {
+            size_t middle = (low + high) / 2;
+            int result = compareSegment(children[middle]->segment, path, length);
+            if (result == 0) {
+                const Values *values = match(children[middle], method, next, end, variables);
+                if (values != nullptr) {
+                    return values;
+                }
+                break;
+            } else if (result < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+
+        // then the variables, the captured ones are dropped if the rest does not match.
+        for (const Node *variable: node->variables) {
+            size_t count = variables.count();
+            variables.add(variable->segment, path, length);
+            const Values *values = match(variable, method, next, end, variables);
+            if (values != nullptr) {
+                return values;
+            }
+            variables.truncate(count);
+        }
+        return nullptr;
+    }
+
+    bool HttpRouter::parseVarName(const String &segment, String &name) {
+        size_t length = segment.length();
+        if (length >= 2 && segment[0] == '{' && segment[length - 1] == '}') {
+            name = segment.substr(1, length - 2);
+            return true;
+        }
+        return false;
+    }
+}
@@ -108,11 +108,14 @@ namespace Http {
                this->enabled == other.enabled;
     }
 
-    HttpServer::Context::Context(const Endpoint &endpoint, const Secure &secure, const TimeSpan &timeout) {
+    HttpServer::Context::Context(const Endpoint &endpoint, const Secure &secure, const TimeSpan &timeout,
+                                 int loopCount, int workerCount) {
         this->endpoint = endpoint;
         this->secure = secure;
         static const TimeSpan MinTimeout = TimeSpan::fromSeconds(3);
         this->timeout = timeout > MinTimeout ? timeout : MinTimeout;
+        this->loopCount = loopCount >= 1 && loopCount <= MaxLoopCount ? loopCount : 1;
+        this->workerCount = workerCount >= 0 && workerCount <= MaxWorkerCount ? workerCount : 0;
     }
 
     HttpServer::Context::Context(const Context &context) {
@@ -128,6 +131,8 @@ namespace Http {
             this->endpoint = value.endpoint;
             this->secure = value.secure;
             this->timeout = value.timeout;
+            this->loopCount = value.loopCount;
+            this->workerCount = value.workerCount;
         }
         return *this;
     }
@@ -135,80 +140,176 @@ namespace Http {
     bool HttpServer::Context::operator==(const Context &value) const {
         return this->endpoint == value.endpoint &&
                this->secure == value.secure &&
-               this->timeout == value.timeout;
+               this->timeout == value.timeout &&
+               this->loopCount == value.loopCount &&
+               this->workerCount == value.workerCount;
     }
 
     bool HttpServer::Context::operator!=(const Context &value) const {
         return !operator==(value);
     }
 
-    HttpServer::ContextEntry::ContextEntry() : base(nullptr), loopExit(true) {
+    HttpServer::Job::Job(LoopEntry *loop, struct evhttp_request *req) : loop(loop), req(req), request(nullptr),
+                                                                        code(HTTP_NOTFOUND), stream(nullptr),
+                                                                        closed(false), streaming(false),
+                                                                        working(false), chunk(nullptr) {
     }
 
-    HttpServer::HttpServer() : _httpThread(nullptr), _httpsThread(nullptr) {
+    HttpServer::Job::~Job() {
+        // the content of the request refers to the stream.
+        delete request;
+        delete stream;
+        if (chunk != nullptr)
+            evbuffer_free(chunk);
+        if (!fileName.isNullOrEmpty() && File::exists(fileName))
+            File::deleteFile(fileName);
     }
 
+    void HttpServer::Job::process(const Actions &actions) {
+        if (request != nullptr && actions.processAction != nullptr) {
+            code = actions.processAction(actions.owner, *request, response);
+        }
+    }
+
+    void HttpServer::Job::readChunk() {
+        // the part is read into the buffer of libevent directly.
+        chunk = evbuffer_new();
+        struct evbuffer_iovec v{};
+        if (evbuffer_reserve_space(chunk, ChunkSize, &v, 1) == 1) {
+            // the small parts of the content are sent together.
+            size_t size = Math::min(v.iov_len, ChunkSize);
+            size_t length = 0;
+            ssize_t count;
+            while (length < size &&
+                   (count = response.content->read((uint8_t *) v.iov_base + length, 1, size - length)) > 0) {
+                length += count;
+            }
+            v.iov_len = length;
+            evbuffer_commit_space(chunk, &v, 1);
+        }
+    }
+
+    HttpServer::LoopEntry::LoopEntry(ContextEntry *entry) : entry(entry), base(nullptr), http(nullptr),
+                                                            replyEvent(nullptr), thread(nullptr), stopping(false) {
+    }
+
+    HttpServer::LoopEntry::~LoopEntry() {
+        delete thread;
+        for (Job *job: replies) {
+            delete job;
+        }
+        if (replyEvent != nullptr)
+            event_free(replyEvent);
+        if (http != nullptr)
+            evhttp_free(http);
+        if (base != nullptr)
+            event_base_free(base);
+    }
+
+    bool HttpServer::LoopEntry::open(evutil_socket_t fd) {
+        base = event_base_new();
+        if (!base) {
+            Trace::writeLine("Couldn't create an event_base!");
+            evutil_closesocket(fd);
+            return false;
+        }
+
+        http = evhttp_new(base);
+        if (!http) {
+            Trace::writeLine("couldn't create evhttp.");
+            evutil_closesocket(fd);
+            return false;
+        }
+
+        if (entry->ssl != nullptr)
+            evhttp_set_bevcb(http, bevcb, entry->ssl);
+
+        evhttp_set_timeout(http, (int) entry->context.timeout.totalSeconds()); // seconds
+
+        evhttp_set_allowed_methods(http, EVHTTP_REQ_GET | EVHTTP_REQ_POST |
+                                         EVHTTP_REQ_PUT | EVHTTP_REQ_OPTIONS |
+                                         EVHTTP_REQ_DELETE | EVHTTP_REQ_PATCH);
+
+        if (entry->actions.action != nullptr)
+            evhttp_set_gencb(http, entry->actions.action, entry);
+        else
+            evhttp_set_gencb(http, send_document_cb, this);
+
+        if (evhttp_accept_socket_with_handle(http, fd) == nullptr) {
+            Trace::writeLine("couldn't accept the socket.");
+            evutil_closesocket(fd);
+            return false;
+        }
+
+        replyEvent = event_new(base, -1, EV_PERSIST, replies_cb, this);
+        return replyEvent != nullptr;
+    }
+
+    void HttpServer::LoopEntry::post(Job *job) {
+        {
+            std::lock_guard<std::mutex> locker(repliesMutex);
+            if (job != nullptr)
+                replies.push_back(job);
+        }
+        event_active(replyEvent, EV_READ, 0);
+    }
+
+    HttpServer::ContextEntry::ContextEntry() : ssl(nullptr), running(false), stopping(false) {
+    }
+
+    bool HttpServer::ContextEntry::post(Job *job) {
+        {
+            std::lock_guard<std::mutex> locker(jobsMutex);
+            if (stopping)
+                return false;
+            jobs.push_back(job);
+        }
+        jobsSignal.notify_one();
+        return true;
+    }
+
+    HttpServer::HttpServer() = default;
+
     HttpServer::~HttpServer() {
         stop();
-
-        delete _httpThread;
-        delete _httpsThread;
     }
 
     bool HttpServer::startHttpServer(const Context &context, const Actions &actions) {
-        _httpThread = new Thread("http_server", httpServerStart, &_httpContext);
         _httpContext.actions = actions;
         return startHttpServer(context);
     }
 
     bool HttpServer::startHttpServer(const Context &context) {
-        if (!context.isEmpty() && !_httpThread->isAlive()) {
-            _httpContext.context = context;
-            _httpThread->start();
-            return true;
-        }
-        return false;
+        return start(_httpContext, context);
     }
 
     bool HttpServer::startHttpsServer(const Context &context, const Actions &actions) {
-        _httpsThread = new Thread("https_server", httpServerStart, &_httpsContext);
         _httpsContext.actions = actions;
         return startHttpsServer(context);
     }
 
     bool HttpServer::startHttpsServer(const Context &context) {
-        if (!context.isEmpty() && !_httpsThread->isAlive()) {
-            _httpsContext.context = context;
-            _httpsThread->start();
-            return true;
-        }
-        return false;
+        return start(_httpsContext, context);
     }
 
     void HttpServer::stop() {
-        event_base_loopbreak(_httpContext.base);
-        event_base_loopbreak(_httpsContext.base);
+        stop(_httpContext);
+        stop(_httpsContext);
     }
 
     bool HttpServer::isAlive() const {
-        return (_httpThread != nullptr && _httpThread->isAlive() && !_httpContext.loopExit) ||
-               (_httpsThread != nullptr && _httpsThread->isAlive() && !_httpsContext.loopExit);
+        return _httpContext.running || _httpsContext.running;
     }
 
-    void HttpServer::httpServerStart(void *parameter) {
-        auto *entry = static_cast<ContextEntry *>(parameter);
-        assert(entry);
+    bool HttpServer::start(ContextEntry &entry, const Context &context) {
+        if (context.isEmpty() || entry.running) {
+            return false;
+        }
+        entry.context = context;
 
-        const Context &context = entry->context;
         const Endpoint &endpoint = context.endpoint;
         const String http_addr = endpoint.isAnyAddress() ? String("0.0.0.0") : endpoint.address;
-
-        Application *app = Application::instance();
-        String path = app->rootPath();
         const Secure &secure = context.secure;
-        String keyFile = Path::isPathRooted(secure.keyFile) ? secure.keyFile : Path::combine(path, secure.keyFile);
-        String certFile = Path::isPathRooted(secure.certFile) ? secure.certFile : Path::combine(path, secure.certFile);
-//        String cacertFile = Path::isPathRooted(secure.cacertFile) ? secure.cacertFile : Path::combine(path, secure.cacertFile);
 
 #ifdef WIN32
         evthread_use_windows_threads();
@@ -216,22 +317,13 @@ namespace Http {
         evthread_use_pthreads();
 #endif
 
-        struct event_base *base;
-        base = event_base_new();
-        if (!base) {
-            Trace::writeLine("Couldn't create an event_base!");
-            return;
-        }
-
-        struct evhttp *http;
-        http = evhttp_new(base);
-        if (!http) {
-            event_base_free(base);
-            Trace::writeLine("couldn't create evhttp.");
-            return;
-        }
-
         if (secure.enabled) {
+            Application *app = Application::instance();
+            String path = app != nullptr ? app->rootPath() : String::Empty;
+            String keyFile = Path::isPathRooted(secure.keyFile) ? secure.keyFile : Path::combine(path, secure.keyFile);
+            String certFile = Path::isPathRooted(secure.certFile) ? secure.certFile : Path::combine(path, secure.certFile);
+//            String cacertFile = Path::isPathRooted(secure.cacertFile) ? secure.cacertFile : Path::combine(path, secure.cacertFile);
+
             SSL_CTX *ctx = SSL_CTX_new(SSLv23_server_method());
             SSL_CTX_set_options(ctx,
                                 SSL_OP_SINGLE_DH_USE |
@@ -248,92 +340,168 @@ namespace Http {
                 Trace::writeLine("SSL_CTX_set_tmp_ecdh.");
 
             if (!server_setup_certs(ctx, certFile, keyFile)) {
-                evhttp_free(http);
-                event_base_free(base);
-                return;
+                return false;
             }
-
-            evhttp_set_bevcb(http, bevcb, ctx);
+            entry.ssl = ctx;
         }
 
-        evhttp_set_timeout(http, (int) context.timeout.totalSeconds()); // seconds
-
-        evhttp_set_allowed_methods(http, EVHTTP_REQ_GET | EVHTTP_REQ_POST |
-                                         EVHTTP_REQ_PUT | EVHTTP_REQ_OPTIONS |
-                                         EVHTTP_REQ_DELETE | EVHTTP_REQ_PATCH);
+        // every loop listens the port by its own socket, the kernel balances the connections of them.
+#ifdef SO_REUSEPORT
+        int loopCount = context.loopCount;
+#else
+        int loopCount = 1;
+#endif
+        Port port = endpoint.port;
+        for (int i = 0; i < loopCount; i++) {
+            evutil_socket_t fd = bindSocket(http_addr, port, loopCount > 1);
+            if (fd < 0) {
+                if (i == 0) {
+                    Trace::writeFormatLine("Couldn't bind to port %d.", (int) endpoint.port);
+                    stop(entry);
+                    return false;
+                }
+                break;
+            }
+            if (port == 0) {
+                // the port picked by the first socket is shared by the others.
+                sock_hop ss;
+                ev_socklen_t socklen = sizeof(ss);
+                memset(&ss, 0, sizeof(ss));
+                if (getsockname(fd, &ss.sa, &socklen) == 0) {
+                    port = ntohs(ss.ss.ss_family == AF_INET6 ? ss.i6.sin6_port : ss.in.sin_port);
+                }
+            }
 
-        if (entry->actions.action != nullptr)
-            evhttp_set_gencb(http, entry->actions.action, parameter);
-        else
-            evhttp_set_gencb(http, send_document_cb, parameter);
+            auto loop = new LoopEntry(&entry);
+            entry.loops.push_back(loop);
+            if (!loop->open(fd)) {
+                stop(entry);
+                return false;
+            }
+        }
 
-        struct evhttp_bound_socket *handle;
-        handle = evhttp_bind_socket_with_handle(http, http_addr, endpoint.port);
-        if (!handle) {
-            Trace::writeFormatLine("Couldn't bind to port %d.", endpoint.port);
-            evhttp_free(http);
-            event_base_free(base);
-            return;
+        entry.stopping = false;
+        for (int i = 0; i < context.workerCount; i++) {
+            auto thread = new Thread("http_worker", workerProc, &entry);
+            entry.workers.push_back(thread);
+            thread->start();
         }
+        for (LoopEntry *loop: entry.loops) {
+            loop->thread = new Thread("http_server", httpServerStart, loop);
+            loop->thread->start();
+        }
+        entry.running = true;
 
+        Trace::writeLine(String::convert("http%s server start successfully. endpoint('%s'), loops: %d, workers: %d",
+                                         secure.enabled ? "s" : "",
+                                         endpoint.toString().c_str(),
+                                         (int) entry.loops.size(), context.workerCount), Trace::Info);
+        return true;
+    }
+
+    void HttpServer::stop(ContextEntry &entry) {
+        // the workers finish the jobs at first, the replies of them are posted to the loops.
         {
-            sock_hop ss;
-            evutil_socket_t fd;
-            ev_socklen_t socklen = sizeof(ss);
-            char addrbuf[128];
-            void *inaddr;
-            const char *addr;
-//            int got_port = -1;
-
-            fd = evhttp_bound_socket_get_fd(handle);
-            memset(&ss, 0, sizeof(ss));
-
-            if (getsockname(fd, &ss.sa, &socklen)) {
-                Trace::writeLine("getsockname() failed");
-                evhttp_free(http);
-                event_base_free(base);
-                return;
+            std::lock_guard<std::mutex> locker(entry.jobsMutex);
+            entry.stopping = true;
+        }
+        entry.jobsSignal.notify_all();
+        for (Thread *thread: entry.workers) {
+            thread->join();
+            delete thread;
+        }
+        entry.workers.clear();
+
+        for (LoopEntry *loop: entry.loops) {
+            if (loop->thread != nullptr) {
+                loop->stopping = true;
+                loop->post(nullptr);
+                loop->thread->join();
             }
-            if (ss.ss.ss_family == AF_INET) {
-//                got_port = ntohs (ss.in.sin_port);
-                inaddr = &ss.in.sin_addr;
-            } else if (ss.ss.ss_family == AF_INET6) {
-//                got_port = ntohs (ss.i6.sin6_port);
-                inaddr = &ss.i6.sin6_addr;
-            } else {
-                Trace::writeFormatLine("Weird address family %d", ss.ss.ss_family);
-                evhttp_free(http);
-                event_base_free(base);
-                return;
+            delete loop;
+        }
+        entry.loops.clear();
+
+        if (entry.ssl != nullptr) {
+            SSL_CTX_free(entry.ssl);
+            entry.ssl = nullptr;
+        }
+
+        if (entry.running) {
+            entry.running = false;
+            const Context &context = entry.context;
+            Trace::writeLine(String::convert("http%s server stop successfully. endpoint('%s')",
+                                             context.secure.enabled ? "s" : "",
+                                             context.endpoint.toString().c_str()), Trace::Info);
+        }
+    }
+
+    void HttpServer::httpServerStart(void *parameter) {
+        auto *loop = static_cast<LoopEntry *>(parameter);
+        assert(loop);
+
+        event_base_dispatch(loop->base);
+    }
+
+    void HttpServer::workerProc(void *parameter) {
+        auto *entry = static_cast<ContextEntry *>(parameter);
+        assert(entry);
+
+        while (true) {
+            Job *job;
+            {
+                std::unique_lock<std::mutex> locker(entry->jobsMutex);
+                entry->jobsSignal.wait(locker, [entry] {
+                    return entry->stopping || !entry->jobs.empty();
+                });
+                if (entry->jobs.empty()) {
+                    return;
+                }
+                job = entry->jobs.front();
+                entry->jobs.pop_front();
             }
-            addr = evutil_inet_ntop(ss.ss.ss_family, inaddr, addrbuf,
-                                    sizeof(addrbuf));
-            if (addr) {
-                //                Debug::writeFormatLine("Listening on %s:%d", addr, got_port);
+
+            if (job->streaming) {
+                job->readChunk();
             } else {
-                Trace::writeLine("evutil_inet_ntop failed.");
-                evhttp_free(http);
-                event_base_free(base);
-                return;
+                job->process(entry->actions);
             }
+            job->loop->post(job);
         }
+    }
 
-        Trace::writeLine(String::convert("http%s server start successfully. endpoint('%s')",
-                                         secure.enabled ? "s" : "",
-                                         endpoint.toString().c_str()), Trace::Info);
-
-        entry->base = base;
-        entry->loopExit = false;
-
-        event_base_dispatch(base);
+    evutil_socket_t HttpServer::bindSocket(const String &address, Port port, bool reusePort) {
+        struct evutil_addrinfo hints{}, *result = nullptr;
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        hints.ai_flags = EVUTIL_AI_PASSIVE | EVUTIL_AI_ADDRCONFIG;
+        char service[16];
+        snprintf(service, sizeof(service), "%d", (int) port);
+        if (evutil_getaddrinfo(address, service, &hints, &result) != 0 || result == nullptr) {
+            return -1;
+        }
 
-        evhttp_free(http);
-        event_base_free(base);
-        entry->base = nullptr;
-        entry->loopExit = true;
-        Trace::writeLine(String::convert("http%s server stop successfully. endpoint('%s')",
-                                         secure.enabled ? "s" : "",
-                                         endpoint.toString().c_str()), Trace::Info);
+        evutil_socket_t fd = socket(result->ai_family, SOCK_STREAM, 0);
+        if (fd < 0) {
+            evutil_freeaddrinfo(result);
+            return -1;
+        }
+        bool ok = evutil_make_socket_nonblocking(fd) == 0 &&
+                  evutil_make_socket_closeonexec(fd) == 0 &&
+                  evutil_make_listen_socket_reuseable(fd) == 0;
+#ifdef SO_REUSEPORT
+        if (ok && reusePort) {
+            ok = evutil_make_listen_socket_reuseable_port(fd) == 0;
+        }
+#endif
+        ok = ok && bind(fd, result->ai_addr, (ev_socklen_t) result->ai_addrlen) == 0 && listen(fd, 128) == 0;
+        evutil_freeaddrinfo(result);
+        if (!ok) {
+            evutil_closesocket(fd);
+            return -1;
+        }
+        return fd;
     }
 
     char *HttpServer::find_http_header(struct evhttp_request *req, struct evkeyvalq *params, const char *query_char) {
@@ -447,89 +615,121 @@ namespace Http {
     }
 
     bool HttpServer::getMessage(struct evhttp_request *req, String &buffer) {
-        size_t post_size = evbuffer_get_length(req->input_buffer);
-        //        Debug::writeFormatLine("====line:%d,post len:%ld",__LINE__,post_size);
-        if (post_size <= 0) {
-//            Debug::writeFormatLine("====line:%d,post msg is empty!", __LINE__);
+        struct evbuffer *input = req->input_buffer;
+        size_t size = evbuffer_get_length(input);
+        if (size == 0) {
             return false;
-        } else {
-            buffer = String((const char *) evbuffer_pullup(req->input_buffer, -1), post_size);
-            return true;
         }
+
+        // copied chain by chain without pulling it up, the copied chains are freed at once.
+        buffer.reserve(size);
+        struct evbuffer_iovec v{};
+        while (evbuffer_peek(input, -1, nullptr, &v, 1) > 0 && v.iov_len > 0) {
+            buffer.append((const char *) v.iov_base, v.iov_len);
+            evbuffer_drain(input, v.iov_len);
+        }
+        return true;
     }
 
     bool HttpServer::getFileName(struct evhttp_request *req, String &fileName) {
-        int n, r;
-        struct evbuffer_iovec *v;
-
-        n = evbuffer_peek(req->input_buffer, -1, nullptr, nullptr, 0);
-        if (n <= 0)
+        struct evbuffer *input = req->input_buffer;
+        if (evbuffer_get_length(input) == 0)
             return false;
 
-        bool multiData = false;
-//        struct evkeyvalq* headers = req->input_headers;
-//        String contentType = evhttp_find_header(headers, "Content-Type");
-//        if(contentType.find("multipart/form-data") >= 0)
-//        {
-//            multiData = true;
-//        }
-
         fileName = Path::getTempFileName("http_server");
         FileStream fs(fileName, FileMode::FileCreate, FileAccess::FileWrite);
 
-        v = (struct evbuffer_iovec *) malloc(sizeof(struct evbuffer_iovec) * n);
-        evbuffer_peek(req->input_buffer, -1, nullptr, v, n);
-        if (n > 0) {
-            static const uint8_t MultiHeader[] = {0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D};
-            static const ByteArray MultiHeaderArray(MultiHeader, 6);
-            ByteArray source((const uint8_t *) v[0].iov_base, v[0].iov_len);
-            int pos = (int) source.find(MultiHeaderArray);
-            if (pos >= 0)
-                multiData = true;
-        }
-        for (int i = 0; i < n; ++i) {
-            if (multiData && i == 0)  // trim header.
-            {
-                off_t offset = 0;
-                static const uint8_t TailStr[] = {0x0D, 0x0A, 0x0D, 0x0A};
-                static const ByteArray TailArray(TailStr, 4);
-                ByteArray source((const uint8_t *) v[i].iov_base, v[i].iov_len);
-                int pos = (int) source.find(TailArray);
-                if (pos > 0)
-                    offset = pos + (int) TailArray.count();
-                r = fs.write((const uint8_t *) v[i].iov_base + offset, 0, v[i].iov_len - offset);
-            } else if (multiData && i == n - 1)  // trim tail.
-            {
+        // written chain by chain, the written chains are freed at once.
+        bool first = true, multiData = false;
+        struct evbuffer_iovec v{};
+        while (evbuffer_peek(input, -1, nullptr, &v, 1) > 0 && v.iov_len > 0) {
+            const auto *data = (const uint8_t *) v.iov_base;
+            size_t offset = 0, count = v.iov_len;
+            bool last = v.iov_len == evbuffer_get_length(input);
+            if (first) {
+                static const uint8_t MultiHeader[] = {0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D};
+                static const ByteArray MultiHeaderArray(MultiHeader, 6);
+                ByteArray source(data, v.iov_len);
+                if (source.find(MultiHeaderArray) >= 0) {
+                    multiData = true;
+                    // trim header.
+                    static const uint8_t TailStr[] = {0x0D, 0x0A, 0x0D, 0x0A};
+                    static const ByteArray TailArray(TailStr, 4);
+                    ssize_t pos = source.find(TailArray);
+                    if (pos > 0)
+                        offset = pos + TailArray.count();
+                }
+            }
+            if (multiData && last) {
+                // trim tail.
                 static const uint8_t HeaderStr[] = {0x0D, 0x0A, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D, 0x2D};
                 static const ByteArray HeaderArray(HeaderStr, 8);
-                ByteArray source((const uint8_t *) v[i].iov_base, v[i].iov_len);
-                int pos = source.find(HeaderArray);
+                ByteArray source(data + offset, count - offset);
+                ssize_t pos = source.find(HeaderArray);
                 if (pos > 0)
-                    r = fs.write((const uint8_t *) v[i].iov_base, 0, pos);
-                else
-                    r = fs.write((const uint8_t *) v[i].iov_base, 0, v[i].iov_len);
-//                ByteArray temp((const uint8_t*)v[i].iov_base + v[i].iov_len - 64, 64);
-//                Trace::debug(temp.toString());
-            } else {
-                r = fs.write((const uint8_t *) v[i].iov_base, 0, v[i].iov_len);
+                    count = offset + pos;
             }
 
-            if (r <= 0)
+            ssize_t r = count > offset ? fs.write(data, (off_t) offset, count - offset) : 0;
+            evbuffer_drain(input, v.iov_len);
+            if (r < 0)
                 break;
+            first = false;
         }
-        free(v);
         fs.close();
 
         return true;
     }
 
     void HttpServer::send_document_cb(struct evhttp_request *req, void *arg) {
-        struct evbuffer *evb = nullptr;
+        auto loop = static_cast<LoopEntry *>(arg);
+        assert(loop);
+        ContextEntry *entry = loop->entry;
+
+        auto job = new Job(loop, req);
+        if (!parseRequest(req, entry, job)) {
+            delete job;
+            return;
+        }
+
+        // the slow actions do not stall the other requests of the loop.
+        evhttp_connection_set_closecb(evhttp_request_get_connection(req), connection_closed_cb, job);
+        job->working = true;
+        if (entry->workers.empty() || !entry->post(job)) {
+            job->working = false;
+            job->process(entry->actions);
+            sendReply(job);
+        }
+    }
+
+    void HttpServer::replies_cb(evutil_socket_t, short, void *arg) {
+        auto loop = static_cast<LoopEntry *>(arg);
+        assert(loop);
+
+        std::vector<Job *> replies;
+        {
+            std::lock_guard<std::mutex> locker(loop->repliesMutex);
+            replies.swap(loop->replies);
+        }
+        for (Job *job: replies) {
+            job->working = false;
+            if (job->streaming) {
+                sendChunk(job);
+            } else {
+                sendReply(job);
+            }
+        }
+
+        if (loop->stopping) {
+            event_base_loopbreak(loop->base);
+        }
+    }
+
+    bool HttpServer::parseRequest(struct evhttp_request *req, const ContextEntry *entry, Job *job) {
         const char *uri = evhttp_request_get_uri(req);
         struct evhttp_uri *decoded = nullptr;
         const char *uri_path = nullptr;
         char *decoded_path = nullptr;
-        int code = HTTP_NOTFOUND;
 
 //        evhttp_connection *con = evhttp_request_get_connection(req);
 //        if (con) {
@@ -542,15 +742,12 @@ namespace Http {
 
         evhttp_cmd_type type = evhttp_request_get_command(req);
 
-        auto entry = static_cast<ContextEntry *>(arg);
-        assert(entry);
-
         /* Decode the URI */
         decoded = evhttp_uri_parse(uri);
         if (!decoded) {
             Debug::writeLine("It's not a good URI. Sending BADREQUEST");
             evhttp_send_error(req, HTTP_BADREQUEST, nullptr);
-            return;
+            return false;
         }
         /* Let's see what path the user asked for. */
         uri_path = evhttp_uri_get_path(decoded);
@@ -558,198 +755,315 @@ namespace Http {
 
         /* We need to decode it, to see what path the user really wanted. */
         decoded_path = evhttp_uridecode(uri_path, 0, nullptr);
+        evhttp_uri_free(decoded);
         if (decoded_path == nullptr) {
             evhttp_send_error(req, HTTP_NOTFOUND, "Document was not found");
-        } else {
-            String path = decoded_path;
-            if (path[0] == '/')
-                path = path.substr(1, path.length() - 1);
-
-            HttpHeaders inputHeaders;
-            struct evkeyval *header;
-            struct evkeyvalq *headers = req->input_headers;
-            TAILQ_FOREACH(header, headers, next) {
-                inputHeaders.add(header->key, header->value);
-            }
+            return false;
+        }
 
-            StringMap parameters;
-            struct evkeyvalq params{};
-            struct evkeyval *param;
-            if (evhttp_parse_query(uri, &params) == 0) {
-                TAILQ_FOREACH(param, &params, next) {
-                    parameters.add(param->key, param->value);
-                }
-            }
-            evhttp_clear_headers(&params);
-
-            // filter the url.
-            if (!isIllegal(req, path)) {
-                if (decoded)
-                    evhttp_uri_free(decoded);
-                if (decoded_path)
-                    free(decoded_path);
-                return;
-            }
+        String path = decoded_path;
+        free(decoded_path);
+        if (path[0] == '/')
+            path = path.substr(1, path.length() - 1);
 
-            const char *host = evhttp_request_get_host(req);
-            Url baseUrl(entry->context.secure.enabled ? "https" : "http", Endpoint(host, entry->context.endpoint.port));
-            Url url(baseUrl, path);
-            HttpMethod method = HttpMethod::Get;
-            switch (type) {
-                case EVHTTP_REQ_GET:
-                    method = HttpMethod::Get;
-                    break;
-                case EVHTTP_REQ_POST:
-                    method = HttpMethod::Post;
-                    break;
-                case EVHTTP_REQ_HEAD:
-                    method = HttpMethod::Head;
-                    break;
-                case EVHTTP_REQ_PUT:
-                    method = HttpMethod::Put;
-                    break;
-                case EVHTTP_REQ_DELETE:
-                    method = HttpMethod::Delete;
-                    break;
-                case EVHTTP_REQ_OPTIONS:
-                    method = HttpMethod::Options;
-                    break;
-                case EVHTTP_REQ_TRACE:
-                    method = HttpMethod::Trace;
-                    break;
-                case EVHTTP_REQ_CONNECT:
-                    method = HttpMethod::Connect;
-                    break;
-                case EVHTTP_REQ_PATCH:
-                    method = HttpMethod::Patch;
-                    break;
-                default:
-                    method = HttpMethod::Get;
-                    break;
+        HttpHeaders inputHeaders;
+        struct evkeyval *header;
+        struct evkeyvalq *headers = req->input_headers;
+        TAILQ_FOREACH(header, headers, next) {
+            inputHeaders.add(header->key, header->value);
+        }
+
+        StringMap parameters;
+        struct evkeyvalq params{};
+        struct evkeyval *param;
+        if (evhttp_parse_query(uri, &params) == 0) {
+            TAILQ_FOREACH(param, &params, next) {
+                parameters.add(param->key, param->value);
             }
+        }
+        evhttp_clear_headers(&params);
 
-            HttpResponse response;
-            if (type == EVHTTP_REQ_GET) {
-                if (entry->actions.processAction != nullptr) {
-                    HttpRequest request(url, method, inputHeaders, parameters);
-                    code = entry->actions.processAction(entry->actions.owner, request, response);
-                }
-            } else if (type == EVHTTP_REQ_POST ||
-                       type == EVHTTP_REQ_PUT ||
-                       type == EVHTTP_REQ_DELETE ||
-                       type == EVHTTP_REQ_TRACE ||
-                       type == EVHTTP_REQ_PATCH) {
-                if (entry->actions.processAction != nullptr) {
-                    if (inputHeaders.isTextContent()) {
-                        String body;
-                        HttpServer::getMessage(req, body);
-                        // filter the request body.
-                        if (!isIllegal(req, body)) {
-                            if (decoded)
-                                evhttp_uri_free(decoded);
-                            if (decoded_path)
-                                free(decoded_path);
-                            return;
-                        }
-
-                        HttpRequest request(url, method, inputHeaders, parameters, new HttpStringContent(body));
-                        code = entry->actions.processAction(entry->actions.owner, request, response);
-                    } else {
-                        String fileName;
-                        if (HttpServer::getFileName(req, fileName)) {
-                            FileStream fs(fileName, FileMode::FileOpenWithoutException, FileAccess::FileRead);
-                            HttpRequest request(url, method, inputHeaders, parameters, new HttpStreamContent(&fs));
-                            code = entry->actions.processAction(entry->actions.owner, request, response);
-
-                            if (File::exists(fileName))
-                                File::deleteFile(fileName);
-                        }
-                    }
+        // filter the url.
+        if (!isIllegal(req, path)) {
+            return false;
+        }
+
+        const char *host = evhttp_request_get_host(req);
+        Url baseUrl(entry->context.secure.enabled ? "https" : "http", Endpoint(host, entry->context.endpoint.port));
+        Url url(baseUrl, path);
+        HttpMethod method = HttpMethod::Get;
+        switch (type) {
+            case EVHTTP_REQ_GET:
+                method = HttpMethod::Get;
+                break;
+            case EVHTTP_REQ_POST:
+                method = HttpMethod::Post;
+                break;
+            case EVHTTP_REQ_HEAD:
+                method = HttpMethod::Head;
+                break;
+            case EVHTTP_REQ_PUT:
+                method = HttpMethod::Put;
+                break;
+            case EVHTTP_REQ_DELETE:
+                method = HttpMethod::Delete;
+                break;
+            case EVHTTP_REQ_OPTIONS:
+                method = HttpMethod::Options;
+                break;
+            case EVHTTP_REQ_TRACE:
+                method = HttpMethod::Trace;
+                break;
+            case EVHTTP_REQ_CONNECT:
+                method = HttpMethod::Connect;
+                break;
+            case EVHTTP_REQ_PATCH:
+                method = HttpMethod::Patch;
+                break;
+            default:
+                method = HttpMethod::Get;
+                break;
+        }
+
+        if (entry->actions.processAction == nullptr) {
+            // replied as not found.
+        } else if (type == EVHTTP_REQ_POST ||
+                   type == EVHTTP_REQ_PUT ||
+                   type == EVHTTP_REQ_DELETE ||
+                   type == EVHTTP_REQ_TRACE ||
+                   type == EVHTTP_REQ_PATCH) {
+            if (inputHeaders.isTextContent()) {
+                // the chains of the body are moved, not copied.
+                auto body = new HttpBufferContent(req->input_buffer);
+                // filter the request body.
+                if (!isIllegal(req, body)) {
+                    delete body;
+                    return false;
                 }
+
+                job->request = new HttpRequest(url, method, inputHeaders, parameters, body);
             } else {
-                if (entry->actions.processAction != nullptr) {
-                    HttpRequest request(url, method, inputHeaders, parameters);
-                    code = entry->actions.processAction(entry->actions.owner, request, response);
+                String fileName;
+                if (HttpServer::getFileName(req, fileName)) {
+                    job->fileName = fileName;
+                    job->stream = new FileStream(fileName, FileMode::FileOpenWithoutException, FileAccess::FileRead);
+                    job->request = new HttpRequest(url, method, inputHeaders, parameters,
+                                                   new HttpStreamContent(job->stream));
                 }
             }
+        } else {
+            job->request = new HttpRequest(url, method, inputHeaders, parameters);
+        }
+        return true;
+    }
 
-            bool hasContentType = false;
-            for (size_t i = 0; i < response.headers.count(); i++) {
-                const HttpHeader &h = response.headers[i];
-                if (h.name == "Content-Type")
-                    hasContentType = true;
-                evhttp_add_header(req->output_headers, h.name, h.value);
-            }
+    void HttpServer::sendReply(Job *job) {
+        struct evhttp_request *req = job->req;
+        if (job->closed) {
+            // libevent keeps the request not replied when its client is gone, it is freed here.
+            if (req != nullptr)
+                evhttp_request_free(req);
+            delete job;
+            return;
+        }
+        evhttp_connection_set_closecb(evhttp_request_get_connection(req), nullptr, nullptr);
 
-            if (!hasContentType) {
-                if (dynamic_cast<HttpStringContent *>(response.content) != nullptr)
-                    evhttp_add_header(req->output_headers, "Content-Type", "text/json; charset=UTF-8");
-            }
+        const HttpResponse &response = job->response;
+        int code = job->code;
 
-            // process response cookie.
-            if (!response.cookie.isEmpty()) {
-                evhttp_add_header(req->output_headers, "Set-Cookie", response.cookie.toString());
-            }
+        bool hasContentType = false;
+        for (size_t i = 0; i < response.headers.count(); i++) {
+            const HttpHeader &h = response.headers[i];
+            if (h.name == "Content-Type")
+                hasContentType = true;
+            evhttp_add_header(req->output_headers, h.name, h.value);
+        }
 
-            String reason;
-            switch (code) {
-                case HTTP_OK:
-                    reason = "OK";
-                    break;
-                case HTTP_BADREQUEST:
-                    reason = "badrequest";
-                    break;
-                case HTTP_BADMETHOD:
-                    reason = "badmethod";
-                    break;
-                case HTTP_NOTFOUND:
-                default:
-                    reason = "notfound";
-                    break;
-            }
+        if (!hasContentType) {
+            if (dynamic_cast<HttpStringContent *>(response.content) != nullptr)
+                evhttp_add_header(req->output_headers, "Content-Type", "text/json; charset=UTF-8");
+        }
 
-            evb = evbuffer_new();
-            auto *streamContent = dynamic_cast<HttpStreamContent *>(response.content);
-            if (streamContent == nullptr) {
-                auto *stringContent = dynamic_cast<HttpStringContent *>(response.content);
-                const String &body = stringContent != nullptr ? stringContent->value() : String::Empty;
-                evbuffer_add(evb, body.c_str(), body.length());
-                evhttp_send_reply(req, code, reason, evb);
+        // process response cookie.
+        if (!response.cookie.isEmpty()) {
+            evhttp_add_header(req->output_headers, "Set-Cookie", response.cookie.toString());
+        }
+
+        String reason;
+        switch (code) {
+            case HTTP_OK:
+                reason = "OK";
+                break;
+            case HTTP_BADREQUEST:
+                reason = "badrequest";
+                break;
+            case HTTP_BADMETHOD:
+                reason = "badmethod";
+                break;
+            case HTTP_NOTFOUND:
+            default:
+                reason = "notfound";
+                break;
+        }
+
+        HttpContent *content = response.content;
+        auto *stringContent = dynamic_cast<HttpStringContent *>(content);
+        auto *bytesContent = dynamic_cast<HttpByteArrayContent *>(content);
+        auto *streamContent = dynamic_cast<HttpStreamContent *>(content);
+        auto *fs = streamContent != nullptr ? dynamic_cast<FileStream *>(streamContent->stream()) : nullptr;
+        bool hasBody = code >= 200 && code != HttpStatus::HttpNoContent && code != HttpStatus::HttpNotModified;
+
+        struct evbuffer *evb = evbuffer_new();
+        if (content == nullptr || !hasBody) {
+            evhttp_send_reply(req, code, reason, evb);
+        } else if (stringContent != nullptr || bytesContent != nullptr) {
+            const void *data = stringContent != nullptr ?
+                               (const void *) stringContent->value().c_str() : bytesContent->value().data();
+            size_t length = stringContent != nullptr ? stringContent->value().length() : bytesContent->value().count();
+            if (length >= ReferenceSize) {
+                // not copied, the job is deleted after the body is sent.
+                evbuffer_add_reference(evb, data, length, reference_cleanup, job);
+                job = nullptr;
             } else {
-                auto *fs = dynamic_cast<FileStream *>(streamContent->stream());
-                if (fs != nullptr && fs->isOpen()) {
-                    int fd = fs->fd();
-                    struct stat st{};
-                    if (fstat(fd, &st) < 0) {
-                        evhttp_send_error(req, HttpStatus::HttpNotFound, "Document was not found");
-                    } else {
-                        evbuffer_add_file(evb, fd, 0, (int32_t) st.st_size);
-                        evhttp_send_reply(req, code, reason, evb);
-                    }
-                } else if (streamContent->stream() != nullptr) {
-                    ByteArray body;
-                    streamContent->stream()->readToEnd(body);
-                    evbuffer_add(evb, body.data(), body.count());
-                    evhttp_send_reply(req, code, reason, evb);
-                }
+                evbuffer_add(evb, data, length);
+            }
+            evhttp_send_reply(req, code, reason, evb);
+        } else if (fs != nullptr && fs->isOpen()) {
+            int fd = fs->fd();
+            struct stat st{};
+            if (fstat(fd, &st) < 0) {
+                evhttp_send_error(req, HttpStatus::HttpNotFound, "Document was not found");
+            } else {
+                evbuffer_add_file(evb, fd, 0, (int32_t) st.st_size);
+                evhttp_send_reply(req, code, reason, evb);
+            }
+        } else {
+            // the other streams and the chunked contents are sent part by part.
+            Stream *stream = streamContent != nullptr ? streamContent->stream() : nullptr;
+            if (stream != nullptr && stream->canSeek() &&
+                evhttp_find_header(req->output_headers, "Content-Length") == nullptr) {
+                // sent without the chunked encoding.
+                int64_t length = Math::max((int64_t) stream->length() - (int64_t) stream->position(), (int64_t) 0);
+                evhttp_add_header(req->output_headers, "Content-Length", Int64(length).toString());
             }
+            evhttp_send_reply_start(req, code, reason);
+            job->streaming = true;
+            evhttp_connection_set_closecb(evhttp_request_get_connection(req), connection_closed_cb, job);
+            readNextChunk(job);
+            job = nullptr;
+        }
+        evbuffer_free(evb);
+        delete job;
+    }
+
+    void HttpServer::readNextChunk(Job *job) {
+        ContextEntry *entry = job->loop->entry;
+        job->working = true;
+        if (entry->workers.empty() || !entry->post(job)) {
+            job->working = false;
+            job->readChunk();
+            sendChunk(job);
+        }
+    }
+
+    void HttpServer::sendChunk(Job *job) {
+        struct evhttp_request *req = job->req;
+        if (job->closed) {
+            // the client is gone while the part is read.
+            if (req != nullptr)
+                evhttp_request_free(req);
+            delete job;
+            return;
         }
 
-        if (decoded)
-            evhttp_uri_free(decoded);
-        if (decoded_path)
-            free(decoded_path);
-        if (evb)
-            evbuffer_free(evb);
+        struct evbuffer *chunk = job->chunk;
+        job->chunk = nullptr;
+        if (evbuffer_get_length(chunk) > 0) {
+            // the next part is read after this one is sent.
+            evhttp_send_reply_chunk_with_cb(req, chunk, chunk_sent_cb, job);
+        } else {
+            evhttp_connection_set_closecb(evhttp_request_get_connection(req), nullptr, nullptr);
+            evhttp_send_reply_end(req);
+            delete job;
+        }
+        evbuffer_free(chunk);
+    }
+
+    void HttpServer::chunk_sent_cb(struct evhttp_connection *, void *arg) {
+        auto job = static_cast<Job *>(arg);
+        assert(job);
+        readNextChunk(job);
+    }
+
+    void HttpServer::connection_closed_cb(struct evhttp_connection *evcon, void *arg) {
+        auto job = static_cast<Job *>(arg);
+        assert(job);
+
+        // the request not replied is detached from the connection and kept,
+        // the others are freed with the connection, e.g. the server is stopping.
+        struct evhttp_request *req = job->req;
+        if (req != nullptr && req->evcon == evcon) {
+            job->req = nullptr;
+        }
+        if (job->working) {
+            // still on a worker, the reply is dropped on the loop.
+            job->closed = true;
+        } else {
+            // the client is gone before the body is sent.
+            if (job->req != nullptr)
+                evhttp_request_free(job->req);
+            delete job;
+        }
+    }
+
+    void HttpServer::reference_cleanup(const void *, size_t, void *arg) {
+        delete static_cast<Job *>(arg);
     }
 
     bool HttpServer::isIllegal(struct evhttp_request *req, const String &str) {
+        if (matchFilter(str.c_str(), str.length())) {
+            returnIllegalInfo(req);
+            return false;
+        }
+        return true;
+    }
+
+    bool HttpServer::isIllegal(struct evhttp_request *req, const HttpBufferContent *content) {
+        // the end of the last part, it is filtered with the start of the next one.
+        String tail;
+        if (!content->peek(&tail, filter_cb)) {
+            returnIllegalInfo(req);
+            return false;
+        }
+        return true;
+    }
+
+    bool HttpServer::matchFilter(const char *str, size_t length) {
         static Regex filterRegex(
                 "\b(and|exec|insert|select|drop|grant|alter|delete|update|count|chr|mid|master|truncate|char|declare|or)\b|(\\*|;|\\+|'|%)");
-        if (filterRegex.isMatch(str)) {
-            returnIllegalInfo(req);
+        return filterRegex.isMatch(str, length);
+    }
+
+    bool HttpServer::filter_cb(void *owner, const uint8_t *data, size_t length) {
+        // longer than the words of the filter.
+        static const size_t JointLength = 16;
+        if (length == 0) {
+            return true;
+        }
+
+        auto tail = static_cast<String *>(owner);
+        if (!tail->isNullOrEmpty()) {
+            String joint = *tail;
+            joint.append((const char *) data, Math::min(length, JointLength));
+            if (matchFilter(joint.c_str(), joint.length())) {
+                return false;
+            }
+        }
+        if (matchFilter((const char *) data, length)) {
             return false;
         }
+        size_t count = Math::min(length, JointLength);
+        *tail = String((const char *) data + length - count, (uint32_t) count);
         return true;
     }
 
@@ -908,7 +908,30 @@ namespace Microservice {
     const HttpHeader Actuator::ContentTypeHeader("Content-Type",
                                                  "application/vnd.spring-boot.actuator.v2+json;charset=UTF-8");
 
-    Actuator::Actuator() = default;
+    HttpStatus IActuator::onServiceRegistry(const HttpRequest &request, HttpResponse &response) {
+        response.setContent("UP");
+        return HttpStatus::HttpOk;
+    }
+
+    Actuator::Actuator() {
+        addRoute("actuator", &Actuator::onActuator);
+        addRoute("actuator/info", &Actuator::onInfo);
+        addRoute("actuator/health", &Actuator::onHealth);
+        addRoute("actuator/metrics", &Actuator::onMetrics);
+        addRoute("actuator/metrics/process.uptime", &Actuator::onProcessUptime);
+        addRoute("actuator/metrics/system.cpu.count", &Actuator::onSystemCPUCount);
+        addRoute("actuator/metrics/process.cpu.usage", &Actuator::onProcessCPUUsage);
+        addRoute("actuator/metrics/system.cpu.usage", &Actuator::onSystemCPUUsage);
+        addRoute("actuator/metrics/jvm.threads.live", &Actuator::onThreadsLive);
+        addRoute("actuator/metrics/jvm.threads.peak", &Actuator::onThreadsPeak);
+        addRoute("actuator/metrics/jvm.threads.daemon", &Actuator::onThreadsDaemon);
+        addRoute("actuator/metrics/jvm.memory.max", &Actuator::onMemoryMax);
+        addRoute("actuator/metrics/jvm.memory.used", &Actuator::onMemoryUsed);
+        addRoute("actuator/metrics/jvm.memory.committed", &Actuator::onMemoryCommitted);
+        addRoute("actuator/env", &Actuator::onEnvironment);
+        addRoute("actuator/env/PID", &Actuator::onProcessId);
+        addRoute("actuator/service-registry", &Actuator::onServiceRegistry);
+    }
 
     Actuator::~Actuator() = default;
 
@@ -974,41 +997,10 @@ namespace Microservice {
 
     HttpStatus Actuator::onAction(const HttpRequest &request, HttpResponse &response) {
         HttpStatus status = HttpStatus::HttpNotFound;
-        if (request.match("actuator")) {
-            status = onActuator(request, response);
-        } else if (request.match("actuator/info")) {
-            status = onInfo(request, response);
-        } else if (request.match("actuator/health")) {
-            status = onHealth(request, response);
-        } else if (request.match("actuator/metrics")) {
-            status = onMetrics(request, response);
-        } else if (request.match("actuator/metrics/process.uptime")) {
-            status = onProcessUptime(request, response);
-        } else if (request.match("actuator/metrics/system.cpu.count")) {
-            status = onSystemCPUCount(request, response);
-        } else if (request.match("actuator/metrics/process.cpu.usage")) {
-            status = onProcessCPUUsage(request, response);
-        } else if (request.match("actuator/metrics/system.cpu.usage")) {
-            status = onSystemCPUUsage(request, response);
-        } else if (request.match("actuator/metrics/jvm.threads.live")) {
-            status = onThreadsLive(request, response);
-        } else if (request.match("actuator/metrics/jvm.threads.peak")) {
-            status = onThreadsPeak(request, response);
-        } else if (request.match("actuator/metrics/jvm.threads.daemon")) {
-            status = onThreadsDaemon(request, response);
-        } else if (request.match("actuator/metrics/jvm.memory.max")) {
-            status = onMemoryMax(request, response);
-        } else if (request.match("actuator/metrics/jvm.memory.used")) {
-            status = onMemoryUsed(request, response);
-        } else if (request.match("actuator/metrics/jvm.memory.committed")) {
-            status = onMemoryCommitted(request, response);
-        } else if (request.match("actuator/env")) {
-            status = onEnvironment(request, response);
-        } else if (request.match("actuator/env/PID")) {
-            status = onProcessId(request, response);
-        } else if (request.match("actuator/service-registry")) {
-            response.setContent("UP");
-            status = HttpStatus::HttpOk;
+        const HttpRouter::Values *values = _router.route(request);
+        if (values != nullptr) {
+            auto callback = (HttpCallback<IActuator> *) values->front();
+            status = callback->execute(request, response);
         }
 
         if (status == HttpStatus::HttpOk) {
@@ -1017,6 +1009,18 @@ namespace Microservice {
         return status;
     }
 
+    void Actuator::addRoute(const String &path, HttpCallback<IActuator>::Method method) {
+        auto callback = new HttpCallback<IActuator>(this, method);
+        _callbacks.add(callback);
+        // all the methods as the match of the path before, the handlers answer the ones they support.
+        const HttpMethod *methods[] = {&HttpMethod::Get, &HttpMethod::Put, &HttpMethod::Post, &HttpMethod::Delete,
+                                       &HttpMethod::Head, &HttpMethod::Options, &HttpMethod::Trace,
+                                       &HttpMethod::Connect, &HttpMethod::Patch};
+        for (const HttpMethod *m: methods) {
+            _router.add(*m, path, callback);
+        }
+    }
+
     HttpStatus Actuator::onAction(void *parameter, const HttpRequest &request, HttpResponse &response) {
         auto service = (Actuator *) parameter;
         assert(service);
@@ -67,6 +67,10 @@ namespace Microservice {
         return _method;
     }
 
+    const String &BaseHttpMapping::path() const {
+        return _path;
+    }
+
     void IHttpRegister::registerWebPath(const String &webPath) {
         ServiceFactory *factory = ServiceFactory::instance();
         assert(factory);
@@ -83,9 +87,16 @@ namespace Microservice {
 
     void IHttpRegister::clearMapping() {
         Locker locker(&_mappingsMutex);
+        _router.clear();
         _mappings.clear();
     }
 
+    void IHttpRegister::addMapping(BaseHttpMapping *mapping) {
+        Locker locker(&_mappingsMutex);
+        _mappings.add(mapping);
+        _router.add(mapping->method(), mapping->path(), mapping);
+    }
+
     void IHttpSession::registerTokenId(const String &tokenId) {
         _tokenId = tokenId;
     }
@@ -148,7 +159,11 @@ namespace Microservice {
             return false;
         }
 
-        HttpServer::Context context(Endpoint("any", serverPort));
+        int loopCount = 1, workerCount = 0;
+        cs->getProperty("server.http.threads.loops", loopCount);
+        cs->getProperty("server.http.threads.workers", workerCount);
+        HttpServer::Context context(Endpoint("any", serverPort), HttpServer::Secure::None,
+                                    TimeSpan::fromSeconds(30), loopCount, workerCount);
         HttpServer::Actions actions(this, onAction);
         if (!_httpServer.startHttpServer(context, actions)) {
             Trace::writeLine("Can not start http server.", Trace::Error);
@@ -158,7 +173,7 @@ namespace Microservice {
         // add http header from yml file.
         static const size_t MaxHeader = 200;
         for (size_t i = 0; i < MaxHeader; i++) {
-            const String prefix = String::format("server.http.headers[%d]", i);
+            const String prefix = String::format("server.http.headers[%d]", (int) i);
             const String k = String::format("%s.name", prefix.c_str());
             const String v = String::format("%s.value", prefix.c_str());
             String key, value;
@@ -182,7 +197,7 @@ namespace Microservice {
         // ext mine types.
         static const size_t MaxTypes = 200;
         for (size_t i = 0; i < MaxTypes; i++) {
-            const String prefix = String::format("server.http.mineTypes[%d]", i);
+            const String prefix = String::format("server.http.mineTypes[%d]", (int) i);
             const String k = String::format("%s.extName", prefix.c_str());
             const String v = String::format("%s.type", prefix.c_str());
             String key, value;
@@ -279,9 +294,14 @@ namespace Microservice {
     }
 
     HttpStatus HttpService::onActionProcess(const HttpRequest &request, HttpResponse &response) {
-        Locker locker(&_actionsMutex);
-        for (size_t i = 0; i < _actions.count(); i++) {
-            IHttpAction *action = _actions[i];
+        // the actions run without the lock, a slow one does not block the others.
+        HttpActions actions(false);
+        {
+            Locker locker(&_actionsMutex);
+            actions.addRange(_actions);
+        }
+        for (size_t i = 0; i < actions.count(); i++) {
+            IHttpAction *action = actions[i];
             HttpStatus status = action->onAction(request, response);
             if (status != HttpStatus::HttpNotFound)
                 return status;
@@ -290,19 +310,27 @@ namespace Microservice {
     }
 
     HttpStatus HttpService::onMappingProcess(const HttpRequest &request, HttpResponse &response) {
-        Locker locker(&_mappingsMutex);
-        for (size_t i = 0; i < _mappings.count(); i++) {
-            BaseHttpMapping *mapping = _mappings[i];
-            if (mapping->match(request)) {
-                if (mapping->method() == HttpMethod::Options) {
-                    return HttpStatus::HttpOk;
-                } else {
-                    HttpStatus status = mapping->execute(request, response);
-                    if (status != HttpStatus::HttpNotFound)
-                        return status;
+        // the matched mappings are copied, they run without the lock.
+        HttpMappings mappings;
+        {
+            Locker locker(&_mappingsMutex);
+            const HttpRouter::Values *values = _router.route(request);
+            if (values != nullptr) {
+                for (void *value: *values) {
+                    mappings.add(((const BaseHttpMapping *) value)->clone());
                 }
             }
         }
+        for (size_t i = 0; i < mappings.count(); i++) {
+            BaseHttpMapping *mapping = mappings[i];
+            if (mapping->method() == HttpMethod::Options) {
+                return HttpStatus::HttpOk;
+            } else {
+                HttpStatus status = mapping->execute(request, response);
+                if (status != HttpStatus::HttpNotFound)
+                    return status;
+            }
+        }
         return HttpStatus::HttpNotFound;
     }
 
@@ -538,7 +538,7 @@ namespace Microservice {
                             _loginTimer->change(_accessToken.tokenTtl * 1000);
                         }
                     } else {
-                        Trace::error(String::format("Failed to parse access token'%s'!", LoginUrl,
+                        Trace::error(String::format("Failed to parse access token'%s'!",
                                                     content->value().toString().c_str()));
                     }
                 } else {
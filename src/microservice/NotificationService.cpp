@@ -26,13 +26,9 @@ namespace Microservice {
     }
 
     HttpNotification::HttpNotification(const Url &url) : BaseNotification(NotificationType::Http), _url(url) {
-        if (!_url.isEmpty())
-            _webClient.start();
     }
 
-    HttpNotification::~HttpNotification() {
-        _webClient.stop();
-    }
+    HttpNotification::~HttpNotification() = default;
 
     void HttpNotification::push(const String &key, const String &value) {
         if (!_url.isEmpty())
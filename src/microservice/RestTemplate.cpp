@@ -18,7 +18,7 @@ namespace Microservice {
     RestTemplate::RestTemplate() = default;
 
     bool RestTemplate::get(const String &url, String &result, const HttpHeaders &headers) {
-        Locker locker(&_clientMutex);
+        // the client is thread safe, the requests are sent concurrently.
         return _client.get(parseUrl(url), headers, result);
     }
 
@@ -29,7 +29,7 @@ namespace Microservice {
     }
 
     bool RestTemplate::post(const String &url, const String &body, String &result, const HttpHeaders &headers) {
-        Locker locker(&_clientMutex);
+        // the client is thread safe, the requests are sent concurrently.
         return _client.post(parseUrl(url), headers, body, result);
     }
 
@@ -41,7 +41,7 @@ namespace Microservice {
 
     bool
     RestTemplate::RestTemplate::put(const String &url, const String &body, String &result, const HttpHeaders &headers) {
-        Locker locker(&_clientMutex);
+        // the client is thread safe, the requests are sent concurrently.
         return _client.put(parseUrl(url), headers, body, result);
     }
 
@@ -52,6 +52,7 @@ namespace Microservice {
     }
 
     Url RestTemplate::parseUrl(const String &original) {
+        Locker locker(&_clientMutex);
         ServiceFactory *factory = ServiceFactory::instance();
         assert(factory);
         auto service = factory->getService<LoadBalancerClient>();
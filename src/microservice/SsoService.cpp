@@ -410,8 +410,8 @@ namespace Microservice {
         static const uint32_t maxUserCount = 8;
         bool correct = false;
         for (size_t i = 0; i < maxUserCount; i++) {
-            cs->getProperty(String::format(SecurityPrefix "users[%d].name", i), oname);
-            cs->getProperty(String::format(SecurityPrefix "users[%d].password", i), opassword);
+            cs->getProperty(String::format(SecurityPrefix "users[%d].name", (int) i), oname);
+            cs->getProperty(String::format(SecurityPrefix "users[%d].password", (int) i), opassword);
             correct = name == oname && password == opassword;
             if (correct)
                 break;
@@ -503,7 +503,7 @@ namespace Microservice {
         static const uint32_t maxUserCount = 8;
         bool correct = false;
         for (size_t i = 0; i < maxUserCount; i++) {
-            cs->getProperty(String::format(SecurityPrefix "users[%d].name", i), oname);
+            cs->getProperty(String::format(SecurityPrefix "users[%d].name", (int) i), oname);
             correct = name == oname;
             if (correct)
                 break;
@@ -589,11 +589,11 @@ namespace Microservice {
         static const uint32_t maxUserCount = 8;
         bool correct = false;
         for (size_t i = 0; i < maxUserCount; i++) {
-            cs->getProperty(String::format(SecurityPrefix "users[%d].name", i), oname);
-            cs->getProperty(String::format(SecurityPrefix "users[%d].password", i), opassword);
+            cs->getProperty(String::format(SecurityPrefix "users[%d].name", (int) i), oname);
+            cs->getProperty(String::format(SecurityPrefix "users[%d].password", (int) i), opassword);
             correct = name == oname && oldPassword == opassword;
             if (correct) {
-                key = String::format(SecurityPrefix "users[%d].password", i);
+                key = String::format(SecurityPrefix "users[%d].password", (int) i);
                 break;
             }
         }
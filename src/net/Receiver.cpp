@@ -18,6 +18,152 @@ using namespace Diag;
 using namespace System;
 
 namespace Net {
+    ReceiveBuffer::ReceiveBuffer(size_t capacity) : _array(nullptr), _capacity(capacity), _front(0), _count(0) {
+    }
+
+    ReceiveBuffer::~ReceiveBuffer() {
+        delete[] _array;
+        _array = nullptr;
+    }
+
+    size_t ReceiveBuffer::count() const {
+        return _count;
+    }
+
+    bool ReceiveBuffer::isEmpty() const {
+        return _count == 0;
+    }
+
+    size_t ReceiveBuffer::capacity() const {
+        return _capacity;
+    }
+
+    uint8_t ReceiveBuffer::at(size_t pos) const {
+        if (pos < _count) {
+            size_t index = _front + pos;
+            return _array[index < _capacity ? index : index - _capacity];
+        }
+        return 0;
+    }
+
+    ssize_t ReceiveBuffer::find(const uint8_t *bytes, size_t length, size_t from) const {
+        if (bytes == nullptr || length == 0) {
+            return -1;
+        }
+
+        for (size_t i = from; i + length <= _count; i++) {
+            size_t j = 0;
+            while (j < length && at(i + j) == bytes[j]) {
+                j++;
+            }
+            if (j == length) {
+                return (ssize_t) i;
+            }
+        }
+        return -1;
+    }
+
+    size_t ReceiveBuffer::read(uint8_t *data, size_t count) {
+        if (data == nullptr) {
+            return 0;
+        }
+
+        count = Math::min(count, _count);
+        if (count > 0) {
+            size_t n = Math::min(count, _capacity - _front);
+            memcpy(data, _array + _front, n);
+            memcpy(data + n, _array, count - n);
+        }
+        return skip(count);
+    }
+
+    size_t ReceiveBuffer::read(ByteArray *buffer, size_t count) {
+        if (buffer == nullptr) {
+            return 0;
+        }
+
+        count = Math::min(count, _count);
+        if (count > 0) {
+            size_t n = Math::min(count, _capacity - _front);
+            buffer->addRange(_array + _front, n);
+            buffer->addRange(_array, count - n);
+        }
+        return skip(count);
+    }
+
+    size_t ReceiveBuffer::skip(size_t count) {
+        count = Math::min(count, _count);
+        _count -= count;
+        _front = _count == 0 ? 0 : (_front + count) % _capacity;
+        return count;
+    }
+
+    size_t ReceiveBuffer::write(const uint8_t *data, size_t count) {
+        if (data == nullptr || count == 0) {
+            return 0;
+        }
+
+        reserve(_count + count);
+        size_t rear = (_front + _count) % _capacity;
+        size_t n = Math::min(count, _capacity - rear);
+        memcpy(_array + rear, data, n);
+        memcpy(_array, data + n, count - n);
+        _count += count;
+        return count;
+    }
+
+    ssize_t ReceiveBuffer::receive(Receiver *receiver, size_t count) {
+        if (receiver == nullptr || count == 0) {
+            return 0;
+        }
+
+        // read into the free space directly, at most two contiguous parts.
+        reserve(_count + count);
+        ssize_t received = 0;
+        while (count > 0) {
+            size_t rear = (_front + _count) % _capacity;
+            size_t n = Math::min(count, rear >= _front ? _capacity - rear : _front - rear);
+            ssize_t length = receiver->receiveInner(_array, (off_t) rear, n);
+            if (length <= 0) {
+                break;
+            }
+            length = Math::min(length, (ssize_t) n);
+            _count += length;
+            received += length;
+            count -= length;
+            if ((size_t) length < n) {
+                break;
+            }
+        }
+        return received;
+    }
+
+    void ReceiveBuffer::clear() {
+        _front = _count = 0;
+    }
+
+    void ReceiveBuffer::reserve(size_t capacity) {
+        if (_array == nullptr) {
+            _capacity = Math::max(_capacity, capacity);
+            _array = new uint8_t[_capacity];
+            return;
+        }
+        if (capacity > _capacity) {
+            size_t newCapacity = _capacity;
+            while (newCapacity < capacity) {
+                newCapacity *= 2;
+            }
+            auto array = new uint8_t[newCapacity];
+            size_t n = Math::min(_count, _capacity - _front);
+            memcpy(array, _array + _front, n);
+            memcpy(array + n, _array, _count - n);
+            delete[] _array;
+            _array = array;
+            _capacity = newCapacity;
+            _front = 0;
+        }
+    }
+
     Receiver::Receiver() = default;
 
     Receiver::~Receiver() = default;
@@ -51,12 +197,15 @@ namespace Net {
         if (count > 0 && count <= 20 * 1024 * 1024)  // 20M
         {
             buffer.clear();
-            auto temp = new uint8_t[count];
-            memset(temp, 0, count);
-            ssize_t length = 0, totalLength = 0;
+            ssize_t totalLength = (ssize_t) _buffer.read(&buffer, count);
+            if (totalLength >= (ssize_t) count) {
+                return totalLength;
+            }
 
+            auto temp = new uint8_t[count];
+            ssize_t length = 0;
             do {
-                length = receive(temp, 0, count);
+                length = receive(temp, 0, count - totalLength);
                 if (length > 0 && length <= (ssize_t) count) {
                     buffer.addRange(temp, length);
                     totalLength += length;
@@ -151,61 +300,46 @@ namespace Net {
         }
 
         if (!useReceiveTimeout()) {
-            uint32_t received = 0;
             if (connected()) {
+                size_t received = 0;
                 bool bReceiveEndBytes = false;
-                int nSuffix = 0, nStartByte = 0;
+                int nSuffix = 0;
+                size_t nStartByte = 0;
                 uint32_t startTime = TickTimeout::getCurrentTickCount();
                 uint32_t deadTime = TickTimeout::getDeadTickCount(startTime, timeout);
                 do {
-                    if (bReceiveEndBytes && nSuffix >= suffix)
-                        break;
-                    size_t nBytesToRead = this->available();
-                    if (nBytesToRead <= 0) {
-                        Thread::msleep(1);
-                        if (TickTimeout::isTimeout(startTime, deadTime))
-                            break;
-                        continue;
-                    }
-                    if (received + 1 <= (uint32_t) bufferLength) {
-                        received += this->receive(buffer, received, 1);
-                    } else {
-                        return received;
-                    }
-
-                    if (!bReceiveEndBytes) {
-//#ifdef DEBUG
-//                        if (received - 1 > (uint32_t)bufferLength || nStartByte > ebLength)
-//                        {
-//                            Debug::writeFormatLine("nStartByte: %d, received: %d", nStartByte, received);
-//                            ByteArray sBuffer(buffer, received);
-//                            Debug::writeLine(sBuffer.toString());
-//                        }
-//#endif
-                        if (buffer[received - 1] == endBuffer[nStartByte]) {
-                            nStartByte++;
-                            if (nStartByte == ebLength) {
-                                bReceiveEndBytes = true;
-                            }
-                        } else {
-                            if (nStartByte == 0) {
-                                continue;
-                            }
+                    // match the end bytes in memory, only the bytes of this frame are taken from the buffer.
+                    while (!(bReceiveEndBytes && nSuffix >= suffix) && received < _buffer.count()) {
+                        if (received + 1 > bufferLength) {
+                            return (ssize_t) _buffer.read(buffer, received);
+                        }
 
-                            nStartByte = 0;
-                            if (buffer[received - 1] == endBuffer[nStartByte]) {
+                        uint8_t value = _buffer.at(received++);
+                        if (!bReceiveEndBytes) {
+                            if (value == endBuffer[nStartByte]) {
                                 nStartByte++;
+                                if (nStartByte == ebLength) {
+                                    bReceiveEndBytes = true;
+                                }
+                            } else if (nStartByte > 0) {
+                                nStartByte = value == endBuffer[0] ? 1 : 0;
                             }
+                        } else {
+                            nSuffix++;
                         }
-                    } else {
-                        nSuffix++;
                     }
+                    if (bReceiveEndBytes && nSuffix >= suffix)
+                        break;
 
-                    deadTime = TickTimeout::getDeadTickCount(timeout);
+                    if (receiveToBuffer(startTime, deadTime) > 0) {
+                        deadTime = TickTimeout::getDeadTickCount(timeout);
+                    } else if (TickTimeout::isTimeout(startTime, deadTime)) {
+                        break;
+                    }
                 } while (true);
-                return received;
+                return (ssize_t) _buffer.read(buffer, received);
             }
-            return received;
+            return 0;
         } else {
             uint32_t received = 0;
             if (connected()) {
@@ -296,25 +430,22 @@ namespace Net {
             if (endBuffer.count() == 0)
                 return 0;
 
+            // the data stays in the buffer, so the caller can receive the frame by this length.
+            size_t from = 0;
             uint32_t startTime = TickTimeout::getCurrentTickCount();
             uint32_t deadTime = TickTimeout::getDeadTickCount(startTime, timeout);
             do {
-                if (TickTimeout::isTimeout(startTime, deadTime))
+                ssize_t position = _buffer.find(endBuffer.data(), endBuffer.count(), from);
+                if (position >= 0) {
+                    received = position + (ssize_t) endBuffer.count();
                     break;
-
-                size_t nBytesToRead = this->available();
-                if (nBytesToRead > 0) {
-                    ByteArray tempBuffer;
-                    receiveBySizeWithoutEscape(&tempBuffer, nBytesToRead, timeout);
-                    //                Debug::writeFormatLine("tempBuffer, count: %d, buffer: %s", tempBuffer.count(), tempBuffer.toString().c_str());
-                    received = tempBuffer.find(endBuffer);
-                    if (received > 0) {
-                        received += (ssize_t) endBuffer.count();
-                        break;
-                    }
+                }
+                if (_buffer.count() >= endBuffer.count()) {
+                    from = _buffer.count() - endBuffer.count() + 1;
                 }
 
-                Thread::msleep(10);
+                if (receiveToBuffer(startTime, deadTime) == 0 && TickTimeout::isTimeout(startTime, deadTime))
+                    break;
             } while (true);
         }
         return received;
@@ -369,15 +500,16 @@ namespace Net {
             ssize_t received = 0;
             uint32_t startByte = 0;
             do {
-                size_t available = this->available();
-                if (available <= 0) {
-                    Thread::msleep(1);
-                    if (TickTimeout::isTimeout(startTime, deadTime))
+                if (_buffer.isEmpty()) {
+                    if (receiveToBuffer(startTime, deadTime) > 0) {
+                        deadTime = TickTimeout::getDeadTickCount(timeout);
+                    } else if (TickTimeout::isTimeout(startTime, deadTime)) {
                         break;
+                    }
                     continue;
                 }
                 if (received + 1 <= (ssize_t) bufferLength) {
-                    received += this->receive(buffer, received + offset, 1);
+                    received += (ssize_t) _buffer.read(buffer + received + offset, 1);
                 } else {
                     return received;
                 }
@@ -400,7 +532,6 @@ namespace Net {
                 if (received >= (ssize_t) count && startByte <= 0) {
                     return received;
                 }
-                deadTime = TickTimeout::getDeadTickCount(timeout);
             } while (true);
             return received;
         } else {
@@ -447,30 +578,21 @@ namespace Net {
             uint32_t startTime = TickTimeout::getCurrentTickCount();
             uint32_t deadTime = TickTimeout::getDeadTickCount(startTime, timeout);
 
-            size_t available = this->available();
-            bool dataReady = false;
-            do {
-                if (this->available() >= count) {
-                    dataReady = true;
-                    break;
-                }
-                uint32_t now = TickTimeout::getCurrentTickCount();
-                if (this->available() == available) {
-                    Thread::msleep(1);
-                    if (TickTimeout::isTimeout(startTime, deadTime, now))
-                        break;
-                } else {
-                    available = this->available();
-                    deadTime = TickTimeout::getDeadTickCount(now, timeout);
+            size_t received = _buffer.read(buffer + offset, count);
+            while (received < count) {
+                if (waitUntil(startTime, deadTime)) {
+                    size_t length = Math::min(count - received, availableInner());
+                    ssize_t readCount = length > 0 ? receiveInner(buffer, offset + (off_t) received, length) : 0;
+                    if (readCount > 0) {
+                        received += readCount;
+                        deadTime = TickTimeout::getDeadTickCount(timeout);
+                        continue;
+                    }
                 }
-            } while (true);
-
-            if (this->available() > 0) {
-                return dataReady
-                       ? this->receive(buffer, offset, count)
-                       : this->receive(buffer, offset, Math::min(this->available(), bufferLength));
+                if (TickTimeout::isTimeout(startTime, deadTime))
+                    break;
             }
-            return 0;
+            return (ssize_t) received;
         } else {
             return this->receive(buffer, offset, count, timeout);
         }
@@ -485,28 +607,21 @@ namespace Net {
             uint32_t deadTime = TickTimeout::getDeadTickCount(startTime, timeout);
 
             uint8_t temp[BufferLength];
-            memset(temp, 0, sizeof(temp));
-            size_t readCount = 0;
-            size_t totalCount = 0;
-            size_t singleReceiveCount = 0;
-            do {
-                size_t available = this->available();
-                if (available > 0) {
-                    singleReceiveCount = Math::min(count - totalCount, BufferLength);
-                    singleReceiveCount = Math::min(singleReceiveCount, available);
-                    readCount = this->receive(temp, 0, singleReceiveCount);
-
+            size_t totalCount = _buffer.read(buffer, count);
+            while (totalCount < count) {
+                if (waitUntil(startTime, deadTime)) {
+                    size_t singleReceiveCount = Math::min(count - totalCount, BufferLength);
+                    singleReceiveCount = Math::min(singleReceiveCount, availableInner());
+                    ssize_t readCount = singleReceiveCount > 0 ? receiveInner(temp, 0, singleReceiveCount) : 0;
                     if (readCount > 0) {
                         buffer->addRange(temp, readCount);
                         totalCount += readCount;
+                        continue;
                     }
                 }
-
                 if (TickTimeout::isTimeout(startTime, deadTime))
                     break;
-
-                Thread::msleep(1);
-            } while (readCount >= 0 && totalCount < count);
+            }
             return totalCount == count ? (ssize_t) totalCount : 0;
         } else {
             return this->receive(buffer, count, timeout);
@@ -518,11 +633,13 @@ namespace Net {
             return 0;
 
         uint8_t temp[BufferLength];
-        memset(temp, 0, sizeof(temp));
         ssize_t readCount = 0;
-        ssize_t totalCount = 0;
+        auto totalCount = (ssize_t) _buffer.read(buffer, count);
+        if (totalCount >= (ssize_t) count) {
+            return totalCount;
+        }
         do {
-            readCount = this->receive(temp, 0, Math::min(count - (size_t) totalCount, BufferLength));
+            readCount = receiveInner(temp, 0, Math::min(count - (size_t) totalCount, BufferLength));
             if (readCount > 0) {
                 buffer->addRange(temp, readCount);
                 totalCount += readCount;
@@ -532,6 +649,8 @@ namespace Net {
     }
 
     void Receiver::clearReceiveBuffer() {
+        _buffer.clear();
+
         if (!useReceiveTimeout()) {
             size_t available = this->available();
             if (available > 0) {
@@ -547,4 +666,53 @@ namespace Net {
             receiveBySizeWithoutEscape(buffer, sizeof(buffer), 0, sizeof(buffer), 2);    // ms
         }
     }
+
+    bool Receiver::waitAvailable(uint32_t timeout) {
+        // no readiness notification in general.
+        return pollAvailable(timeout, hasAvailable, this);
+    }
+
+    size_t Receiver::bufferedCount() const {
+        return _buffer.count();
+    }
+
+    bool Receiver::pollAvailable(uint32_t timeout, delay_callback available, void *owner) {
+        return TickTimeout::msdelay(timeout, available, owner, 1);
+    }
+
+    bool Receiver::hasAvailable(void *parameter) {
+        auto receiver = static_cast<Receiver *>(parameter);
+        assert(receiver);
+        return receiver->available() > 0;
+    }
+
+    size_t Receiver::availableInner() {
+        return available();
+    }
+
+    ssize_t Receiver::receiveInner(uint8_t *buffer, off_t offset, size_t count) {
+        return receive(buffer, offset, count);
+    }
+
+    bool Receiver::waitAvailableInner(uint32_t timeout) {
+        return waitAvailable(timeout);
+    }
+
+    size_t Receiver::receiveFromBuffer(uint8_t *buffer, size_t count) {
+        return _buffer.read(buffer, count);
+    }
+
+    bool Receiver::waitUntil(uint32_t startTime, uint32_t deadTime) {
+        uint32_t now = TickTimeout::getCurrentTickCount();
+        return waitAvailableInner(
+                TickTimeout::isTimeout(startTime, deadTime, now) ? 0 : TickTimeout::elapsed(now, deadTime));
+    }
+
+    size_t Receiver::receiveToBuffer(uint32_t startTime, uint32_t deadTime) {
+        if (waitUntil(startTime, deadTime)) {
+            ssize_t length = _buffer.receive(this, Math::min(availableInner(), BufferLength));
+            return length > 0 ? (size_t) length : 0;
+        }
+        return 0;
+    }
 }
@@ -129,7 +129,12 @@ namespace Net {
     }
 
     ssize_t TcpClient::receive(uint8_t *buffer, off_t offset, size_t count) {
-        return read(buffer + offset, count);
+        // the bytes read ahead are returned at first.
+        size_t length = receiveFromBuffer(buffer + offset, count);
+        if (length > 0) {
+            return (ssize_t) length;
+        }
+        return receiveInner(buffer, offset, count);
     }
 
     ssize_t TcpClient::receive(uint8_t *buffer, off_t offset, size_t count, uint32_t timeout) {
@@ -353,6 +358,19 @@ namespace Net {
     }
 
     size_t TcpClient::available() {
+        // the bytes read ahead past the last frame are counted.
+        return bufferedCount() + availableInner();
+    }
+
+    bool TcpClient::waitAvailable(uint32_t timeout) {
+        return bufferedCount() > 0 || waitAvailableInner(timeout);
+    }
+
+    ssize_t TcpClient::receiveInner(uint8_t *buffer, off_t offset, size_t count) {
+        return read(buffer + offset, count);
+    }
+
+    size_t TcpClient::availableInner() {
         if (_socket != -1) {
             u_long argp = 0;
             if (ioctl(_socket, FIONREAD, &argp) == 0) {
@@ -362,6 +380,14 @@ namespace Net {
         return 0;
     }
 
+    bool TcpClient::waitAvailableInner(uint32_t timeout) {
+        if (availableInner() > 0) {
+            return true;
+        }
+        // the socket is readable with nothing available when the peer has been closed.
+        return isReadSet(timeout) && availableInner() > 0;
+    }
+
     ssize_t TcpClient::write(const uint8_t *data, size_t count) {
         if (_socket != -1) {
             ssize_t length = ::send(_socket, (const char *) data, (int) count, 0);
@@ -467,6 +493,16 @@ namespace Net {
         return false;
     }
 
+    bool TcpClient::isReadSet(uint32_t timeout) const {
+        if (_socket != -1) {
+            struct pollfd pfd_read{};
+            pfd_read.fd = _socket;
+            pfd_read.events = POLLIN;
+            return poll(&pfd_read, 1, (int) timeout) == 1;
+        }
+        return false;
+    }
+
     void TcpClient::initializeSocket() {
         static bool initSocket = false;
         if (!initSocket) {
@@ -1075,12 +1111,12 @@ namespace Net {
         return 0;
     }
 
-    size_t TcpSSLClient::available() {
+    size_t TcpSSLClient::availableInner() {
         size_t available = 0;
         if (_ssl != nullptr) {
             available = SSL_pending((SSL *) _ssl);
             if (available == 0)
-                return TcpClient::available();
+                return TcpClient::availableInner();
         }
         return available;
     }
@@ -1235,13 +1271,13 @@ namespace Net {
         _decoding = true;
     }
 
-    size_t WebSocketClient::available() {
+    size_t WebSocketClient::availableInner() {
         if (_buffer.count() > 0 &&
             _position >= 0 && _position < (int) _buffer.count()) {
             size_t bufferCount = _buffer.count() - _position;
             return bufferCount + 6;     // buffer count + header count
         }
-        return TcpClient::available();
+        return TcpClient::availableInner();
     }
 
     void WebSocketClient::clearReceiveBuffer() {
@@ -1571,13 +1607,13 @@ namespace Net {
         return _isClosing;
     }
 
-    size_t WebSocketSSLClient::available() {
+    size_t WebSocketSSLClient::availableInner() {
         if (_buffer.count() > 0 &&
             _position >= 0 && _position < (off_t) _buffer.count()) {
             size_t bufferCount = _buffer.count() - _position;
             return bufferCount + 6;     // buffer count + header count
         }
-        return TcpSSLClient::available();
+        return TcpSSLClient::availableInner();
     }
 
     void WebSocketSSLClient::clearReceiveBuffer() {
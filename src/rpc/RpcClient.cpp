@@ -13,21 +13,25 @@
 #include "communication/ClientService.h"
 
 namespace Rpc {
-    RpcClientContext::RpcClientContext(const Endpoint &endpoint) : endpoint(endpoint) {
+    RpcClientContext::RpcClientContext(const Endpoint &endpoint, bool pipelined) : endpoint(endpoint),
+                                                                                   pipelined(pipelined) {
     }
 
-    RpcClientContext::RpcClientContext(const RpcClientContext &other) : RpcClientContext(other.endpoint) {
+    RpcClientContext::RpcClientContext(const RpcClientContext &other) : RpcClientContext(other.endpoint,
+                                                                                         other.pipelined) {
     }
 
     bool RpcClientContext::equals(const RpcClientContext &other) const {
-        return this->endpoint == other.endpoint;
+        return this->endpoint == other.endpoint && this->pipelined == other.pipelined;
     }
 
     void RpcClientContext::evaluates(const RpcClientContext &other) {
         this->endpoint = other.endpoint;
+        this->pipelined = other.pipelined;
     }
 
-    RpcClient::RpcClient(const RpcClientContext &context) : _context(context), _service(nullptr) {
+    RpcClient::RpcClient(const RpcClientContext &context) : _context(context), _service(nullptr),
+                                                            _pipeline(sendBatch, this) {
     }
 
     RpcClient::~RpcClient() {
@@ -61,6 +65,13 @@ namespace Rpc {
         if (_service == nullptr)
             initService();
 
+        if (_context.pipelined) {
+            if (!connected())
+                return RpcStatus(RpcStatus::Disconnected);
+
+            auto timeout = (uint32_t) _service->client().timeout.receive.totalMilliseconds();
+            return _pipeline.invoke(context, request, response, timeout);
+        }
         return RpcSender::invoke(context, request, response);
     }
 
@@ -79,6 +90,14 @@ namespace Rpc {
         return RpcSender::notify(context, info);
     }
 
+    size_t RpcClient::pendingCount() const {
+        return _pipeline.pendingCount();
+    }
+
+    bool RpcClient::onPipelinedResponse(const Uuid &token, Stream *stream) {
+        return _pipeline.complete(token, stream);
+    }
+
     bool RpcClient::sendSync(const RpcMethodContext &context, const RpcSyncRequest &request, RpcSyncResponse &response,
                              const String &name) {
         return _service->sendSync<RpcSyncRequest, RpcSyncResponse, RpcSyncContext>(request, response, name,
@@ -147,6 +166,8 @@ namespace Rpc {
             _service->unInitialize();
             delete _service;
             _service = nullptr;
+
+            _pipeline.cancel();
         }
         return true;
     }
@@ -171,6 +192,9 @@ namespace Rpc {
 
         instructions->add(new RpcNotifyInstruction(new InstructionDescription("RpcNotify", new RpcNotifyContext())));
 
+        instructions->add(new RpcBatchRequestInstruction(
+                new InstructionDescription("RpcBatchRequest", new RpcBatchRequestContext())));
+
         // receiver's instructions.
         instructions->add(
                 new ServerRpcSyncInstruction2(new InstructionDescription("ServerRpcSync", new RpcSyncContext()), cs));
@@ -194,6 +218,21 @@ namespace Rpc {
         assert(cs);
         auto e = dynamic_cast<DeviceStatusEventArgs *>(args);
         assert(e);
-        cs->onServerStatusChanged(e->newStatus == Device::Status::Online);
+        bool online = e->newStatus == Device::Status::Online;
+        if (!online) {
+            // the responses of the pending calls will not come back.
+            cs->_pipeline.cancel();
+        }
+        cs->onServerStatusChanged(online);
+    }
+
+    bool RpcClient::sendBatch(void *owner) {
+        auto cs = static_cast<RpcClient *>(owner);
+        assert(cs);
+        if (cs->_service == nullptr)
+            return false;
+
+        RpcBatchRequest request(&cs->_pipeline);
+        return cs->_service->sendAsync<RpcBatchRequest, RpcBatchRequestContext>(request, "RpcBatchRequest");
     }
 }
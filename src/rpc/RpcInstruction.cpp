@@ -8,8 +8,12 @@
 
 #include "RpcInstruction.h"
 #include "data/Dictionary.h"
+#include "system/Math.h"
 
 namespace Rpc {
+    // the name, the endpoint and the try count of the context, the token and the length of an empty request.
+    static const off_t MinBatchRequestLength = 1 + 1 + 4 + 4 + 16 + 4;
+
     RpcServerEventContainer::RpcServerEventContainer(IRpcServerEvent *receiver) {
         assert(receiver);
         _receiver = receiver;
@@ -66,6 +70,35 @@ namespace Rpc {
         return context;
     }
 
+    RpcBatchRequestContext *RpcReceiverEventContainer::onBatchRequestSetValue(RpcBatchRequestContext *context) {
+        if (context != nullptr) {
+            RpcBatchRequest *request = context->inputData();
+            Stream *stream = context->stream();
+            // the count and the lengths come from the peer, they are bounded by the bytes of the frame.
+            auto end = (off_t) stream->length();
+            off_t remaining = end - stream->position();
+            uint32_t count = remaining > 0 ?
+                             (uint32_t) Math::min((off_t) request->count(), remaining / MinBatchRequestLength) : 0;
+            for (uint32_t i = 0; i < count && stream->position() < end; i++) {
+                RpcMethodContext methodContext;
+                methodContext.read(stream);
+                Uuid token;
+                token.read(stream);
+                uint32_t length = stream->readUInt32();
+                off_t position = stream->position();
+                if (position > end || (off_t) length > end - position) {
+                    Trace::writeFormatLine("Drop a truncated batch request, peer: %s, count: %u, index: %u",
+                                           context->peerEndpoint().toString().c_str(), request->count(), i);
+                    break;
+                }
+                _receiver->onAsyncRequestSetValue(methodContext, stream, token, context->peerEndpoint());
+                // skips the request whatever the method read.
+                stream->seek(position + (off_t) length, SeekBegin);
+            }
+        }
+        return context;
+    }
+
     RpcSenderEventContainer::RpcSenderEventContainer(IRpcSenderEvent *receiver) {
         assert(receiver);
         _receiver = receiver;
@@ -324,6 +357,50 @@ namespace Rpc {
         return false;
     }
 
+    // batch request
+    RpcBatchRequestInstruction::RpcBatchRequestInstruction(InstructionDescription *id)
+            : ElementAInstruction<RpcBatchRequest>(id) {
+    }
+
+    RpcBatchRequestInstruction::~RpcBatchRequestInstruction() = default;
+
+    uint8_t RpcBatchRequestInstruction::command() const {
+        return 0x19;
+    }
+
+    bool RpcBatchRequestInstruction::allowLogMessage() const {
+        return false;
+    }
+
+    ServerRpcBatchRequestInstruction::ServerRpcBatchRequestInstruction(InstructionDescription *id,
+                                                                       IRpcReceiverEvent *receiver)
+            : ServerElementAInstruction<RpcBatchRequest>(id), RpcReceiverEventContainer(receiver) {
+    }
+
+    ServerRpcBatchRequestInstruction::~ServerRpcBatchRequestInstruction() = default;
+
+    uint8_t ServerRpcBatchRequestInstruction::command() const {
+        return 0x19;
+    }
+
+    bool ServerRpcBatchRequestInstruction::allowLogMessage() const {
+        return false;
+    }
+
+    bool ServerRpcBatchRequestInstruction::setCommandBuffer(MemoryStream &ms, ClientContext *context) {
+        auto rcontext = dynamic_cast<RpcBatchRequestContext *>(context);
+        if (rcontext != nullptr) {
+            ms.readByte();    // skip command
+            readVersion(&ms);
+
+            rcontext->inputData()->read(&ms);
+            rcontext->setStream(&ms);
+
+            return onBatchRequestSetValue(rcontext);
+        }
+        return false;
+    }
+
     RpcSyncInstruction2::RpcSyncInstruction2(InstructionDescription *id) : RpcSyncInstruction(id) {
     }
 
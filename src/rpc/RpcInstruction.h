@@ -44,6 +44,8 @@ namespace Rpc {
 
         RpcNotifyContext *onNotifySetValue(RpcNotifyContext *context);
 
+        RpcBatchRequestContext *onBatchRequestSetValue(RpcBatchRequestContext *context);
+
     private:
         IRpcReceiverEvent *_receiver;
     };
@@ -208,6 +210,31 @@ namespace Rpc {
         bool setCommandBuffer(MemoryStream &ms, ClientContext *context) override;
     };
 
+    class RpcBatchRequestInstruction : public ElementAInstruction<RpcBatchRequest> {
+    public:
+        explicit RpcBatchRequestInstruction(InstructionDescription *id);
+
+        ~RpcBatchRequestInstruction() override;
+
+        uint8_t command() const override;
+
+        bool allowLogMessage() const override;
+    };
+
+    class ServerRpcBatchRequestInstruction
+            : public ServerElementAInstruction<RpcBatchRequest>, public RpcReceiverEventContainer {
+    public:
+        ServerRpcBatchRequestInstruction(InstructionDescription *id, IRpcReceiverEvent *receiver);
+
+        ~ServerRpcBatchRequestInstruction() override;
+
+        uint8_t command() const override;
+
+        bool allowLogMessage() const override;
+
+        bool setCommandBuffer(MemoryStream &ms, ClientContext *context) override;
+    };
+
     class RpcSyncInstruction2 : public RpcSyncInstruction {
     public:
         explicit RpcSyncInstruction2(InstructionDescription *id);
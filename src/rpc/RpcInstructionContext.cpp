@@ -7,6 +7,7 @@
 //
 
 #include "rpc/RpcInstructionContext.h"
+#include "rpc/RpcInvoker.h"
 
 namespace Rpc {
     RpcStreamContext::RpcStreamContext() : _stream(nullptr) {
@@ -243,6 +244,30 @@ namespace Rpc {
         return _token;
     }
 
+    RpcBatchRequest::RpcBatchRequest(RpcPipeline *pipeline) : _pipeline(pipeline), _count(0) {
+    }
+
+    void RpcBatchRequest::write(Stream *stream) const {
+        if (_pipeline != nullptr) {
+            _pipeline->drain(stream);
+        } else {
+            stream->writeUInt32(0);
+        }
+    }
+
+    void RpcBatchRequest::read(Stream *stream) {
+        _count = stream->readUInt32();
+    }
+
+    void RpcBatchRequest::copyFrom(const RpcBatchRequest *value) {
+        _pipeline = value->_pipeline;
+        _count = value->_count;
+    }
+
+    uint32_t RpcBatchRequest::count() const {
+        return _count;
+    }
+
     RpcNotifyInfo::RpcNotifyInfo(const RpcMethodContext &context, const IRpcNotifyInfo *info) {
         _context.copyFrom(&context);
         _info = info != nullptr ? info->clone() : nullptr;
@@ -8,6 +8,7 @@
 
 #include "rpc/RpcInvoker.h"
 #include "rpc/RpcInstructionContext.h"
+#include "IO/MemoryStream.h"
 
 namespace Rpc {
     RpcAsyncElement::RpcAsyncElement(const Uuid &token, const IRpcAsyncRequestData *request,
@@ -109,6 +110,142 @@ namespace Rpc {
         return false;
     }
 
+    RpcPipeline::Call::Call(IRpcSyncResponseData *response) : response(response), status(-1) {
+    }
+
+    RpcPipeline::RpcPipeline(schedule_callback action, void *owner) : _action(action), _owner(owner),
+                                                                      _calls(false), _scheduled(false),
+                                                                      _drainCount(0) {
+    }
+
+    RpcPipeline::~RpcPipeline() {
+        cancel();
+    }
+
+    RpcStatus RpcPipeline::invoke(const RpcMethodContext &context, const IRpcSyncRequestData &request,
+                                  IRpcSyncResponseData &response, uint32_t timeout) {
+        Uuid token = Uuid::generate();
+        Call call(&response);
+
+        std::unique_lock<std::mutex> locker(_mutex);
+        // context, token, length and data of the request, appended to the buffer without a copy of it.
+        size_t start = _buffer.count();
+        MemoryStream ms(&_buffer, false);
+        ms.seek((off_t) start, SeekBegin);
+        context.write(&ms);
+        token.write(&ms);
+        off_t lengthPosition = ms.position();
+        ms.writeUInt32(0);
+        request.write(&ms);
+        size_t end = _buffer.count();
+        ms.seek(lengthPosition, SeekBegin);
+        ms.writeUInt32((uint32_t) (end - (size_t) lengthPosition - sizeof(uint32_t)));
+        _requests.push_back({token, end - start});
+        _calls.add(token, &call);
+
+        uint64_t drainCount = _drainCount;
+        if (!_scheduled) {
+            _scheduled = true;
+            locker.unlock();
+            bool scheduled = schedule();
+            locker.lock();
+            if (!scheduled) {
+                // fails this call only, the connection loss cancels all of them, see RpcClient.
+                remove(token);
+                if (_drainCount == drainCount) {
+                    _scheduled = false;
+                }
+                return RpcStatus(RpcStatus::CommError);
+            }
+        }
+
+        if (!call.condition.wait_for(locker, std::chrono::milliseconds(timeout),
+                                     [&call] { return call.status >= 0; })) {
+            remove(token);
+            if (_drainCount == drainCount) {
+                // the batch request was not sent, so the next call queues another one.
+                _scheduled = false;
+            }
+            return RpcStatus(RpcStatus::CommError);
+        }
+        return RpcStatus(call.status);
+    }
+
+    void RpcPipeline::drain(Stream *stream) {
+        bool remaining;
+        {
+            std::lock_guard<std::mutex> locker(_mutex);
+            size_t count = 0, length = 0;
+            while (count < _requests.size() &&
+                   (count == 0 || length + _requests[count].length <= MaxBatchLength)) {
+                length += _requests[count].length;
+                count++;
+            }
+            stream->writeUInt32((uint32_t) count);
+            stream->write(_buffer.data(), 0, length);
+
+            // the capacity of the buffer is kept for the next requests.
+            _buffer.removeRange(0, length);
+            _requests.erase(_requests.begin(), _requests.begin() + (ssize_t) count);
+            _drainCount++;
+            remaining = !_requests.empty();
+            _scheduled = remaining;
+        }
+        if (remaining && !schedule()) {
+            // the remaining requests are sent by the batch of the next call, or time out.
+            std::lock_guard<std::mutex> locker(_mutex);
+            _scheduled = false;
+        }
+    }
+
+    bool RpcPipeline::complete(const Uuid &token, Stream *stream) {
+        std::lock_guard<std::mutex> locker(_mutex);
+        Call *call = nullptr;
+        if (_calls.at(token, call)) {
+            call->response->read(stream);
+            call->status = RpcStatus::Ok;
+            _calls.remove(token);
+            call->condition.notify_one();
+            return true;
+        }
+        return false;
+    }
+
+    void RpcPipeline::cancel() {
+        std::lock_guard<std::mutex> locker(_mutex);
+        for (auto it = _calls.begin(); it != _calls.end(); ++it) {
+            Call *call = it.value();
+            call->status = RpcStatus::CommError;
+            call->condition.notify_one();
+        }
+        _calls.clear();
+        _buffer.removeRange(0, _buffer.count());
+        _requests.clear();
+        _scheduled = false;
+    }
+
+    size_t RpcPipeline::pendingCount() const {
+        std::lock_guard<std::mutex> locker(_mutex);
+        return _calls.count();
+    }
+
+    void RpcPipeline::remove(const Uuid &token) {
+        _calls.remove(token);
+        size_t offset = 0;
+        for (auto it = _requests.begin(); it != _requests.end(); ++it) {
+            if (it->token == token) {
+                _buffer.removeRange(offset, it->length);
+                _requests.erase(it);
+                break;
+            }
+            offset += it->length;
+        }
+    }
+
+    bool RpcPipeline::schedule() {
+        return _action != nullptr && _action(_owner);
+    }
+
     IRpcSenderEvent::IRpcSenderEvent() = default;
 
     IRpcSenderEvent::~IRpcSenderEvent() = default;
@@ -174,6 +311,10 @@ namespace Rpc {
     }
 
     bool RpcSender::onAsyncResponseSetValue(const RpcMethodContext &context, Stream *stream, const Uuid &token) {
+        if (onPipelinedResponse(token, stream)) {
+            return true;
+        }
+
         _asyncElementsMutex.lock();
         RpcAsyncElement *element = nullptr;
         if (_asyncElements.at(token, element)) {
@@ -192,6 +333,10 @@ namespace Rpc {
         return false;
     }
 
+    bool RpcSender::onPipelinedResponse(const Uuid &token, Stream *stream) {
+        return false;
+    }
+
     IRpcReceiverEvent::IRpcReceiverEvent() = default;
 
     IRpcReceiverEvent::~IRpcReceiverEvent() = default;
@@ -212,9 +357,12 @@ namespace Rpc {
         if (_methods.at(context.name, m) && (method = dynamic_cast<RpcSyncMethod *>(m)) != nullptr) {
             sync_callback action = method->action;
             if (action != nullptr) {
-                method->request->read(stream);
-                action(method->owner, method->request, method->response);
+                // the registered data are the prototypes, so the calls do not see the values of each other.
+                IRpcSyncRequestData *request = method->request->clone();
+                request->read(stream);
                 response = method->response->clone();
+                action(method->owner, request, response);
+                delete request;
                 return true;
             }
         }
@@ -224,22 +372,45 @@ namespace Rpc {
     bool RpcReceiver::onAsyncRequestSetValue(const RpcMethodContext &context, Stream *stream, const Uuid &token,
                                              const Endpoint &peerEndpoint) {
         RpcMethod *m = nullptr;
+        if (!_methods.at(context.name, m)) {
+            return false;
+        }
+
+        // the pipelined calls of the sync methods come as the async requests.
+        IRpcData *result;
+        async_callback action;
+        void *owner;
         RpcAsyncMethod *method;
-        if (_methods.at(context.name, m) && (method = dynamic_cast<RpcAsyncMethod *>(m)) != nullptr) {
-            async_callback action = method->action;
-            if (action != nullptr) {
-                method->request->read(stream);
-                action(method->owner, method->request, method->response);
-
-                // send async response.
-                if (connected()) {
-                    RpcAsyncResponse response(context, token, method->response);
-                    return sendAsync(peerEndpoint, response, "RpcAsyncResponse");
-//                    return _service->sendAsync<RpcAsyncResponse, RpcAsyncResponseContext>(peerEndpoint, response, "RpcAsyncResponse");
-                }
+        RpcSyncMethod *syncMethod;
+        if ((method = dynamic_cast<RpcAsyncMethod *>(m)) != nullptr) {
+            result = method->response;
+            action = method->action;
+            owner = method->owner;
+        } else if ((syncMethod = dynamic_cast<RpcSyncMethod *>(m)) != nullptr) {
+            result = syncMethod->response;
+            action = syncMethod->action;
+            owner = syncMethod->owner;
+        } else {
+            return false;
+        }
+
+        bool sent = false;
+        if (action != nullptr) {
+            IRpcAsyncRequestData *request = m->request->clone();
+            request->read(stream);
+            result = result->clone();
+            action(owner, request, result);
+
+            // send async response.
+            if (connected()) {
+                RpcAsyncResponse response(context, token, result);
+                sent = sendAsync(peerEndpoint, response, "RpcAsyncResponse");
+//                sent = _service->sendAsync<RpcAsyncResponse, RpcAsyncResponseContext>(peerEndpoint, response, "RpcAsyncResponse");
             }
+            delete request;
+            delete result;
         }
-        return false;
+        return sent;
     }
 
     bool RpcReceiver::onNotifySetValue(const RpcMethodContext &context, Stream *stream, IRpcNotifyInfo *info) {
@@ -248,8 +419,10 @@ namespace Rpc {
         if (_methods.at(context.name, m) && (method = dynamic_cast<RpcNotifyMethod *>(m)) != nullptr) {
             notify_callback action = method->action;
             if (action != nullptr) {
-                method->request->read(stream);
-                action(method->owner, method->request);
+                IRpcNotifyInfo *request = method->request->clone();
+                request->read(stream);
+                action(method->owner, request);
+                delete request;
                 return true;
             }
         }
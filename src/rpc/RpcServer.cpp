@@ -146,6 +146,8 @@ namespace Rpc {
                 new InstructionDescription("ServerRpcAsyncRequest", new RpcAsyncRequestContext()), cs));
         instructions->add(new RpcAsyncResponseInstruction(
                 new InstructionDescription("RpcAsyncResponse", new RpcAsyncResponseContext())));
+        instructions->add(new ServerRpcBatchRequestInstruction(
+                new InstructionDescription("ServerRpcBatchRequest", new RpcBatchRequestContext()), cs));
 
         instructions->add(
                 new ServerRpcNotifyInstruction(new InstructionDescription("ServerRpcNotify", new RpcNotifyContext()),
@@ -7,8 +7,286 @@
 //
 
 #include "system/CheckProvider.h"
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CRC_HARDWARE_X86
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CRC_HARDWARE_ARM
+#include <arm_acle.h>
+#endif
+
+namespace {
+    using namespace System;
+
+    template<int... Indices>
+    struct CrcIndices {
+    };
+
+    template<int N, int... Indices>
+    struct CrcMakeIndices : CrcMakeIndices<N - 1, N - 1, Indices...> {
+    };
+
+    template<int... Indices>
+    struct CrcMakeIndices<0, Indices...> {
+        typedef CrcIndices<Indices...> Type;
+    };
+
+    // The register after shifting bits zeros in, poly is reflected if refIn.
+    template<class Type>
+    constexpr Type crcShift(Type crc, Type poly, bool refIn, int bits) {
+        return bits == 0 ? crc :
+               crcShift<Type>(refIn ?
+                              ((crc & 1) ? (Type) ((crc >> 1) ^ poly) : (Type) (crc >> 1)) :
+                              (((crc >> (sizeof(Type) * 8 - 1)) & 1) ? (Type) ((crc << 1) ^ poly) : (Type) (crc << 1)),
+                              poly, refIn, bits - 1);
+    }
+
+    template<class Type>
+    constexpr Type crcReverse(Type value, int bit = 0) {
+        return bit == (int) sizeof(Type) * 8 ? (Type) 0 :
+               (Type) ((Type) (((value >> bit) & 1) << (sizeof(Type) * 8 - 1 - bit)) | crcReverse<Type>(value, bit + 1));
+    }
+
+    // The entry of the byte index followed by slice bytes.
+    template<class Type>
+    constexpr Type crcEntry(Type poly, bool refIn, int index, int slice) {
+        return refIn ? crcShift<Type>((Type) index, poly, true, 8 * (slice + 1)) :
+               crcShift<Type>((Type) (index << (sizeof(Type) * 8 - 8)), poly, false, 8 * (slice + 1));
+    }
+
+    template<class Type, Type Poly, bool RefIn, class Indices = typename CrcMakeIndices<256>::Type>
+    struct CrcTable;
+
+    // The slice-by-8 tables generated at compile time.
+    template<class Type, Type Poly, bool RefIn, int... Indices>
+    struct CrcTable<Type, Poly, RefIn, CrcIndices<Indices...>> {
+        static constexpr Type Shifted = RefIn ? crcReverse<Type>(Poly) : Poly;
+
+        static constexpr Type Values[] = {
+                crcEntry<Type>(Shifted, RefIn, Indices, 0)...,
+                crcEntry<Type>(Shifted, RefIn, Indices, 1)...,
+                crcEntry<Type>(Shifted, RefIn, Indices, 2)...,
+                crcEntry<Type>(Shifted, RefIn, Indices, 3)...,
+                crcEntry<Type>(Shifted, RefIn, Indices, 4)...,
+                crcEntry<Type>(Shifted, RefIn, Indices, 5)...,
+                crcEntry<Type>(Shifted, RefIn, Indices, 6)...,
+                crcEntry<Type>(Shifted, RefIn, Indices, 7)...
+        };
+    };
+
+    template<class Type, Type Poly, bool RefIn, int... Indices>
+    constexpr Type CrcTable<Type, Poly, RefIn, CrcIndices<Indices...>>::Values[];
+
+    template<class Type>
+    struct CrcTables {
+        Type poly;
+        bool refIn;
+        const Type *values;
+    };
+
+    // The polys of the Crc16Provider and Crc32Provider presets.
+    const CrcTables<Crc16Type> Crc16Presets[] = {
+            {0x8005, true,  CrcTable<Crc16Type, 0x8005, true>::Values},
+            {0x8005, false, CrcTable<Crc16Type, 0x8005, false>::Values},
+            {0x1021, true,  CrcTable<Crc16Type, 0x1021, true>::Values},
+            {0x1021, false, CrcTable<Crc16Type, 0x1021, false>::Values},
+            {0x3D65, true,  CrcTable<Crc16Type, 0x3D65, true>::Values},
+            {0x3D65, false, CrcTable<Crc16Type, 0x3D65, false>::Values},
+            {0xC867, false, CrcTable<Crc16Type, 0xC867, false>::Values},
+            {0x0589, false, CrcTable<Crc16Type, 0x0589, false>::Values},
+            {0x8BB7, false, CrcTable<Crc16Type, 0x8BB7, false>::Values},
+            {0xA097, false, CrcTable<Crc16Type, 0xA097, false>::Values},
+    };
+
+    const CrcTables<Crc32Type> Crc32Presets[] = {
+            {0x04C11DB7, true,  CrcTable<Crc32Type, 0x04C11DB7, true>::Values},
+            {0x04C11DB7, false, CrcTable<Crc32Type, 0x04C11DB7, false>::Values},
+            {0x1EDC6F41, true,  CrcTable<Crc32Type, 0x1EDC6F41, true>::Values},
+            {0xA833982B, true,  CrcTable<Crc32Type, 0xA833982B, true>::Values},
+            {0x814141AB, false, CrcTable<Crc32Type, 0x814141AB, false>::Values},
+            {0x000000AF, false, CrcTable<Crc32Type, 0x000000AF, false>::Values},
+    };
+
+    template<class Type>
+    const Type *findTables(const CrcConfig<Type> &config, const CrcTables<Type> *presets, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            if (presets[i].poly == config.poly && presets[i].refIn == config.refIn) {
+                return presets[i].values;
+            }
+        }
+
+        // built at the first use, never released.
+        static std::mutex mutex;
+        static std::vector<CrcTables<Type>> tables;
+        std::lock_guard<std::mutex> locker(mutex);
+        for (const CrcTables<Type> &item: tables) {
+            if (item.poly == config.poly && item.refIn == config.refIn) {
+                return item.values;
+            }
+        }
+
+        static const int Count = CrcProvider<Type>::Count;
+        static const int Slices = CrcProvider<Type>::Slices;
+        Type poly = config.refIn ? crcReverse<Type>(config.poly) : config.poly;
+        auto values = new Type[Slices * Count];
+        for (int i = 0; i < Count; i++) {
+            values[i] = crcEntry<Type>(poly, config.refIn, i, 0);
+            for (int slice = 1; slice < Slices; slice++) {
+                values[slice * Count + i] = crcShift<Type>(values[(slice - 1) * Count + i], poly, config.refIn, 8);
+            }
+        }
+        tables.push_back({config.poly, config.refIn, values});
+        return values;
+    }
+
+#ifdef CRC_HARDWARE_X86
+    // The folding of "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" by Intel,
+    // for the reflected 0x04C11DB7, count is at least 64 and a multiple of 16.
+    __attribute__((target("sse4.2,pclmul")))
+    Crc32Type crc32Pclmul(Crc32Type crc, const uint8_t *buffer, size_t count) {
+        alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+        alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+        alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+        alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+        __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+        x1 = _mm_loadu_si128((const __m128i *) (buffer + 0x00));
+        x2 = _mm_loadu_si128((const __m128i *) (buffer + 0x10));
+        x3 = _mm_loadu_si128((const __m128i *) (buffer + 0x20));
+        x4 = _mm_loadu_si128((const __m128i *) (buffer + 0x30));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+        x0 = _mm_load_si128((const __m128i *) k1k2);
+        buffer += 64;
+        count -= 64;
+
+        // folds 4 blocks of 16 bytes in parallel.
+        while (count >= 64) {
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+            x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+            x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+            y5 = _mm_loadu_si128((const __m128i *) (buffer + 0x00));
+            y6 = _mm_loadu_si128((const __m128i *) (buffer + 0x10));
+            y7 = _mm_loadu_si128((const __m128i *) (buffer + 0x20));
+            y8 = _mm_loadu_si128((const __m128i *) (buffer + 0x30));
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+            buffer += 64;
+            count -= 64;
+        }
+
+        // folds into 128 bits.
+        x0 = _mm_load_si128((const __m128i *) k3k4);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+        // folds the left blocks of 16 bytes.
+        while (count >= 16) {
+            x2 = _mm_loadu_si128((const __m128i *) buffer);
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+            buffer += 16;
+            count -= 16;
+        }
+
+        // folds 128 bits to 64 bits.
+        x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+        x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+        x1 = _mm_srli_si128(x1, 8);
+        x1 = _mm_xor_si128(x1, x2);
+        x0 = _mm_loadl_epi64((const __m128i *) k5k0);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, x3);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+
+        // Barrett reduces to 32 bits.
+        x0 = _mm_load_si128((const __m128i *) poly);
+        x2 = _mm_and_si128(x1, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+        x2 = _mm_and_si128(x2, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return (Crc32Type) _mm_extract_epi32(x1, 1);
+    }
+
+    // The reflected 0x1EDC6F41 of the SSE4.2 crc32 instruction.
+    __attribute__((target("sse4.2")))
+    Crc32Type crc32cSse42(Crc32Type crc, const uint8_t *buffer, size_t count) {
+        uint64_t value = crc;
+        for (; count >= 8; buffer += 8, count -= 8) {
+            uint64_t data;
+            memcpy(&data, buffer, sizeof(data));
+            value = _mm_crc32_u64(value, data);
+        }
+        crc = (Crc32Type) value;
+        while (count--) {
+            crc = _mm_crc32_u8(crc, *buffer++);
+        }
+        return crc;
+    }
+#endif
+
+#ifdef CRC_HARDWARE_ARM
+    // The reflected 0x04C11DB7 of the ARMv8 crc32 instructions.
+    Crc32Type crc32Arm(Crc32Type crc, const uint8_t *buffer, size_t count) {
+        for (; count >= 8; buffer += 8, count -= 8) {
+            uint64_t data;
+            memcpy(&data, buffer, sizeof(data));
+            crc = __crc32d(crc, data);
+        }
+        while (count--) {
+            crc = __crc32b(crc, *buffer++);
+        }
+        return crc;
+    }
+
+    // The reflected 0x1EDC6F41 of the ARMv8 crc32c instructions.
+    Crc32Type crc32cArm(Crc32Type crc, const uint8_t *buffer, size_t count) {
+        for (; count >= 8; buffer += 8, count -= 8) {
+            uint64_t data;
+            memcpy(&data, buffer, sizeof(data));
+            crc = __crc32cd(crc, data);
+        }
+        while (count--) {
+            crc = __crc32cb(crc, *buffer++);
+        }
+        return crc;
+    }
+#endif
+}
 
 namespace System {
+    const Crc8Type *crcTables(const Crc8Config &config) {
+        return findTables<Crc8Type>(config, nullptr, 0);
+    }
+
+    const Crc16Type *crcTables(const Crc16Config &config) {
+        return findTables<Crc16Type>(config, Crc16Presets, sizeof(Crc16Presets) / sizeof(Crc16Presets[0]));
+    }
+
+    const Crc32Type *crcTables(const Crc32Config &config) {
+        return findTables<Crc32Type>(config, Crc32Presets, sizeof(Crc32Presets) / sizeof(Crc32Presets[0]));
+    }
+
     // Block Check Character
     BccProvider::BccProvider() = default;
 
@@ -92,8 +370,47 @@ namespace System {
     Crc32Provider Crc32Provider::D = Crc32Provider({0xA833982B, 0xFFFFFFFF, true, true, 0xFFFFFFFF});
     Crc32Provider Crc32Provider::Q = Crc32Provider({0x814141AB, 0x00000000, false, false, 0x00000000});
 
-    Crc32Provider::Crc32Provider(const Crc32Config &config) : CrcProvider<Crc32Type>(config) {
+    Crc32Provider::Crc32Provider(const Crc32Config &config) : CrcProvider<Crc32Type>(config),
+                                                              _kernel(hardwareKernel(config)) {
     }
 
     Crc32Provider::~Crc32Provider() = default;
+
+    bool Crc32Provider::isAccelerated() const {
+        return _kernel != nullptr;
+    }
+
+    Crc32Type Crc32Provider::update(Crc32Type crc, const uint8_t *buffer, size_t count) const {
+        if (_kernel != nullptr && count >= MinHardwareCount) {
+            size_t length = count & ~(size_t) 15;
+            crc = _kernel(crc, buffer, length);
+            buffer += length;
+            count -= length;
+        }
+        return CrcProvider<Crc32Type>::update(crc, buffer, count);
+    }
+
+    Crc32Provider::Kernel Crc32Provider::hardwareKernel(const Crc32Config &config) {
+        if (!config.refIn) {
+            return nullptr;
+        }
+#if defined(CRC_HARDWARE_X86)
+        // the presets are constructed before main.
+        __builtin_cpu_init();
+        if (config.poly == 0x04C11DB7 && __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.2")) {
+            return crc32Pclmul;
+        }
+        if (config.poly == 0x1EDC6F41 && __builtin_cpu_supports("sse4.2")) {
+            return crc32cSse42;
+        }
+#elif defined(CRC_HARDWARE_ARM)
+        if (config.poly == 0x04C11DB7) {
+            return crc32Arm;
+        }
+        if (config.poly == 0x1EDC6F41) {
+            return crc32cArm;
+        }
+#endif
+        return nullptr;
+    }
 }
@@ -72,6 +72,20 @@ namespace System {
         return false;
     }
 
+    bool Regex::isMatch(const char *input, size_t length) {
+        if (isValid() && input != nullptr && length > 0) {
+            cmatch m;
+            try {
+                return regex_search(input, input + length, m, *_regex, regex_constants::match_not_null);
+            } catch (std::regex_error &e) {
+                // Syntax error in the regular expression
+                _error = e.what();
+                Debug::writeFormatLine("regex error, length: %d, code: %d", (int) length, e.code());
+            }
+        }
+        return false;
+    }
+
     bool Regex::match(const String &input, StringArray &groups) {
         if (isValid() && !input.isNullOrEmpty()) {
             try {
@@ -13,28 +13,40 @@ namespace Threading {
 
     IMutex::~IMutex() = default;
 
-    Mutex::Mutex() {
-        _mutex = new mutex();
+    Mutex::Mutex() : _mutex(nullptr) {
     }
 
-    Mutex::Mutex(const Mutex &m) {
-        _mutex = new mutex();
+    Mutex::Mutex(const Mutex &m) : _mutex(nullptr) {
     }
 
     Mutex::~Mutex() {
-        delete _mutex;
+        delete _mutex.load(std::memory_order_relaxed);
     }
 
     void Mutex::lock() {
-        _mutex->lock();
+        get()->lock();
     }
 
     bool Mutex::tryLock() {
-        return _mutex->try_lock();
+        return get()->try_lock();
     }
 
     void Mutex::unlock() {
-        _mutex->unlock();
+        get()->unlock();
+    }
+
+    mutex *Mutex::get() {
+        mutex *m = _mutex.load(std::memory_order_acquire);
+        if (m == nullptr) {
+            // the threads locking it at first race to create it, one of them wins.
+            auto created = new mutex();
+            if (_mutex.compare_exchange_strong(m, created, std::memory_order_acq_rel)) {
+                m = created;
+            } else {
+                delete created;
+            }
+        }
+        return m;
     }
 
     RecursiveMutex::RecursiveMutex() {
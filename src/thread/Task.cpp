@@ -7,14 +7,25 @@
 //
 
 #include "thread/Task.h"
+#include "thread/TaskExecutor.h"
 
 namespace Threading {
-    TaskBackground::TaskBackground() {
-        _thread = Thread("task", &TaskBackground::execute, this);
+    TaskBackground::TaskBackground() : _status(TaskCreated), _taken(false), _refCount(1), _completed(false),
+                                       _continuations(nullptr) {
+    }
+
+    TaskBackground::~TaskBackground() {
+        while (_continuations != nullptr) {
+            Continuation *next = _continuations->next;
+            delete _continuations;
+            _continuations = next;
+        }
     }
 
     void TaskBackground::execute() {
-        _status = TaskCompletion;
+        TaskStatus status = _status;
+        while (status != TaskCanceled && !_status.compare_exchange_weak(status, TaskCompletion)) {
+        }
     }
 
     TaskStatus TaskBackground::status() const {
@@ -22,24 +33,26 @@ namespace Threading {
     }
 
     bool TaskBackground::isCompleted() const {
-        return !_thread.isAlive();
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _completed;
     }
 
     bool TaskBackground::wait(const TimeSpan &timeout) {
         if (timeout == TimeSpan::Zero) {
-            _thread.join();
+            // not started yet, execute it here instead of waiting for a worker.
+            run();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _completedSignal.wait(lock, [this] { return _completed; });
             return true;
         } else {
-            auto isThreadDead = [](Thread *thread) {
-                return !thread->isAlive();
-            };
-            Thread::delay(timeout, Func<bool>(isThreadDead, &_thread));
-            if (_thread.isAlive()) {
-                _status = TaskTimeout;
-                return false;
-            } else {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_completedSignal.wait_for(lock, std::chrono::milliseconds((int64_t) timeout.totalMilliseconds()),
+                                          [this] { return _completed; })) {
                 return true;
             }
+            _status = TaskTimeout;
+            return false;
         }
     }
 
@@ -51,18 +64,21 @@ namespace Threading {
         if (_status == TaskCanceled) {
             return;
         }
-        if (_thread.id() != Thread::currentThreadId()) {
-            if (delay > TimeSpan::Zero) {
-                auto isThreadDead = [](Thread *thread) {
-                    return !thread->isAlive();
-                };
-                Thread::delay(delay, Func<bool>(isThreadDead, &_thread));
-            }
-            if (_thread.isAlive()) {
-                _status = TaskCanceled;
-                _thread.detach();
-            }
-        } else {
+
+        bool taken = false;
+        if (_taken.compare_exchange_strong(taken, true)) {
+            // never be executed.
+            _status = TaskCanceled;
+            complete();
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_runner != std::this_thread::get_id() && delay > TimeSpan::Zero) {
+            _completedSignal.wait_for(lock, std::chrono::milliseconds((int64_t) delay.totalMilliseconds()),
+                                      [this] { return _completed; });
+        }
+        if (!_completed) {
             _status = TaskCanceled;
         }
     }
@@ -71,9 +87,102 @@ namespace Threading {
         cancel(TimeSpan::fromSeconds(delaySeconds));
     }
 
+    bool TaskBackground::run() {
+        bool taken = false;
+        if (!_taken.compare_exchange_strong(taken, true)) {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _runner = std::this_thread::get_id();
+        }
+        try {
+            execute();
+        } catch (...) {
+            _status = TaskFaulted;
+        }
+        complete();
+        return true;
+    }
+
+    void TaskBackground::retain() {
+        _refCount++;
+    }
+
+    void TaskBackground::release() {
+        if (--_refCount == 0) {
+            delete this;
+        }
+    }
+
     void TaskBackground::start() {
-        _thread.start();
-        _status = _thread.isAlive() ? TaskRunning : TaskFaulted;
+        _status = TaskRunning;
+        retain();
+        TaskExecutor::instance()->post(this);
+    }
+
+    void TaskBackground::complete() {
+        Continuation *continuations;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _completed = true;
+            _runner = std::thread::id();
+            continuations = _continuations;
+            _continuations = nullptr;
+        }
+        _completedSignal.notify_all();
+
+        while (continuations != nullptr) {
+            Continuation *next = continuations->next;
+            continuations->when->notify(continuations->index);
+            continuations->when->release();
+            delete continuations;
+            continuations = next;
+        }
+    }
+
+    void TaskBackground::addContinuation(TaskWhen *when, size_t index) {
+        when->retain();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_completed) {
+                _continuations = new Continuation{when, index, _continuations};
+                return;
+            }
+        }
+        when->notify(index);
+        when->release();
+    }
+
+    TaskWhen::TaskWhen(bool any, size_t count) : TaskBackground(), _any(any), _remaining(count), _notified(false) {
+        _taken = true;
+        _status = TaskRunning;
+        _result.setValue(-1);
+        if (count == 0) {
+            execute();
+            complete();
+        }
+    }
+
+    TaskWhen::~TaskWhen() = default;
+
+    void *TaskWhen::resultPtr() {
+        return &_result;
+    }
+
+    void TaskWhen::notify(size_t index) {
+        if (_any) {
+            bool notified = false;
+            if (_notified.compare_exchange_strong(notified, true)) {
+                _result.setValue((int) index);
+                execute();
+                complete();
+            }
+        } else if (--_remaining == 0) {
+            execute();
+            complete();
+        }
     }
 
     Task::Task() : _state(nullptr) {
@@ -86,6 +195,10 @@ namespace Threading {
 
     Task &Task::operator=(Task &&other) noexcept {
         if (this != &other) {
+            if (_state != nullptr) {
+                // the executor keeps its own reference until the task is done.
+                _state->release();
+            }
             _state = other._state;
             other._state = nullptr;
         }
@@ -93,8 +206,13 @@ namespace Threading {
     }
 
     Task::~Task() {
-        delete _state;
-        _state = nullptr;
+        if (_state != nullptr) {
+            if (_state->status() != TaskCanceled) {
+                _state->wait();
+            }
+            _state->release();
+            _state = nullptr;
+        }
     }
 
     TaskStatus Task::status() const {
@@ -120,4 +238,36 @@ namespace Threading {
             _state->cancel(delaySeconds);
         }
     }
+
+    Task Task::whenAll(Task *tasks[], size_t count) {
+        auto when = new TaskWhen(false, count);
+        for (size_t i = 0; i < count; i++) {
+            TaskBackground *state = tasks[i] != nullptr ? tasks[i]->_state : nullptr;
+            if (state != nullptr) {
+                state->addContinuation(when, i);
+            } else {
+                when->notify(i);
+            }
+        }
+
+        Task task;
+        task._state = when;
+        return task;
+    }
+
+    Task Task::whenAny(Task *tasks[], size_t count) {
+        auto when = new TaskWhen(true, count);
+        for (size_t i = 0; i < count; i++) {
+            TaskBackground *state = tasks[i] != nullptr ? tasks[i]->_state : nullptr;
+            if (state != nullptr) {
+                state->addContinuation(when, i);
+            } else {
+                when->notify(i);
+            }
+        }
+
+        Task task;
+        task._state = when;
+        return task;
+    }
 }
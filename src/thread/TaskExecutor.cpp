@@ -0,0 +1,150 @@
+//
+//  TaskExecutor.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "thread/TaskExecutor.h"
+#include "thread/Task.h"
+#include "system/Environment.h"
+
+namespace Threading {
+    static const size_t NoWorker = (size_t) -1;
+    static thread_local size_t currentWorker = NoWorker;
+
+    TaskExecutor::Worker::Worker() : thread(nullptr) {
+    }
+
+    TaskExecutor::Worker::~Worker() {
+        delete thread;
+        thread = nullptr;
+    }
+
+    void TaskExecutor::Worker::push(TaskBackground *task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(task);
+    }
+
+    TaskBackground *TaskExecutor::Worker::pop() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tasks.empty()) {
+            return nullptr;
+        }
+        TaskBackground *task = _tasks.back();
+        _tasks.pop_back();
+        return task;
+    }
+
+    TaskBackground *TaskExecutor::Worker::steal() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tasks.empty()) {
+            return nullptr;
+        }
+        TaskBackground *task = _tasks.front();
+        _tasks.pop_front();
+        return task;
+    }
+
+    TaskExecutor::TaskExecutor() : _workers{}, _workerCount(0), _maxWorkerCount(MaxWorkerCount),
+                                   _next(0), _pending(0), _idleCount(0), _progress(0) {
+        size_t count = Thread::concurrency();
+        if (count < 2) {
+            count = 2;
+        }
+        for (size_t i = 0; i < count; i++) {
+            addWorker();
+        }
+        _monitorTimer = new Timer("task.executor.monitor", (int) BlockedTime, &TaskExecutor::monitorProc, this);
+    }
+
+    TaskExecutor::~TaskExecutor() = default;
+
+    TaskExecutor *TaskExecutor::instance() {
+        // never released, the tasks may be waited by static destructors.
+        static TaskExecutor *executor = new TaskExecutor();
+        return executor;
+    }
+
+    void TaskExecutor::post(TaskBackground *task) {
+        size_t count = _workerCount;
+        size_t index = currentWorker != NoWorker ? currentWorker : _next++ % count;
+        _workers[index]->push(task);
+        _pending++;
+
+        if (_idleCount > 0) {
+            std::lock_guard<std::mutex> lock(_idleMutex);
+            _idleSignal.notify_one();
+        }
+    }
+
+    size_t TaskExecutor::workerCount() const {
+        return _workerCount;
+    }
+
+    size_t TaskExecutor::maxWorkerCount() const {
+        return _maxWorkerCount;
+    }
+
+    void TaskExecutor::setMaxWorkerCount(size_t count) {
+        std::lock_guard<std::mutex> lock(_workersMutex);
+        if (count < _workerCount) {
+            count = _workerCount;
+        }
+        _maxWorkerCount = count < MaxWorkerCount ? count : MaxWorkerCount;
+    }
+
+    void TaskExecutor::addWorker() {
+        std::lock_guard<std::mutex> lock(_workersMutex);
+        size_t index = _workerCount;
+        if (index >= _maxWorkerCount) {
+            return;
+        }
+
+        auto worker = new Worker();
+        worker->thread = new Thread(String::convert("task.worker%d", (int) index),
+                                    &TaskExecutor::workerProc, this, index);
+        _workers[index] = worker;
+        _workerCount++;
+        worker->thread->start();
+    }
+
+    TaskBackground *TaskExecutor::take(size_t index) {
+        TaskBackground *task = _workers[index]->pop();
+        if (task == nullptr) {
+            size_t count = _workerCount;
+            for (size_t i = 1; i < count && task == nullptr; i++) {
+                task = _workers[(index + i) % count]->steal();
+            }
+        }
+        return task;
+    }
+
+    void TaskExecutor::workerProc(size_t index) {
+        currentWorker = index;
+        while (true) {
+            TaskBackground *task = take(index);
+            if (task != nullptr) {
+                _pending--;
+                _progress = Environment::getTickCount();
+                task->run();
+                task->release();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_idleMutex);
+            _idleCount++;
+            _idleSignal.wait(lock, [this] { return _pending > 0; });
+            _idleCount--;
+        }
+    }
+
+    void TaskExecutor::monitorProc() {
+        // all of the workers are blocked by long running tasks, add one more.
+        if (_pending > 0 && _idleCount == 0 &&
+            Environment::getTickCount() - _progress >= BlockedTime) {
+            addWorker();
+        }
+    }
+}
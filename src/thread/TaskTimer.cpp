@@ -35,13 +35,29 @@ namespace Threading {
         _action.execute();
     }
 
+    uint64_t TaskTimer::Group::remaining(uint64_t now) const {
+        if (_start == 0) {
+            return 0;
+        }
+
+        auto interval = (uint64_t) _interval.totalMilliseconds();
+        uint64_t elapsed = now - _start;
+        return elapsed > interval ? 0 : interval - elapsed + 1;
+    }
+
     void TaskTimer::Group::change(const String &name, const TimeSpan &interval) {
         _interval = interval;
         _start = 0;
     }
 
     TaskTimer::TaskTimer(const String &name) :
-            _name(!name.isNullOrEmpty() ? name : "TaskTimer"), _timer(nullptr) {
+            _name(!name.isNullOrEmpty() ? name : "TaskTimer") {
+#ifdef __EMSCRIPTEN__
+        _timer = nullptr;
+#else
+        _entry = nullptr;
+        _fired = false;
+#endif
     }
 
     TaskTimer::~TaskTimer() {
@@ -73,6 +89,7 @@ namespace Threading {
                 if (_currentThreadId != currentThreadId) {
                     _groups.unlock();
                 }
+                reschedule();
                 return true;
             }
         }
@@ -102,18 +119,37 @@ namespace Threading {
         if (running())
             return;
 
+#ifdef __EMSCRIPTEN__
         _timer = new Timer(name(), (int) dueTime.totalMilliseconds(), 1, &TaskTimer::taskTimeUp, this);
+#else
+        // one shot entry, taskTimeUp schedules it again for the nearest group.
+        _fired = false;
+        _entry = TimerService::instance()->create(name(), Action(&TaskTimer::taskTimeUp, this),
+                                                  (int) dueTime.totalMilliseconds(), Timer::Infinite);
+        TimerService::instance()->start(_entry);
+#endif
     }
 
     void TaskTimer::stop() {
+#ifdef __EMSCRIPTEN__
         if (_timer != nullptr) {
             delete _timer;
             _timer = nullptr;
         }
+#else
+        if (_entry != nullptr) {
+            TimerService::instance()->destroy(_entry);
+            _entry = nullptr;
+        }
+#endif
     }
 
     bool TaskTimer::running() const {
+#ifdef __EMSCRIPTEN__
         return _timer != nullptr && _timer->running();
+#else
+        return _entry != nullptr;
+#endif
     }
 
     const String &TaskTimer::name() const {
@@ -136,5 +172,29 @@ namespace Threading {
                 group->execute();
             }
         }
+
+#ifndef __EMSCRIPTEN__
+        _fired = true;
+        uint64_t now = Environment::getTickCount();
+        int dueTime = Timer::Infinite;
+        for (size_t i = 0; i < _groups.count(); i++) {
+            auto remaining = (int) _groups[i]->remaining(now);
+            if (dueTime == Timer::Infinite || remaining < dueTime) {
+                dueTime = remaining;
+            }
+        }
+        if (_entry != nullptr) {
+            TimerService::instance()->change(_entry, dueTime, Timer::Infinite);
+        }
+#endif
+    }
+
+    void TaskTimer::reschedule() {
+#ifndef __EMSCRIPTEN__
+        // a new or changed group is time up at once, unless the start due time is not reached.
+        if (_entry != nullptr && _fired) {
+            TimerService::instance()->change(_entry, Timer::Zero, Timer::Infinite);
+        }
+#endif
     }
 }
@@ -349,7 +349,7 @@ namespace Threading {
         } else {
             int result = pthread_setschedparam(_thread.native_handle(), policy, &param);
             if (result != 0) {
-                Trace::error(String::format("Failed to set thread priority'%d:%d', result: %d.",
+                Trace::error(String::format("Failed to set thread priority'%d:%d:%d', result: %d.",
                                             priority, priority, param.sched_priority, result));
             } else {
                 Debug::writeLine(String::format("Set thread'%s' priority'%d:%d' successfully.",
@@ -24,22 +24,26 @@ namespace Threading {
 #ifdef __EMSCRIPTEN__
         _running = false;
 #else
-        _firstInvoke = true;
-        _start = 0;
-        _loop = false;
+        _entry = nullptr;
 #endif
     }
 
     Timer::Timer(Timer &&other) noexcept {
+#ifndef __EMSCRIPTEN__
+        _entry = nullptr;
+#endif
         move(other);
     }
 
     Timer::~Timer() {
 #ifdef __EMSCRIPTEN__
         _timers.remove((int) this);
-#endif
 
         stop();
+#else
+        TimerService::instance()->destroy(_entry);
+        _entry = nullptr;
+#endif
 
 #ifdef DEBUG
         printDebugInfo("Destroy a timer.");
@@ -69,11 +73,7 @@ namespace Threading {
         _running = false;
         _timers.add((int) this, DateTime::now());
 #else
-        _firstInvoke = true;
-        _start = 0;
-        _loop = false;
-
-        _thread = Thread(tName, &Timer::threadProc, this);
+        _entry = TimerService::instance()->create(tName, std::move(_action), dueTime, period);
 #endif
 
 #ifdef DEBUG
@@ -95,14 +95,9 @@ namespace Threading {
             other._running = false;
         }
 #else
-        _firstInvoke = other._firstInvoke;
-        _start = other._start;
-        if (other._loop) {
-            _loop = true;
-            other._loop = false;
-        }
-
-        _thread = std::move(other._thread);
+        TimerService::instance()->destroy(_entry);
+        _entry = other._entry;
+        other._entry = nullptr;
 #endif
     }
 
@@ -116,10 +111,9 @@ namespace Threading {
             _running = true;
             glutTimerFunc(_dueTime == Zero ? 0 : _dueTime, threadProc, (int) this);
 #else
-            _firstInvoke = true;
-            _loop = true;
-
-            _thread.start();
+            if (_entry != nullptr) {
+                TimerService::instance()->start(_entry);
+            }
 #endif
         }
     }
@@ -132,19 +126,8 @@ namespace Threading {
 #ifdef __EMSCRIPTEN__
         _running = false;
 #else
-        _loop = false;
-
-        if (_thread.id() != Thread::currentThreadId()) {
-            auto isThreadDead = [](Thread *thread) {
-                return !thread->isAlive();
-            };
-            Thread::delay(TimeSpan::fromSeconds(delaySeconds), Func<bool>(isThreadDead, &_thread));
-            if (_thread.isAlive()) {
-                _thread.detach();
-            } else if (_thread.joinable()) {
-                _thread.join();
-            }
-        } else {
+        if (_entry != nullptr) {
+            TimerService::instance()->stop(_entry, delaySeconds > 0 ? (uint32_t) delaySeconds * 1000 : 0);
         }
 #endif
     }
@@ -161,7 +144,7 @@ namespace Threading {
 #ifdef __EMSCRIPTEN__
         return _running;
 #else
-        return _thread.isAlive();
+        return _entry != nullptr && TimerService::instance()->running(_entry);
 #endif
     }
 
@@ -175,7 +158,9 @@ namespace Threading {
                 glutTimerFunc(_dueTime == Zero ? 0 : _dueTime, threadProc, (int) this);
             }
 #else
-            _firstInvoke = true;
+            if (_entry != nullptr) {
+                TimerService::instance()->change(_entry, _dueTime, _period);
+            }
 #endif
             return true;
         }
@@ -194,12 +179,12 @@ namespace Threading {
         return change((int) period.totalMilliseconds());
     }
 
+#ifdef __EMSCRIPTEN__
+
     void Timer::fire() {
         _action.execute();
     }
 
-#ifdef __EMSCRIPTEN__
-
     void Timer::threadProc(int value) {
         if (!_timers.contains(value)) {
             Debug::writeFormatLine("removed timer's invoke, value: 0x%X", value);
@@ -219,54 +204,6 @@ namespace Threading {
         }
     }
 
-#else
-
-    void Timer::threadProc() {
-        while (_loop) {
-            if (_firstInvoke) {
-                _firstInvoke = false;
-                _start = TickTimeout::getCurrentTickCount();
-
-                if (_dueTime == Zero) {
-                    fire();
-                } else if (_dueTime == Infinite) {
-                } else {
-                    if (msleepWithBreak(_start, _dueTime)) {
-                        fire();
-                        _start = TickTimeout::getCurrentTickCount();
-                    }
-                }
-            } else {
-                _start = TickTimeout::getNextTickCount(_start, _period);
-                if (_dueTime != Infinite) {
-                    fire();
-                }
-            }
-
-            msleepWithBreak(_start, _period);
-        }
-    }
-
-    bool Timer::msleepWithBreak(uint32_t start, uint32_t msec) const {
-        const uint32_t unitmsec = 10;        // 10 ms
-        if (msec <= unitmsec) {
-            if (msec != 0) {
-                Thread::msleep(msec);
-                return true;
-            }
-            return false;
-        } else {
-            uint32_t end = TickTimeout::getDeadTickCount(start, msec);
-            while (_loop) {
-                if (TickTimeout::isTimeout(start, end)) {
-                    break;
-                }
-                Thread::msleep(unitmsec);
-            }
-            return _loop;
-        }
-    }
-
 #endif
 
 #ifdef DEBUG
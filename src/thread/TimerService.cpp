@@ -0,0 +1,409 @@
+//
+//  TimerService.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "thread/TimerService.h"
+#include "thread/Timer.h"
+
+namespace Threading {
+    class TimerService::Entry {
+    public:
+        enum State {
+            Idle,
+            Scheduled,
+            Ready,
+            Running
+        };
+
+        Entry(const String &name, Action &&action, int dueTime, int period) :
+                name(name), action(std::move(action)), dueTime(dueTime), period(period),
+                deadline(0), readyTick(0), state(Idle), active(false), restart(false), orphan(false),
+                level(0), slot(0), prev(nullptr), next(nullptr) {
+        }
+
+        String name;
+        Action action;
+
+        int dueTime;
+        int period;
+        uint64_t deadline;
+        uint64_t readyTick;
+
+        State state;
+        bool active;
+        bool restart;
+        bool orphan;
+        std::thread::id worker;
+
+        int level;
+        size_t slot;
+        Entry *prev;
+        Entry *next;
+    };
+
+    TimerService::TimerService() : _epoch(std::chrono::steady_clock::now()), _wheel{}, _level0Bitmap(0),
+                                   _current(0), _wakeTick(NoWake), _scheduledCount(0),
+                                   _readyHead(nullptr), _readyTail(nullptr), _readyCount(0),
+                                   _count(0), _idleCount(0), _maxWorkerCount(DefaultMaxWorkerCount) {
+        _coreWorkerCount = Thread::concurrency();
+        if (_coreWorkerCount < 2) {
+            _coreWorkerCount = 2;
+        }
+
+        _wheelThread = new Thread("timer.wheel", &TimerService::wheelProc, this);
+        _wheelThread->start();
+    }
+
+    TimerService::~TimerService() = default;
+
+    TimerService *TimerService::instance() {
+        // never released, the timers may be stopped by static destructors.
+        static TimerService *service = new TimerService();
+        return service;
+    }
+
+    TimerService::Entry *TimerService::create(const String &name, Action &&action, int dueTime, int period) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _count++;
+        return new Entry(name, std::move(action), dueTime, period);
+    }
+
+    void TimerService::destroy(Entry *entry, uint32_t timeout) {
+        if (entry == nullptr) {
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        entry->active = false;
+        unlink(entry);
+        _count--;
+        if (entry->state == Entry::Running && entry->worker != std::this_thread::get_id()) {
+            _doneSignal.wait_for(lock, std::chrono::milliseconds(timeout),
+                                 [entry] { return entry->state != Entry::Running; });
+        }
+        if (entry->state == Entry::Running) {
+            // released by the worker after the callback returns.
+            entry->orphan = true;
+            return;
+        }
+        delete entry;
+    }
+
+    void TimerService::start(Entry *entry) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (entry->active) {
+            return;
+        }
+        entry->active = true;
+        if (entry->state == Entry::Running) {
+            entry->restart = true;
+        } else {
+            scheduleFirst(entry);
+        }
+    }
+
+    void TimerService::stop(Entry *entry, uint32_t timeout) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        entry->active = false;
+        entry->restart = false;
+        unlink(entry);
+        if (entry->state == Entry::Running && entry->worker != std::this_thread::get_id()) {
+            _doneSignal.wait_for(lock, std::chrono::milliseconds(timeout),
+                                 [entry] { return entry->state != Entry::Running; });
+        }
+    }
+
+    void TimerService::change(Entry *entry, int dueTime, int period) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        entry->dueTime = dueTime;
+        entry->period = period;
+        if (entry->active) {
+            if (entry->state == Entry::Running) {
+                entry->restart = true;
+            } else {
+                unlink(entry);
+                scheduleFirst(entry);
+            }
+        }
+    }
+
+    bool TimerService::running(const Entry *entry) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return entry->active || entry->state == Entry::Running;
+    }
+
+    size_t TimerService::timerCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _count;
+    }
+
+    size_t TimerService::workerCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _workers.count();
+    }
+
+    size_t TimerService::maxWorkerCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _maxWorkerCount;
+    }
+
+    void TimerService::setMaxWorkerCount(size_t count) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _maxWorkerCount = count > 0 ? count : 1;
+    }
+
+    void TimerService::scheduleFirst(Entry *entry) {
+        if (entry->dueTime == Timer::Infinite) {
+            // started, but never fired.
+            return;
+        }
+        uint64_t tick = now();
+        schedule(entry, entry->dueTime > 0 ? tick + entry->dueTime : tick);
+    }
+
+    void TimerService::schedule(Entry *entry, uint64_t deadline) {
+        entry->deadline = deadline;
+        if (deadline < _current) {
+            addToReady(entry);
+        } else {
+            addToWheel(entry);
+            _scheduledCount++;
+            if (deadline < _wakeTick) {
+                _wheelSignal.notify_one();
+            }
+        }
+    }
+
+    void TimerService::addToWheel(Entry *entry) {
+        uint64_t expires = entry->deadline;
+        if (expires - _current >= MaxRange) {
+            // fired early and scheduled again, see advance.
+            expires = _current + MaxRange - 1;
+        }
+        uint64_t delta = expires - _current;
+        int level = 0;
+        while (level < LevelCount - 1 && delta >= ((uint64_t) 1 << (SlotBits * (level + 1)))) {
+            level++;
+        }
+        size_t slot = (size_t) (expires >> (SlotBits * level)) & SlotMask;
+
+        Entry *&head = _wheel[level][slot];
+        entry->level = level;
+        entry->slot = slot;
+        entry->prev = nullptr;
+        entry->next = head;
+        if (head != nullptr) {
+            head->prev = entry;
+        }
+        head = entry;
+        if (level == 0) {
+            _level0Bitmap |= (uint64_t) 1 << slot;
+        }
+        entry->state = Entry::Scheduled;
+    }
+
+    void TimerService::addToReady(Entry *entry) {
+        entry->state = Entry::Ready;
+        entry->readyTick = _current;
+        entry->next = nullptr;
+        entry->prev = _readyTail;
+        if (_readyTail != nullptr) {
+            _readyTail->next = entry;
+        } else {
+            _readyHead = entry;
+        }
+        _readyTail = entry;
+        _readyCount++;
+
+        if (_idleCount > 0) {
+            _readySignal.notify_one();
+        }
+        if (_readyCount > _idleCount && _workers.count() < _coreWorkerCount) {
+            addWorker();
+        }
+    }
+
+    void TimerService::addWorker() {
+        if (_workers.count() < _maxWorkerCount) {
+            auto worker = new Thread(String::convert("timer.worker%d", (int) _workers.count()),
+                                     &TimerService::workerProc, this);
+            _workers.add(worker);
+            worker->start();
+        }
+    }
+
+    void TimerService::unlink(Entry *entry) {
+        if (entry->state == Entry::Scheduled) {
+            Entry *&head = _wheel[entry->level][entry->slot];
+            if (entry->prev != nullptr) {
+                entry->prev->next = entry->next;
+            } else {
+                head = entry->next;
+            }
+            if (entry->next != nullptr) {
+                entry->next->prev = entry->prev;
+            }
+            if (entry->level == 0 && head == nullptr) {
+                _level0Bitmap &= ~((uint64_t) 1 << entry->slot);
+            }
+            _scheduledCount--;
+        } else if (entry->state == Entry::Ready) {
+            if (entry->prev != nullptr) {
+                entry->prev->next = entry->next;
+            } else {
+                _readyHead = entry->next;
+            }
+            if (entry->next != nullptr) {
+                entry->next->prev = entry->prev;
+            } else {
+                _readyTail = entry->prev;
+            }
+            _readyCount--;
+        } else {
+            return;
+        }
+        entry->prev = entry->next = nullptr;
+        entry->state = Entry::Idle;
+    }
+
+    void TimerService::cascade(int level, size_t index) {
+        Entry *entry = _wheel[level][index];
+        _wheel[level][index] = nullptr;
+        while (entry != nullptr) {
+            Entry *next = entry->next;
+            addToWheel(entry);
+            entry = next;
+        }
+    }
+
+    void TimerService::advance(uint64_t now) {
+        while (_current <= now) {
+            size_t index = (size_t) _current & SlotMask;
+            if (index == 0) {
+                for (int level = 1; level < LevelCount; level++) {
+                    size_t slot = (size_t) (_current >> (SlotBits * level)) & SlotMask;
+                    cascade(level, slot);
+                    if (slot != 0) {
+                        break;
+                    }
+                }
+            }
+
+            if ((_level0Bitmap >> index) == 0) {
+                // nothing left in this round, jump to the next cascade.
+                uint64_t next = (_current | SlotMask) + 1;
+                _current = next <= now ? next : now + 1;
+                continue;
+            }
+
+            Entry *entry = _wheel[0][index];
+            _wheel[0][index] = nullptr;
+            _level0Bitmap &= ~((uint64_t) 1 << index);
+            while (entry != nullptr) {
+                Entry *next = entry->next;
+                if (entry->deadline > _current) {
+                    addToWheel(entry);
+                } else {
+                    _scheduledCount--;
+                    addToReady(entry);
+                }
+                entry = next;
+            }
+            _current++;
+        }
+    }
+
+    uint64_t TimerService::nextWakeTick() const {
+        if (_scheduledCount == 0) {
+            return NoWake;
+        }
+        size_t index = (size_t) _current & SlotMask;
+        if (index == 0) {
+            // cascade is not done yet.
+            return _current;
+        }
+        uint64_t bits = _level0Bitmap >> index;
+        if (bits != 0) {
+            return _current + __builtin_ctzll(bits);
+        }
+        return (_current | SlotMask) + 1;
+    }
+
+    uint64_t TimerService::now() const {
+        return (uint64_t) std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - _epoch).count();
+    }
+
+    void TimerService::wheelProc() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            uint64_t tick = now();
+            advance(tick);
+            _wakeTick = nextWakeTick();
+
+            // all of the workers are blocked by the callbacks, add one more.
+            if (_readyHead != nullptr && _idleCount == 0) {
+                if (tick >= _readyHead->readyTick + BlockedTime) {
+                    addWorker();
+                } else if (_readyHead->readyTick + BlockedTime < _wakeTick) {
+                    _wakeTick = _readyHead->readyTick + BlockedTime;
+                }
+            }
+            if (_wakeTick == NoWake) {
+                _wheelSignal.wait(lock);
+            } else {
+                _wheelSignal.wait_until(lock, _epoch + std::chrono::milliseconds(_wakeTick));
+            }
+        }
+    }
+
+    void TimerService::workerProc() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            while (_readyHead == nullptr) {
+                _idleCount++;
+                _readySignal.wait(lock);
+                _idleCount--;
+            }
+
+            Entry *entry = _readyHead;
+            unlink(entry);
+            entry->state = Entry::Running;
+            entry->worker = std::this_thread::get_id();
+            entry->restart = false;
+
+            lock.unlock();
+            entry->action.execute();
+            lock.lock();
+
+            entry->state = Entry::Idle;
+            entry->worker = std::thread::id();
+            if (entry->orphan) {
+                delete entry;
+                continue;
+            }
+            if (entry->active) {
+                if (entry->restart) {
+                    entry->restart = false;
+                    scheduleFirst(entry);
+                } else if (entry->period > 0 && entry->dueTime != Timer::Infinite) {
+                    // fixed rate, a late callback does not fire again to catch up.
+                    int period = entry->period;
+                    if (period < MinPeriod) {
+                        period = MinPeriod;
+                    }
+                    uint64_t tick = now();
+                    uint64_t deadline = entry->deadline + period;
+                    schedule(entry, deadline > tick ? deadline : tick);
+                } else {
+                    entry->active = false;
+                }
+            }
+            _doneSignal.notify_all();
+        }
+    }
+}
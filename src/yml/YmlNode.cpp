@@ -377,14 +377,14 @@ namespace Yml {
         if (node.node->Type() == YAML::NodeType::Map) {
             // This should be true; do something here with the map.
             String temp = levelStr;
-            levelStr.append(String::format("[%d]", index));
+            levelStr.append(String::format("[%d]", (int) index));
             properties.add(levelStr, String::Empty);
 
             getProperties(node, levelStr, properties);
             levelStr = temp;
         } else if (node.node->Type() == YAML::NodeType::Scalar) {
             String temp = levelStr;
-            levelStr.append(String::format("[%d]", index));
+            levelStr.append(String::format("[%d]", (int) index));
             properties.add(levelStr, node.node->as<string>());
             levelStr = temp;
 //#ifdef DEBUG
@@ -0,0 +1,265 @@
+//
+//  BufferedStreamTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "IO/BufferedStream.h"
+#include "IO/FileStream.h"
+#include "IO/MemoryStream.h"
+#include "IO/Path.h"
+#include "IO/File.h"
+#include "IO/Directory.h"
+#include "system/Environment.h"
+
+using namespace IO;
+using namespace System;
+
+static const String _path = Path::combine(Path::getTempPath(), "bufferedstream_test");
+
+void cleanUp() {
+    if (Directory::exists(_path)) {
+        Directory::deleteDirectory(_path);
+    }
+}
+
+void setUp() {
+    cleanUp();
+
+    if (!Directory::exists(_path)) {
+        Directory::createDirectory(_path);
+    }
+}
+
+// 24 bytes of the mixed primitives.
+static const size_t RecordSize = 24;
+
+void writeRecord(Stream &stream, int i) {
+    stream.writeInt32(i);
+    stream.writeUInt16((uint16_t) i);
+    stream.writeBCDByte((uint8_t) (i % 100));
+    stream.writeDouble(i * 0.5);
+    stream.writeInt64((int64_t) i * 1000);
+    stream.writeByte((uint8_t) i);
+}
+
+bool readRecord(Stream &stream, int i) {
+    return stream.readInt32() == i &&
+           stream.readUInt16() == (uint16_t) i &&
+           stream.readBCDByte() == (uint8_t) (i % 100) &&
+           stream.readDouble() == i * 0.5 &&
+           stream.readInt64() == (int64_t) i * 1000 &&
+           stream.readByte() == (uint8_t) i;
+}
+
+bool testReadWrite() {
+    String fileName = Path::combine(_path, "test.bin");
+    {
+        FileStream fs(fileName, FileMode::FileCreate, FileAccess::FileWrite);
+        // the records cross the buffer boundaries.
+        BufferedStream bs(&fs, 100);
+        for (int i = 0; i < 1000; i++) {
+            writeRecord(bs, i);
+        }
+        if (bs.position() != (off_t) (1000 * RecordSize) || bs.length() != 1000 * RecordSize) {
+            return false;
+        }
+        // larger than the buffer, written through.
+        uint8_t buffer[256];
+        memset(buffer, 0xAA, sizeof(buffer));
+        bs.write(buffer, 0, sizeof(buffer));
+    }
+    if (File::getLength(fileName) != (int64_t) (1000 * RecordSize + 256)) {
+        return false;
+    }
+    {
+        FileStream fs(fileName, FileMode::FileOpen, FileAccess::FileRead);
+        fs.setSequential();
+        BufferedStream bs(&fs, 100);
+        for (int i = 0; i < 1000; i++) {
+            if (!readRecord(bs, i)) {
+                return false;
+            }
+        }
+        uint8_t buffer[300];
+        if (bs.read(buffer, 0, sizeof(buffer)) != 256 || buffer[0] != 0xAA || buffer[255] != 0xAA) {
+            return false;
+        }
+        if (!bs.isEnd()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testSeek() {
+    MemoryStream ms;
+    BufferedStream bs(&ms, 16);
+    for (int i = 0; i < 10; i++) {
+        bs.writeInt32(i);
+    }
+    // the writes are still in the buffer.
+    if (bs.position() != 40 || bs.length() != 40) {
+        return false;
+    }
+
+    bs.seek(8, SeekBegin);
+    if (bs.readInt32() != 2 || bs.position() != 12) {
+        return false;
+    }
+    bs.seek(4, SeekCurrent);
+    if (bs.readInt32() != 4 || bs.position() != 20) {
+        return false;
+    }
+
+    // the write after a read goes to the position of the reader.
+    bs.writeInt32(100);
+    bs.flush();
+    if (ms.length() != 40) {
+        return false;
+    }
+    bs.seek(20, SeekBegin);
+    if (bs.readInt32() != 100 || bs.readInt32() != 6) {
+        return false;
+    }
+
+    bs.seek(0, SeekEnd);
+    bs.writeInt32(10);
+    if (bs.length() != 44) {
+        return false;
+    }
+    bs.flush();
+    if (ms.length() != 44) {
+        return false;
+    }
+
+    return true;
+}
+
+// A memory stream which can not seek, like a pipe.
+class SequentialStream : public MemoryStream {
+public:
+    off_t seek(off_t offset, SeekOrigin origin) override {
+        return -1;
+    }
+
+    bool canSeek() const override {
+        return false;
+    }
+};
+
+bool testNotSeekable() {
+    SequentialStream ss;
+    for (int i = 0; i < 10; i++) {
+        ss.writeInt32(i);
+    }
+    ss.MemoryStream::seek(0, SeekBegin);
+
+    BufferedStream bs(&ss, 16);
+    if (bs.readInt32() != 0) {
+        return false;
+    }
+    // the read-ahead bytes can not be given back, the write is refused and they are kept.
+    if (bs.write((const uint8_t *) "abcd", 0, 4) != -1) {
+        return false;
+    }
+    for (int i = 1; i < 10; i++) {
+        if (bs.readInt32() != i) {
+            return false;
+        }
+    }
+
+    // nothing unread, the write goes on.
+    if (bs.write((const uint8_t *) "abcd", 0, 4) != 4) {
+        return false;
+    }
+    bs.flush();
+    if (ss.length() != 44) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testBenchmark() {
+    static const size_t Sizes[] = {10 * 1024 * 1024, 100 * 1024 * 1024};
+
+    String fileName = Path::combine(_path, "benchmark.bin");
+    for (size_t size: Sizes) {
+        int count = (int) (size / RecordSize);
+        if (size <= 10 * 1024 * 1024) {
+            FileStream fs(fileName, FileMode::FileCreate, FileAccess::FileWrite);
+            uint64_t start = Environment::getTickCount();
+            for (int i = 0; i < count; i++) {
+                writeRecord(fs, i);
+            }
+            fs.close();
+            uint64_t elapsed = Environment::getTickCount() - start;
+            printf("FileStream, write %d MB of primitives: %llu ms\n", (int) (size / 1024 / 1024),
+                   (unsigned long long) elapsed);
+        }
+        {
+            FileStream fs(fileName, FileMode::FileCreate, FileAccess::FileWrite);
+            BufferedStream bs(&fs);
+            uint64_t start = Environment::getTickCount();
+            for (int i = 0; i < count; i++) {
+                writeRecord(bs, i);
+            }
+            bs.close();
+            uint64_t elapsed = Environment::getTickCount() - start;
+            printf("BufferedStream, write %d MB of primitives: %llu ms\n", (int) (size / 1024 / 1024),
+                   (unsigned long long) elapsed);
+        }
+        if (File::getLength(fileName) != (int64_t) (count * RecordSize)) {
+            return false;
+        }
+        {
+            FileStream fs(fileName, FileMode::FileOpen, FileAccess::FileRead);
+            fs.setSequential();
+            BufferedStream bs(&fs);
+            uint64_t start = Environment::getTickCount();
+            for (int i = 0; i < count; i++) {
+                if (!readRecord(bs, i)) {
+                    return false;
+                }
+            }
+            uint64_t elapsed = Environment::getTickCount() - start;
+            printf("BufferedStream, read %d MB of primitives: %llu ms\n", (int) (size / 1024 / 1024),
+                   (unsigned long long) elapsed);
+        }
+    }
+    File::deleteFile(fileName);
+
+    return true;
+}
+
+int main() {
+    setUp();
+
+    if (!testReadWrite()) {
+        cleanUp();
+        return 1;
+    }
+
+    if (!testSeek()) {
+        cleanUp();
+        return 2;
+    }
+
+    if (!testBenchmark()) {
+        cleanUp();
+        return 3;
+    }
+
+    if (!testNotSeekable()) {
+        cleanUp();
+        return 4;
+    }
+
+    cleanUp();
+
+    return 0;
+}
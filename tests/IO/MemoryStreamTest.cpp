@@ -6,8 +6,10 @@
 //
 
 #include "IO/MemoryStream.h"
+#include "system/Environment.h"
 
 using namespace IO;
+using namespace System;
 
 bool testConstructor() {
     {
@@ -202,6 +204,147 @@ bool testCopyTo() {
     return true;
 }
 
+bool testBulkPrimitives() {
+    static const bool Endians[] = {true, false};
+
+    for (bool bigEndian: Endians) {
+        int32_t ints[100];
+        double doubles[100];
+        uint16_t shorts[100];
+        for (int i = 0; i < 100; i++) {
+            ints[i] = i * 100000 - 5;
+            doubles[i] = i * 1.25;
+            shorts[i] = (uint16_t) (i * 600);
+        }
+
+        MemoryStream ms;
+        if (!ms.writeInt32s(ints, 100, bigEndian) || !ms.writeDoubles(doubles, 100, bigEndian) ||
+            !ms.writeUInt16s(shorts, 100, bigEndian)) {
+            return false;
+        }
+        if (ms.length() != 100 * (4 + 8 + 2)) {
+            return false;
+        }
+
+        // the same bytes as the single primitives.
+        ms.seek(0, SeekBegin);
+        for (int i = 0; i < 100; i++) {
+            if (ms.readInt32(bigEndian) != ints[i]) {
+                return false;
+            }
+        }
+        for (int i = 0; i < 100; i++) {
+            if (ms.readDouble(bigEndian) != doubles[i]) {
+                return false;
+            }
+        }
+        for (int i = 0; i < 100; i++) {
+            if (ms.readUInt16(bigEndian) != shorts[i]) {
+                return false;
+            }
+        }
+
+        ms.seek(0, SeekBegin);
+        int32_t ints2[100];
+        double doubles2[100];
+        uint16_t shorts2[100];
+        if (ms.readInt32s(ints2, 100, bigEndian) != 100 || ms.readDoubles(doubles2, 100, bigEndian) != 100 ||
+            ms.readUInt16s(shorts2, 100, bigEndian) != 100) {
+            return false;
+        }
+        if (memcmp(ints, ints2, sizeof(ints)) != 0 || memcmp(doubles, doubles2, sizeof(doubles)) != 0 ||
+            memcmp(shorts, shorts2, sizeof(shorts)) != 0) {
+            return false;
+        }
+
+        // only the whole values at the end.
+        uint64_t longs[10];
+        ms.seek(-12, SeekEnd);
+        if (ms.readUInt64s(longs, 10, bigEndian) != 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testBulkBenchmark() {
+    static const size_t Count = 1000000;
+    static const bool Endians[] = {true, false};
+
+    auto *values = new float[Count];
+    for (size_t i = 0; i < Count; i++) {
+        values[i] = (float) i * 0.5f;
+    }
+    bool result = true;
+    for (bool bigEndian: Endians) {
+        MemoryStream ms(Count * sizeof(float));
+        uint64_t start = Environment::getTickCount();
+        for (size_t i = 0; i < Count; i++) {
+            ms.writeFloat(values[i], bigEndian);
+        }
+        uint64_t elapsed = Environment::getTickCount() - start;
+
+        MemoryStream ms2(Count * sizeof(float));
+        start = Environment::getTickCount();
+        ms2.writeFloats(values, Count, bigEndian);
+        uint64_t elapsed2 = Environment::getTickCount() - start;
+
+        ms2.seek(0, SeekBegin);
+        start = Environment::getTickCount();
+        for (size_t i = 0; i < Count; i++) {
+            if (ms2.readFloat(bigEndian) != values[i]) {
+                result = false;
+            }
+        }
+        uint64_t elapsed3 = Environment::getTickCount() - start;
+
+        auto *values2 = new float[Count];
+        ms2.seek(0, SeekBegin);
+        start = Environment::getTickCount();
+        if (ms2.readFloats(values2, Count, bigEndian) != Count) {
+            result = false;
+        }
+        uint64_t elapsed4 = Environment::getTickCount() - start;
+        if (memcmp(values, values2, Count * sizeof(float)) != 0) {
+            result = false;
+        }
+        delete[] values2;
+
+        printf("%s endian, %d floats, writeFloat: %llu ms, writeFloats: %llu ms, "
+               "readFloat: %llu ms, readFloats: %llu ms\n", bigEndian ? "big" : "little", (int) Count,
+               (unsigned long long) elapsed, (unsigned long long) elapsed2,
+               (unsigned long long) elapsed3, (unsigned long long) elapsed4);
+    }
+    delete[] values;
+
+    return result;
+}
+
+bool testWriteBenchmark() {
+    static const size_t Counts[] = {1000, 100000, 1000000};
+
+    uint8_t buffer[16];
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t) i;
+    }
+    for (size_t count: Counts) {
+        MemoryStream ms;
+        uint64_t start = Environment::getTickCount();
+        for (size_t i = 0; i < count; i++) {
+            ms.writeInt32((int) i);
+            ms.write(buffer, 0, sizeof(buffer));
+        }
+        printf("MemoryStream, write %d records: %llu ms\n", (int) count,
+               (unsigned long long) (Environment::getTickCount() - start));
+        if (ms.length() != count * (4 + sizeof(buffer))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     if (!testConstructor()) {
         return 1;
@@ -223,5 +366,17 @@ int main() {
         return 5;
     }
 
+    if (!testWriteBenchmark()) {
+        return 6;
+    }
+
+    if (!testBulkPrimitives()) {
+        return 7;
+    }
+
+    if (!testBulkBenchmark()) {
+        return 8;
+    }
+
     return 0;
 }
\ No newline at end of file
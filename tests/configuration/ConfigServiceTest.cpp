@@ -13,6 +13,7 @@
 #include "IO/Path.h"
 #include "IO/File.h"
 #include "IO/Directory.h"
+#include "system/Environment.h"
 
 using namespace Data;
 using namespace Net;
@@ -232,6 +233,169 @@ bool testRetrieveVariable() {
     return true;
 }
 
+// Reads the properties of another service without the snapshot, as before.
+class PlainConfigService : public IConfigService {
+public:
+    using IConfigService::getProperty;
+
+    explicit PlainConfigService(const YmlNode::Properties &properties) : _properties(properties) {
+    }
+
+    const YmlNode::Properties &properties() const override {
+        return _properties;
+    }
+
+    bool updateConfigFile(const YmlNode::Properties &) override {
+        return false;
+    }
+
+    bool setProperty(const String &key, const String &value) override {
+        _properties.add(key, value);
+        return true;
+    }
+
+private:
+    YmlNode::Properties _properties;
+};
+
+void onConfigChanged(void *owner, void *, EventArgs *args) {
+    auto changed = dynamic_cast<ConfigChangedEventArgs *>(args);
+    if (changed != nullptr) {
+        ((StringArray *) owner)->addRange(changed->keys);
+    }
+}
+
+bool testSnapshot() {
+    static int argc = 1;
+    static const char *argv[] = {"ConfigServiceTest"};
+    Application app(argc, argv, _rootPath);
+    String ymlFileName = Path::combine(_rootPath, "application.yml");
+    YmlNode::Properties properties;
+    properties.add("server.port", "8080");
+    properties.add("server.http.session.enabled", "true");
+    properties.add("server.http.session.ratio", "0.5");
+    properties.add("server.http.name", "${test.name:abc}");
+    if (!YmlNode::updateFile(ymlFileName, properties)) {
+        return false;
+    }
+
+    ConfigService cs;
+    if (cs.snapshot() != nullptr) {
+        return false;
+    }
+    // resolved before the service is initialized.
+    ConfigHandle port = cs.getHandle("server.port");
+    if (!cs.initialize()) {
+        return false;
+    }
+    const ConfigSnapshot *snapshot = cs.snapshot();
+    if (snapshot == nullptr || snapshot->version() != 1) {
+        return false;
+    }
+
+    int32_t value = 0;
+    uint16_t portValue = 0;
+    if (!(cs.getProperty(port, value) && value == 8080 && cs.getProperty(port, portValue) && portValue == 8080)) {
+        return false;
+    }
+    uint8_t byteValue = 0;
+    if (cs.getProperty(port, byteValue)) {
+        // out of range.
+        return false;
+    }
+    bool enabled = false;
+    if (!(cs.getProperty("server.http.session.enabled", enabled) && enabled)) {
+        return false;
+    }
+    double ratio = 0;
+    if (!(cs.getProperty(cs.getHandle("server.http.session.ratio"), ratio) && ratio == 0.5)) {
+        return false;
+    }
+    String name;
+    if (!(cs.getProperty("server.http.name", name) && name == "abc")) {
+        return false;
+    }
+
+    // the handle of a key added later.
+    ConfigHandle timeout = cs.getHandle("server.http.timeout");
+    if (cs.getProperty(timeout, value) || cs.contains("server.http.timeout")) {
+        return false;
+    }
+    StringArray changedKeys;
+    cs.changedDelegates()->add(&changedKeys, onConfigChanged);
+    cs.setProperty("server.http.timeout", 30);
+    cs.setProperty("server.port", "8080");
+    if (!(cs.getProperty(timeout, value) && value == 30)) {
+        return false;
+    }
+    if (changedKeys.count() != 1 || changedKeys[0] != "server.http.timeout") {
+        return false;
+    }
+    // the old snapshot is still readable.
+    if (snapshot->getValue(timeout, value) || cs.snapshot()->version() != 3) {
+        return false;
+    }
+
+    // the current snapshot is retired, still readable after the service is uninitialized.
+    const ConfigSnapshot *current = cs.snapshot();
+    cs.unInitialize();
+    if (cs.snapshot() != nullptr) {
+        return false;
+    }
+    return current->getValue(port, value) && value == 8080;
+}
+
+bool testSnapshotBenchmark() {
+    static const int Count = 1000000;
+    static int argc = 1;
+    static const char *argv[] = {"ConfigServiceTest"};
+    Application app(argc, argv, _rootPath);
+    String ymlFileName = Path::combine(_rootPath, "application.yml");
+    YmlNode::Properties properties;
+    for (int i = 0; i < 200; i++) {
+        properties.add(String::format("summer.test.group%d.value%d", i % 10, i), Int32(i).toString());
+    }
+    properties.add("server.http.session.timeout", "3600");
+    if (!YmlNode::updateFile(ymlFileName, properties)) {
+        return false;
+    }
+    ConfigService cs;
+    if (!cs.initialize()) {
+        return false;
+    }
+    PlainConfigService plain(cs.properties());
+
+    int64_t sum = 0;
+    int32_t value = 0;
+    uint64_t start = Environment::getTickCount();
+    for (int i = 0; i < Count; i++) {
+        plain.getProperty("server.http.session.timeout", value);
+        sum += value;
+    }
+    uint64_t elapsed = Environment::getTickCount() - start;
+    printf("getProperty(key, int32) with parsing: %.1f ns\n", (double) elapsed * 1000000.0 / Count);
+
+    start = Environment::getTickCount();
+    for (int i = 0; i < Count; i++) {
+        cs.getProperty("server.http.session.timeout", value);
+        sum += value;
+    }
+    elapsed = Environment::getTickCount() - start;
+    printf("getProperty(key, int32) from the snapshot: %.1f ns\n", (double) elapsed * 1000000.0 / Count);
+
+    ConfigHandle handle = cs.getHandle("server.http.session.timeout");
+    start = Environment::getTickCount();
+    for (int i = 0; i < Count; i++) {
+        cs.getProperty(handle, value);
+        sum += value;
+    }
+    elapsed = Environment::getTickCount() - start;
+    printf("getProperty(handle, int32) from the snapshot: %.1f ns\n", (double) elapsed * 1000000.0 / Count);
+
+    cs.unInitialize();
+    return sum == (int64_t) Count * 3 * 3600;
+}
+
 int main() {
     int result = 0;
     if (!testConstructor()) {
@@ -255,6 +419,12 @@ int main() {
     if (!testRetrieveVariable()) {
         result = 7;
     }
+    if (!testSnapshot()) {
+        result = 8;
+    }
+    if (!testSnapshotBenchmark()) {
+        result = 9;
+    }
 
     cleanUp();
 
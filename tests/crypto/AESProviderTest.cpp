@@ -8,9 +8,11 @@
 
 #include "crypto/AESProvider.h"
 #include "IO/FileStream.h"
+#include "system/Environment.h"
 
 using namespace Crypto;
 using namespace IO;
+using namespace System;
 
 static const char *_plainText = "ABC/abc123,)_中文";
 static const ByteArray _plainBuffer = {1, 2, 3, 4, 5, 6, 7, 8, 9, 0};
@@ -71,7 +73,8 @@ bool testAES_StringKey(AESProvider::KeySize keySizes) {
 
 bool testAES_Modes(AESProvider::KeySize keySizes) {
     static const CypherMode modes[] = {CypherMode::CBC, CypherMode::ECB,
-                                       CypherMode::OFB, CypherMode::CFB};
+                                       CypherMode::OFB, CypherMode::CFB,
+                                       CypherMode::CTR, CypherMode::GCM};
     for (auto mode: modes) {
         {
             AESProvider test(keySizes, AES_Keys[keySizes], AES_IV);
@@ -125,6 +128,22 @@ bool testAES_Modes(AESProvider::KeySize keySizes) {
         }
     }
 
+    // each GCM message has its own nonce, the same plain text is not encrypted to the same one.
+    {
+        AESProvider test(keySizes, AES_Keys[keySizes], AES_IV);
+        test.setMode(CypherMode::GCM);
+
+        ByteArray data1, data2;
+        if (!test.encrypt(_plainBuffer, data1) || !test.encrypt(_plainBuffer, data2) || data1 == data2) {
+            return false;
+        }
+        ByteArray plain1, plain2;
+        if (!test.decrypt(data1, plain1) || !test.decrypt(data2, plain2) ||
+            plain1 != _plainBuffer || plain2 != _plainBuffer) {
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -212,6 +231,195 @@ bool testAES_Base64(AESProvider::KeySize keySizes) {
     return true;
 }
 
+bool testAES_Context(AESProvider::KeySize keySizes) {
+    static const CypherMode modes[] = {CypherMode::CBC, CypherMode::CTR, CypherMode::GCM};
+    ByteArray message;
+    for (int i = 0; i < 1000; i++) {
+        message.add((uint8_t) (i * 7));
+    }
+
+    for (auto mode: modes) {
+        AESProvider test(keySizes, AES_Keys[keySizes], AES_IV);
+        test.setMode(mode);
+        CipherContext encryptor(test, true);
+        CipherContext decryptor(test, false);
+        if (!encryptor.isValid() || !decryptor.isValid()) {
+            return false;
+        }
+
+        // the contexts are reused by the messages, each one has its own IV.
+        ByteArray iv;
+        for (int i = 0; i < 3; i++) {
+            uint8_t ivData[16];
+            memcpy(ivData, AES_IV.data(), sizeof(ivData));
+            ivData[15] ^= (uint8_t) (i + 1);
+            iv = ByteArray(ivData, sizeof(ivData));
+
+            uint8_t buffer[1000 + 32];
+            memcpy(buffer, message.data(), message.count());
+
+            // in place, in the parts of 100 bytes.
+            if (!encryptor.init(iv)) {
+                return false;
+            }
+            size_t length = 0;
+            for (size_t offset = 0; offset < message.count(); offset += 100) {
+                size_t len = 0;
+                if (!encryptor.update(buffer + offset, 100, buffer + length, len)) {
+                    return false;
+                }
+                length += len;
+            }
+            size_t finalLength = 0;
+            if (!encryptor.final(buffer + length, finalLength)) {
+                return false;
+            }
+            length += finalLength;
+            uint8_t tag[CipherContext::TagSize];
+            if (mode == CypherMode::GCM && !encryptor.getTag(tag)) {
+                return false;
+            }
+
+            // the same as the one of the algorithm, GCM of it has a random nonce before the cipher text and the tag.
+            AESProvider expectTest(keySizes, AES_Keys[keySizes], iv);
+            expectTest.setMode(mode);
+            ByteArray expect;
+            if (!expectTest.encrypt(message, expect)) {
+                return false;
+            }
+            if (mode == CypherMode::GCM) {
+                ByteArray plain;
+                if (expect.count() != iv.count() + length + CipherContext::TagSize ||
+                    !expectTest.decrypt(expect, plain) || plain != message) {
+                    return false;
+                }
+            } else if (expect.count() != length || memcmp(expect.data(), buffer, length) != 0) {
+                return false;
+            }
+
+            if (!decryptor.init(iv)) {
+                return false;
+            }
+            if (mode == CypherMode::GCM && !decryptor.setTag(tag)) {
+                return false;
+            }
+            size_t plainLength = 0;
+            if (!decryptor.update(buffer, length, buffer, plainLength) ||
+                !decryptor.final(buffer + plainLength, finalLength)) {
+                return false;
+            }
+            plainLength += finalLength;
+            if (plainLength != message.count() || memcmp(buffer, message.data(), plainLength) != 0) {
+                return false;
+            }
+        }
+
+        // the IV of the algorithm, or the one of the last message, reuses the key stream.
+        bool stream = mode != CypherMode::CBC;
+        if (encryptor.init() == stream || encryptor.init(iv) == stream) {
+            return false;
+        }
+    }
+
+    // the GCM message with the additional data, the tampered one fails.
+    {
+        AESProvider test(keySizes, AES_Keys[keySizes], AES_IV);
+        test.setMode(CypherMode::GCM);
+        CipherContext encryptor(test, true);
+        CipherContext decryptor(test, false);
+        static const uint8_t iv[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        static const uint8_t aad[4] = {0xAA, 0xBB, 0xCC, 0xDD};
+
+        uint8_t buffer[1000];
+        size_t length = 0, finalLength = 0;
+        uint8_t tag[CipherContext::TagSize];
+        if (!encryptor.init(iv, sizeof(iv)) || !encryptor.updateAad(aad, sizeof(aad)) ||
+            !encryptor.update(message.data(), message.count(), buffer, length) ||
+            !encryptor.final(buffer + length, finalLength) || !encryptor.getTag(tag)) {
+            return false;
+        }
+
+        uint8_t plain[1000];
+        if (!decryptor.init(iv, sizeof(iv)) || !decryptor.updateAad(aad, sizeof(aad)) || !decryptor.setTag(tag) ||
+            !decryptor.update(buffer, length, plain, length) || !decryptor.final(plain + length, finalLength)) {
+            return false;
+        }
+        if (memcmp(plain, message.data(), message.count()) != 0) {
+            return false;
+        }
+
+        buffer[10] ^= 1;
+        if (!decryptor.init(iv, sizeof(iv)) || !decryptor.updateAad(aad, sizeof(aad)) || !decryptor.setTag(tag) ||
+            !decryptor.update(buffer, length, plain, length)) {
+            return false;
+        }
+        if (decryptor.final(plain + length, finalLength)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testBenchmark() {
+    static const size_t Sizes[] = {64, 1024, 1024 * 1024};
+    static const CypherMode modes[] = {CypherMode::CBC, CypherMode::CTR, CypherMode::GCM};
+    static const char *modeNames[] = {"CBC", "CTR", "GCM"};
+
+    for (size_t size: Sizes) {
+        int count = (int) (256 * 1024 * 1024 / (size * 4));
+        if (count > 200000) {
+            count = 200000;
+        }
+        ByteArray message;
+        for (size_t i = 0; i < size; i++) {
+            message.add((uint8_t) i);
+        }
+        auto buffer = new uint8_t[size + 32];
+
+        for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+            AESProvider test(AESProvider::Aes256, AES_Keys[AESProvider::Aes256], AES_IV);
+            test.setMode(modes[m]);
+
+            ByteArray output;
+            uint64_t start = Environment::getTickCount();
+            for (int i = 0; i < count; i++) {
+                if (!test.encrypt(message, output)) {
+                    delete[] buffer;
+                    return false;
+                }
+            }
+            uint64_t elapsed1 = Environment::getTickCount() - start;
+
+            // a counter in the IV, each message has its own.
+            CipherContext context(test, true);
+            uint8_t iv[16];
+            memcpy(iv, AES_IV.data(), sizeof(iv));
+            memcpy(buffer, message.data(), size);
+            start = Environment::getTickCount();
+            for (int i = 0; i < count; i++) {
+                size_t length = 0, finalLength = 0;
+                memcpy(iv + 12, &i, sizeof(i));
+                if (!context.init(iv, sizeof(iv)) || !context.update(buffer, size, buffer, length) ||
+                    !context.final(buffer + length, finalLength)) {
+                    delete[] buffer;
+                    return false;
+                }
+            }
+            uint64_t elapsed2 = Environment::getTickCount() - start;
+
+            elapsed1 = elapsed1 > 0 ? elapsed1 : 1;
+            elapsed2 = elapsed2 > 0 ? elapsed2 : 1;
+            printf("AES-256-%s, %d B x %d: encrypt %.1f MB/s, %.2f us/message; context %.1f MB/s, %.2f us/message\n",
+                   modeNames[m], (int) size, count,
+                   (double) size * count / (double) elapsed1 / 1000.0, (double) elapsed1 * 1000.0 / count,
+                   (double) size * count / (double) elapsed2 / 1000.0, (double) elapsed2 * 1000.0 / count);
+        }
+        delete[] buffer;
+    }
+    return true;
+}
+
 int main() {
     static const AESProvider::KeySize keySizes[] = {
             AESProvider::Aes128,
@@ -230,6 +438,12 @@ int main() {
         if (!testAES_Base64(keySize)) {
             return 4;
         }
+        if (!testAES_Context(keySize)) {
+            return 5;
+        }
+    }
+    if (!testBenchmark()) {
+        return 6;
     }
 
     return 0;
@@ -10,8 +10,10 @@
 #include "IO/FileStream.h"
 #include "IO/Path.h"
 #include "IO/File.h"
+#include "system/Environment.h"
 
 using namespace Crypto;
+using namespace System;
 
 static const String _plainText = "ABC/abc123,)_中文";
 
@@ -45,6 +47,129 @@ bool testMd5_file() {
     return true;
 }
 
+bool testMd5_context() {
+    Md5Provider md5;
+    HashContext context(md5);
+    String cypherText;
+    // not started.
+    if (context.update(_plainText) || context.final(cypherText)) {
+        return false;
+    }
+
+    // the parts of the text in 100 times.
+    if (!context.init()) {
+        return false;
+    }
+    ByteArray buffer((const uint8_t *) _plainText.c_str(), _plainText.length());
+    for (int i = 0; i < 100; ++i) {
+        if (!context.update(buffer.data(), 5) ||
+            !context.update(buffer.data() + 5, buffer.count() - 5)) {
+            return false;
+        }
+    }
+    if (!context.final(cypherText) || context.isStarted()) {
+        return false;
+    }
+    if (cypherText != "463E0E11B9A09B5C33D82FD9BB351BBA") {
+        return false;
+    }
+
+    // init again.
+    if (!context.init() || !context.update(_plainText) || !context.final(cypherText)) {
+        return false;
+    }
+    if (cypherText != "0587236E6F70BFB675B3BBD33BA5C095") {
+        return false;
+    }
+    return true;
+}
+
+bool testMd5_files() {
+    Md5Provider md5;
+    StringArray fileNames;
+    for (int i = 0; i < 10; ++i) {
+        String fileName = Path::combine(Path::getTempPath(), String::convert("test_md5_file%d.txt", i));
+        FileStream fs(fileName, FileMode::FileCreate, FileAccess::FileWrite);
+        for (int j = 0; j < 100 * (i + 1); ++j) {
+            fs.writeText(_plainText);
+        }
+        fs.close();
+        fileNames.add(fileName);
+    }
+    fileNames.add(Path::combine(Path::getTempPath(), "test_md5_not_exist.txt"));
+
+    StringArray cypherTexts;
+    // false for the last one.
+    if (md5.computeFileHashes(fileNames, cypherTexts, 4)) {
+        return false;
+    }
+    if (cypherTexts.count() != fileNames.count() || !cypherTexts[10].isNullOrEmpty()) {
+        return false;
+    }
+    bool matched = true;
+    for (size_t i = 0; i < fileNames.count() - 1; ++i) {
+        String expect;
+        md5.computeFileHash(fileNames[i], expect);
+        if (cypherTexts[i] != expect) {
+            matched = false;
+        }
+        File::deleteFile(fileNames[i]);
+    }
+    if (!matched) {
+        return false;
+    }
+    if (cypherTexts[0] != "463E0E11B9A09B5C33D82FD9BB351BBA") {
+        return false;
+    }
+    return true;
+}
+
+bool testBenchmark() {
+    static const int FileCount = 8;
+    static const int FileLength = 32 * 1024 * 1024;
+
+    Md5Provider md5;
+    StringArray fileNames;
+    auto buffer = new uint8_t[FileLength];
+    for (int i = 0; i < FileLength; ++i) {
+        buffer[i] = (uint8_t) (i * 31 + (i >> 8));
+    }
+    for (int i = 0; i < FileCount; ++i) {
+        String fileName = Path::combine(Path::getTempPath(), String::convert("test_md5_benchmark%d.bin", i));
+        FileStream fs(fileName, FileMode::FileCreate, FileAccess::FileWrite);
+        fs.write(buffer, 0, FileLength);
+        fs.close();
+        fileNames.add(fileName);
+    }
+    delete[] buffer;
+
+    StringArray expects;
+    uint64_t start = Environment::getTickCount();
+    for (int i = 0; i < FileCount; ++i) {
+        String cypherText;
+        md5.computeFileHash(fileNames[i], cypherText);
+        expects.add(cypherText);
+    }
+    uint64_t elapsed = Environment::getTickCount() - start;
+    printf("computeFileHash, %d files of %d MB: %llu ms\n", FileCount, FileLength / 1024 / 1024,
+           (unsigned long long) elapsed);
+
+    StringArray cypherTexts;
+    start = Environment::getTickCount();
+    bool result = md5.computeFileHashes(fileNames, cypherTexts);
+    elapsed = Environment::getTickCount() - start;
+    printf("computeFileHashes, %d files of %d MB: %llu ms\n", FileCount, FileLength / 1024 / 1024,
+           (unsigned long long) elapsed);
+
+    for (int i = 0; i < FileCount; ++i) {
+        if (cypherTexts[i] != expects[i]) {
+            result = false;
+        }
+        File::deleteFile(fileNames[i]);
+    }
+    return result;
+}
+
 int main() {
     if(!testMd5()) {
         return 1;
@@ -52,5 +177,14 @@ int main() {
     if(!testMd5_file()) {
         return 2;
     }
+    if(!testMd5_context()) {
+        return 3;
+    }
+    if(!testMd5_files()) {
+        return 4;
+    }
+    if(!testBenchmark()) {
+        return 5;
+    }
     return 0;
 }
\ No newline at end of file
@@ -61,6 +61,27 @@ bool testSHA_file(SHAProvider::KeySize keySize) {
     return true;
 }
 
+bool testSHA_context(SHAProvider::KeySize keySize) {
+    SHAProvider sha(keySize);
+    HashContext context(sha);
+    if (!context.init()) {
+        return false;
+    }
+    for (int i = 0; i < 100; ++i) {
+        if (!context.update(_plainText)) {
+            return false;
+        }
+    }
+    String cypherText;
+    if (!context.final(cypherText)) {
+        return false;
+    }
+    if (cypherText != _cypherFileTexts[keySize]) {
+        return false;
+    }
+    return true;
+}
+
 int main() {
     static const SHAProvider::KeySize keySizes[] = {
             SHAProvider::Key1,
@@ -77,6 +98,9 @@ int main() {
         if (!testSHA_file(keySize)) {
             return 2;
         }
+        if (!testSHA_context(keySize)) {
+            return 3;
+        }
     }
 
     return 0;
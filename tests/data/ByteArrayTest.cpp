@@ -69,6 +69,17 @@ bool testStream() {
         return false;
     }
 
+    // the count is larger than the data, only the data is read.
+    MemoryStream ms2;
+    ms2.writeUInt32(0xFFFFFFFF);
+    ms2.write(test.data(), 0, 10);
+    ms2.seek(0, SeekOrigin::SeekBegin);
+    ByteArray test3;
+    test3.read(&ms2);
+    if (test3.count() != 10 || test3.capacity() > 65535) {
+        return false;
+    }
+
     return true;
 }
 
@@ -0,0 +1,340 @@
+//
+//  ConcurrentLoopListTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "data/ConcurrentLoopList.h"
+#include "data/LoopVector.h"
+#include "data/PList.h"
+#include "thread/Thread.h"
+#include "system/Environment.h"
+#include <atomic>
+
+using namespace Data;
+
+bool testSpscConstructor() {
+    {
+        SpscLoopVector<int> test;
+        if (test.size() != 1024) {
+            return false;
+        }
+        if (!test.isEmpty()) {
+            return false;
+        }
+    }
+    {
+        SpscLoopVector<int> test(100);
+        if (test.size() != 128) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testSpscEnqueue() {
+    SpscLoopVector<int> test(16);
+    for (int i = 0; i < 16; i++) {
+        if (!test.enqueue(i)) {
+            return false;
+        }
+    }
+    if (!test.isFull() || test.count() != 16) {
+        return false;
+    }
+    if (test.enqueue(16)) {
+        return false;
+    }
+
+    int values[16];
+    test.copyTo(values);
+    for (int i = 0; i < 16; i++) {
+        if (values[i] != i) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testSpscDequeue() {
+    SpscLoopVector<int> test(16);
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 10; i++) {
+            test.enqueue(round * 10 + i);
+        }
+        int value;
+        if (!test.dequeue(value) || value != round * 10) {
+            return false;
+        }
+        int values[16];
+        if (test.dequeue(values, 16) != 9) {
+            return false;
+        }
+        for (int i = 0; i < 9; i++) {
+            if (values[i] != round * 10 + i + 1) {
+                return false;
+            }
+        }
+        if (test.dequeue(value)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testMpmcEnqueue() {
+    MpmcLoopVector<String> test(16);
+    for (int i = 0; i < 16; i++) {
+        if (!test.enqueue(Int32(i).toString())) {
+            return false;
+        }
+    }
+    if (!test.isFull() || test.enqueue("16")) {
+        return false;
+    }
+
+    String values[16];
+    if (test.copyTo(values) != 16) {
+        return false;
+    }
+    for (int i = 0; i < 16; i++) {
+        if (values[i] != Int32(i).toString()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testMpmcDequeue() {
+    MpmcLoopVector<String> test(16);
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 10; i++) {
+            test.enqueue(Int32(round * 10 + i).toString());
+        }
+        String value;
+        if (!test.dequeue(value) || value != Int32(round * 10).toString()) {
+            return false;
+        }
+        String values[4];
+        if (test.dequeue(values, 4) != 4 || values[3] != Int32(round * 10 + 4).toString()) {
+            return false;
+        }
+        if (test.dequeue(values, 4) != 4) {
+            return false;
+        }
+        if (test.dequeue(values, 4) != 1 || values[0] != Int32(round * 10 + 9).toString()) {
+            return false;
+        }
+        if (!test.isEmpty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testMpmcPList() {
+    struct Item {
+        explicit Item(int value) : value(value) {
+        }
+
+        int value;
+    };
+
+    MpmcLoopPList<Item> test(16);
+    for (int i = 0; i < 10; i++) {
+        test.enqueue(new Item(i));
+    }
+    Item *item = test.dequeue();
+    if (item == nullptr || item->value != 0) {
+        return false;
+    }
+    delete item;
+
+    Item *items[4];
+    if (test.dequeue(items, 4) != 4 || items[3]->value != 4) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) {
+        delete items[i];
+    }
+    if (test.count() != 5) {
+        return false;
+    }
+    // the others are deleted by the destructor.
+
+    return true;
+}
+
+bool testMpmcThreads() {
+    static const int ProducerCount = 4;
+    static const int ConsumerCount = 4;
+    static const int Count = 100000;
+
+    MpmcLoopVector<int> test(1024);
+    std::atomic<int64_t> sum(0);
+    std::atomic<int> received(0);
+
+    PList<Thread> threads;
+    for (int i = 0; i < ProducerCount; i++) {
+        auto thread = new Thread("producer", [&test]() {
+            for (int j = 1; j <= Count; j++) {
+                while (!test.enqueue(j)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.add(thread);
+    }
+    for (int i = 0; i < ConsumerCount; i++) {
+        auto thread = new Thread("consumer", [&test, &sum, &received]() {
+            int values[32];
+            while (received < ProducerCount * Count) {
+                size_t count = test.dequeue(values, 32);
+                for (size_t j = 0; j < count; j++) {
+                    sum += values[j];
+                }
+                if (count > 0) {
+                    received += (int) count;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        threads.add(thread);
+    }
+    for (size_t i = 0; i < threads.count(); i++) {
+        threads[i]->start();
+    }
+    threads.clear();
+
+    return sum == (int64_t) ProducerCount * Count * (Count + 1) / 2;
+}
+
+// producers enqueue, one consumer dequeues in batches.
+template<class Queue>
+static uint64_t runContention(Queue &queue, int producerCount, int count) {
+    std::atomic<int> received(0);
+    int total = producerCount * count;
+
+    uint64_t start = Environment::getTickCount();
+    PList<Thread> threads;
+    for (int i = 0; i < producerCount; i++) {
+        threads.add(new Thread("producer", [&queue, count]() {
+            for (int j = 0; j < count; j++) {
+                while (!queue.enqueue(j)) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    threads.add(new Thread("consumer", [&queue, &received, total]() {
+        int values[64];
+        while (received < total) {
+            size_t n = queue.dequeue(values, 64);
+            if (n > 0) {
+                received += (int) n;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }));
+    for (size_t i = 0; i < threads.count(); i++) {
+        threads[i]->start();
+    }
+    threads.clear();
+    return Environment::getTickCount() - start;
+}
+
+// LoopVector guarded by its own mutex, same as the current users.
+class LockedLoopVector {
+public:
+    explicit LockedLoopVector(size_t size) : _values(size) {
+    }
+
+    bool enqueue(int value) {
+        Locker locker(&_values);
+        if (_values.isFull()) {
+            return false;
+        }
+        _values.enqueue(value);
+        return true;
+    }
+
+    size_t dequeue(int *values, size_t count) {
+        Locker locker(&_values);
+        size_t n = 0;
+        while (n < count && !_values.isEmpty()) {
+            values[n++] = _values.front();
+            _values.dequeue();
+        }
+        return n;
+    }
+
+private:
+    LoopVector<int> _values;
+};
+
+bool testBenchmark() {
+    static const int Count = 1000000;
+    static const size_t Size = 4096;
+    static const int Producers[] = {1, 4, 16};
+
+    for (int producerCount : Producers) {
+        int count = Count / producerCount;
+        uint64_t lockedElapsed, mpmcElapsed;
+        {
+            LockedLoopVector queue(Size);
+            lockedElapsed = runContention(queue, producerCount, count);
+        }
+        {
+            MpmcLoopVector<int> queue(Size);
+            mpmcElapsed = runContention(queue, producerCount, count);
+        }
+        printf("producers: %d, values: %d, locked LoopVector: %llu ms, MpmcLoopVector: %llu ms\n",
+               producerCount, producerCount * count,
+               (unsigned long long) lockedElapsed, (unsigned long long) mpmcElapsed);
+        if (producerCount == 1) {
+            SpscLoopVector<int> queue(Size);
+            uint64_t elapsed = runContention(queue, 1, count);
+            printf("producers: 1, values: %d, SpscLoopVector: %llu ms\n", count, (unsigned long long) elapsed);
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    if (!testSpscConstructor()) {
+        return 1;
+    }
+    if (!testSpscEnqueue()) {
+        return 2;
+    }
+    if (!testSpscDequeue()) {
+        return 3;
+    }
+    if (!testMpmcEnqueue()) {
+        return 4;
+    }
+    if (!testMpmcDequeue()) {
+        return 5;
+    }
+    if (!testMpmcPList()) {
+        return 6;
+    }
+    if (!testMpmcThreads()) {
+        return 7;
+    }
+    if (!testBenchmark()) {
+        return 8;
+    }
+
+    return 0;
+}
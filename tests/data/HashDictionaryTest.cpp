@@ -0,0 +1,206 @@
+//
+//  HashDictionaryTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "data/HashDictionary.h"
+#include "data/Dictionary.h"
+#include "data/StringArray.h"
+#include "data/ValueType.h"
+#include "system/Environment.h"
+
+using namespace Data;
+using namespace System;
+
+typedef HashDictionary<String, String> StringHash;
+
+bool testConstructor() {
+    {
+        StringHash test;
+        if (!test.isEmpty() || test.count() != 0) {
+            return false;
+        }
+        if (test.contains("a")) {
+            return false;
+        }
+    }
+    {
+        StringHash test{{"a", "1"},
+                        {"b", "2"}};
+        if (test.count() != 2 || test["a"] != "1" || test["b"] != "2") {
+            return false;
+        }
+        StringHash test2(test);
+        if (test2 != test) {
+            return false;
+        }
+        StringHash test3(std::move(test2));
+        if (test3 != test || !test2.isEmpty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testAdd() {
+    StringHash test;
+    for (int i = 0; i < 1000; i++) {
+        test.add(Int32(i).toString(), Int32(i * 2).toString());
+    }
+    if (test.count() != 1000) {
+        return false;
+    }
+    for (int i = 0; i < 1000; i++) {
+        String value;
+        if (!test.at(Int32(i).toString(), value) || value != Int32(i * 2).toString()) {
+            return false;
+        }
+    }
+    test.add("1", "one");
+    if (test.count() != 1000 || test.at("1") != "one") {
+        return false;
+    }
+    if (!test.contains("1", "one") || test.contains("1", "1")) {
+        return false;
+    }
+    if (test.set("abc", "1") || !test.set("1", "2") || test.at("1") != "2") {
+        return false;
+    }
+    test["abc"] = "x";
+    if (test.count() != 1001 || test.at("abc") != "x") {
+        return false;
+    }
+
+    return true;
+}
+
+bool testRemove() {
+    HashDictionary<int, int> test;
+    for (int i = 0; i < 1000; i++) {
+        test.add(i, i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        if (!test.remove(i)) {
+            return false;
+        }
+    }
+    if (test.remove(0) || test.count() != 500) {
+        return false;
+    }
+    for (int i = 0; i < 1000; i++) {
+        if (test.contains(i) != (i % 2 == 1)) {
+            return false;
+        }
+    }
+    test.clear();
+    if (!test.isEmpty() || test.contains(1)) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testIterator() {
+    StringHash test;
+    for (int i = 0; i < 100; i++) {
+        test.add(Int32(i).toString(), Int32(i).toString());
+    }
+    size_t count = 0;
+    for (auto it = test.begin(); it != test.end(); ++it) {
+        if (it.key() != it.value()) {
+            return false;
+        }
+        count++;
+    }
+    if (count != 100) {
+        return false;
+    }
+    for (auto it = test.begin(); it != test.end(); ++it) {
+        it.value() = "x";
+    }
+    if (test.at("50") != "x") {
+        return false;
+    }
+
+    StringArray keys;
+    test.keys(keys, true);
+    if (keys.count() != 100) {
+        return false;
+    }
+    for (size_t i = 1; i < keys.count(); i++) {
+        if (!(keys[i - 1] < keys[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<class T>
+static bool runBenchmark(const char *name, const StringArray &keys, size_t lookups) {
+    uint64_t start = Environment::getTickCount();
+    T test;
+    for (size_t i = 0; i < keys.count(); i++) {
+        test.add(keys[i], keys[i]);
+    }
+    uint64_t insertElapsed = Environment::getTickCount() - start;
+
+    start = Environment::getTickCount();
+    size_t found = 0;
+    String value;
+    for (size_t i = 0; i < lookups; i++) {
+        // fresh String in scattered order, so the lookup pays the hash and the cache misses as a real request does.
+        String key(keys[(i * 7919) % keys.count()].c_str());
+        if (test.at(key, value)) {
+            found++;
+        }
+    }
+    uint64_t lookupElapsed = Environment::getTickCount() - start;
+    printf("%s, entries: %d, insert: %llu ms, %d lookups: %llu ms\n", name, (int) keys.count(),
+           (unsigned long long) insertElapsed, (int) lookups, (unsigned long long) lookupElapsed);
+    return found == lookups;
+}
+
+bool testBenchmark() {
+    static const size_t Sizes[] = {10, 1000, 1000000};
+    static const size_t Lookups = 1000000;
+
+    for (size_t size : Sizes) {
+        StringArray keys(size);
+        for (size_t i = 0; i < size; i++) {
+            keys.add(String::format("server.http.property%d", (int) i));
+        }
+        if (!runBenchmark<Dictionary<String, String>>("Dictionary", keys, Lookups)) {
+            return false;
+        }
+        if (!runBenchmark<HashDictionary<String, String>>("HashDictionary", keys, Lookups)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    if (!testConstructor()) {
+        return 1;
+    }
+    if (!testAdd()) {
+        return 2;
+    }
+    if (!testRemove()) {
+        return 3;
+    }
+    if (!testIterator()) {
+        return 4;
+    }
+    if (!testBenchmark()) {
+        return 5;
+    }
+
+    return 0;
+}
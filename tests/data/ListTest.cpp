@@ -7,8 +7,12 @@
 //
 
 #include "data/List.h"
+#include "data/PList.h"
+#include "data/Vector.h"
+#include "data/Dictionary.h"
 #include "data/ValueType.h"
 #include "thread/Thread.h"
+#include "system/Environment.h"
 
 using namespace Data;
 
@@ -1564,6 +1568,81 @@ bool testLock() {
 
 #endif  // __EMSCRIPTEN__
 
+bool testNullMutex() {
+    List<int, NullMutex> test{1, 2, 3};
+    {
+        Locker locker(&test);
+        test.add(4);
+    }
+    if (test.count() != 4 || test[3] != 4) {
+        return false;
+    }
+    if (!test.tryLock()) {
+        return false;
+    }
+    test.unlock();
+
+    SortedList<int, NullMutex> sorted{3, 1, 2};
+    sorted.sort();
+    if (sorted[0] != 1 || sorted[2] != 3) {
+        return false;
+    }
+
+    List<int, NullMutex> copy(test);
+    if (copy != test) {
+        return false;
+    }
+
+    return true;
+}
+
+template<class T>
+static uint64_t constructElapsed(int count) {
+    uint64_t start = Environment::getTickCount();
+    for (int i = 0; i < count; i++) {
+        T *value = new T(16);
+        delete value;
+    }
+    return Environment::getTickCount() - start;
+}
+
+template<class T>
+static uint64_t constructMapElapsed(int count) {
+    uint64_t start = Environment::getTickCount();
+    for (int i = 0; i < count; i++) {
+        T *value = new T();
+        delete value;
+    }
+    return Environment::getTickCount() - start;
+}
+
+bool testFootprint() {
+    static const int Count = 1000000;
+
+    printf("sizeof List: %d, List<NullMutex>: %d\n",
+           (int) sizeof(List<int>), (int) sizeof(List<int, NullMutex>));
+    printf("sizeof PList: %d, PList<NullMutex>: %d\n",
+           (int) sizeof(PList<int>), (int) sizeof(PList<int, NullMutex>));
+    printf("sizeof Vector: %d, Vector<NullMutex>: %d\n",
+           (int) sizeof(Vector<int>), (int) sizeof(Vector<int, NullMutex>));
+    printf("sizeof Dictionary: %d, Dictionary<NullMutex>: %d\n",
+           (int) sizeof(Dictionary<int, int>), (int) sizeof(Dictionary<int, int, NullMutex>));
+    // Mutex allocates a std::mutex in the heap as well.
+    printf("sizeof heap std::mutex: %d\n", (int) sizeof(std::mutex));
+
+    printf("construct %d List: %llu ms, List<NullMutex>: %llu ms\n", Count,
+           (unsigned long long) constructElapsed<List<int>>(Count),
+           (unsigned long long) constructElapsed<List<int, NullMutex>>(Count));
+    printf("construct %d Vector: %llu ms, Vector<NullMutex>: %llu ms\n", Count,
+           (unsigned long long) constructElapsed<Vector<int>>(Count),
+           (unsigned long long) constructElapsed<Vector<int, NullMutex>>(Count));
+    printf("construct %d Dictionary: %llu ms, Dictionary<NullMutex>: %llu ms\n", Count,
+           (unsigned long long) constructMapElapsed<Dictionary<int, int>>(Count),
+           (unsigned long long) constructMapElapsed<Dictionary<int, int, NullMutex>>(Count));
+
+    return sizeof(List<int, NullMutex>) < sizeof(List<int>);
+}
+
 int main() {
     if (!testIntConstructor()) {
         return 1;
@@ -1685,6 +1764,12 @@ int main() {
         return 47;
     }
 #endif // __EMSCRIPTEN__
+    if (!testNullMutex()) {
+        return 48;
+    }
+    if (!testFootprint()) {
+        return 49;
+    }
 
     return 0;
 }
\ No newline at end of file
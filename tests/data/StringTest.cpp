@@ -9,8 +9,27 @@
 #include "data/String.h"
 #include "data/WString.h"
 #include "IO/MemoryStream.h"
+#include "system/Environment.h"
+#include <new>
 
 using namespace Data;
+using namespace System;
+
+// counts the allocations of the benchmarks.
+static size_t _allocations = 0;
+
+void *operator new(size_t size) {
+    _allocations++;
+    void *p = malloc(size > 0 ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
 
 static const String _text = "ABC/abc123,)_中文";
 static const string _text2 = "ABC/abc123,)_中文";
@@ -628,6 +647,217 @@ bool testFormat() {
             return false;
         }
     }
+    {
+        // longer than the stack buffer.
+        String text('a', 1000);
+        String test = String::format("[%s]", text.c_str());
+        if (test.length() != 1002 || test[0] != '[' || test[1001] != ']') {
+            return false;
+        }
+        test.appendFormat("%s", test.c_str());
+        if (test.length() != 2004 || test.substr(1000, 4) != "a][a") {
+            return false;
+        }
+    }
+    {
+        size_t allocations = _allocations;
+        String test = String::format("%s-%d", "key", 100);
+        if (_allocations != allocations || test != "key-100") {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testFormatTo() {
+    String test;
+    String::formatTo(test, "%s=%d", String("id"), 10);
+    String::formatTo(test, ",%s=%.1f", std::string("value"), 1.5);
+    String::formatTo(test, ",%s", "name");
+    if (test != "id=10,value=1.5,name") {
+        return false;
+    }
+
+    String::formatTo(test, "%s", test);
+    if (test != "id=10,value=1.5,nameid=10,value=1.5,name") {
+        return false;
+    }
+
+    return true;
+}
+
+// the former format, a 64K buffer is allocated and cleared by every call.
+static String formatBy64K(const char *format, ...) {
+    static const int MaxFormatStrLength = 65535;
+    char *message = new char[MaxFormatStrLength];
+    memset(message, 0, MaxFormatStrLength);
+    va_list ap;
+    va_start(ap, format);
+    vsnprintf(message, MaxFormatStrLength, format, ap);
+    va_end(ap);
+    String result = message;
+    delete[] message;
+    return result;
+}
+
+bool testFormatBenchmark() {
+    static const int Count = 100000;
+
+    size_t length = 0;
+    size_t allocations = _allocations;
+    uint64_t start = Environment::getTickCount();
+    for (int i = 0; i < Count; i++) {
+        length += formatBy64K("select * from t where id=%d", i).length();
+    }
+    printf("format by 64K buffer, %d calls: %llu ms, %d allocations\n", Count,
+           (unsigned long long) (Environment::getTickCount() - start), (int) (_allocations - allocations));
+
+    size_t length2 = 0;
+    allocations = _allocations;
+    start = Environment::getTickCount();
+    for (int i = 0; i < Count; i++) {
+        length2 += String::format("select * from t where id=%d", i).length();
+    }
+    printf("String::format, %d calls: %llu ms, %d allocations\n", Count,
+           (unsigned long long) (Environment::getTickCount() - start), (int) (_allocations - allocations));
+
+    String text;
+    allocations = _allocations;
+    start = Environment::getTickCount();
+    for (int i = 0; i < Count; i++) {
+        text.empty();
+        String::formatTo(text, "select * from t where id=%d", i);
+    }
+    printf("String::formatTo, %d calls: %llu ms, %d allocations\n", Count,
+           (unsigned long long) (Environment::getTickCount() - start), (int) (_allocations - allocations));
+
+    return length == length2;
+}
+
+bool testHashCode() {
+    String test = "abc";
+    size_t hash = test.hashCode();
+    if (hash != String("abc").hashCode()) {
+        return false;
+    }
+    test.append('d');
+    if (test.hashCode() == hash || test.hashCode() != String("abcd").hashCode()) {
+        return false;
+    }
+    test.set(0, 'x');
+    if (test.hashCode() != String("xbcd").hashCode()) {
+        return false;
+    }
+    test.removeAt(0);
+    if (test.hashCode() != String("bcd").hashCode()) {
+        return false;
+    }
+    test = "abc";
+    if (test.hashCode() != hash) {
+        return false;
+    }
+    if (String::Empty.hashCode() == 0) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testShortString() {
+    {
+        size_t allocations = _allocations;
+        String test("short");
+        String test2 = test;
+        test2 += "-string";
+        String test3(std::move(test2));
+        if (_allocations != allocations) {
+            return false;
+        }
+        if (test3 != "short-string" || test3.length() != 12 || test != "short") {
+            return false;
+        }
+    }
+    {
+        // grows from the inline buffer to the heap and back by assignment.
+        String test("abc");
+        for (int i = 0; i < 100; i++) {
+            test += "0123456789";
+        }
+        if (test.length() != 1003 || test.substr(0, 5) != "abc01" || test[1002] != '9') {
+            return false;
+        }
+        String test2(std::move(test));
+        if (test2.length() != 1003 || !test.isNullOrEmpty()) {
+            return false;
+        }
+        test = "abc";
+        test2 = test;
+        if (test2 != "abc" || test2.length() != 3) {
+            return false;
+        }
+    }
+    {
+        // append itself.
+        String test("abc");
+        test += test;
+        test += test.c_str();
+        if (test != "abcabcabcabc") {
+            return false;
+        }
+        test = test.c_str() + 3;
+        if (test != "abcabcabc") {
+            return false;
+        }
+    }
+    {
+        String test;
+        test.reserve(1000);
+        if (test.capacity() < 1000) {
+            return false;
+        }
+        size_t allocations = _allocations;
+        for (int i = 0; i < 1000; i++) {
+            test.append('a');
+        }
+        if (_allocations != allocations || test.length() != 1000) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testBenchmark() {
+    static const size_t Counts[] = {1000, 100000, 1000000};
+
+    for (size_t count: Counts) {
+        size_t allocations = _allocations;
+        uint64_t start = Environment::getTickCount();
+        String text;
+        for (size_t i = 0; i < count; i++) {
+            text.append('a');
+        }
+        printf("String, append %d chars one by one: %llu ms, %d allocations\n", (int) count,
+               (unsigned long long) (Environment::getTickCount() - start), (int) (_allocations - allocations));
+        if (text.length() != count) {
+            return false;
+        }
+
+        allocations = _allocations;
+        start = Environment::getTickCount();
+        size_t length = 0;
+        for (size_t i = 0; i < count; i++) {
+            String name("name");
+            name += ".key";
+            length += name.length();
+        }
+        printf("String, create %d short strings: %llu ms, %d allocations\n", (int) count,
+               (unsigned long long) (Environment::getTickCount() - start), (int) (_allocations - allocations));
+        if (length != count * 8) {
+            return false;
+        }
+    }
 
     return true;
 }
@@ -681,6 +911,21 @@ int main() {
     if (!testFormat()) {
         return 16;
     }
+    if (!testHashCode()) {
+        return 17;
+    }
+    if (!testShortString()) {
+        return 18;
+    }
+    if (!testBenchmark()) {
+        return 19;
+    }
+    if (!testFormatTo()) {
+        return 20;
+    }
+    if (!testFormatBenchmark()) {
+        return 21;
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -9,8 +9,27 @@
 #include "data/Vector.h"
 #include "data/ValueType.h"
 #include "thread/Thread.h"
+#include "system/Environment.h"
+#include <new>
 
 using namespace Data;
+using namespace System;
+
+// counts the allocations of the benchmarks.
+static size_t _allocations = 0;
+
+void *operator new(size_t size) {
+    _allocations++;
+    void *p = malloc(size > 0 ? size : 1);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
 
 #define DefaultCapacity 125
 
@@ -1585,6 +1604,98 @@ bool testLock() {
 
 #endif  // __EMSCRIPTEN__
 
+bool testGrowth() {
+    {
+        Integers test(4);
+        for (int i = 0; i < 1000; i++) {
+            test.add(i);
+        }
+        // add itself, the items are copied before the array is moved.
+        test.addRange(test);
+        if (test.count() != 2000 || test[999] != 999 || test[1000] != 0 || test[1999] != 999) {
+            return false;
+        }
+        test.insertRange(1, test, 0, 3);
+        if (test.count() != 2003 || test[1] != 0 || test[2] != 1 || test[3] != 2 || test[4] != 1) {
+            return false;
+        }
+    }
+    {
+        Vector<String> test(4);
+        for (int i = 0; i < 1000; i++) {
+            test.add(Int32(i).toString());
+        }
+        test.insert(0, "first");
+        test.add(test[0]);
+        if (test.count() != 1002 || test[0] != "first" || test[1] != "0" || test[1001] != "first") {
+            return false;
+        }
+        test.removeRange(0, 2);
+        if (test.count() != 1000 || test[0] != "1" || test[998] != "999") {
+            return false;
+        }
+
+        Vector<String> test2(std::move(test));
+        if (test2.count() != 1000 || !test.isEmpty()) {
+            return false;
+        }
+        test.add("a");
+        if (test.count() != 1 || test[0] != "a") {
+            return false;
+        }
+        test = std::move(test2);
+        if (test.count() != 1000 || test[998] != "999") {
+            return false;
+        }
+    }
+    {
+        // no allocation after reserve.
+        Integers test;
+        test.reserve(10000);
+        size_t allocations = _allocations;
+        for (int i = 0; i < 10000; i++) {
+            test.add(i);
+        }
+        if (_allocations != allocations) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testBenchmark() {
+    static const size_t Counts[] = {1000, 100000, 1000000};
+
+    for (size_t count: Counts) {
+        size_t allocations = _allocations;
+        uint64_t start = Environment::getTickCount();
+        Vector<uint8_t> bytes;
+        for (size_t i = 0; i < count; i++) {
+            bytes.add((uint8_t) i);
+        }
+        printf("Vector<uint8_t>, add %d items one by one: %llu ms, %d allocations\n", (int) count,
+               (unsigned long long) (Environment::getTickCount() - start), (int) (_allocations - allocations));
+        if (bytes.count() != count) {
+            return false;
+        }
+
+        allocations = _allocations;
+        start = Environment::getTickCount();
+        Vector<String> texts;
+        for (size_t i = 0; i < count / 10; i++) {
+            texts.add(String("value"));
+        }
+        printf("Vector<String>, add %d items one by one: %llu ms, %d allocations\n", (int) (count / 10),
+               (unsigned long long) (Environment::getTickCount() - start), (int) (_allocations - allocations));
+        if (texts.count() != count / 10) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     if (!testIntConstructor()) {
         return 1;
@@ -1712,6 +1823,12 @@ int main() {
         return 48;
     }
 #endif // __EMSCRIPTEN__
+    if (!testGrowth()) {
+        return 49;
+    }
+    if (!testBenchmark()) {
+        return 50;
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -636,6 +636,14 @@ bool testFormat() {
             return false;
         }
     }
+    {
+        // longer than the stack buffer.
+        WString text(L'a', 1000);
+        WString test = WString::format(L"[%ls]", text.c_str());
+        if (test.length() != 1002 || test[0] != L'[' || test[1001] != L']') {
+            return false;
+        }
+    }
 
     return true;
 }
@@ -7,8 +7,13 @@
 //
 
 #include "database/DataTable.h"
+#include "database/ColumnTable.h"
+#include "system/Environment.h"
+#include "IO/Metrics.h"
 
 using namespace Database;
+using namespace System;
+using namespace IO;
 
 bool testDataColumnConstructor() {
     {
@@ -2223,6 +2228,202 @@ bool testSql() {
     return true;
 }
 
+bool testColumnTable() {
+    {
+        ColumnTable test("abc");
+        test.addColumns({
+                                DataColumn("id", DbType::Integer32, true),
+                                DataColumn("name", DbType::Text, false),
+                                DataColumn("score", DbType::Float64, false),
+                        });
+        test.addRow(DataRow({
+                                    DataCell(test.columns()[0], 1),
+                                    DataCell(test.columns()[1], "Xu"),
+                                    DataCell(test.columns()[2], 86.5),
+                            }));
+        test.addRow(DataRow({
+                                    DataCell(test.columns()[0], 2),
+                                    DataCell(test.columns()[1], DbValue::NullValue),
+                                    DataCell(test.columns()[2], 90),
+                            }));
+        test.addRow(DataRow({
+                                    DataCell(test.columns()[0], 3),
+                                    DataCell(test.columns()[1], "Xu"),
+                                    DataCell(test.columns()[2], DbValue::NullValue),
+                            }));
+        if (test.rowCount() != 3 || test.columnCount() != 3) {
+            return false;
+        }
+        if (test.value(0, 0) != 1 || test.value(2, 0) != 3) {
+            return false;
+        }
+        if (test.value(0, 1) != "Xu" || !test.at(1).isNullValue(1) || test.at(1).isNullValue(2)) {
+            return false;
+        }
+        if (test.value(0, 2) != 86.5 || !test.row(2).isNullValue(2)) {
+            return false;
+        }
+        // the same text is stored once.
+        if (test.at(1).entryCount() != 1) {
+            return false;
+        }
+        if (test.row(1)["score"] != 90 || test.row(0)["name"] != "Xu" || test.row(0)[0] != 1) {
+            return false;
+        }
+        if (test.indexOf("score") != 2 || test.indexOf("xyz") != -1) {
+            return false;
+        }
+        if (test.row(0).valueStr(1, true) != "'Xu'") {
+            return false;
+        }
+
+        DataTable table;
+        test.toDataTable(table);
+        if (table.name() != "abc" || table.rowCount() != 3 || table.columnCount() != 3) {
+            return false;
+        }
+        if (table.rows()[0].cells()["name"].value() != "Xu" || table.rows()[2].cells()[0].value() != 3) {
+            return false;
+        }
+        ColumnTable test2(table);
+        if (test2 != test) {
+            return false;
+        }
+        ColumnTable test3(test2);
+        if (test3 != test) {
+            return false;
+        }
+
+        test.clearRows();
+        if (test.rowCount() != 0 || test.columnCount() != 3) {
+            return false;
+        }
+        test.clear();
+        if (test.columnCount() != 0) {
+            return false;
+        }
+    }
+    {
+        // a reused table does not report the total of the previous query.
+        ColumnTable test("abc");
+        test.setTotalCount(100);
+        test.clear();
+        if (test.totalCount() != 0) {
+            return false;
+        }
+    }
+    {
+        ColumnTable test("abc");
+        test.addColumn(DataColumn("id", DbType::Integer64, true));
+        test.at(0).addInteger(1);
+        test.at(0).addInteger(2);
+        // the existing rows get the nulls.
+        test.addColumn(DataColumn("time", DbType::Timestamp, false));
+        if (test.rowCount() != 2 || !test.at(1).isNullValue(0) || !test.at(1).isNullValue(1)) {
+            return false;
+        }
+        test.at(0).addInteger(3);
+        const char *time = "2026-10-18 12:30:00";
+        test.at(1).addText(time, strlen(time));
+        if (test.value(2, 1) != DbValue(DbType::Timestamp, time)) {
+            return false;
+        }
+        test.at(0).addText("4", 1);
+        test.at(1).addNull();
+        if (test.value(3, 0) != (int64_t) 4 || !test.at(1).isNullValue(3)) {
+            return false;
+        }
+    }
+    {
+        ColumnVector test(DataColumn("data", DbType::Blob, false));
+        uint8_t data[] = {1, 2, 3, 0, 5};
+        test.addBlob(data, sizeof(data));
+        test.addBlob(data, sizeof(data));
+        test.addBlob(nullptr, 0);
+        ByteArray array;
+        if (!test.value(0).getValue(array) || array != ByteArray(data, sizeof(data))) {
+            return false;
+        }
+        if (test.count() != 3 || test.entryCount() != 2 || !test.isNullValue(2)) {
+            return false;
+        }
+    }
+    {
+        // more texts than the initial capacity of the dictionary.
+        ColumnVector test(DataColumn("name", DbType::Text, false));
+        for (int i = 0; i < 10000; i++) {
+            String text = String::format("name%d", i % 1000);
+            test.addText(text.c_str(), text.length());
+        }
+        if (test.count() != 10000 || test.entryCount() != 1000) {
+            return false;
+        }
+        for (int i = 0; i < 10000; i += 7) {
+            if (test.value(i) != String::format("name%d", i % 1000)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool testColumnTableBenchmark() {
+    static const int RowCount = 100000;
+    static const char *Cities[] = {"Beijing", "Shanghai", "Guangzhou", "Shenzhen", "Hangzhou"};
+
+    DataColumns columns{
+            DataColumn("id", DbType::Integer32, true),
+            DataColumn("city", DbType::Text, false),
+            DataColumn("score", DbType::Float64, false),
+            DataColumn("time", DbType::Timestamp, false),
+    };
+    DateTime now = DateTime::now();
+
+    int64_t heap = MemoryStat::usedHeap();
+    uint64_t start = Environment::getTickCount();
+    {
+        DataTable table("benchmark");
+        table.addColumns(columns);
+        for (int i = 0; i < RowCount; i++) {
+            table.addRow(DataRow({
+                                         DataCell(columns[0], i),
+                                         DataCell(columns[1], Cities[i % 5]),
+                                         DataCell(columns[2], i * 0.5),
+                                         DataCell(columns[3], now),
+                                 }));
+        }
+        uint64_t elapsed = Environment::getTickCount() - start;
+        int64_t used = MemoryStat::usedHeap() - heap;
+        printf("DataTable, rows: %d, fill: %llu ms, heap: %lld bytes/row\n", RowCount,
+               (unsigned long long) elapsed, (long long) (used / RowCount));
+    }
+
+    heap = MemoryStat::usedHeap();
+    start = Environment::getTickCount();
+    {
+        ColumnTable table("benchmark");
+        table.addColumns(columns);
+        table.reserve(RowCount);
+        for (int i = 0; i < RowCount; i++) {
+            table.at(0).addInteger(i);
+            table.at(1).addText(Cities[i % 5], strlen(Cities[i % 5]));
+            table.at(2).addFloat(i * 0.5);
+            table.at(3).addValue(DbValue(now));
+        }
+        uint64_t elapsed = Environment::getTickCount() - start;
+        int64_t used = MemoryStat::usedHeap() - heap;
+        printf("ColumnTable, rows: %d, fill: %llu ms, heap: %lld bytes/row, vectors: %d bytes/row\n", RowCount,
+               (unsigned long long) elapsed, (long long) (used / RowCount), (int) (table.memorySize() / RowCount));
+        if (table.rowCount() != RowCount || table.value(RowCount - 1, 0) != RowCount - 1 ||
+            table.value(7, 1) != Cities[2]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     if (!testDataColumnConstructor()) {
         return 1;
@@ -2303,5 +2504,12 @@ int main() {
         return 81;
     }
 
+    if (!testColumnTable()) {
+        return 90;
+    }
+    if (!testColumnTableBenchmark()) {
+        return 91;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -456,6 +456,61 @@ bool testIsConnected() {
     return true;
 }
 
+bool testCursor() {
+    {
+        MysqlClient test;
+        if (!test.open(_url, _username, _password)) {
+            return false;
+        }
+        if (!test.executeSql("create table t_student(\n"
+                             "id int primary key not null,\n"
+                             "name text not null,\n"
+                             "score real\n"
+                             ");")) {
+            return false;
+        }
+        test.beginTransaction();
+        for (int i = 0; i < 2500; i++) {
+            test.executeSql(String::format("insert into t_student values(%d, 'name%d', %d.5);", i, i, i), false);
+        }
+        test.commitTransaction();
+
+        DbCursor *cursor = test.executeSqlCursor("select * from t_student order by id;", 1000);
+        if (cursor == nullptr) {
+            return false;
+        }
+        int count = 0;
+        while (cursor->moveNext()) {
+            int id = -1;
+            String name;
+            if (!cursor->getValue(0, id) || id != count) {
+                delete cursor;
+                return false;
+            }
+            if (!cursor->getValue("name", name) || name != String::format("name%d", count)) {
+                delete cursor;
+                return false;
+            }
+            count++;
+        }
+        bool succeed = !cursor->hasError() && cursor->rowCount() == 2500;
+        delete cursor;
+        if (!succeed || count != 2500) {
+            return false;
+        }
+
+        // the client is usable after the cursor is deleted.
+        int total;
+        if (!test.retrieveCount("select count(*) from t_student", total) || total != 2500) {
+            return false;
+        }
+
+        test.executeSql("drop table t_student;");
+    }
+
+    return true;
+}
+
 bool parseArguments(const Application &app) {
     const Application::Arguments &arguments = app.arguments();
     String host, userName, password, database;
@@ -552,6 +607,9 @@ int main(int argc, const char *argv[]) {
     if (!testIsConnected()) {
         result = 10;
     }
+    if (!testCursor()) {
+        result = 11;
+    }
 
     cleanUp();
 
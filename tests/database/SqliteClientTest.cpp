@@ -10,8 +10,12 @@
 #include "IO/Directory.h"
 #include "IO/Path.h"
 #include "IO/File.h"
+#include "system/Environment.h"
+#include "IO/Metrics.h"
 
 using namespace Database;
+using namespace System;
+using namespace IO;
 
 static String _path = Path::combine(Path::getTempPath(), "SqliteClientTest");
 static String _fileName = Path::combine(_path, "test.db");
@@ -403,6 +407,244 @@ bool testGetColumnNames() {
     return true;
 }
 
+static bool createStudents(SqliteClient &client, int count) {
+    if (!client.executeSql("create table t_student(\n"
+                           "id int primary key not null,\n"
+                           "name text not null,\n"
+                           "score real\n"
+                           ");", false)) {
+        return false;
+    }
+    client.beginTransaction();
+    for (int i = 0; i < count; i++) {
+        String sql = String::format("insert into t_student values(%d, 'name%d', %d.5);", i, i % 100, i);
+        if (!client.executeSql(sql, false)) {
+            client.rollbackTransaction();
+            return false;
+        }
+    }
+    return client.commitTransaction();
+}
+
+bool testQueryColumnTable() {
+    File::deleteFile(_fileName);
+    {
+        SqliteClient test;
+        if (!test.open(_fileName)) {
+            return false;
+        }
+        if (!createStudents(test, 1000)) {
+            return false;
+        }
+        if (!test.executeSql("insert into t_student values(1000, 'Xu', null);", false)) {
+            return false;
+        }
+
+        ColumnTable table;
+        if (!test.executeSqlQuery("select * from t_student order by id;", table)) {
+            return false;
+        }
+        if (table.rowCount() != 1001 || table.columnCount() != 3) {
+            return false;
+        }
+        if (table.at(0).type() != DbType::Integer32 || table.at(1).type() != DbType::Text ||
+            table.at(2).type() != DbType::Float64) {
+            return false;
+        }
+        if (table.value(10, 0) != 10 || table.value(10, 1) != "name10" || table.value(10, 2) != 10.5) {
+            return false;
+        }
+        if (table.at(1).entryCount() != 101 || !table.at(2).isNullValue(1000)) {
+            return false;
+        }
+
+        // the same result as the DataTable one.
+        DataTable table2;
+        if (!test.executeSqlQuery("select * from t_student order by id;", table2)) {
+            return false;
+        }
+        if (ColumnTable(table2) != table) {
+            return false;
+        }
+    }
+    File::deleteFile(_fileName);
+
+    return true;
+}
+
+bool testQueryBenchmark() {
+    static const int RowCount = 100000;
+
+    File::deleteFile(_fileName);
+    {
+        SqliteClient test;
+        if (!test.open(_fileName)) {
+            return false;
+        }
+        if (!createStudents(test, RowCount)) {
+            return false;
+        }
+
+        uint64_t start = Environment::getTickCount();
+        DataTable table;
+        if (!test.executeSqlQuery("select * from t_student;", table) || table.rowCount() != RowCount) {
+            return false;
+        }
+        printf("DataTable, rows: %d, query: %llu ms\n", RowCount,
+               (unsigned long long) (Environment::getTickCount() - start));
+
+        start = Environment::getTickCount();
+        ColumnTable table2;
+        if (!test.executeSqlQuery("select * from t_student;", table2) || table2.rowCount() != RowCount) {
+            return false;
+        }
+        printf("ColumnTable, rows: %d, query: %llu ms\n", RowCount,
+               (unsigned long long) (Environment::getTickCount() - start));
+    }
+    File::deleteFile(_fileName);
+
+    return true;
+}
+
+bool testCursor() {
+    File::deleteFile(_fileName);
+    {
+        SqliteClient test;
+        if (!test.open(_fileName)) {
+            return false;
+        }
+        if (!createStudents(test, 2500)) {
+            return false;
+        }
+
+        DbCursor *cursor = test.executeSqlCursor("select * from t_student order by id;", 1000);
+        if (cursor == nullptr) {
+            return false;
+        }
+        if (cursor->columnCount() != 3 || cursor->indexOf("score") != 2) {
+            delete cursor;
+            return false;
+        }
+        int count = 0;
+        while (cursor->moveNext()) {
+            int id = -1;
+            double score = 0;
+            String name;
+            if (!cursor->getValue(0, id) || id != count) {
+                break;
+            }
+            if (!cursor->getValue("name", name) || name != String::format("name%d", count % 100)) {
+                break;
+            }
+            if (!cursor->getValue(2, score) || score != count + 0.5) {
+                break;
+            }
+            count++;
+        }
+        bool succeed = count == 2500 && !cursor->hasError() && cursor->rowCount() == 2500 &&
+                       cursor->batch().rowCount() == 500 && !cursor->fetch();
+        delete cursor;
+        if (!succeed) {
+            return false;
+        }
+
+        // the whole batches.
+        cursor = test.executeSqlCursor("select id from t_student;", 1000);
+        if (cursor == nullptr) {
+            return false;
+        }
+        size_t rows = 0, batches = 0;
+        while (cursor->fetch()) {
+            rows += cursor->batch().rowCount();
+            batches++;
+        }
+        // busy for the pool, even on the thread of the cursor.
+        bool executing = test.isExecuting();
+        delete cursor;
+        if (rows != 2500 || batches != 3 || !executing || test.isExecuting()) {
+            return false;
+        }
+
+        // the client is unlocked by the cursor.
+        int total;
+        if (!test.retrieveCount("select count(*) from t_student", total) || total != 2500) {
+            return false;
+        }
+
+        cursor = test.executeSqlCursor("select * from t_not_exists;");
+        if (cursor != nullptr) {
+            delete cursor;
+            return false;
+        }
+        cursor = test.executeSqlCursor("select * from t_student where id < 0;");
+        if (cursor == nullptr || cursor->moveNext() || cursor->hasError()) {
+            delete cursor;
+            return false;
+        }
+        delete cursor;
+    }
+    File::deleteFile(_fileName);
+
+    return true;
+}
+
+bool testCursorBenchmark() {
+    static const int RowCount = 1000000;
+
+    File::deleteFile(_fileName);
+    {
+        SqliteClient test;
+        if (!test.open(_fileName)) {
+            return false;
+        }
+        if (!createStudents(test, RowCount)) {
+            return false;
+        }
+
+        // the peak of the heap while the rows are scanned.
+        int64_t heap = MemoryStat::usedHeap();
+        int64_t peak = 0;
+        uint64_t start = Environment::getTickCount();
+        DbCursor *cursor = test.executeSqlCursor("select * from t_student;");
+        if (cursor == nullptr) {
+            return false;
+        }
+        double sum = 0;
+        while (cursor->fetch()) {
+            const ColumnVector &scores = cursor->batch().at(2);
+            for (size_t i = 0; i < scores.count(); i++) {
+                double score = 0;
+                scores.value(i).getValue(score);
+                sum += score;
+            }
+            int64_t used = MemoryStat::usedHeap() - heap;
+            if (used > peak) {
+                peak = used;
+            }
+        }
+        bool succeed = cursor->rowCount() == RowCount;
+        delete cursor;
+        printf("DbCursor, rows: %d, scan: %llu ms, peak heap: %lld KB, sum: %.1f\n", RowCount,
+               (unsigned long long) (Environment::getTickCount() - start), (long long) (peak / 1024), sum);
+        if (!succeed) {
+            return false;
+        }
+
+        heap = MemoryStat::usedHeap();
+        start = Environment::getTickCount();
+        ColumnTable table;
+        if (!test.executeSqlQuery("select * from t_student;", table) || table.rowCount() != RowCount) {
+            return false;
+        }
+        printf("ColumnTable, rows: %d, query: %llu ms, heap: %lld KB\n", RowCount,
+               (unsigned long long) (Environment::getTickCount() - start),
+               (long long) ((MemoryStat::usedHeap() - heap) / 1024));
+    }
+    File::deleteFile(_fileName);
+
+    return true;
+}
+
 int main() {
     setUp();
 
@@ -434,6 +676,18 @@ int main() {
     if(!testGetColumnNames()) {
         result = 9;
     }
+    if (!testQueryColumnTable()) {
+        result = 10;
+    }
+    if (!testQueryBenchmark()) {
+        result = 11;
+    }
+    if (!testCursor()) {
+        result = 12;
+    }
+    if (!testCursorBenchmark()) {
+        result = 13;
+    }
 
     cleanUp();
 
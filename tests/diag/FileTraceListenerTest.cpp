@@ -8,7 +8,12 @@
 
 #include "diag/Trace.h"
 #include "diag/FileTraceListener.h"
+#include "diag/TraceWriter.h"
 #include "IO/Directory.h"
+#include "IO/File.h"
+#include "IO/Path.h"
+#include "thread/Thread.h"
+#include "system/Environment.h"
 
 using namespace Data;
 using namespace Diag;
@@ -36,9 +41,120 @@ bool testLog1() {
     return false;
 }
 
+bool testAsyncLog() {
+    static const String logStr = "logs";
+    FileTraceListener *listener = new FileTraceListener(logStr);
+    Trace::addTraceListener(listener);
+    if (!Trace::enableAsync(TraceBlock)) {
+        return false;
+    }
+    Trace::info("async1");
+    Trace::writeFormatLine("async%d", 2);
+    Trace::error("async3");
+    Trace::removeTraceListener(listener);
+    TraceStatistics statistics = Trace::asyncStatistics();
+    Trace::disableAsync();
+    delete listener;
+
+    String logPath = Path::combine(Path::getAppPath(), logStr);
+    DateTime now = DateTime::now();
+    String fileName = Path::combine(logPath, String::format("%s.log", now.toString("d").c_str()));
+    String text = File::exists(fileName) ? File::readAllText(fileName) : String::Empty;
+    Directory::deleteDirectory(logPath);
+    if (text.find("[INFO]  async1") < 0 || text.find("async2") < 0 || text.find("[ERROR] async3") < 0) {
+        return false;
+    }
+    if (statistics.written < 3 || statistics.dropped != 0) {
+        return false;
+    }
+    return !Trace::isAsync();
+}
+
+bool testLongPrefix() {
+    // the prefix and the message are both longer than a record of the smallest buffer.
+    TraceWriter *writer = TraceWriter::instance();
+    if (!writer->start(TraceDrop, 1024, 0)) {
+        return false;
+    }
+    String prefix('p', 300);
+    String message('m', 2000);
+    bool result = writer->write(prefix.c_str(), prefix.length(), message.c_str(), message.length(), true,
+                               Trace::Info, false);
+    writer->stop();
+    return result;
+}
+
+static uint64_t runLogs(int threadCount, int count) {
+    uint64_t start = Environment::getTickCount();
+    PList<Thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.add(new Thread("logger", [count]() {
+            for (int j = 0; j < count; j++) {
+                Trace::writeFormatLine("benchmark message %d, the value is %s.", j, "abcdefg");
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.count(); i++) {
+        threads[i]->start();
+    }
+    threads.clear();
+    Trace::flush();
+    return Environment::getTickCount() - start;
+}
+
+bool testBenchmark() {
+    static const String logStr = "logs";
+    static const int ThreadCount = 16;
+    static const int Count = 20000;
+    static const int Total = ThreadCount * Count;
+
+    Trace::disableConsoleOutput();
+    FileTraceListener *listener = new FileTraceListener(logStr);
+    Trace::addTraceListener(listener);
+
+    uint64_t syncElapsed = runLogs(ThreadCount, Count);
+    printf("threads: %d, messages: %d, sync: %.1f ns/message\n", ThreadCount, Total,
+           (double) syncElapsed * 1000000.0 / Total);
+
+    static const TraceOverflow Policies[] = {TraceBlock, TraceDrop};
+    for (TraceOverflow policy : Policies) {
+        TraceStatistics before = Trace::asyncStatistics();
+        Trace::enableAsync(policy);
+        uint64_t asyncElapsed = runLogs(ThreadCount, Count);
+        TraceStatistics after = Trace::asyncStatistics();
+        Trace::disableAsync();
+        printf("threads: %d, messages: %d, async(%s): %.1f ns/message, written: %llu, dropped: %llu, "
+               "blocked: %llu, batches: %llu\n",
+               ThreadCount, Total, policy == TraceBlock ? "block" : "drop",
+               (double) asyncElapsed * 1000000.0 / Total,
+               (unsigned long long) (after.written - before.written),
+               (unsigned long long) (after.dropped - before.dropped),
+               (unsigned long long) (after.blocked - before.blocked),
+               (unsigned long long) (after.batches - before.batches));
+        if (policy == TraceBlock && after.written - before.written != Total) {
+            return false;
+        }
+    }
+
+    Trace::removeTraceListener(listener);
+    delete listener;
+    Trace::enableConsoleOutput();
+    Directory::deleteDirectory(Path::combine(Path::getAppPath(), logStr));
+    return true;
+}
+
 int main() {
     if(!testLog1()) {
         return 1;
     }
+    if (!testAsyncLog()) {
+        return 2;
+    }
+    if (!testBenchmark()) {
+        return 3;
+    }
+    if (!testLongPrefix()) {
+        return 4;
+    }
     return 0;
 }
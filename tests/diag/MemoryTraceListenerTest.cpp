@@ -10,9 +10,13 @@
 #include "diag/FileTraceListener.h"
 #include "diag/MemoryTraceListener.h"
 #include "system/Application.h"
+#include "system/Environment.h"
+#include "thread/Thread.h"
+#include <atomic>
 
 using namespace Diag;
 using namespace System;
+using namespace Threading;
 
 class TraceListenerContextTest {
 public:
@@ -204,6 +208,25 @@ public:
             if (test.maxMessageCount != 10000) {
                 return false;
             }
+            if (test.bufferSize != MemoryTraceListenerContext::DefaultBufferSize) {
+                return false;
+            }
+        }
+        {
+            MemoryTraceListenerContext test(12000, 64 * 1024 * 1024);
+            if (test.bufferSize != 64 * 1024 * 1024) {
+                return false;
+            }
+            MemoryTraceListenerContext test2 = test;
+            if (test2.bufferSize != 64 * 1024 * 1024) {
+                return false;
+            }
+        }
+        {
+            MemoryTraceListenerContext test(12000, 1024);
+            if (test.bufferSize != MemoryTraceListenerContext::DefaultBufferSize) {
+                return false;
+            }
         }
 
         return true;
@@ -237,6 +260,13 @@ public:
                 return false;
             }
         }
+        {
+            MemoryTraceListenerContext test(12000, 1024 * 1024);
+            MemoryTraceListenerContext test2(12000, 2 * 1024 * 1024);
+            if (test == test2) {
+                return false;
+            }
+        }
 
         return true;
     }
@@ -306,6 +336,27 @@ public:
                 return false;
             }
         }
+        {
+            // the last maxMessageCount ones, the long messages take more than one slot.
+            MemoryTraceListener test(MemoryTraceListenerContext(1000));
+            Trace::disableConsoleOutput();
+            Trace::addTraceListener(&test);
+            String padding('x', 300);
+            for (int i = 0; i < 5000; i++) {
+                Trace::info(String::format("message %d %s", i, i % 2 == 0 ? "" : padding.c_str()));
+            }
+            Trace::removeTraceListener(&test);
+            Trace::enableConsoleOutput();
+
+            StringArray messages;
+            test.getAllMessages(messages);
+            if (messages.count() != 1000) {
+                return false;
+            }
+            if (messages[0].find("message 4000 ") <= 0 || messages[999].find("message 4999 ") <= 0) {
+                return false;
+            }
+        }
 
         return true;
     }
@@ -336,6 +387,183 @@ public:
         return true;
     }
 
+    static bool testGetMessages() {
+        {
+            MemoryTraceListener test;
+            Trace::addTraceListener(&test);
+            Trace::write("first");
+            uint64_t cursor = test.position();
+            Trace::write("second");
+            Trace::write("third");
+
+            StringArray messages;
+            if (test.getMessages(cursor, messages) != 2 || messages.count() != 2) {
+                Trace::removeTraceListener(&test);
+                return false;
+            }
+            if (messages[0].find("second") <= 0 || messages[1].find("third") <= 0) {
+                Trace::removeTraceListener(&test);
+                return false;
+            }
+            // nothing new.
+            if (test.getMessages(cursor, messages) != 0 || cursor != test.position()) {
+                Trace::removeTraceListener(&test);
+                return false;
+            }
+            Trace::removeTraceListener(&test);
+        }
+        {
+            // the old messages are overwritten, the long ones take several slots.
+            TraceRing ring(64 * 1024);
+            char text[TraceRing::MaxTextLength + 100];
+            for (int i = 0; i < 10000; i++) {
+                int length = snprintf(text, sizeof(text), "%d ", i);
+                int size = length + i % 1000;
+                memset(text + length, 'a', size - length);
+                ring.write(text, size);
+            }
+            memset(text, 'b', sizeof(text));
+            ring.write(text, sizeof(text));
+
+            uint64_t cursor = 0;
+            StringArray messages;
+            ring.read(cursor, messages);
+            if (messages.count() < 2 || cursor != ring.next()) {
+                return false;
+            }
+            int last = -1;
+            for (size_t i = 0; i + 1 < messages.count(); i++) {
+                int value = 0;
+                if (sscanf(messages[i].c_str(), "%d", &value) != 1 || value <= last) {
+                    return false;
+                }
+                last = value;
+            }
+            // truncated.
+            if (last != 9999 || messages[messages.count() - 1].length() != TraceRing::MaxTextLength) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool isValid(const String &message, int &thread, int &index) {
+        int length = 0, prefix = 0;
+        if (sscanf(message.c_str(), "%d %d %d %n", &thread, &index, &length, &prefix) != 3) {
+            return false;
+        }
+        if ((int) message.length() != length) {
+            return false;
+        }
+        for (int i = prefix; i < length; i++) {
+            if (message[i] != 'a' + thread) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool testConcurrent() {
+        static const int ThreadCount = 4;
+        static const int MessageCount = 20000;
+
+        TraceRing ring(64 * 1024);
+        std::atomic<int> running(ThreadCount);
+        auto writeProc = [&ring, &running](int thread) {
+            char text[1024];
+            for (int i = 0; i < MessageCount; i++) {
+                int length = 16 + (i * 7 + thread) % 500;
+                int prefix = snprintf(text, sizeof(text), "%d %d %d ", thread, i, length);
+                memset(text + prefix, 'a' + thread, length - prefix);
+                ring.write(text, length);
+            }
+            running--;
+        };
+
+        // the reader tails the ring while it is written, the messages are never torn.
+        bool result = true;
+        size_t readCount = 0;
+        auto readProc = [&ring, &running, &result, &readCount]() {
+            int last[ThreadCount] = {-1, -1, -1, -1};
+            uint64_t cursor = 0;
+            StringArray messages;
+            do {
+                bool done = running == 0;
+                messages.clear();
+                ring.read(cursor, messages);
+                for (size_t i = 0; i < messages.count(); i++) {
+                    int thread = 0, index = 0;
+                    if (!isValid(messages[i], thread, index) || thread < 0 || thread >= ThreadCount ||
+                        index <= last[thread]) {
+                        result = false;
+                        return;
+                    }
+                    last[thread] = index;
+                }
+                readCount += messages.count();
+                if (done) {
+                    break;
+                }
+            } while (true);
+            // the older messages of the other threads may be overwritten before read.
+            bool found = false;
+            for (int i = 0; i < ThreadCount; i++) {
+                if (last[i] == MessageCount - 1) {
+                    found = true;
+                }
+            }
+            if (!found) {
+                result = false;
+            }
+        };
+
+        PList<Thread> threads;
+        for (int i = 0; i < ThreadCount; i++) {
+            auto thread = new Thread("ring.writer", writeProc, i);
+            threads.add(thread);
+        }
+        Thread reader("ring.reader", readProc);
+        reader.start();
+        for (size_t i = 0; i < threads.count(); i++) {
+            threads[i]->start();
+        }
+        for (size_t i = 0; i < threads.count(); i++) {
+            threads[i]->join();
+        }
+        reader.join();
+        return result && readCount > 0;
+    }
+
+    static bool testBenchmark() {
+        static const int Count = 1000000;
+
+        Trace::disableConsoleOutput();
+        uint64_t start = Environment::getTickCount();
+        for (int i = 0; i < Count; i++) {
+            Trace::info("GET /actuator/health 200, the response is sent in 1 ms.");
+        }
+        uint64_t baseline = Environment::getTickCount() - start;
+
+        MemoryTraceListener test;
+        Trace::addTraceListener(&test);
+        start = Environment::getTickCount();
+        for (int i = 0; i < Count; i++) {
+            Trace::info("GET /actuator/health 200, the response is sent in 1 ms.");
+        }
+        uint64_t elapsed = Environment::getTickCount() - start;
+        Trace::removeTraceListener(&test);
+        Trace::enableConsoleOutput();
+
+        printf("Trace::info, %d messages: %llu ms, with MemoryTraceListener: %llu ms, %.1f ns/message added\n",
+               Count, (unsigned long long) baseline, (unsigned long long) elapsed,
+               ((double) elapsed - (double) baseline) * 1000000.0 / Count);
+
+        StringArray messages;
+        test.getAllMessages(messages);
+        return messages.count() == (size_t) test.context().maxMessageCount;
+    }
+
     static int runTest() {
         if (!testConstructor()) {
             return 41;
@@ -346,6 +574,15 @@ public:
         if (!testUpdatedDelegates()) {
             return 43;
         }
+        if (!testGetMessages()) {
+            return 44;
+        }
+        if (!testConcurrent()) {
+            return 45;
+        }
+        if (!testBenchmark()) {
+            return 46;
+        }
 
         return 0;
     }
@@ -0,0 +1,337 @@
+//
+//  DriverManagerTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "driver/DriverManager.h"
+#include "driver/channels/Interactive.h"
+#include "driver/instructions/Instruction.h"
+#include "driver/instructions/InstructionSet.h"
+#include "driver/instructions/InstructionDescription.h"
+#include "driver/devices/DeviceDescription.h"
+#include "system/Environment.h"
+
+using namespace Drivers;
+using namespace System;
+
+class TestInteractive : public Interactive {
+public:
+    explicit TestInteractive(DriverManager *dm) : Interactive(dm) {
+    }
+
+    bool open() override {
+        return true;
+    }
+
+    void close() override {
+    }
+
+    bool connected() override {
+        return true;
+    }
+
+    size_t available() override {
+        return 0;
+    }
+
+    ssize_t send(const uint8_t *buffer, off_t offset, size_t count) override {
+        return (ssize_t) count;
+    }
+
+    ssize_t receive(uint8_t *buffer, off_t offset, size_t count) override {
+        return 0;
+    }
+};
+
+// The data is received from the memory.
+class MemoryInteractive : public Interactive {
+public:
+    MemoryInteractive(DriverManager *dm, const String &str) : Interactive(dm), _position(0) {
+        _data.addRange((const uint8_t *) str.c_str(), str.length());
+    }
+
+    bool open() override {
+        return true;
+    }
+
+    void close() override {
+    }
+
+    bool connected() override {
+        return true;
+    }
+
+    size_t available() override {
+        return _data.count() - _position;
+    }
+
+    ssize_t send(const uint8_t *buffer, off_t offset, size_t count) override {
+        return (ssize_t) count;
+    }
+
+    ssize_t receive(uint8_t *buffer, off_t offset, size_t count) override {
+        size_t length = count < available() ? count : available();
+        memcpy(buffer + offset, _data.data() + _position, length);
+        _position += length;
+        return (ssize_t) length;
+    }
+
+private:
+    ByteArray _data;
+    size_t _position;
+};
+
+class TestInstruction : public Instruction {
+public:
+    explicit TestInstruction(InstructionDescription *id) : Instruction(id) {
+    }
+
+    InstructionContext *execute(Interactive *interactive, Device *device, InstructionContext *context,
+                                const ByteArray *buffer) override {
+        return context;
+    }
+};
+
+class TestInstructionSet : public InstructionSet {
+public:
+    void generateInstructions(Instructions *instructions) override {
+        instructions->add(new TestInstruction(new InstructionDescription("read")));
+    }
+};
+
+// a pool of the other devices, e.g. a sampler of many devices.
+class GroupPool : public InstructionPool {
+public:
+    GroupPool(DriverManager *dm, DeviceDescription *dd, const StringArray &deviceNames) :
+            InstructionPool(dm, dd->getChannel(), dd), _deviceNames(deviceNames) {
+    }
+
+    bool containsDevice(const String &deviceName) const override {
+        return _deviceNames.contains(deviceName);
+    }
+
+private:
+    StringArray _deviceNames;
+};
+
+// devicesPerChannel devices share the name of a channel.
+void addDevices(DriverManager &dm, int count, int devicesPerChannel) {
+    for (int i = 0; i < count; i++) {
+        String channelName = String::convert("channel%d", i / devicesPerChannel);
+        // the channel is created by the first description of the name.
+        Interactive *interactive = i % devicesPerChannel == 0 ? new TestInteractive(&dm) : nullptr;
+        auto cd = new ChannelDescription(channelName, nullptr, interactive);
+        auto dd = new DeviceDescription(String::convert("device%d", i), cd, new TestInstructionSet());
+        dm.description()->addDevice(dd);
+    }
+}
+
+bool testDevices() {
+    DriverManager dm;
+    addDevices(dm, 10, 3);
+    dm.open();
+
+    for (int i = 0; i < 10; i++) {
+        String deviceName = String::convert("device%d", i);
+        Device *device = dm.getDevice(deviceName);
+        if (device == nullptr || device->name() != deviceName) {
+            return false;
+        }
+        Channel *channel = dm.getChannel(String::convert("channel%d", i / 3));
+        if (channel == nullptr || device->getChannel() != channel) {
+            return false;
+        }
+        if (dm.getDevice(channel) != dm.getDevice(String::convert("device%d", i / 3 * 3))) {
+            return false;
+        }
+        if (!dm.hasChannel(channel->description())) {
+            return false;
+        }
+    }
+    if (dm.getDevice("device10") != nullptr || dm.getChannel("channel4") != nullptr) {
+        return false;
+    }
+
+    Devices devices;
+    dm.getDevices(dm.getChannel("channel1"), devices);
+    if (devices.count() != 3 || devices[0]->name() != "device3" || devices[2]->name() != "device5") {
+        return false;
+    }
+    devices.clear();
+    dm.getDevices(dm.getChannel("channel3"), devices);
+    if (devices.count() != 1) {
+        return false;
+    }
+
+    InstructionDescription id("read");
+    if (dm.executeInstruction("device1", &id) != id.context()) {
+        return false;
+    }
+
+    dm.close();
+    if (dm.getDevice("device1") != nullptr || dm.getChannel("channel0") != nullptr) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testPools() {
+    DriverManager dm;
+    addDevices(dm, 4, 2);
+    DeviceDescriptions *dds = dm.description()->getDevices();
+    for (size_t i = 0; i < dds->count(); i++) {
+        DeviceDescription *dd = dds->at(i);
+        dm.addPool(new InstructionPool(&dm, dd->getChannel(), dd));
+    }
+
+    if (dm.getPool("device1") != dm.getPools()->at(1) || dm.getPoolByDeviceName("device3") != dm.getPools()->at(3)) {
+        return false;
+    }
+    // the first pool of the channel.
+    if (dm.getPoolByChannelName("channel1") != dm.getPools()->at(2)) {
+        return false;
+    }
+    if (dm.getPool("device4") != nullptr || dm.getPoolByChannelName("channel2") != nullptr) {
+        return false;
+    }
+
+    // the devices not indexed are found by InstructionPool::containsDevice.
+    StringArray groupNames;
+    groupNames.add("group1");
+    groupNames.add("group2");
+    auto group = new GroupPool(&dm, dds->at(0), groupNames);
+    dm.addPool(group);
+    if (dm.getPool("group2") != group || dm.getPool("device0") != dm.getPools()->at(0)) {
+        return false;
+    }
+    if (dm.getPool("group3") != nullptr) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testChannelBuffer() {
+    DriverManager dm;
+    auto cd = new ChannelDescription("memory", new ChannelContext(), new MemoryInteractive(&dm, "a\nbc\n"));
+    dm.description()->addDevice(new DeviceDescription("memory", cd, new TestInstructionSet()));
+    dm.open();
+
+    Channel *channel = dm.getChannel("memory");
+    uint8_t buffer[16];
+    if (channel == nullptr || channel->readLine(buffer, sizeof(buffer), 100) != 2) {
+        return false;
+    }
+    // the next line is read ahead, it is counted and returned at first.
+    if (channel->bufferedCount() != 3 || channel->available() != 3 || !channel->waitAvailable(0)) {
+        return false;
+    }
+    if (channel->receive(buffer, 0, sizeof(buffer)) != 3 || memcmp(buffer, "bc\n", 3) != 0) {
+        return false;
+    }
+    if (channel->available() != 0 || channel->waitAvailable(0)) {
+        return false;
+    }
+
+    dm.close();
+    return true;
+}
+
+bool testBenchmark() {
+    static const int DeviceCount = 50000;
+    static const int DevicesPerChannel = 10;
+    static const int Rounds = 10;
+
+    DriverManager dm;
+    addDevices(dm, DeviceCount, DevicesPerChannel);
+
+    uint64_t start = Environment::getTickCount();
+    dm.open();
+    uint64_t elapsed = Environment::getTickCount() - start;
+    printf("DriverManager, open %d devices: %llu ms\n", DeviceCount, (unsigned long long) elapsed);
+
+    StringArray deviceNames;
+    for (int i = 0; i < DeviceCount; i++) {
+        deviceNames.add(String::convert("device%d", i));
+    }
+    InstructionDescription id("read");
+    start = Environment::getTickCount();
+    for (int r = 0; r < Rounds; r++) {
+        for (size_t i = 0; i < deviceNames.count(); i++) {
+            if (dm.executeInstruction(deviceNames[i], &id) != id.context()) {
+                return false;
+            }
+        }
+    }
+    elapsed = Environment::getTickCount() - start;
+    printf("DriverManager, execute %d instructions on %d devices: %llu ms\n", DeviceCount * Rounds, DeviceCount,
+           (unsigned long long) elapsed);
+
+    // a frame received by a channel looks up the device of it.
+    Channels channels(false);
+    for (int i = 0; i < DeviceCount / DevicesPerChannel; i++) {
+        channels.add(dm.getChannel(String::convert("channel%d", i)));
+    }
+    start = Environment::getTickCount();
+    for (int r = 0; r < Rounds; r++) {
+        for (size_t i = 0; i < channels.count(); i++) {
+            if (dm.getDevice(channels.at(i)) == nullptr) {
+                return false;
+            }
+        }
+    }
+    elapsed = Environment::getTickCount() - start;
+    printf("DriverManager, find the devices of %d frames: %llu ms\n", (int) channels.count() * Rounds,
+           (unsigned long long) elapsed);
+
+    // the pools of all the devices are published at once.
+    InstructionPools pools(false);
+    DeviceDescriptions *dds = dm.description()->getDevices();
+    for (size_t i = 0; i < dds->count(); i++) {
+        DeviceDescription *dd = dds->at(i);
+        pools.add(new InstructionPool(&dm, dd->getChannel(), dd));
+    }
+    start = Environment::getTickCount();
+    dm.addPools(pools);
+    elapsed = Environment::getTickCount() - start;
+    printf("DriverManager, add %d pools: %llu ms\n", DeviceCount, (unsigned long long) elapsed);
+
+    start = Environment::getTickCount();
+    for (int r = 0; r < Rounds; r++) {
+        for (size_t i = 0; i < deviceNames.count(); i++) {
+            if (dm.getPool(deviceNames[i]) != pools.at(i)) {
+                return false;
+            }
+        }
+    }
+    elapsed = Environment::getTickCount() - start;
+    printf("DriverManager, find %d pools: %llu ms\n", DeviceCount * Rounds, (unsigned long long) elapsed);
+
+    start = Environment::getTickCount();
+    dm.close();
+    elapsed = Environment::getTickCount() - start;
+    printf("DriverManager, close %d devices: %llu ms\n", DeviceCount, (unsigned long long) elapsed);
+
+    return true;
+}
+
+int main() {
+    if (!testDevices()) {
+        return 1;
+    }
+    if (!testPools()) {
+        return 2;
+    }
+    if (!testBenchmark()) {
+        return 3;
+    }
+    if (!testChannelBuffer()) {
+        return 4;
+    }
+
+    return 0;
+}
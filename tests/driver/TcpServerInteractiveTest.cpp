@@ -0,0 +1,131 @@
+//
+//  TcpServerInteractiveTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "driver/DriverManager.h"
+#include "driver/channels/TcpServerInteractive.h"
+#include "driver/channels/TcpServerChannelContext.h"
+#include "driver/instructions/InstructionSet.h"
+#include "driver/devices/DeviceDescription.h"
+#include "net/TcpClient.h"
+#include "thread/Thread.h"
+#include "thread/TickTimeout.h"
+
+using namespace Drivers;
+using namespace Net;
+using namespace Threading;
+
+static const int _port = 28502;
+
+class TestInstructionSet : public InstructionSet {
+public:
+    void generateInstructions(Instructions *instructions) override {
+    }
+
+    InstructionSet *clone() const override {
+        return new TestInstructionSet();
+    }
+};
+
+// waits until the server has count clients.
+bool waitClientCount(TcpServerInteractive *ti, size_t count, uint32_t timeout) {
+    uint32_t start = TickTimeout::getCurrentTickCount();
+    while (ti->clientCount() != count) {
+        if (TickTimeout::isTimeout(start, TimeSpan::fromMilliseconds(timeout))) {
+            return false;
+        }
+        Thread::msleep(10);
+    }
+    return true;
+}
+
+bool testReactorCloseIdle() {
+    DriverManager dm;
+    auto cd = new ChannelDescription("server", "TcpServerInteractive");
+    auto tcc = (TcpServerChannelContext *) cd->context();
+    tcc->setAddress("127.0.0.1");
+    tcc->setPort(_port);
+    tcc->setReuseAddress(true);
+    tcc->setReceiverType(TcpChannelContext::Reactor);
+    tcc->setEventLoopCount(1);
+    tcc->setCloseTimeout(300);
+    dm.description()->addDevice(new DeviceDescription("server", cd, new TestInstructionSet()));
+    dm.open();
+
+    auto ti = dynamic_cast<TcpServerInteractive *>(dm.getChannel("server")->interactive());
+    if (ti == nullptr) {
+        return false;
+    }
+
+    TcpClient client;
+    if (!client.connectToHost("127.0.0.1", _port)) {
+        return false;
+    }
+    if (!waitClientCount(ti, 1, 3000)) {
+        return false;
+    }
+
+    // the idle client times out, then the loop sweeps it, once a second.
+    if (!waitClientCount(ti, 0, 3000)) {
+        return false;
+    }
+
+    dm.close();
+    return true;
+}
+
+bool testReactorMaxConnections() {
+    DriverManager dm;
+    auto cd = new ChannelDescription("server", "TcpServerInteractive");
+    auto tcc = (TcpServerChannelContext *) cd->context();
+    tcc->setAddress("127.0.0.1");
+    tcc->setPort(_port + 1);
+    tcc->setReuseAddress(true);
+    tcc->setReceiverType(TcpChannelContext::Reactor);
+    tcc->setEventLoopCount(2);
+    tcc->setMaxConnections(2);
+    dm.description()->addDevice(new DeviceDescription("server", cd, new TestInstructionSet()));
+    dm.open();
+
+    auto ti = dynamic_cast<TcpServerInteractive *>(dm.getChannel("server")->interactive());
+    if (ti == nullptr) {
+        return false;
+    }
+
+    TcpClient clients[3];
+    for (int i = 0; i < 2; i++) {
+        if (!clients[i].connectToHost("127.0.0.1", _port + 1)) {
+            return false;
+        }
+    }
+    if (!waitClientCount(ti, 2, 3000)) {
+        return false;
+    }
+
+    // the third one is accepted and closed at once.
+    if (!clients[2].connectToHost("127.0.0.1", _port + 1)) {
+        return false;
+    }
+    Thread::msleep(200);
+    if (ti->clientCount() != 2) {
+        return false;
+    }
+
+    dm.close();
+    return true;
+}
+
+int main() {
+    if (!testReactorCloseIdle()) {
+        return 1;
+    }
+    if (!testReactorMaxConnections()) {
+        return 2;
+    }
+
+    return 0;
+}
@@ -12,6 +12,10 @@
 #include "IO/Path.h"
 #include "IO/File.h"
 #include "IO/Directory.h"
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <algorithm>
 
 using namespace Http;
 
@@ -29,6 +33,9 @@ static HttpStatus onAction(void *parameter, const HttpRequest &request, HttpResp
         if (request.match("get/test")) {
             response.headers.add("Content-Type", "text/plain");
             response.setContent("test abc.");
+        } else if (request.match("get/slow")) {
+            Thread::msleep(500);
+            response.setContent("slow");
         } else if (request.match("get/test2")) {
             response.headers.add("Content-Type", "application/octet-stream");
             auto ms = new MemoryStream();
@@ -399,6 +406,197 @@ bool testEscape() {
     return true;
 }
 
+bool testSendAsync() {
+    Url baseUrl("http", Endpoint("127.0.0.1", _serverPort));
+    HttpHeaders textHeaders({HttpHeader("Content-Type", "text/plain")});
+    HttpClient client{
+            {"connectionTimeout",  "00:00:05"},
+            {"receiveTimeout",     "00:00:05"},
+            {"maxHostConnections", "4"},
+    };
+    if (client.maxHostConnections() != 4) {
+        return false;
+    }
+
+    static const int Count = 100;
+    std::atomic<int> completed(0);
+    std::atomic<int> succeeded(0);
+    struct State {
+        std::atomic<int> *completed;
+        std::atomic<int> *succeeded;
+    } state{&completed, &succeeded};
+    for (int i = 0; i < Count; i++) {
+        HttpRequest request(Url(baseUrl, "get/test"), HttpMethod::Get, textHeaders);
+        bool result = client.sendAsync(request, [](bool result, HttpResponse &response, void *state) {
+            auto s = (State *) state;
+            auto content = dynamic_cast<HttpStringContent *>(response.content);
+            if (result && response.status == HttpStatus::HttpOk && content != nullptr &&
+                content->value() == "test abc.") {
+                (*s->succeeded)++;
+            }
+            (*s->completed)++;
+        }, &state);
+        if (!result) {
+            return false;
+        }
+    }
+    Thread::delay(10000, Func<bool>([](std::atomic<int> *completed) {
+        return *completed == Count;
+    }, &completed));
+    if (completed != Count || succeeded != Count || client.pendingCount() != 0) {
+        return false;
+    }
+
+    // the sync requests of many threads share the handles of the client.
+    std::atomic<int> succeeded2(0);
+    Thread *threads[4];
+    for (auto &thread: threads) {
+        thread = new Thread("http.test", [&client, &baseUrl, &textHeaders, &succeeded2]() {
+            for (int i = 0; i < 25; i++) {
+                String response;
+                if (client.get(Url(baseUrl, "get/test"), textHeaders, response) && response == "test abc.") {
+                    succeeded2++;
+                }
+            }
+        });
+        thread->start();
+    }
+    for (auto &thread: threads) {
+        thread->join();
+        delete thread;
+    }
+    if (succeeded2 != 100) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testStopAsync() {
+    Url baseUrl("http", Endpoint("127.0.0.1", _serverPort));
+    HttpHeaders textHeaders({HttpHeader("Content-Type", "text/plain")});
+    std::atomic<int> completed(0);
+    std::atomic<int> failed(0);
+    struct State {
+        std::atomic<int> *completed;
+        std::atomic<int> *failed;
+    } state{&completed, &failed};
+    {
+        HttpClient client;
+        HttpRequest request(Url(baseUrl, "get/slow"), HttpMethod::Get, textHeaders);
+        bool result = client.sendAsync(request, [](bool result, HttpResponse &, void *state) {
+            auto s = (State *) state;
+            if (!result) {
+                (*s->failed)++;
+            }
+            (*s->completed)++;
+        }, &state);
+        if (!result) {
+            return false;
+        }
+        Thread::msleep(100);
+    }
+    // the transfer not done is completed with an error when the client is destroyed.
+    if (completed != 1 || failed != 1) {
+        return false;
+    }
+    // the server is still processing the slow request.
+    Thread::msleep(500);
+
+    return true;
+}
+
+static double percentile(std::vector<double> &values, double p) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = (size_t) (p * (double) (values.size() - 1));
+    return values[index];
+}
+
+bool testBenchmark() {
+    typedef std::chrono::steady_clock Clock;
+    Url url(Url("http", Endpoint("127.0.0.1", _serverPort)), "get/test");
+    HttpHeaders textHeaders({HttpHeader("Content-Type", "text/plain")});
+    static const int Count = 2000;
+
+    // a new client and connection of every request, the former behavior.
+    {
+        std::vector<double> latencies;
+        auto start = Clock::now();
+        for (int i = 0; i < Count / 4; i++) {
+            auto time = Clock::now();
+            HttpClient client;
+            String response;
+            if (!client.get(url, textHeaders, response)) {
+                return false;
+            }
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - time).count());
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        printf("new connection per request, %d requests: %.0f req/s, p50: %.0f us, p99: %.0f us\n", Count / 4,
+               Count / 4 / seconds, percentile(latencies, 0.5), percentile(latencies, 0.99));
+    }
+
+    HttpClient client;
+    // one thread, the connection is reused.
+    {
+        std::vector<double> latencies;
+        auto start = Clock::now();
+        for (int i = 0; i < Count; i++) {
+            auto time = Clock::now();
+            String response;
+            if (!client.get(url, textHeaders, response)) {
+                return false;
+            }
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - time).count());
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        printf("reused connection, %d requests: %.0f req/s, p50: %.0f us, p99: %.0f us\n", Count,
+               Count / seconds, percentile(latencies, 0.5), percentile(latencies, 0.99));
+    }
+
+    // all the requests in flight, multiplexed by the engine.
+    {
+        struct State {
+            Clock::time_point time;
+            double latency;
+            std::atomic<int> *completed;
+        };
+        std::atomic<int> completed(0);
+        std::vector<State> states((size_t) Count);
+        auto start = Clock::now();
+        for (int i = 0; i < Count; i++) {
+            State &state = states[i];
+            state.time = Clock::now();
+            state.completed = &completed;
+            HttpRequest request(url, HttpMethod::Get, textHeaders);
+            client.sendAsync(request, [](bool, HttpResponse &, void *state) {
+                auto s = (State *) state;
+                s->latency = std::chrono::duration<double, std::micro>(Clock::now() - s->time).count();
+                (*s->completed)++;
+            }, &state);
+        }
+        Thread::delay(30000, Func<bool>([](std::atomic<int> *completed) {
+            return *completed == Count;
+        }, &completed));
+        if (completed != Count) {
+            return false;
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::vector<double> latencies;
+        for (const State &state: states) {
+            latencies.push_back(state.latency);
+        }
+        printf("async, %d requests in flight, %d connections: %.0f req/s, p50: %.0f us, p99: %.0f us\n", Count,
+               (int) client.maxHostConnections(), Count / seconds, percentile(latencies, 0.5),
+               percentile(latencies, 0.99));
+    }
+
+    return true;
+}
+
 int main() {
     // start a web server.
     HttpServer server;
@@ -440,6 +638,15 @@ int main() {
     if (!testEscape()) {
         result = 8;
     }
+    if (!testSendAsync()) {
+        result = 9;
+    }
+    if (!testBenchmark()) {
+        result = 10;
+    }
+    if (!testStopAsync()) {
+        result = 11;
+    }
 
     cleanUp();
 
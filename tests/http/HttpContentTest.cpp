@@ -520,6 +520,58 @@ bool testHttpContent() {
     return true;
 }
 
+bool writeNumbers(void *state, Stream &stream) {
+    int &number = *(int *) state;
+    stream.writeByte((uint8_t) ('0' + number));
+    return ++number < 10;
+}
+
+bool testHttpContentRead() {
+    {
+        HttpStringContent test("abcdef");
+        char buffer[4];
+        if (test.read(buffer, 1, 4) != 4 || memcmp(buffer, "abcd", 4) != 0) {
+            return false;
+        }
+        if (test.read(buffer, 1, 4) != 2 || memcmp(buffer, "ef", 2) != 0) {
+            return false;
+        }
+        if (test.read(buffer, 1, 4) != 0) {
+            return false;
+        }
+        HttpStringContent test2(test);
+        if (test2.read(buffer, 1, 4) != 4 || test2.value() != "abcdef") {
+            return false;
+        }
+    }
+    {
+        HttpByteArrayContent test(ByteArray((const uint8_t *) "abcdef", 6));
+        HttpByteArrayContent test2(test);
+        uint8_t buffer[8];
+        if (test2.read(buffer, 1, 8) != 6 || memcmp(buffer, "abcdef", 6) != 0) {
+            return false;
+        }
+    }
+    {
+        int number = 0;
+        HttpChunkedContent test(&number, writeNumbers);
+        if (test.size() != 0 || test.isEnd()) {
+            return false;
+        }
+        String text;
+        char buffer[3];
+        ssize_t count;
+        while ((count = test.read(buffer, 1, sizeof(buffer))) > 0) {
+            text.append(buffer, count);
+        }
+        if (text != "0123456789" || !test.isEnd()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     if (!testHttpHeader()) {
         return 1;
@@ -545,5 +597,9 @@ int main() {
         return 6;
     }
 
+    if (!testHttpContentRead()) {
+        return 7;
+    }
+
     return 0;
 }
\ No newline at end of file
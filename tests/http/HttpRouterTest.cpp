@@ -0,0 +1,298 @@
+//
+//  HttpRouterTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "http/HttpRouter.h"
+#include "system/Environment.h"
+
+using namespace Http;
+using namespace System;
+
+static int _values[16];
+
+HttpRequest makeRequest(const HttpMethod &method, const String &path) {
+    return HttpRequest(Url(String("http://127.0.0.1:8080/") + path), method);
+}
+
+void *routeValue(const HttpRouter &router, const HttpRequest &request) {
+    const HttpRouter::Values *values = router.route(request);
+    return values != nullptr && !values->empty() ? values->front() : nullptr;
+}
+
+bool testRoute() {
+    HttpRouter router;
+    router.add(HttpMethod::Get, "api/v1/users", &_values[0]);
+    router.add(HttpMethod::Post, "api/v1/users", &_values[1]);
+    router.add(HttpMethod::Get, "/api/v1/users/{id}", &_values[2]);
+    router.add(HttpMethod::Get, "api/v1/users/me", &_values[3]);
+    router.add(HttpMethod::Get, "api/v1/users/{id}/orders/{orderId}", &_values[4]);
+    router.add(HttpMethod::Get, "api/v1/{module}/status", &_values[5]);
+    router.add(HttpMethod::Get, "", &_values[6]);
+    if (router.count() != 7) {
+        return false;
+    }
+
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users")) != &_values[0]) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Post, "api/v1/users")) != &_values[1]) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Delete, "api/v1/users")) != nullptr) {
+        return false;
+    }
+    // the text segment is preferred.
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users/me")) != &_values[3]) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users/me2")) != &_values[2]) {
+        return false;
+    }
+    // backtracks to the variable, users is not a text segment of status.
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users/status")) != &_values[2]) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/orders/status")) != &_values[5]) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users/1/orders")) != nullptr) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users/1/orders/2/items")) != nullptr) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api")) != nullptr) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "")) != &_values[6]) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testVariables() {
+    HttpRouter router;
+    router.add(HttpMethod::Get, "api/v1/users/{id}", &_values[0]);
+    router.add(HttpMethod::Get, "api/v1/users/{userId}/orders/{orderId}", &_values[1]);
+    router.add(HttpMethod::Get, "api/v1/users/{id}/name", &_values[2]);
+
+    {
+        HttpRequest request = makeRequest(HttpMethod::Get, "api/v1/users/123");
+        if (routeValue(router, request) != &_values[0]) {
+            return false;
+        }
+        if (request.pathVariables.count() != 1 || request.getPathVariable("id") != "123") {
+            return false;
+        }
+    }
+    {
+        HttpRequest request = makeRequest(HttpMethod::Get, "api/v1/users/123/orders/456");
+        if (routeValue(router, request) != &_values[1]) {
+            return false;
+        }
+        // the id captured while backtracking is dropped.
+        if (request.pathVariables.count() != 2) {
+            return false;
+        }
+        if (request.getPathVariable("userId") != "123" || request.getPathVariable("orderId") != "456") {
+            return false;
+        }
+        String value;
+        if (request.getPathVariable("id", value)) {
+            return false;
+        }
+        if (request.pathVariables.nameAt(1) != "orderId" || request.pathVariables.valueAt(1) != "456") {
+            return false;
+        }
+    }
+    {
+        HttpRequest request = makeRequest(HttpMethod::Get, "api/v1/users/abc/name");
+        if (routeValue(router, request) != &_values[2] || request.getPathVariable("id") != "abc") {
+            return false;
+        }
+    }
+    {
+        HttpRequest request = makeRequest(HttpMethod::Get, "api/v1/users/abc/unknown");
+        if (routeValue(router, request) != nullptr || request.pathVariables.count() != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testManyVariables() {
+    // more variables than the ones kept in place.
+    HttpRouter router;
+    String path, requestPath;
+    for (int i = 0; i < 12; i++) {
+        path.append(String::format("/{v%d}", i));
+        requestPath.append(String::format("/%d", i));
+    }
+    router.add(HttpMethod::Get, path, &_values[0]);
+    router.add(HttpMethod::Get, path + "/end", &_values[1]);
+
+    {
+        HttpRequest request = makeRequest(HttpMethod::Get, requestPath.substr(1));
+        if (routeValue(router, request) != &_values[0] || request.pathVariables.count() != 12) {
+            return false;
+        }
+        if (request.getPathVariable("v0") != "0" || request.getPathVariable("v11") != "11") {
+            return false;
+        }
+        if (request.pathVariables.nameAt(10) != "v10" || request.pathVariables.valueAt(10) != "10") {
+            return false;
+        }
+    }
+    {
+        HttpRequest request = makeRequest(HttpMethod::Get, requestPath.substr(1) + "/end");
+        if (routeValue(router, request) != &_values[1] || request.getPathVariable("v9") != "9") {
+            return false;
+        }
+    }
+    {
+        HttpRequest request = makeRequest(HttpMethod::Get, requestPath.substr(1) + "/end/more");
+        if (routeValue(router, request) != nullptr || request.pathVariables.count() != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testRemove() {
+    HttpRouter router;
+    router.add(HttpMethod::Get, "api/v1/users/{id}", &_values[0]);
+    router.add(HttpMethod::Get, "api/v1/users/{id}", &_values[1]);
+    router.add(HttpMethod::Options, "api/v1/users/{id}", &_values[0]);
+
+    {
+        const HttpRouter::Values *values = router.route(makeRequest(HttpMethod::Get, "api/v1/users/1"));
+        if (values == nullptr || values->size() != 2 || (*values)[0] != &_values[0] ||
+            (*values)[1] != &_values[1]) {
+            return false;
+        }
+    }
+    if (!router.remove(HttpMethod::Get, "api/v1/users/{id}", &_values[0])) {
+        return false;
+    }
+    if (router.remove(HttpMethod::Get, "api/v1/users/{id}", &_values[0])) {
+        return false;
+    }
+    if (router.remove(HttpMethod::Get, "api/v1/users/{name}", &_values[1])) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users/1")) != &_values[1]) {
+        return false;
+    }
+    if (!router.remove(HttpMethod::Get, "api/v1/users/{id}", &_values[1])) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Get, "api/v1/users/1")) != nullptr) {
+        return false;
+    }
+    if (routeValue(router, makeRequest(HttpMethod::Options, "api/v1/users/1")) != &_values[0]) {
+        return false;
+    }
+    router.clear();
+    if (router.count() != 0 || routeValue(router, makeRequest(HttpMethod::Options, "api/v1/users/1")) != nullptr) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testBenchmark() {
+    static const int MappingCount = 500;
+    static const int RequestCount = 1000000;
+    static const int LinearCount = 10000;
+
+    // 50 modules of 10 mappings, the half of them have a variable.
+    static const HttpMethod *methods[] = {&HttpMethod::Get, &HttpMethod::Post, &HttpMethod::Put, &HttpMethod::Delete};
+    HttpRouter router;
+    StringArray paths;
+    PList<HttpMethod> mappingMethods;
+    for (int i = 0; i < MappingCount; i++) {
+        String path = i % 2 == 0 ?
+                      String::format("api/v1/module%d/resource%d", i / 10, i % 10) :
+                      String::format("api/v1/module%d/resource%d/{id}/detail", i / 10, i % 10);
+        const HttpMethod &method = *methods[i % 4];
+        paths.add(path);
+        mappingMethods.add(new HttpMethod(method));
+        router.add(method, path, (void *) (intptr_t) (i + 1));
+    }
+
+    PList<HttpRequest> requests;
+    for (int i = 0; i < 1000; i++) {
+        int index = (i * 7919) % MappingCount;
+        String path = index % 2 == 0 ?
+                      String::format("api/v1/module%d/resource%d", index / 10, index % 10) :
+                      String::format("api/v1/module%d/resource%d/%d/detail", index / 10, index % 10, i);
+        requests.add(new HttpRequest(makeRequest(*methods[index % 4], path)));
+    }
+
+    uint64_t start = Environment::getTickCount();
+    int found = 0;
+    for (int i = 0; i < RequestCount; i++) {
+        const HttpRequest &request = *requests[i % requests.count()];
+        if (routeValue(router, request) != nullptr) {
+            found++;
+        }
+    }
+    uint64_t elapsed = Environment::getTickCount() - start;
+    if (found != RequestCount) {
+        return false;
+    }
+
+    // the linear matching of the mappings, the same as before the router.
+    start = Environment::getTickCount();
+    found = 0;
+    for (int i = 0; i < LinearCount; i++) {
+        const HttpRequest &request = *requests[i % requests.count()];
+        for (int j = 0; j < MappingCount; j++) {
+            if (request.method == *mappingMethods[j] && request.match(paths[j])) {
+                found++;
+                break;
+            }
+        }
+    }
+    uint64_t linearElapsed = Environment::getTickCount() - start;
+    if (found != LinearCount) {
+        return false;
+    }
+
+    printf("route %d requests across %d mappings: %llu ms, %.1f ns/request, linear match: %.1f ns/request\n",
+           RequestCount, MappingCount, (unsigned long long) elapsed, (double) elapsed * 1000000.0 / RequestCount,
+           (double) linearElapsed * 1000000.0 / LinearCount);
+
+    return true;
+}
+
+int main() {
+    if (!testRoute()) {
+        return 1;
+    }
+
+    if (!testVariables()) {
+        return 2;
+    }
+
+    if (!testRemove()) {
+        return 3;
+    }
+
+    if (!testBenchmark()) {
+        return 4;
+    }
+
+    if (!testManyVariables()) {
+        return 5;
+    }
+
+    return 0;
+}
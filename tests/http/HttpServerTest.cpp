@@ -0,0 +1,643 @@
+//
+//  HttpServerTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "http/HttpServer.h"
+#include "system/Environment.h"
+#include "system/Math.h"
+#include <algorithm>
+#include <chrono>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace Http;
+using namespace System;
+using namespace std::chrono;
+
+static const uint16_t BasePort = 18620;
+
+static const size_t LargeSize = 1024 * 1024;
+
+// The rows written 100 by 100 while they are sent.
+class RowsContent : public HttpChunkedContent {
+public:
+    explicit RowsContent(int count) : _row(0), _count(count) {
+    }
+
+protected:
+    bool writeNext(Stream &stream) override {
+        for (int i = 0; i < 100 && _row < _count; i++, _row++) {
+            String line = String::format("row %d\n", _row);
+            stream.write((const uint8_t *) line.c_str(), 0, line.length());
+        }
+        return _row < _count;
+    }
+
+private:
+    int _row;
+    int _count;
+};
+
+// The '.' of the size, it is never in memory as a whole.
+class BlankContent : public HttpChunkedContent {
+public:
+    explicit BlankContent(int64_t size) : _size(size) {
+    }
+
+protected:
+    bool writeNext(Stream &stream) override {
+        static uint8_t part[64 * 1024] = {0};
+        if (part[0] == 0) {
+            memset(part, '.', sizeof(part));
+        }
+        size_t count = (size_t) Math::min(_size, (int64_t) sizeof(part));
+        stream.write(part, 0, count);
+        _size -= (int64_t) count;
+        return _size > 0;
+    }
+
+private:
+    int64_t _size;
+};
+
+HttpStatus onAction(void *, const HttpRequest &request, HttpResponse &response) {
+    const String path = request.url.relativeUrl();
+    if (path == "slow") {
+        Thread::msleep(1000);
+    } else if (path == "large") {
+        response.setContent(String('a', LargeSize));
+        return HttpStatus::HttpOk;
+    } else if (path == "rows" || path == "slowrows") {
+        if (path == "slowrows") {
+            Thread::msleep(500);
+        }
+        response.content = new RowsContent(10000);
+        return HttpStatus::HttpOk;
+    } else if (path.find("blank/") == 0) {
+        int64_t size = 0;
+        Int64::parse(path.substr(6), size);
+        response.content = new BlankContent(size);
+        return HttpStatus::HttpOk;
+    } else if (path == "text") {
+        // the body stays in the chains of libevent until the text is asked for.
+        bool buffered = dynamic_cast<HttpBufferContent *>(request.content) != nullptr;
+        response.setContent(buffered ? Int64((int64_t) request.text().length()).toString() : String("copied"));
+        return HttpStatus::HttpOk;
+    } else if (path == "upload") {
+        // the body is in a file, it is checked part by part.
+        auto content = dynamic_cast<HttpStreamContent *>(request.content);
+        Stream *stream = content != nullptr ? content->stream() : nullptr;
+        int64_t length = 0;
+        bool valid = stream != nullptr;
+        uint8_t buffer[64 * 1024];
+        ssize_t count;
+        while (valid && (count = stream->read(buffer, 0, sizeof(buffer))) > 0) {
+            for (ssize_t i = 0; i < count; i++) {
+                if (buffer[i] != (uint8_t) ((length + i) % 251)) {
+                    valid = false;
+                    break;
+                }
+            }
+            length += count;
+        }
+        response.setContent(valid ? Int64(length).toString() : String("invalid"));
+        return HttpStatus::HttpOk;
+    }
+    response.setContent("ok");
+    return HttpStatus::HttpOk;
+}
+
+int connectServer(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    int flag = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    return fd;
+}
+
+// Sends a keep-alive GET, returns the status code, or -1 if failed.
+int get(int fd, const char *path, String *body = nullptr) {
+    char buffer[4096];
+    int length = snprintf(buffer, sizeof(buffer), "GET /%s HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n", path);
+    if (send(fd, buffer, length, 0) != length) {
+        return -1;
+    }
+
+    size_t count = 0;
+    const char *end = nullptr;
+    while (end == nullptr) {
+        ssize_t size = recv(fd, buffer + count, sizeof(buffer) - count - 1, 0);
+        if (size <= 0) {
+            return -1;
+        }
+        count += size;
+        buffer[count] = '\0';
+        end = strstr(buffer, "\r\n\r\n");
+    }
+    int code = 0;
+    if (sscanf(buffer, "HTTP/1.1 %d", &code) != 1) {
+        return -1;
+    }
+    size_t contentLength = 0;
+    const char *header = strcasestr(buffer, "Content-Length:");
+    if (header != nullptr && header < end) {
+        contentLength = (size_t) atol(header + 15);
+    }
+    size_t headerLength = end + 4 - buffer;
+    while (count < headerLength + contentLength) {
+        ssize_t size = recv(fd, buffer + count, sizeof(buffer) - count - 1, 0);
+        if (size <= 0) {
+            return -1;
+        }
+        count += size;
+    }
+    if (body != nullptr) {
+        *body = String(buffer + headerLength, contentLength);
+    }
+    return code;
+}
+
+// Reads a response with the Content-Length or the chunked body, the body is kept if it is not null.
+int readResponse(int fd, String *body, int64_t &length) {
+    static const size_t BufferSize = 64 * 1024;
+    std::vector<char> buffer(BufferSize + 1);
+    size_t position = 0, count = 0;
+    auto fill = [&]() {
+        if (position > 0) {
+            memmove(buffer.data(), buffer.data() + position, count - position);
+            count -= position;
+            position = 0;
+        }
+        ssize_t size = recv(fd, buffer.data() + count, BufferSize - count, 0);
+        if (size <= 0) {
+            return false;
+        }
+        count += size;
+        buffer[count] = '\0';
+        return true;
+    };
+    auto readLine = [&](String &line) {
+        const char *end;
+        while ((end = strstr(buffer.data() + position, "\r\n")) == nullptr) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        // the count 0 means to the end of the string.
+        line = end > buffer.data() + position ? String(buffer.data() + position, end - buffer.data() - position) :
+               String::Empty;
+        position = end + 2 - buffer.data();
+        return true;
+    };
+    auto consume = [&](int64_t size) {
+        while (size > 0) {
+            if (position == count && !fill()) {
+                return false;
+            }
+            size_t n = (size_t) Math::min((int64_t) (count - position), size);
+            if (body != nullptr) {
+                body->append(buffer.data() + position, n);
+            }
+            position += n;
+            size -= (int64_t) n;
+            length += (int64_t) n;
+        }
+        return true;
+    };
+
+    buffer[0] = '\0';
+    String line;
+    int code = 0;
+    if (!readLine(line) || sscanf(line.c_str(), "HTTP/1.1 %d", &code) != 1) {
+        return -1;
+    }
+    int64_t contentLength = -1;
+    bool chunked = false;
+    while (readLine(line) && !line.isNullOrEmpty()) {
+        if (strncasecmp(line.c_str(), "Content-Length:", 15) == 0) {
+            contentLength = atoll(line.c_str() + 15);
+        } else if (strncasecmp(line.c_str(), "Transfer-Encoding: chunked", 26) == 0) {
+            chunked = true;
+        }
+    }
+
+    length = 0;
+    if (!chunked) {
+        return consume(Math::max(contentLength, (int64_t) 0)) ? code : -1;
+    }
+    while (true) {
+        if (!readLine(line)) {
+            return -1;
+        }
+        int64_t size = strtoll(line.c_str(), nullptr, 16);
+        if (size == 0) {
+            return readLine(line) ? code : -1;
+        }
+        if (!consume(size) || !readLine(line)) {
+            return -1;
+        }
+    }
+}
+
+// Sends a keep-alive request with a generated body of the size.
+bool sendRequest(int fd, const char *method, const char *path, int64_t size = 0) {
+    char header[512];
+    int length = snprintf(header, sizeof(header),
+                          "%s /%s HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                          "Content-Type: application/octet-stream\r\nContent-Length: %lld\r\n\r\n",
+                          method, path, (long long) size);
+    if (send(fd, header, length, 0) != length) {
+        return false;
+    }
+    uint8_t buffer[64 * 1024];
+    for (int64_t position = 0; position < size;) {
+        size_t count = (size_t) Math::min(size - position, (int64_t) sizeof(buffer));
+        for (size_t i = 0; i < count; i++) {
+            buffer[i] = (uint8_t) ((position + (int64_t) i) % 251);
+        }
+        if (send(fd, buffer, count, 0) != (ssize_t) count) {
+            return false;
+        }
+        position += (int64_t) count;
+    }
+    return true;
+}
+
+// Sends a keep-alive request with the text body.
+bool sendText(int fd, const char *path, const String &text) {
+    char header[512];
+    int length = snprintf(header, sizeof(header),
+                          "POST /%s HTTP/1.1\r\nHost: 127.0.0.1\r\n"
+                          "Content-Type: text/plain\r\nContent-Length: %d\r\n\r\n",
+                          path, (int) text.length());
+    return send(fd, header, length, 0) == length &&
+           send(fd, text.c_str(), text.length(), 0) == (ssize_t) text.length();
+}
+
+// The peak of the resident memory in MB since the last reset.
+int64_t peakMemory(bool reset = false) {
+    FILE *file = fopen(reset ? "/proc/self/clear_refs" : "/proc/self/status", reset ? "w" : "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    int64_t peak = 0;
+    char line[256];
+    if (reset) {
+        fputs("5", file);
+    } else {
+        while (fgets(line, sizeof(line), file) != nullptr) {
+            if (strncmp(line, "VmHWM:", 6) == 0) {
+                peak = atoll(line + 6) / 1024;
+            }
+        }
+    }
+    fclose(file);
+    return peak;
+}
+
+bool testStart() {
+    HttpServer server;
+    HttpServer::Context context(Endpoint("127.0.0.1", BasePort), HttpServer::Secure::None,
+                                TimeSpan::fromSeconds(30), 4, 2);
+    if (context.loopCount != 4 || context.workerCount != 2) {
+        return false;
+    }
+    if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+    if (!server.isAlive()) {
+        return false;
+    }
+    // already started.
+    if (server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+
+    // the connections are balanced to the loops, each one is replied.
+    for (int i = 0; i < 16; i++) {
+        int fd = connectServer(BasePort);
+        String body;
+        if (fd < 0) {
+            return false;
+        }
+        int code = get(fd, "test", &body);
+        int code2 = get(fd, "test2");
+        close(fd);
+        if (code != 200 || code2 != 200 || body != "ok") {
+            return false;
+        }
+    }
+
+    server.stop();
+    if (server.isAlive()) {
+        return false;
+    }
+
+    // restart on the same port.
+    if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+    int fd = connectServer(BasePort);
+    bool result = fd >= 0 && get(fd, "test") == 200;
+    close(fd);
+    server.stop();
+
+    return result;
+}
+
+bool testSlowAction() {
+    HttpServer server;
+    HttpServer::Context context(Endpoint("127.0.0.1", BasePort + 1), HttpServer::Secure::None,
+                                TimeSpan::fromSeconds(30), 1, 4);
+    if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+
+    int slowCode = 0;
+    Thread slow("slow", [&slowCode]() {
+        int fd = connectServer(BasePort + 1);
+        slowCode = get(fd, "slow");
+        close(fd);
+    });
+    slow.start();
+    Thread::msleep(100);
+
+    // the slow action runs on a worker, the loop still replies the others.
+    uint64_t start = Environment::getTickCount();
+    int fd = connectServer(BasePort + 1);
+    int code = get(fd, "fast");
+    close(fd);
+    uint64_t elapsed = Environment::getTickCount() - start;
+
+    slow.join();
+    server.stop();
+    return code == 200 && slowCode == 200 && elapsed < 500;
+}
+
+// Sends a request, the client is closed before the reply.
+void abandon(uint16_t port, const char *path) {
+    int fd = connectServer(port);
+    char buffer[256];
+    int length = snprintf(buffer, sizeof(buffer), "GET /%s HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n", path);
+    send(fd, buffer, length, 0);
+    Thread::msleep(100);
+    close(fd);
+}
+
+bool testClientGone() {
+    HttpServer server;
+    HttpServer::Context context(Endpoint("127.0.0.1", BasePort + 7), HttpServer::Secure::None,
+                                TimeSpan::fromSeconds(30), 1, 4);
+    if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+
+    // the workers are still processing when the clients are gone, the replies are dropped.
+    abandon(BasePort + 7, "slow");
+    abandon(BasePort + 7, "slowrows");
+    Thread::msleep(1500);
+
+    int fd = connectServer(BasePort + 7);
+    int code = get(fd, "fast");
+    close(fd);
+
+    server.stop();
+    return code == 200;
+}
+
+bool testBody() {
+    HttpServer server;
+    HttpServer::Context context(Endpoint("127.0.0.1", BasePort + 5), HttpServer::Secure::None,
+                                TimeSpan::fromSeconds(30), 1, 2);
+    if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+    int fd = connectServer(BasePort + 5);
+    if (fd < 0) {
+        return false;
+    }
+    bool result = true;
+
+    // sent by reference.
+    String body;
+    int64_t length = 0;
+    if (!sendRequest(fd, "GET", "large") || readResponse(fd, &body, length) != 200 ||
+        body != String('a', LargeSize)) {
+        result = false;
+    }
+
+    // chunked, and the connection is still alive after it.
+    body.empty();
+    if (result && (!sendRequest(fd, "GET", "rows") || readResponse(fd, &body, length) != 200 ||
+                   body.find("row 0\n") != 0 ||
+                   body.substr(body.length() - 9) != "row 9999\n")) {
+        result = false;
+    }
+
+    // the upload is in a file.
+    body.empty();
+    if (result && (!sendRequest(fd, "POST", "upload", 3 * 1000 * 1000 + 7) ||
+                   readResponse(fd, &body, length) != 200 || body != "3000007")) {
+        result = false;
+    }
+
+    // the client is gone before the body is sent.
+    int fd2 = connectServer(BasePort + 5);
+    if (result && sendRequest(fd2, "GET", "blank/104857600")) {
+        char buffer[1024];
+        recv(fd2, buffer, sizeof(buffer), 0);
+    }
+    close(fd2);
+    if (result && (!sendRequest(fd, "GET", "test") || readResponse(fd, &body, length) != 200)) {
+        result = false;
+    }
+
+    close(fd);
+    server.stop();
+    return result;
+}
+
+bool testTextBody() {
+    HttpServer server;
+    HttpServer::Context context(Endpoint("127.0.0.1", BasePort + 8), HttpServer::Secure::None,
+                                TimeSpan::fromSeconds(30), 1, 2);
+    if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+    int fd = connectServer(BasePort + 8);
+    if (fd < 0) {
+        return false;
+    }
+    bool result = true;
+
+    // received in many chains.
+    String text('a', 200 * 1024);
+    String body;
+    int64_t length = 0;
+    if (!sendText(fd, "text", text) || readResponse(fd, &body, length) != 200 || body != "204800") {
+        result = false;
+    }
+
+    // the illegal text is found in the middle of the chains.
+    text = String('a', 100 * 1024) + "';" + String('a', 100 * 1024);
+    body.empty();
+    if (result && (!sendText(fd, "text", text) || readResponse(fd, &body, length) != 200 ||
+                   body.find("illegal") < 0)) {
+        result = false;
+    }
+
+    close(fd);
+    server.stop();
+    return result;
+}
+
+bool testBodyBenchmark() {
+    static const int64_t Size = 500LL * 1024 * 1024;
+
+    HttpServer server;
+    HttpServer::Context context(Endpoint("127.0.0.1", BasePort + 6), HttpServer::Secure::None,
+                                TimeSpan::fromSeconds(60), 1, 2);
+    if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+        return false;
+    }
+    int fd = connectServer(BasePort + 6);
+    if (fd < 0) {
+        return false;
+    }
+
+    peakMemory(true);
+    int64_t base = peakMemory();
+    uint64_t start = Environment::getTickCount();
+    int64_t length = 0;
+    int code = sendRequest(fd, "GET", "blank/524288000") ? readResponse(fd, nullptr, length) : -1;
+    uint64_t elapsed = Environment::getTickCount() - start;
+    int64_t peak = peakMemory();
+    printf("http server, download %d MB: %llu ms, peak rss: +%d MB\n", (int) (Size / 1024 / 1024),
+           (unsigned long long) elapsed, (int) (peak - base));
+    bool result = code == 200 && length == Size && peak - base < 64;
+
+    peakMemory(true);
+    base = peakMemory();
+    start = Environment::getTickCount();
+    String body;
+    code = sendRequest(fd, "POST", "upload", Size) ? readResponse(fd, &body, length) : -1;
+    elapsed = Environment::getTickCount() - start;
+    peak = peakMemory();
+    printf("http server, upload %d MB: %llu ms, peak rss: +%d MB\n", (int) (Size / 1024 / 1024),
+           (unsigned long long) elapsed, (int) (peak - base));
+    result = result && code == 200 && body == Int64(Size).toString();
+
+    close(fd);
+    server.stop();
+    return result;
+}
+
+bool testBenchmark() {
+    static const int ThreadCounts[] = {1, 4, 16};
+    static const int ClientCount = 16;
+    static const uint64_t Duration = 2000;     // ms
+
+    for (size_t i = 0; i < sizeof(ThreadCounts) / sizeof(ThreadCounts[0]); i++) {
+        int threadCount = ThreadCounts[i];
+        auto port = (uint16_t) (BasePort + 2 + i);
+        HttpServer server;
+        HttpServer::Context context(Endpoint("127.0.0.1", port), HttpServer::Secure::None,
+                                    TimeSpan::fromSeconds(30), threadCount, 0);
+        if (!server.startHttpServer(context, HttpServer::Actions(nullptr, onAction))) {
+            return false;
+        }
+
+        // wrk style, every client keeps one connection and sends the next request after the reply.
+        std::vector<uint32_t> latencies[ClientCount];
+        std::atomic<int> failed(0);
+        uint64_t start = Environment::getTickCount();
+        auto clientProc = [&latencies, &failed, port, start](int index) {
+            int fd = connectServer(port);
+            if (fd < 0) {
+                failed++;
+                return;
+            }
+            std::vector<uint32_t> &values = latencies[index];
+            while (Environment::getTickCount() - start < Duration) {
+                auto begin = steady_clock::now();
+                if (get(fd, "bench") != 200) {
+                    failed++;
+                    break;
+                }
+                values.push_back((uint32_t) duration_cast<microseconds>(steady_clock::now() - begin).count());
+            }
+            close(fd);
+        };
+        PList<Thread> clients;
+        for (int j = 0; j < ClientCount; j++) {
+            auto thread = new Thread("bench.client", clientProc, j);
+            clients.add(thread);
+            thread->start();
+        }
+        for (size_t j = 0; j < clients.count(); j++) {
+            clients[j]->join();
+        }
+        uint64_t elapsed = Environment::getTickCount() - start;
+        server.stop();
+
+        std::vector<uint32_t> all;
+        for (const std::vector<uint32_t> &values: latencies) {
+            all.insert(all.end(), values.begin(), values.end());
+        }
+        if (failed > 0 || all.empty()) {
+            return false;
+        }
+        std::sort(all.begin(), all.end());
+        printf("http server, %d loop threads, %d connections: %.0f requests/s, p50: %u us, p99: %u us\n",
+               threadCount, ClientCount, (double) all.size() * 1000.0 / (double) elapsed,
+               all[all.size() / 2], all[all.size() * 99 / 100]);
+    }
+
+    return true;
+}
+
+int main() {
+    if (!testStart()) {
+        return 1;
+    }
+
+    if (!testSlowAction()) {
+        return 2;
+    }
+
+    if (!testBody()) {
+        return 3;
+    }
+
+    if (!testBodyBenchmark()) {
+        return 4;
+    }
+
+    if (!testBenchmark()) {
+        return 5;
+    }
+
+    if (!testClientGone()) {
+        return 6;
+    }
+
+    if (!testTextBody()) {
+        return 7;
+    }
+
+    return 0;
+}
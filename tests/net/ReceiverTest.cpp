@@ -0,0 +1,235 @@
+//
+//  ReceiverTest.cpp
+//  common
+//
+//  Created by baowei on 2026/10/18.
+//  Copyright (c) 2026 com. All rights reserved.
+//
+
+#include "net/Receiver.h"
+#include "data/ByteArray.h"
+
+using namespace Net;
+
+class MemoryReceiver : public Receiver {
+public:
+    using Receiver::receive;
+
+    explicit MemoryReceiver(const String &str) : _position(0), _readCount(0) {
+        _data.addRange((const uint8_t *) str.c_str(), str.length());
+    }
+
+    bool connected() override {
+        return true;
+    }
+
+    bool useReceiveTimeout() const override {
+        return false;
+    }
+
+    size_t available() override {
+        return _data.count() - _position;
+    }
+
+    ssize_t receive(uint8_t *buffer, off_t offset, size_t count) override {
+        size_t length = count < available() ? count : available();
+        memcpy(buffer + offset, _data.data() + _position, length);
+        _position += length;
+        _readCount++;
+        return (ssize_t) length;
+    }
+
+    int readCount() const {
+        return _readCount;
+    }
+
+private:
+    ByteArray _data;
+    size_t _position;
+    int _readCount;
+};
+
+bool testReceiveBuffer() {
+    {
+        ReceiveBuffer test(16);
+        const uint8_t data[] = "0123456789abcdef0123";
+        if (test.write(data, 10) != 10) {
+            return false;
+        }
+        if (test.skip(8) != 8) {
+            return false;
+        }
+        // wrap around the end of the buffer.
+        if (test.write(data + 10, 10) != 10) {
+            return false;
+        }
+        if (test.count() != 12 || test.capacity() != 16) {
+            return false;
+        }
+        if (test.at(0) != '8' || test.at(2) != 'a') {
+            return false;
+        }
+        if (test.find((const uint8_t *) "ef", 2) != 6) {
+            return false;
+        }
+        // grow with the data wrapped.
+        if (test.write(data, 10) != 10 || test.count() != 22 || test.capacity() != 32) {
+            return false;
+        }
+        uint8_t buffer[32];
+        if (test.read(buffer, sizeof(buffer)) != 22) {
+            return false;
+        }
+        if (memcmp(buffer, "89abcdef01230123456789", 22) != 0) {
+            return false;
+        }
+        if (!test.isEmpty()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testReadLine() {
+    {
+        MemoryReceiver test("line1\r\nline2\r\nline3");
+        uint8_t buffer[64];
+        ssize_t length = test.readLine(buffer, sizeof(buffer), 100, "\r\n");
+        if (String((const char *) buffer, length) != "line1\r\n") {
+            return false;
+        }
+        length = test.readLine(buffer, sizeof(buffer), 100, "\r\n");
+        if (String((const char *) buffer, length) != "line2\r\n") {
+            return false;
+        }
+        // the lines are read in bulk, not byte by byte.
+        if (test.readCount() != 1) {
+            return false;
+        }
+        // no line end, so return the rest after timeout.
+        length = test.readLine(buffer, sizeof(buffer), 10, "\r\n");
+        if (String((const char *) buffer, length) != "line3") {
+            return false;
+        }
+    }
+    {
+        MemoryReceiver test("aab$$xyz");
+        uint8_t buffer[64];
+        static const uint8_t end[] = "$$";
+        ssize_t length = test.receiveByEndBytes(buffer, sizeof(buffer), end, 2, 1, 100);
+        if (String((const char *) buffer, length) != "aab$$x") {
+            return false;
+        }
+        // the rest is still received by size.
+        String str;
+        if (test.receiveBySize(&str, 2, 100) != 2 || str != "yz") {
+            return false;
+        }
+    }
+    {
+        MemoryReceiver test("0123456789");
+        uint8_t buffer[4];
+        ssize_t length = test.readLine(buffer, sizeof(buffer), 100);
+        if (length != 4 || memcmp(buffer, "0123", 4) != 0) {
+            return false;
+        }
+        if (test.bufferedCount() != 6) {
+            return false;
+        }
+    }
+    {
+        MemoryReceiver test("GET Sec-WebSocket-Key: abc\r\n\r\n");
+        uint8_t buffer[64];
+        static const uint8_t start[] = "Key:";
+        static const uint8_t end[] = "\r\n";
+        ssize_t length = test.receiveByEndBytes(buffer, sizeof(buffer), start, 4, end, 2, 0, 100);
+        if (String((const char *) buffer, length) != "Key: abc\r\n") {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testGetLengthByLine() {
+    {
+        MemoryReceiver test("abc\ndef\n");
+        ssize_t length = test.getLengthByLine(100);
+        if (length != 4) {
+            return false;
+        }
+        uint8_t buffer[64];
+        if (test.receiveBySize(buffer, sizeof(buffer), length, 100) != 4) {
+            return false;
+        }
+        if (memcmp(buffer, "abc\n", 4) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool testReceiveBySize() {
+    {
+        MemoryReceiver test("0123456789");
+        uint8_t buffer[64];
+        if (test.receiveBySize(buffer, sizeof(buffer), 4, 100) != 4) {
+            return false;
+        }
+        ByteArray array;
+        if (test.receiveBySize(&array, 6, 100) != 6) {
+            return false;
+        }
+        if (array.count() != 6 || array[0] != '4' || array[5] != '9') {
+            return false;
+        }
+        // timeout.
+        if (test.receiveBySize(buffer, sizeof(buffer), 4, 10) != 0) {
+            return false;
+        }
+    }
+    {
+        MemoryReceiver test("ab\x7d\x5d" "cd");
+        EscapeOption escape;
+        escape.toEscapeBuffer[0] = 0x7d;
+        escape.toEscapeBuffer[1] = 0x5d;
+        escape.toEscapeLength = 2;
+        escape.escapeBuffer[0] = 0x7d;
+        escape.escapeLength = 1;
+        uint8_t buffer[64];
+        ssize_t length = test.receiveBySize(buffer, sizeof(buffer), 0, 5, 100, &escape);
+        if (length != 5 || memcmp(buffer, "ab\x7d" "cd", 5) != 0) {
+            return false;
+        }
+    }
+    {
+        MemoryReceiver test("abc\ndef");
+        uint8_t buffer[64];
+        test.readLine(buffer, sizeof(buffer), 100);
+        ByteArray array;
+        if (test.receive(3, array) != 3 || array.count() != 3 || array[0] != 'd') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main() {
+    if (!testReceiveBuffer()) {
+        return 1;
+    }
+    if (!testReadLine()) {
+        return 2;
+    }
+    if (!testGetLengthByLine()) {
+        return 3;
+    }
+    if (!testReceiveBySize()) {
+        return 4;
+    }
+
+    return 0;
+}
@@ -89,6 +89,38 @@ bool testSendAndReceive() {
     return true;
 }
 
+bool testReadAhead() {
+    {
+        TcpClient test;
+        if (!test.connectToHost(_serverHost, _serverPort)) {
+            return false;
+        }
+        if (!test.waitAvailable(1000)) {
+            return false;
+        }
+        Thread::msleep(100);
+
+        // the rest of the data is read ahead while finding the end of the line.
+        uint8_t buffer[64];
+        ssize_t length = test.readLine(buffer, sizeof(buffer), 1000, "test");
+        if (String((const char *) buffer, length) != "中文test") {
+            return false;
+        }
+        if (test.available() != 6 || !test.waitAvailable(0)) {
+            return false;
+        }
+        length = test.receive(buffer, 0, sizeof(buffer));
+        if (length != 6 || memcmp(buffer, "Abc123", 6) != 0) {
+            return false;
+        }
+        if (test.available() != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     // start a tcp server.
     TcpServer server;
@@ -114,6 +146,9 @@ int main() {
     if (!testSendAndReceive()) {
         result = 3;
     }
+    if (!testReadAhead()) {
+        result = 4;
+    }
 
     cleanUp();
 
@@ -9,6 +9,12 @@
 #include "rpc/RpcClient.h"
 #include "rpc/RpcServer.h"
 #include "data/Vector.h"
+#include "system/Environment.h"
+#include "system/BCDProvider.h"
+#include "system/CheckProvider.h"
+#include "net/TcpClient.h"
+#include "IO/MemoryStream.h"
+#include <atomic>
 
 using namespace Rpc;
 using namespace Data;
@@ -416,6 +422,189 @@ bool testInvoke() {
     return true;
 }
 
+// the client sampler is online after the first heartbeat.
+bool waitForOnline(TestRpcClient &client) {
+    for (int i = 0; i < 100; i++) {
+        if (!client.sayHello("online").isNullOrEmpty()) {
+            return true;
+        }
+        Thread::msleep(100);
+    }
+    return false;
+}
+
+bool testPipelined() {
+    TestRpcClient test((RpcClientContext(_endpoint, true)));
+    if (!test.connect() || !waitForOnline(test)) {
+        return false;
+    }
+
+    String request = "中文Abc123";
+    if (test.sayHello(request) != String::format("Hello %s!", request.c_str())) {
+        return false;
+    }
+    IntArray array = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    if (test.sayHelloMultiPacket(array) != "Hello 1-10!") {
+        return false;
+    }
+
+    // the calls of the threads are in flight at the same time, each gets its own response.
+    std::atomic<int> succeeded(0);
+    Thread *threads[16];
+    for (size_t i = 0; i < 16; i++) {
+        threads[i] = new Thread("rpc.test", [&test, &succeeded, i]() {
+            for (int j = 0; j < 20; j++) {
+                String user = String::format("%d-%d", (int) i, j);
+                if (test.sayHello(user) == String::format("Hello %s!", user.c_str())) {
+                    succeeded++;
+                }
+            }
+        });
+        threads[i]->start();
+    }
+    for (auto thread: threads) {
+        thread->join();
+        delete thread;
+    }
+    if (succeeded != 16 * 20 || test.pendingCount() != 0) {
+        return false;
+    }
+
+    return true;
+}
+
+bool testBenchmark() {
+    static const int Concurrencies[] = {1, 16, 256};
+
+    for (int pipelined = 0; pipelined <= 1; pipelined++) {
+        // the sync calls wait for each other, fewer of them.
+        const int count = pipelined ? 2000 : 500;
+        TestRpcClient test((RpcClientContext(_endpoint, pipelined != 0)));
+        if (!test.connect() || !waitForOnline(test)) {
+            return false;
+        }
+
+        for (int concurrency: Concurrencies) {
+            std::atomic<int> next(0);
+            std::atomic<int> succeeded(0);
+            auto threads = new Thread *[concurrency];
+            uint64_t start = Environment::getTickCount();
+            for (int i = 0; i < concurrency; i++) {
+                threads[i] = new Thread("rpc.bench", [&test, &next, &succeeded, count]() {
+                    while (next++ < count) {
+                        if (!test.sayHello("bench").isNullOrEmpty()) {
+                            succeeded++;
+                        }
+                    }
+                });
+                threads[i]->start();
+            }
+            for (int i = 0; i < concurrency; i++) {
+                threads[i]->join();
+                delete threads[i];
+            }
+            delete[] threads;
+            uint64_t elapsed = Environment::getTickCount() - start;
+            printf("%s, concurrency %d, %d calls: %d ok, %.0f calls/s\n", pipelined ? "pipelined" : "sync",
+                   concurrency, count, (int) succeeded, elapsed > 0 ? succeeded * 1000.0 / (double) elapsed : 0.0);
+            if (pipelined && succeeded != count) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// A batch request frame (0x19) as the client writes it, count is not checked against the requests.
+ByteArray batchFrame(uint32_t count, const ByteArray &requests) {
+    ByteArray buffer;
+    MemoryStream ms(&buffer, false);
+    ms.writeByte(0xEE);
+    ms.writeByte(1);    // frame id
+    ms.writeByte(0);    // state
+    ms.writeUInt32(0);  // length
+    ms.writeByte(0x19);
+    Version(1, 0).writeByte(&ms);
+    ms.writeUInt32(count);
+    ms.write(requests.data(), 0, requests.count());
+
+    uint8_t lengthBuffer[4];
+    BCDProvider::bin2buffer((uint32_t) (buffer.count() - 3 - 4 + 2), lengthBuffer);
+    ms.seek(3, SeekBegin);
+    ms.write(lengthBuffer, 0, sizeof(lengthBuffer));
+    ms.seek(0, SeekEnd);
+    ms.writeUInt16(Crc16Provider::MODBUS.calc(buffer.data(), 1, buffer.count() - 1));
+    return buffer;
+}
+
+// One request of the batch, length is the length written for the data.
+void writeBatchRequest(ByteArray &requests, const Uuid &token, const String &user, uint32_t length = 0) {
+    MemoryStream ms(&requests, false);
+    ms.seek(0, SeekEnd);
+    RpcMethodContext("sayHello").write(&ms);
+    token.write(&ms);
+    HelloRequest request(user);
+    MemoryStream data;
+    request.write(&data);
+    ms.writeUInt32(length > 0 ? length : (uint32_t) data.length());
+    ms.write(data.buffer()->data(), 0, data.length());
+}
+
+bool contains(const ByteArray &buffer, const Uuid &token) {
+    uint8_t value[16];
+    MemoryStream ms;
+    token.write(&ms);
+    memcpy(value, ms.buffer()->data(), sizeof(value));
+    return std::search(buffer.data(), buffer.data() + buffer.count(), value, value + sizeof(value)) !=
+           buffer.data() + buffer.count();
+}
+
+bool testForgedBatch() {
+    TcpClient client;
+    if (!client.connectToHost(_endpoint)) {
+        return false;
+    }
+
+    // one request with a count of 0xFFFFFFFF, it must not spin on the empty stream.
+    Uuid token1 = Uuid::generate();
+    ByteArray requests1;
+    writeBatchRequest(requests1, token1, "forged");
+    ByteArray frame1 = batchFrame(0xFFFFFFFF, requests1);
+    client.send(frame1.data(), 0, frame1.count());
+
+    // the length of the request is larger than the frame, it is dropped.
+    Uuid token2 = Uuid::generate();
+    ByteArray requests2;
+    writeBatchRequest(requests2, token2, "truncated", 0x7FFFFFFF);
+    ByteArray frame2 = batchFrame(1, requests2);
+    client.send(frame2.data(), 0, frame2.count());
+
+    // the frame after them is still served.
+    Uuid token3 = Uuid::generate();
+    ByteArray requests3;
+    writeBatchRequest(requests3, token3, "valid");
+    ByteArray frame3 = batchFrame(1, requests3);
+    client.send(frame3.data(), 0, frame3.count());
+
+    ByteArray received;
+    uint64_t start = Environment::getTickCount();
+    while (Environment::getTickCount() - start < 3000 && !(contains(received, token1) && contains(received, token3))) {
+        if (client.waitAvailable(100)) {
+            uint8_t buffer[1024];
+            ssize_t length = client.receive(buffer, 0, sizeof(buffer));
+            if (length > 0) {
+                received.addRange(buffer, length);
+            }
+        }
+    }
+    if (!contains(received, token1) || !contains(received, token3) || contains(received, token2)) {
+        return false;
+    }
+
+    return true;
+}
+
 int main() {
     Trace::enableConsoleOutput();
     Trace::enableFlushConsoleOutput();
@@ -432,6 +621,15 @@ int main() {
     if (!testInvoke()) {
         return 3;
     }
+    if (!testPipelined()) {
+        return 4;
+    }
+    if (!testBenchmark()) {
+        return 5;
+    }
+    if (!testForgedBatch()) {
+        return 6;
+    }
 
     return 0;
 }
\ No newline at end of file
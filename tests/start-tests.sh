@@ -20,9 +20,11 @@ runTest crypto/SHAProviderTest
 runTest crypto/SmProviderTest
 runTest data/ArrayTest
 runTest data/ByteArrayTest
+runTest data/ConcurrentLoopListTest
 runTest data/ConvertTest
 runTest data/DateTimeTest
 runTest data/DictionaryTest
+runTest data/HashDictionaryTest
 runTest data/ListTest
 runTest data/LoopListTest
 runTest data/LoopVectorTest
@@ -56,8 +58,13 @@ runTest diag/MemoryTraceListenerTest
 runTest diag/ProcessTest
 runTest diag/StopMemoryTest
 runTest diag/StopwatchTest
+runTest driver/DriverManagerTest
+runTest driver/TcpServerInteractiveTest
 runTest http/HttpClientTest
 runTest http/HttpContentTest
+runTest http/HttpRouterTest
+runTest http/HttpServerTest
+runTest IO/BufferedStreamTest
 runTest IO/DirectoryTest
 runTest IO/FileStreamTest
 runTest IO/FileTest
@@ -77,6 +84,7 @@ runTest microservice/SummerStarterTest
 runTest net/DnsTest
 runTest net/NetInterfaceTest
 runTest net/NetTypeTest
+runTest net/ReceiverTest
 runTest net/TcpClientTest
 runTest rpc/RpcClientTest
 runTest system/ActionTest
@@ -7,6 +7,7 @@
 //
 
 #include "system/CheckProvider.h"
+#include "system/Environment.h"
 
 using namespace System;
 
@@ -441,6 +442,105 @@ bool testCrc32Provider() {
     return true;
 }
 
+template<class Type>
+bool testCrcKernel(CrcProvider<Type> &provider, const uint8_t *buffer, size_t length) {
+    // all the alignments and the tails of the 8 bytes steps.
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t count = 0; count < 300; count++) {
+            if (provider.calc(buffer, (off_t) offset, count) != provider.calcDirectly(buffer, (off_t) offset, count)) {
+                return false;
+            }
+        }
+    }
+    for (size_t count = 300; count <= length; count += 97) {
+        if (provider.calc(buffer, 0, count) != provider.calcDirectly(buffer, 0, count)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool testCrcKernels() {
+    static const size_t Length = 4096;
+    uint8_t buffer[Length];
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < Length; i++) {
+        seed = seed * 1103515245 + 12345;
+        buffer[i] = (uint8_t) (seed >> 16);
+    }
+
+    Crc8Provider *crc8s[] = {&Crc8Provider::CRC8, &Crc8Provider::DARC, &Crc8Provider::ITU, &Crc8Provider::ROHC};
+    for (Crc8Provider *provider: crc8s) {
+        if (!testCrcKernel<uint8_t>(*provider, buffer, Length)) {
+            return false;
+        }
+    }
+    Crc16Provider *crc16s[] = {&Crc16Provider::MODBUS, &Crc16Provider::XMODEM, &Crc16Provider::X_25,
+                               &Crc16Provider::DNP, &Crc16Provider::T10_DIF, &Crc16Provider::CDMA2000};
+    for (Crc16Provider *provider: crc16s) {
+        if (!testCrcKernel<uint16_t>(*provider, buffer, Length)) {
+            return false;
+        }
+    }
+    Crc32Provider *crc32s[] = {&Crc32Provider::CRC32, &Crc32Provider::BZIP2, &Crc32Provider::JAMCRC,
+                               &Crc32Provider::POSIX, &Crc32Provider::C, &Crc32Provider::D,
+                               &Crc32Provider::Q, &Crc32Provider::XFER};
+    for (Crc32Provider *provider: crc32s) {
+        if (!testCrcKernel<uint32_t>(*provider, buffer, Length)) {
+            return false;
+        }
+    }
+
+    // not a preset.
+    {
+        Crc16Provider provider({0x1234, 0x5678, false, false, 0x0000});
+        if (!testCrcKernel<uint16_t>(provider, buffer, Length)) {
+            return false;
+        }
+    }
+    {
+        Crc32Provider provider({0x12345679, 0xFFFFFFFF, true, true, 0x00000000});
+        if (!testCrcKernel<uint32_t>(provider, buffer, Length)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<class Type>
+void benchmarkCrc(const char *name, CrcProvider<Type> &provider, const uint8_t *buffer, size_t length) {
+    static const int Rounds = 4;
+    Type result = 0;
+    uint64_t start = Environment::getTickCount();
+    for (int i = 0; i < Rounds; i++) {
+        result = provider.calc(buffer, length);
+    }
+    uint64_t elapsed = Environment::getTickCount() - start;
+    double seconds = (elapsed > 0 ? elapsed : 1) / 1000.0;
+    printf("%s, %d MB: %.2f GB/s (0x%X)\n", name, (int) (length * Rounds / 1024 / 1024),
+           length * Rounds / seconds / 1024 / 1024 / 1024, (unsigned) result);
+}
+
+bool testBenchmark() {
+    static const size_t Length = 64 * 1024 * 1024;
+    auto buffer = new uint8_t[Length];
+    for (size_t i = 0; i < Length; i++) {
+        buffer[i] = (uint8_t) (i * 31 + (i >> 8));
+    }
+
+    benchmarkCrc<uint8_t>("Crc8Provider::CRC8", Crc8Provider::CRC8, buffer, Length);
+    benchmarkCrc<uint8_t>("Crc8Provider::MAXIM", Crc8Provider::MAXIM, buffer, Length);
+    benchmarkCrc<uint16_t>("Crc16Provider::MODBUS", Crc16Provider::MODBUS, buffer, Length);
+    benchmarkCrc<uint16_t>("Crc16Provider::XMODEM", Crc16Provider::XMODEM, buffer, Length);
+    benchmarkCrc<uint32_t>("Crc32Provider::CRC32", Crc32Provider::CRC32, buffer, Length);
+    benchmarkCrc<uint32_t>("Crc32Provider::MPEG_2", Crc32Provider::MPEG_2, buffer, Length);
+    benchmarkCrc<uint32_t>("Crc32Provider::C", Crc32Provider::C, buffer, Length);
+
+    delete[] buffer;
+    return true;
+}
+
 int main() {
     if (!testBccProvider()) {
         return 1;
@@ -457,6 +557,12 @@ int main() {
     if (!testCrc32Provider()) {
         return 5;
     }
+    if (!testCrcKernels()) {
+        return 6;
+    }
+    if (!testBenchmark()) {
+        return 7;
+    }
 
     return 0;
 }
\ No newline at end of file
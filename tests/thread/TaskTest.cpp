@@ -8,6 +8,8 @@
 
 #include "thread/Task.h"
 #include "system/Environment.h"
+#include <atomic>
+#include <vector>
 
 using namespace Threading;
 using namespace System;
@@ -226,6 +228,101 @@ bool testStatus() {
     return true;
 }
 
+bool testWhen() {
+    {
+        auto func = [](int ms) {
+            Thread::msleep(ms);
+            return ms;
+        };
+        Task task1(func, 100);
+        Task task2(func, 200);
+        Task all = Task::whenAll(task1, task2);
+        if (!all.wait(TimeSpan::fromSeconds(3))) {
+            return false;
+        }
+        if (!task1.isCompleted() || !task2.isCompleted()) {
+            return false;
+        }
+        if (task2.result<int>() != 200) {
+            return false;
+        }
+    }
+    {
+        auto func = [](int ms) {
+            Thread::msleep(ms);
+            return ms;
+        };
+        Task task1(func, 1000);
+        Task task2(func, 10);
+        Task any = Task::whenAny(task1, task2);
+        if (any.result<int>() != 1) {
+            return false;
+        }
+        if (task1.isCompleted()) {
+            return false;
+        }
+    }
+    {
+        Task *tasks[] = {nullptr};
+        Task all = Task::whenAll(tasks, 0);
+        if (!all.isCompleted()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void tinyProc(std::atomic<int> *count) {
+    (*count)++;
+}
+
+bool testBenchmark() {
+    static const int BatchCount = 10000;
+    {
+        static const int Count = 1000000;
+        std::atomic<int> count(0);
+        uint64_t start = Environment::getTickCount();
+        std::vector<Task> tasks;
+        tasks.reserve(BatchCount);
+        for (int i = 0; i < Count; i += BatchCount) {
+            for (int j = 0; j < BatchCount; j++) {
+                tasks.emplace_back(tinyProc, &count);
+            }
+            tasks.clear();
+        }
+        uint64_t elapsed = Environment::getTickCount() - start;
+        printf("task executor, tasks: %d, elapsed: %llu ms, %.3f us/task\n", Count,
+               (unsigned long long) elapsed, (double) elapsed * 1000.0 / Count);
+        if (count != Count) {
+            return false;
+        }
+    }
+    {
+        // thread per task, fewer tasks since it is much slower.
+        static const int Count = 10000;
+        std::atomic<int> count(0);
+        uint64_t start = Environment::getTickCount();
+        PList<Thread> threads;
+        for (int i = 0; i < Count; i += BatchCount) {
+            for (int j = 0; j < BatchCount; j++) {
+                auto thread = new Thread("task", tinyProc, &count);
+                thread->start();
+                threads.add(thread);
+            }
+            threads.clear();
+        }
+        uint64_t elapsed = Environment::getTickCount() - start;
+        printf("thread per task, tasks: %d, elapsed: %llu ms, %.3f us/task\n", Count,
+               (unsigned long long) elapsed, (double) elapsed * 1000.0 / Count);
+        if (count != Count) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 int main() {
     if (!testConstructor()) {
         return 1;
@@ -236,6 +333,12 @@ int main() {
     if (!testStatus()) {
         return 3;
     }
+    if (!testWhen()) {
+        return 4;
+    }
+    if (!testBenchmark()) {
+        return 5;
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include "thread/Timer.h"
 #include "system/OsDefine.h"
 #include "diag/Trace.h"
+#include "thread/TimerService.h"
+#include "system/Environment.h"
+#include <atomic>
 
 #ifdef WEB_OS
 #include <emscripten.h>
@@ -349,6 +352,199 @@ bool testChange() {
 
     return true;
 }
+
+bool testDestroy() {
+    // a callback longer than the timeout does not block the destroy.
+    static std::atomic<bool> fired(false);
+    auto timerProc = []() {
+        fired = true;
+        Thread::msleep(1000);
+    };
+    auto service = TimerService::instance();
+    auto entry = service->create("t1", Action(timerProc), 0, Timer::Infinite);
+    service->start(entry);
+    uint64_t start = Environment::getTickCount();
+    while (!fired && Environment::getTickCount() - start < 1000) {
+        Thread::msleep(10);
+    }
+    start = Environment::getTickCount();
+    service->destroy(entry, 100);
+    if (!fired || Environment::getTickCount() - start >= 900) {
+        return false;
+    }
+    // the worker releases the entry after the callback.
+    Thread::msleep(1000);
+
+    return true;
+}
+
+struct CascadeState {
+    uint64_t start;
+    std::atomic<uint64_t> fired;
+};
+
+static void cascadeProc(CascadeState *state) {
+    state->fired = Environment::getTickCount();
+}
+
+bool testCascade() {
+    // the due times past the first level (64 ms) and the second one (4096 ms) cascade down before they fire.
+    static const int DueTimes[] = {30, 100, 1000, 5000};
+    static const int Count = sizeof(DueTimes) / sizeof(DueTimes[0]);
+    static const uint64_t Tolerance = 50;
+
+    CascadeState states[Count];
+    PList<Timer> timers;
+    for (int i = 0; i < Count; i++) {
+        states[i].start = Environment::getTickCount();
+        states[i].fired = 0;
+        timers.add(new Timer(String::convert("cascade%d", i), DueTimes[i], Timer::Infinite, cascadeProc,
+                             &states[i]));
+    }
+    uint64_t start = Environment::getTickCount();
+    while (states[Count - 1].fired == 0 && Environment::getTickCount() - start < 7000) {
+        Thread::msleep(10);
+    }
+    timers.clear();
+
+    for (int i = 0; i < Count; i++) {
+        uint64_t fired = states[i].fired;
+        if (fired == 0) {
+            return false;
+        }
+        uint64_t elapsed = fired - states[i].start;
+        if (elapsed + 1 < (uint64_t) DueTimes[i] || elapsed > DueTimes[i] + Tolerance) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The late of the fired timers in ms, the last bucket counts the ones later than it.
+struct Jitter {
+    static const int BucketCount = 1001;
+    std::atomic<uint64_t> buckets[BucketCount];
+
+    Jitter() {
+        for (int i = 0; i < BucketCount; i++) {
+            buckets[i] = 0;
+        }
+    }
+
+    void add(uint64_t late) {
+        buckets[late < BucketCount - 1 ? late : BucketCount - 1]++;
+    }
+
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (int i = 0; i < BucketCount; i++) {
+            total += buckets[i];
+        }
+        return total;
+    }
+
+    int percentile(double ratio) const {
+        uint64_t total = count();
+        uint64_t rank = (uint64_t) ((double) total * ratio);
+        if (rank >= total && total > 0) {
+            rank = total - 1;
+        }
+        total = 0;
+        for (int i = 0; i < BucketCount; i++) {
+            total += buckets[i];
+            if (total > rank) {
+                return i;
+            }
+        }
+        return BucketCount - 1;
+    }
+
+    void print(const char *name, int timerCount, size_t threadCount) const {
+        printf("%s, timers: %d, threads: %d, fired: %llu, jitter p50: %d ms, p90: %d ms, p99: %d ms, max: %d ms\n",
+               name, timerCount, (int) threadCount, (unsigned long long) count(),
+               percentile(0.5), percentile(0.9), percentile(0.99), percentile(1.0));
+    }
+};
+
+struct TimerState {
+    Jitter *jitter;
+    int period;
+    uint64_t last;
+    uint64_t fired;
+};
+
+static void timerStateProc(TimerState *state) {
+    uint64_t now = Environment::getTickCount();
+    if (state->fired > 0) {
+        uint64_t expected = state->last + state->period;
+        state->jitter->add(now > expected ? now - expected : expected - now);
+    }
+    state->last = now;
+    state->fired++;
+}
+
+// the thread per timer loop before the timer wheel, sleeps in 10 ms slices.
+static void legacyTimerProc(TimerState *state, std::atomic<bool> *loop) {
+    uint64_t start = Environment::getTickCount();
+    while (*loop) {
+        timerStateProc(state);
+        start += state->period;
+        while (*loop && Environment::getTickCount() < start) {
+            Thread::msleep(10);
+        }
+    }
+}
+
+bool testBenchmark() {
+    static const int Period = 100;
+    static const uint32_t Duration = 2000;
+    {
+        static const int Count = 10000;
+        TimerService *service = TimerService::instance();
+        auto jitter = new Jitter();
+        auto states = new TimerState[Count];
+        PList<Timer> timers;
+        for (int i = 0; i < Count; i++) {
+            states[i] = {jitter, Period, 0, 0};
+            timers.add(new Timer(String::convert("bench%d", i), Period, timerStateProc, &states[i]));
+        }
+        Thread::msleep(Duration);
+        size_t workerCount = service->workerCount();
+        timers.clear();
+        delete[] states;
+
+        jitter->print("timer wheel", Count, workerCount);
+        bool result = jitter->count() >= (uint64_t) Count && workerCount <= service->maxWorkerCount();
+        delete jitter;
+        if (!result) {
+            return false;
+        }
+    }
+    {
+        // thread per timer, fewer timers to stay within the process limits.
+        static const int Count = 1000;
+        auto jitter = new Jitter();
+        std::atomic<bool> loop(true);
+        auto states = new TimerState[Count];
+        PList<Thread> threads;
+        for (int i = 0; i < Count; i++) {
+            states[i] = {jitter, Period, 0, 0};
+            auto thread = new Thread(String::convert("legacy%d", i), legacyTimerProc, &states[i], &loop);
+            thread->start();
+            threads.add(thread);
+        }
+        Thread::msleep(Duration);
+        loop = false;
+        threads.clear();
+        delete[] states;
+
+        jitter->print("thread per timer", Count, Count);
+        delete jitter;
+    }
+
+    return true;
+}
 #endif // WEB_OS
 
 int main() {
@@ -364,6 +560,17 @@ int main() {
     if (!testChange()) {
         return 4;
     }
+#ifndef WEB_OS
+    if (!testDestroy()) {
+        return 5;
+    }
+    if (!testCascade()) {
+        return 6;
+    }
+    if (!testBenchmark()) {
+        return 7;
+    }
+#endif
 
     return 0;
 }
\ No newline at end of file